@@ -1,16 +1,23 @@
 SET(ERTWRAPPER_HEADERS
 	eclgridreader.h
 	eclsummaryreader.h
+	eclsummarysnapshot.h
 	ertwrapper_exceptions.h
 )
 
 SET(ERTWRAPPER_SOURCES
 	eclgridreader.cpp
 	eclsummaryreader.cpp
+	eclsummarysnapshot.cpp
 )
 
 SET(ERTWRAPPER_TESTS
 	tests/test_eclgridreader.cpp
 	tests/test_eclsummaryreader.cpp
+	tests/test_eclsummarysnapshot.cpp
 )
 
+
+SET(ERTWRAPPER_BENCHMARKS
+	benchmarks/bench_summary_reader.cpp
+)
@@ -0,0 +1,134 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+/*!
+ * Benchmark of reading the results of one evaluation from a summary.
+ *
+ * Usage: ./bench_ertwrapper [n_wells [n_steps [n_reads]]]
+ *        ./bench_ertwrapper summary_path [n_reads]
+ *
+ * Without a summary path, a synthetic summary with n_wells wells (default 200),
+ * each with rate and cumulative vectors, and n_steps report steps (default 500)
+ * is written to a temporary directory. Two access patterns are timed:
+ *  - objective: the time vector and field cumulatives used by a typical NPV objective;
+ *  - all vectors: every field and well vector, i.e. what the reader used to extract
+ *    when the summary was read.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <boost/filesystem.hpp>
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_tstep.h>
+#include "ERTWrapper/eclsummaryreader.h"
+
+using ERTWrapper::ECLSummary::ECLSummaryReader;
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Write a synthetic summary with the given number of wells and report steps.
+std::string write_summary(int n_wells, int n_steps) {
+    std::string dir = (boost::filesystem::temp_directory_path() / "fieldopt_bench_summary").string();
+    boost::filesystem::create_directories(dir);
+    std::string case_path = dir + "/BENCH";
+
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer(case_path.c_str(), false, true, ":", 0, true, 10, 10, 10);
+    std::vector<smspec_node_type *> nodes;
+    std::vector<double> rates;
+    for (std::string key : {"FOPT", "FWPT", "FGPT", "FWIT", "FGIT"}) {
+        nodes.push_back(ecl_sum_add_var(ecl_sum, key.c_str(), NULL, 0, "SM3", 0));
+        rates.push_back(1000.0 * n_wells);
+    }
+    for (int w = 0; w < n_wells; ++w) {
+        std::string well = "W" + std::to_string(w);
+        for (std::string key : {"WOPR", "WWPR", "WGPR", "WWIR", "WGIR", "WBHP", "WTHP", "WWCT"}) {
+            nodes.push_back(ecl_sum_add_var(ecl_sum, key.c_str(), well.c_str(), 0, "SM3/DAY", 0));
+            rates.push_back(0.0);
+        }
+        for (std::string key : {"WOPT", "WWPT", "WGPT", "WWIT", "WGIT"}) {
+            nodes.push_back(ecl_sum_add_var(ecl_sum, key.c_str(), well.c_str(), 0, "SM3", 0));
+            rates.push_back(1000.0);
+        }
+    }
+    for (int step = 1; step <= n_steps; ++step) {
+        double days = 10.0 * step;
+        ecl_sum_tstep_type *tstep = ecl_sum_add_tstep(ecl_sum, step, days * 86400);
+        for (int i = 0; i < (int)nodes.size(); ++i) {
+            ecl_sum_tstep_set_from_node(tstep, nodes[i], rates[i] > 0 ? rates[i] * days : 100.0);
+        }
+    }
+    ecl_sum_fwrite(ecl_sum);
+    ecl_sum_free(ecl_sum);
+    return case_path;
+}
+
+double read_objective_vectors(const std::string &path) {
+    ECLSummaryReader reader(path);
+    return reader.time().back() + reader.fopt().back() + reader.fwpt().back() + reader.fwit().back();
+}
+
+double read_all_vectors(const std::string &path) {
+    ECLSummaryReader reader(path);
+    double sum = reader.time().back() + reader.fopt().back() + reader.fwpt().back() + reader.fgpt().back()
+        + reader.fwit().back() + reader.fgit().back();
+    for (auto &well : reader.wells()) {
+        sum += reader.wopr(well).back() + reader.wwpr(well).back() + reader.wgpr(well).back()
+            + reader.wwir(well).back() + reader.wgir(well).back();
+        sum += reader.wopt(well).back() + reader.wwpt(well).back() + reader.wgpt(well).back()
+            + reader.wwit(well).back() + reader.wgit(well).back();
+    }
+    return sum;
+}
+
+}
+
+int main(int argc, const char *argv[]) {
+    std::string path;
+    int n_reads = 10;
+    if (argc > 1 && !std::isdigit(argv[1][0])) {
+        path = argv[1];
+        if (argc > 2) n_reads = std::atoi(argv[2]);
+    }
+    else {
+        int n_wells = argc > 1 ? std::atoi(argv[1]) : 200;
+        int n_steps = argc > 2 ? std::atoi(argv[2]) : 500;
+        if (argc > 3) n_reads = std::atoi(argv[3]);
+        std::cout << "Writing synthetic summary with " << n_wells << " wells and " << n_steps << " report steps." << std::endl;
+        path = write_summary(n_wells, n_steps);
+    }
+
+    double check = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n_reads; ++i) check += read_objective_vectors(path);
+    double objective_time = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n_reads; ++i) check += read_all_vectors(path);
+    double all_time = seconds_since(start);
+
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "Objective vectors: " << objective_time / n_reads << " s pr. evaluation" << std::endl;
+    std::cout << "All vectors:       " << all_time / n_reads << " s pr. evaluation" << std::endl;
+    std::cout << "Speedup:           " << std::setprecision(1) << all_time / objective_time << "x" << std::endl;
+    return check > 0 ? 0 : 1;
+}
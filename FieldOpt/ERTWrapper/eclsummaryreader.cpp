@@ -34,8 +34,14 @@ ECLSummaryReader::ECLSummaryReader(string file_name)
     file_name_ = file_name;
     ecl_sum_ = ecl_sum_fread_alloc_case(file_name_.c_str(), "");
     if (ecl_sum_ == NULL) throw SummaryFileNotFoundAtPathException(file_name);
-    populateKeyLists();
-    initializeVectors();
+    key_lists_populated_ = false;
+
+    stringlist_type * wells = ecl_sum_alloc_well_list(ecl_sum_, NULL);
+    for (int i = 0; i < stringlist_get_size(wells); ++i)
+        wells_.insert(stringlist_safe_iget(wells, i));
+    stringlist_free(wells);
+
+    initializeTimeVector();
 }
 
 ECLSummaryReader::~ECLSummaryReader()
@@ -91,365 +97,185 @@ bool ECLSummaryReader::HasReportStep(int report_step) {
     return report_step <= GetLastReportStep() && report_step >= GetFirstReportStep();
 }
 
-bool ECLSummaryReader::hasWellVar(string well_name, string var_name) {
+bool ECLSummaryReader::hasWellVar(string well_name, string var_name) const {
     return ecl_sum_has_well_var(ecl_sum_, well_name.c_str(), var_name.c_str());
 }
 
-bool ECLSummaryReader::hasGroupVar(string group_name, string var_name) {
+bool ECLSummaryReader::hasGroupVar(string group_name, string var_name) const {
     return ecl_sum_has_group_var(ecl_sum_, group_name.c_str(), var_name.c_str());
 }
 
-bool ECLSummaryReader::hasFieldVar(string var_name) {
+bool ECLSummaryReader::hasFieldVar(string var_name) const {
     return ecl_sum_has_field_var(ecl_sum_, var_name.c_str());
 }
 
-bool ECLSummaryReader::hasBlockVar(int block_nr, string var_name) {
+bool ECLSummaryReader::hasBlockVar(int block_nr, string var_name) const {
     return ecl_sum_has_block_var(ecl_sum_, var_name.c_str(), block_nr);
 }
 
-bool ECLSummaryReader::hasMiscVar(string var_name) {
+bool ECLSummaryReader::hasMiscVar(string var_name) const {
     return ecl_sum_has_misc_var(ecl_sum_, var_name.c_str());
 }
 
-void ECLSummaryReader::populateKeyLists() {
+const set<string> &ECLSummaryReader::keys() const {
+    populateKeyLists();
+    return keys_;
+}
+
+const set<string> &ECLSummaryReader::field_keys() const {
+    populateKeyLists();
+    return field_keys_;
+}
+
+const set<string> &ECLSummaryReader::well_keys() const {
+    populateKeyLists();
+    return well_keys_;
+}
+
+void ECLSummaryReader::populateKeyLists() const {
+    if (key_lists_populated_) return;
     stringlist_type * keys = ecl_sum_alloc_matching_general_var_list(ecl_sum_, NULL);
-    stringlist_type * wells = ecl_sum_alloc_well_list(ecl_sum_, NULL);
     stringlist_type * field_keys = ecl_sum_alloc_matching_general_var_list(ecl_sum_, "F*");
     stringlist_type * well_keys = ecl_sum_alloc_well_var_list(ecl_sum_);
 
     for (int i = 0; i < stringlist_get_size(keys); ++i)
         keys_.insert(stringlist_safe_iget(keys, i));
-    for (int j = 0; j < stringlist_get_size(wells); ++j)
-        wells_.insert(stringlist_safe_iget(wells, j));
     for (int k = 0; k < stringlist_get_size(field_keys); ++k)
         field_keys_.insert(stringlist_safe_iget(field_keys, k));
     for (int l = 0; l < stringlist_get_size(well_keys); ++l)
         well_keys_.insert(stringlist_safe_iget(well_keys, l));
 
-    std::stringstream ss;
-    ss << "Found summary keys: ";
-    for (auto key : keys_) ss << key << ", ";
-    for (auto key : field_keys_) ss << key << ", ";
-    for (auto well : wells_) {
-        for (auto key : well_keys_) ss << well << ":" << key << ", ";
-    }
     if (VERB_SIM >= 2) {
+        std::stringstream ss;
+        for (auto key : keys_) ss << key << ", ";
+        for (auto key : field_keys_) ss << key << ", ";
+        for (auto well : wells_) {
+            for (auto key : well_keys_) ss << well << ":" << key << ", ";
+        }
         Printer::ext_info("Found summary keys: " + ss.str(), "ERTWrapper, ECLSummaryReader");
     }
 
-
     stringlist_free(keys);
-    stringlist_free(wells);
     stringlist_free(field_keys);
     stringlist_free(well_keys);
-}
-
-void ECLSummaryReader::initializeVectors() {
-    initializeTimeVector();
-    initializeWellRates();
-    initializeWellCumulatives();
-    initializeFieldCumulatives();
+    key_lists_populated_ = true;
 }
 
 void ECLSummaryReader::initializeTimeVector() {
     int days_var_index = ecl_sum_get_misc_var_index(ecl_sum_, "TIME");
-    double_vector_type * time = ecl_sum_alloc_data_vector(ecl_sum_, days_var_index, true);
-    time_.resize(double_vector_size(time));
-    for (int i = 0; i < double_vector_size(time); ++i) {
-        time_[i] = (double_vector_safe_iget(time, i));
-    }
+    time_ = extractVector(days_var_index);
     time_[0] = GetFirstReportStep();
-    double_vector_free(time);
-}
-
-void ECLSummaryReader::initializeWellRates() {
-    const ecl_smspec_type * smspec;
-    smspec = ecl_sum_get_smspec(ecl_sum_);
-    for(auto wname : wells_) {
-        wopr_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WOPR")) {
-            int index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WOPR");
-            auto * data = ecl_sum_alloc_data_vector(ecl_sum_, index, true);
-            assert(double_vector_size(data) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wopr_[wname][i] = double_vector_safe_iget(data, i);
-            }
-            wopr_[wname][0] = GetWellVar(wname, "WOPR", 0);
-            double_vector_free(data);
-        }
-
-        wwpr_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WWPR")) {
-            int index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WWPR");
-            auto * data = ecl_sum_alloc_data_vector(ecl_sum_, index, true);
-            assert(double_vector_size(data) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wwpr_[wname][i] = double_vector_safe_iget(data, i);
-            }
-            wwpr_[wname][0] = GetWellVar(wname, "WWPR", 0);
-            double_vector_free(data);
-        }
-
-        wgpr_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WGPR")) {
-            int index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WGPR");
-            auto * data = ecl_sum_alloc_data_vector(ecl_sum_, index, true);
-            assert(double_vector_size(data) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wgpr_[wname][i] = double_vector_safe_iget(data, i);
-            }
-            wgpr_[wname][0] = GetWellVar(wname, "WGPR", 0);
-            double_vector_free(data);
-        }
-
-        wwir_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WWIR")) {
-            int index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WWIR");
-            auto * data = ecl_sum_alloc_data_vector(ecl_sum_, index, true);
-            assert(double_vector_size(data) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wwir_[wname][i] = double_vector_safe_iget(data, i);
-            }
-            wwir_[wname][0] = GetWellVar(wname, "WWIR", 0);
-            double_vector_free(data);
-        }
-
-        wgir_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WGIR")) {
-            int index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WGIR");
-            auto * data = ecl_sum_alloc_data_vector(ecl_sum_, index, true);
-            assert(double_vector_size(data) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wgir_[wname][i] = double_vector_safe_iget(data, i);
-            }
-            wgir_[wname][0] = GetWellVar(wname, "WGIR", 0);
-            double_vector_free(data);
-        }
-    }
 }
 
-void ECLSummaryReader::initializeWellCumulatives() {
-    const ecl_smspec_type * smspec = ecl_sum_get_smspec(ecl_sum_);
-    for (auto wname : wells_) {
-        wopt_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WOPT")) {
-            int wopt_index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WOPT");
-            double_vector_type * wopt = ecl_sum_alloc_data_vector(ecl_sum_, wopt_index, true);
-            assert(double_vector_size(wopt) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wopt_[wname][i] = double_vector_safe_iget(wopt, i);
-            }
-            wopt_[wname][0] = 0.0;
-            double_vector_free(wopt);
-        }
-        else if (hasWellVar(wname, "WOPR")) {
-            if (VERB_SIM >= 2) Printer::ext_info("WOPT not found, computing from WOPR.", "ERTWrapper", "ECLSummaryReader");
-            wopt_[wname] = computeCumulativeFromRate(wopr_[wname]);
-        }
-
-        wwpt_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WWPT")) {
-            int wwpt_index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WWPT");
-            double_vector_type * wwpt = ecl_sum_alloc_data_vector(ecl_sum_, wwpt_index, true);
-            assert(double_vector_size(wwpt) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wwpt_[wname][i] = double_vector_safe_iget(wwpt, i);
-            }
-            wwpt_[wname][0] = 0.0;
-            double_vector_free(wwpt);
-        }
-        else if (hasWellVar(wname, "WWPR")) {
-            if (VERB_SIM >= 2) Printer::ext_info("WWPT not found, computing from WWPR.", "ERTWrapper", "ECLSummaryReader");
-            wwpt_[wname] = computeCumulativeFromRate(wwpr_[wname]);
-        }
-
-        wgpt_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WGPT")) {
-            int wgpt_index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WGPT");
-            double_vector_type * wgpt = ecl_sum_alloc_data_vector(ecl_sum_, wgpt_index, true);
-            assert(double_vector_size(wgpt) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wgpt_[wname][i] = double_vector_safe_iget(wgpt, i);
-            }
-            wgpt_[wname][0] = 0.0;
-            double_vector_free(wgpt);
-        }
-        else if (hasWellVar(wname, "WGPR")) {
-            if (VERB_SIM >= 2) Printer::ext_info("WGPT not found, computing from WGPR.", "ERTWrapper", "ECLSummaryReader");
-            wgpt_[wname] = computeCumulativeFromRate(wgpr_[wname]);
-        }
-
-        wwit_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WWIT")) {
-            int wwit_index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WWIT");
-            double_vector_type * wwit = ecl_sum_alloc_data_vector(ecl_sum_, wwit_index, true);
-            assert(double_vector_size(wwit) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wwit_[wname][i] = double_vector_safe_iget(wwit, i);
-            }
-            wwit_[wname][0] = 0.0;
-            double_vector_free(wwit);
-        }
-        else if (hasWellVar(wname, "WWIR")) {
-            if (VERB_SIM >= 2) Printer::ext_info("WWIT not found, computing from WWIR.", "ERTWrapper", "ECLSummaryReader");
-            wwit_[wname] = computeCumulativeFromRate(wwir_[wname]);
-        }
-
-        wgit_[wname] = std::vector<double>(time_.size(), 0.0);
-        if (hasWellVar(wname, "WGIT")) {
-            int wgit_index = ecl_smspec_get_well_var_params_index(smspec, wname.c_str(), "WGIT");
-            double_vector_type * wgit = ecl_sum_alloc_data_vector(ecl_sum_, wgit_index, true);
-            assert(double_vector_size(wgit) == time_.size());
-            for (int i = 0; i < time_.size(); ++i) {
-                wgit_[wname][i] = double_vector_safe_iget(wgit, i);
-            }
-            wgit_[wname][0] = 0.0;
-            double_vector_free(wgit);
-        }
-        else if (hasWellVar(wname, "WGIR")) {
-            if (VERB_SIM >= 2) Printer::ext_info("WGIT not found, computing from WGIR.", "ERTWrapper", "ECLSummaryReader");
-            wgit_[wname] = computeCumulativeFromRate(wgir_[wname]);
-        }
+vector<double> ECLSummaryReader::extractVector(int params_index) const {
+    double_vector_type * data = ecl_sum_alloc_data_vector(ecl_sum_, params_index, true);
+    vector<double> values(double_vector_size(data));
+    for (int i = 0; i < double_vector_size(data); ++i) {
+        values[i] = double_vector_safe_iget(data, i);
     }
+    double_vector_free(data);
+    return values;
 }
 
-void ECLSummaryReader::initializeFieldCumulatives() {
-    const ecl_smspec_type * smspec = ecl_sum_get_smspec(ecl_sum_);
+void ECLSummaryReader::assertWellExists(const string &well_name) const {
+    if (wells_.find(well_name) == wells_.end())
+        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
+}
 
-    fopt_ = std::vector<double>(time_.size(), 0.0);
-    if (hasFieldVar("FOPT")) {
-        int fopt_index = ecl_smspec_get_field_var_params_index(smspec, "FOPT");
-        double_vector_type * fopt = ecl_sum_alloc_data_vector(ecl_sum_, fopt_index, true);
-        assert(double_vector_size(fopt) == time_.size());
-        for (int i = 0; i < time_.size(); ++i) {
-            fopt_[i] = double_vector_safe_iget(fopt, i);
-        }
-        fopt_[0] = 0.0;
-    }
-    else {
-        warnPropertyNotFound("FOPT");
-        for (auto wname : wells_) {
-            for (int i = 0; i < time_.size(); ++i) {
-                fopt_[i] += wopt_[wname][i];
-            }
-        }
-    }
+const vector<double> &ECLSummaryReader::wellRate(const string &well_name, const string &key) const {
+    assertWellExists(well_name);
+    auto &vectors = well_vectors_[key];
+    auto cached = vectors.find(well_name);
+    if (cached != vectors.end()) return cached->second;
 
-    fwpt_ = std::vector<double>(time_.size(), 0.0);
-    if (hasFieldVar("FWPT")) {
-        int fwpt_index = ecl_smspec_get_field_var_params_index(smspec, "FWPT");
-        double_vector_type * fwpt = ecl_sum_alloc_data_vector(ecl_sum_, fwpt_index, true);
-        assert(double_vector_size(fwpt) == time_.size());
-        for (int i = 0; i < time_.size(); ++i) {
-            fwpt_[i] = double_vector_safe_iget(fwpt, i);
-        }
-        fwpt_[0] = 0.0;
+    vector<double> rate(time_.size(), 0.0);
+    if (hasWellVar(well_name, key)) {
+        int index = ecl_smspec_get_well_var_params_index(ecl_sum_get_smspec(ecl_sum_), well_name.c_str(), key.c_str());
+        rate = extractVector(index);
+        assert(rate.size() == time_.size());
+        rate[0] = ecl_sum_get_well_var(ecl_sum_, 0, well_name.c_str(), key.c_str());
     }
-    else {
-        warnPropertyNotFound("FWPT");
-        for (auto wname : wells_) {
-            for (int i = 0; i < time_.size(); ++i) {
-                fwpt_[i] += wwpt_[wname][i];
-            }
-        }
+    return vectors[well_name] = rate;
+}
+
+const vector<double> &ECLSummaryReader::wellCumulative(const string &well_name,
+                                                       const string &key,
+                                                       const string &rate_key) const {
+    assertWellExists(well_name);
+    auto &vectors = well_vectors_[key];
+    auto cached = vectors.find(well_name);
+    if (cached != vectors.end()) return cached->second;
+
+    vector<double> cumulative(time_.size(), 0.0);
+    if (hasWellVar(well_name, key)) {
+        int index = ecl_smspec_get_well_var_params_index(ecl_sum_get_smspec(ecl_sum_), well_name.c_str(), key.c_str());
+        cumulative = extractVector(index);
+        assert(cumulative.size() == time_.size());
+        cumulative[0] = 0.0;
     }
-
-    fgpt_ = std::vector<double>(time_.size(), 0.0);
-    if (hasFieldVar("FGPT")) {
-        int fgpt_index = ecl_smspec_get_field_var_params_index(smspec, "FGPT");
-        double_vector_type * fgpt = ecl_sum_alloc_data_vector(ecl_sum_, fgpt_index, true);
-        assert(double_vector_size(fgpt) == time_.size());
-        for (int i = 0; i < time_.size(); ++i) {
-            fgpt_[i] = double_vector_safe_iget(fgpt, i);
-        }
-        fgpt_[0] = 0.0;
-    }
-    else {
-        warnPropertyNotFound("FGPT");
-        for (auto wname : wells_) {
-            for (int i = 0; i < time_.size(); ++i) {
-                fgpt_[i] += wgpt_[wname][i];
-            }
-        }
+    else if (hasWellVar(well_name, rate_key)) {
+        if (VERB_SIM >= 2) Printer::ext_info(key + " not found, computing from " + rate_key + ".", "ERTWrapper", "ECLSummaryReader");
+        cumulative = computeCumulativeFromRate(wellRate(well_name, rate_key));
     }
+    return vectors[well_name] = cumulative;
+}
 
-    fwit_ = std::vector<double>(time_.size(), 0.0);
-    if (hasFieldVar("FWIT")) {
-        int fwit_index = ecl_smspec_get_field_var_params_index(smspec, "FWIT");
-        double_vector_type * fwit = ecl_sum_alloc_data_vector(ecl_sum_, fwit_index, true);
-        assert(double_vector_size(fwit) == time_.size());
-        for (int i = 0; i < time_.size(); ++i) {
-            fwit_[i] = double_vector_safe_iget(fwit, i);
-        }
-        fwit_[0] = 0.0;
-    }
-    else {
-        warnPropertyNotFound("FWIT");
-        for (auto wname : wells_) {
-            for (int i = 0; i < time_.size(); ++i) {
-                fwit_[i] += wwit_[wname][i];
-            }
-        }
-    }
+const vector<double> &ECLSummaryReader::fieldCumulative(const string &key, const string &well_key) const {
+    auto cached = field_vectors_.find(key);
+    if (cached != field_vectors_.end()) return cached->second;
 
-    fgit_ = std::vector<double>(time_.size(), 0.0);
-    if (hasFieldVar("FGIT")) {
-        int fgit_index = ecl_smspec_get_field_var_params_index(smspec, "FGIT");
-        double_vector_type * fgit = ecl_sum_alloc_data_vector(ecl_sum_, fgit_index, true);
-        assert(double_vector_size(fgit) == time_.size());
-        for (int i = 0; i < time_.size(); ++i) {
-            fgit_[i] = double_vector_safe_iget(fgit, i);
-        }
-        fgit_[0] = 0.0;
+    vector<double> cumulative(time_.size(), 0.0);
+    if (hasFieldVar(key)) {
+        cumulative = extractVector(ecl_smspec_get_field_var_params_index(ecl_sum_get_smspec(ecl_sum_), key.c_str()));
+        assert(cumulative.size() == time_.size());
+        cumulative[0] = 0.0;
     }
     else {
-        warnPropertyNotFound("FGIT");
+        warnPropertyNotFound(key);
+        string rate_key = well_key.substr(0, well_key.size() - 1) + "R";
         for (auto wname : wells_) {
+            const vector<double> &well_cumulative = wellCumulative(wname, well_key, rate_key);
             for (int i = 0; i < time_.size(); ++i) {
-                fgit_[i] += wgit_[wname][i];
+                cumulative[i] += well_cumulative[i];
             }
         }
     }
+    return field_vectors_[key] = cumulative;
 }
 
-const std::vector<double> ECLSummaryReader::wopt(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    if (wopt_.at(well_name).back() == 0.0)
+const std::vector<double> &ECLSummaryReader::wopt(const string well_name) const {
+    const vector<double> &values = wellCumulative(well_name, "WOPT", "WOPR");
+    if (values.back() == 0.0)
         warnPropertyZero(well_name, "WOPT");
-    return wopt_.at(well_name);
+    return values;
 }
 
-const std::vector<double> ECLSummaryReader::wwpt(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    if (wwpt_.at(well_name).back() == 0.0)
+const std::vector<double> &ECLSummaryReader::wwpt(const string well_name) const {
+    const vector<double> &values = wellCumulative(well_name, "WWPT", "WWPR");
+    if (values.back() == 0.0)
         warnPropertyZero(well_name, "WWPT");
-    return wwpt_.at(well_name);
+    return values;
 }
 
-const std::vector<double> ECLSummaryReader::wgpt(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    if (wgpt_.at(well_name).back() == 0.0)
+const std::vector<double> &ECLSummaryReader::wgpt(const string well_name) const {
+    const vector<double> &values = wellCumulative(well_name, "WGPT", "WGPR");
+    if (values.back() == 0.0)
         warnPropertyZero(well_name, "WGPT");
-    return wgpt_.at(well_name);
+    return values;
 }
 
-const std::vector<double> ECLSummaryReader::wwit(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    if (wwit_.at(well_name).back() == 0.0)
+const std::vector<double> &ECLSummaryReader::wwit(const string well_name) const {
+    const vector<double> &values = wellCumulative(well_name, "WWIT", "WWIR");
+    if (values.back() == 0.0)
         warnPropertyZero(well_name, "WWIT");
-    return wwit_.at(well_name);
+    return values;
 }
 
-const std::vector<double> ECLSummaryReader::wgit(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    if (wgit_.at(well_name).back() == 0.0)
+const std::vector<double> &ECLSummaryReader::wgit(const string well_name) const {
+    const vector<double> &values = wellCumulative(well_name, "WGIT", "WGIR");
+    if (values.back() == 0.0)
         warnPropertyZero(well_name, "WGIT");
-    return wgit_.at(well_name);
+    return values;
 }
 
 void ECLSummaryReader::warnPropertyZero(string wname, string propname) const {
@@ -474,65 +300,61 @@ void ECLSummaryReader::warnPropertyZero(string propname) const {
 }
 
 const std::vector<double> &ECLSummaryReader::fopt() const {
-    if (fopt_.back() == 0.0)
+    const vector<double> &values = fieldCumulative("FOPT", "WOPT");
+    if (values.back() == 0.0)
         warnPropertyZero("FOPT");
-    return fopt_;
+    return values;
 }
 
 const std::vector<double> &ECLSummaryReader::fwpt() const {
-    if (fwpt_.back() == 0.0)
-        warnPropertyZero("WOPT");
-    return fwpt_;
+    const vector<double> &values = fieldCumulative("FWPT", "WWPT");
+    if (values.back() == 0.0)
+        warnPropertyZero("FWPT");
+    return values;
 }
 
 const std::vector<double> &ECLSummaryReader::fgpt() const {
-    if (fgpt_.back() == 0.0)
+    const vector<double> &values = fieldCumulative("FGPT", "WGPT");
+    if (values.back() == 0.0)
         warnPropertyZero("FGPT");
-    return fgpt_;
+    return values;
 }
 
 const std::vector<double> &ECLSummaryReader::fwit() const {
-    if (fgpt_.back() == 0.0)
+    const vector<double> &values = fieldCumulative("FWIT", "WWIT");
+    if (values.back() == 0.0)
         warnPropertyZero("FWIT");
-    return fwit_;
+    return values;
 }
 
 const std::vector<double> &ECLSummaryReader::fgit() const {
-    if (fgit_.back() == 0.0)
+    const vector<double> &values = fieldCumulative("FGIT", "WGIT");
+    if (values.back() == 0.0)
         warnPropertyZero("FGIT");
-    return fgit_;
+    return values;
 }
 
-const std::vector<double> ECLSummaryReader::wopr(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    return wopr_.at(well_name);
+const std::vector<double> &ECLSummaryReader::wopr(const string well_name) const {
+    return wellRate(well_name, "WOPR");
 }
 
-const std::vector<double> ECLSummaryReader::wwpr(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    return wwpr_.at(well_name);
+const std::vector<double> &ECLSummaryReader::wwpr(const string well_name) const {
+    return wellRate(well_name, "WWPR");
 }
 
-const std::vector<double> ECLSummaryReader::wgpr(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    return wgpr_.at(well_name);
+const std::vector<double> &ECLSummaryReader::wgpr(const string well_name) const {
+    return wellRate(well_name, "WGPR");
 }
 
-const std::vector<double> ECLSummaryReader::wwir(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    return wwir_.at(well_name);
+const std::vector<double> &ECLSummaryReader::wwir(const string well_name) const {
+    return wellRate(well_name, "WWIR");
 }
 
-const std::vector<double> ECLSummaryReader::wgir(const string well_name) const {
-    if (wells_.find(well_name) == wells_.end())
-        throw SummaryVariableDoesNotExistException("The well " + well_name + " was not found in the summary.");
-    return wgir_.at(well_name);
+const std::vector<double> &ECLSummaryReader::wgir(const string well_name) const {
+    return wellRate(well_name, "WGIR");
 }
-vector<double> ECLSummaryReader::computeCumulativeFromRate(vector<double> rate) {
+
+vector<double> ECLSummaryReader::computeCumulativeFromRate(const vector<double> &rate) const {
     assert(time_.size() == rate.size());
     auto cumulative = vector<double>(rate.size(), 0.0);
     for (int i = 1; i < rate.size(); ++i) {
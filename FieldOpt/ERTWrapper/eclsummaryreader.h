@@ -34,6 +34,13 @@ using namespace std;
 /*!
  * \brief The ECLSummaryReader class is a wrapper for ecl_sum in ERT. It lets you retrieve information
  * from summary files generated by eclipse.
+ *
+ * Only the time vector and the list of wells are extracted when the summary is read. The
+ * other vectors, and the key lists, are extracted from the ERT summary the first time they
+ * are requested, and cached. Cumulatives that are missing from the summary are computed
+ * from the corresponding rates at that point. Reading a summary with many wells is therefore
+ * not much more expensive than reading one with a single well, as long as only a few
+ * vectors (e.g. the ones needed by the objective function) are requested.
  */
 class ECLSummaryReader
 {
@@ -74,74 +81,84 @@ class ECLSummaryReader
   int GetFirstReportStep(); //!< Get the first report step, i.e. the lowest possible time index (usually 0).
   bool HasReportStep(int report_step); //!< Check whether the report step is valid, i.e. < last and > first.
 
-  const set<string> &keys() const { return keys_; } //!< Get the list of all the keys contained in the summary.
+  const set<string> &keys() const; //!< Get the list of all the keys contained in the summary.
   const set<string> &wells() const { return wells_; } //!< Get the list of all wells found in the summary.
-  const set<string> &field_keys() const { return field_keys_; } //!< Get the list of all field-level keys contained in the summary.
-  const set<string> &well_keys() const { return well_keys_; } //!< Get the list of all well-level keys contained in the summary.
+  const set<string> &field_keys() const; //!< Get the list of all field-level keys contained in the summary.
+  const set<string> &well_keys() const; //!< Get the list of all well-level keys contained in the summary.
 
   const vector<double> &time() const { return time_; } //!< Get the time vector (days).
 
+  /*!
+   * The vector getters below return references to vectors cached the first time
+   * they are requested. They remain valid for the lifetime of the reader.
+   */
   const vector<double> &fopt() const;
   const vector<double> &fwpt() const;
   const vector<double> &fgpt() const;
   const vector<double> &fwit() const;
   const vector<double> &fgit() const;
 
-  const vector<double> wopt(const string well_name) const;
-  const vector<double> wwpt(const string well_name) const;
-  const vector<double> wgpt(const string well_name) const;
-  const vector<double> wwit(const string well_name) const;
-  const vector<double> wgit(const string well_name) const;
+  const vector<double> &wopt(const string well_name) const;
+  const vector<double> &wwpt(const string well_name) const;
+  const vector<double> &wgpt(const string well_name) const;
+  const vector<double> &wwit(const string well_name) const;
+  const vector<double> &wgit(const string well_name) const;
 
-  const vector<double> wopr(const string well_name) const;
-  const vector<double> wwpr(const string well_name) const;
-  const vector<double> wgpr(const string well_name) const;
-  const vector<double> wwir(const string well_name) const;
-  const vector<double> wgir(const string well_name) const;
+  const vector<double> &wopr(const string well_name) const;
+  const vector<double> &wwpr(const string well_name) const;
+  const vector<double> &wgpr(const string well_name) const;
+  const vector<double> &wwir(const string well_name) const;
+  const vector<double> &wgir(const string well_name) const;
 
  private:
   string file_name_;
 
   ecl_sum_type *ecl_sum_;
 
-  set<string> keys_; //!< A list of all keys found in the summary.
   set<string> wells_; //!< A list of all the wells found in the summary.
-  set<string> field_keys_; //!< A list of all the field keys found in the summary.
-  set<string> well_keys_; //!< A list of all the well keys found in the summary.
-  void populateKeyLists(); //!< Populalate the key lists using the ecl_sum_select_matching_general_var_list function.
+  mutable bool key_lists_populated_;
+  mutable set<string> keys_; //!< A list of all keys found in the summary.
+  mutable set<string> field_keys_; //!< A list of all the field keys found in the summary.
+  mutable set<string> well_keys_; //!< A list of all the well keys found in the summary.
+  void populateKeyLists() const; //!< Populalate the key lists using the ecl_sum_select_matching_general_var_list function.
 
   vector<double> time_;
-  vector<double> fopt_;
-  vector<double> fwpt_;
-  vector<double> fgpt_;
-  vector<double> fwit_;
-  vector<double> fgit_;
-  map<string, vector<double> > wopt_;
-  map<string, vector<double> > wwpt_;
-  map<string, vector<double> > wgpt_;
-  map<string, vector<double> > wwit_;
-  map<string, vector<double> > wgit_;
-  map<string, vector<double> > wopr_;
-  map<string, vector<double> > wwpr_;
-  map<string, vector<double> > wgpr_;
-  map<string, vector<double> > wwir_;
-  map<string, vector<double> > wgir_;
-
-  void initializeVectors();
+  mutable map<string, vector<double> > field_vectors_; //!< Field vectors extracted so far, by key.
+  mutable map<string, map<string, vector<double> > > well_vectors_; //!< Well vectors extracted so far, by key and well.
+
   void initializeTimeVector();
-  void initializeWellRates();
-  void initializeWellCumulatives();
-  void initializeFieldCumulatives();
+
+  /*!
+   * Get a field cumulative, extracting it if it has not been requested before.
+   * If the key is not in the summary, it is computed as the sum of the well
+   * cumulatives well_key over all wells.
+   */
+  const vector<double> &fieldCumulative(const string &key, const string &well_key) const;
+
+  /*!
+   * Get a well rate, extracting it if it has not been requested before.
+   * A zero vector is returned if the key is not in the summary.
+   */
+  const vector<double> &wellRate(const string &well_name, const string &key) const;
+
+  /*!
+   * Get a well cumulative, extracting it if it has not been requested before.
+   * If the key is not in the summary, it is computed from the rate rate_key.
+   */
+  const vector<double> &wellCumulative(const string &well_name, const string &key, const string &rate_key) const;
+
+  vector<double> extractVector(int params_index) const; //!< Extract the report step values of a summary vector.
+  void assertWellExists(const string &well_name) const;
 
   void warnPropertyZero(string wname, string propname) const;
   void warnPropertyNotFound(string propname) const;
   void warnPropertyZero(string propname) const;
 
-  bool hasWellVar(string well_name, string var_name);
-  bool hasGroupVar(string group_name, string var_name);
-  bool hasFieldVar(string var_name);
-  bool hasBlockVar(int block_nr, string var_name);
-  bool hasMiscVar(string var_name);
+  bool hasWellVar(string well_name, string var_name) const;
+  bool hasGroupVar(string group_name, string var_name) const;
+  bool hasFieldVar(string var_name) const;
+  bool hasBlockVar(int block_nr, string var_name) const;
+  bool hasMiscVar(string var_name) const;
 
   /*!
    * Compute a cumulative vector from a rate vector and time_.
@@ -150,7 +167,7 @@ class ECLSummaryReader
    * and for the remaining:
    *    cml[i] = (time[i] - time[i-1]) * rate[i-1]
    */
-  vector<double> computeCumulativeFromRate(vector<double> rate);
+  vector<double> computeCumulativeFromRate(const vector<double> &rate) const;
 };
 
 }
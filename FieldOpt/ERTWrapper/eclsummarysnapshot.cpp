@@ -0,0 +1,181 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "eclsummarysnapshot.h"
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ERTWrapper {
+namespace ECLSummary {
+
+namespace {
+/// Read a big-endian 32 bit integer, as written by the simulators.
+int32_t readInt(ifstream &in) {
+    unsigned char b[4];
+    in.read(reinterpret_cast<char *>(b), 4);
+    return (int32_t)((uint32_t)b[0] << 24 | (uint32_t)b[1] << 16 | (uint32_t)b[2] << 8 | (uint32_t)b[3]);
+}
+
+long fileSize(const string &path) {
+    boost::system::error_code ec;
+    auto size = boost::filesystem::file_size(path, ec);
+    return ec ? -1 : (long)size;
+}
+
+/// Size in bytes of one element of the given ECL type; -1 if unknown.
+int elementSize(const string &type) {
+    if (type == "INTE" || type == "REAL" || type == "LOGI") return 4;
+    if (type == "DOUB" || type == "CHAR") return 8;
+    if (type == "MESS") return 0;
+    if (type.size() == 4 && type[0] == 'C' && isdigit(type[1]) && isdigit(type[2]) && isdigit(type[3]))
+        return std::stoi(type.substr(1));
+    return -1;
+}
+}
+
+ECLSummarySnapshot::ECLSummarySnapshot(const string &case_path, const string &snapshot_dir)
+{
+    source_base_ = case_path;
+    if (source_base_.size() > 5 && source_base_.substr(source_base_.size() - 5) == ".DATA")
+        source_base_ = source_base_.substr(0, source_base_.size() - 5);
+    snapshot_base_ = snapshot_dir + "/" + boost::filesystem::path(source_base_).filename().string();
+    reset();
+}
+
+void ECLSummarySnapshot::reset()
+{
+    spec_copied_ = false;
+    offset_ = 0;
+    ministeps_ = 0;
+    boost::system::error_code ec;
+    boost::filesystem::remove(snapshot_base_ + ".SMSPEC", ec);
+    boost::filesystem::remove(snapshot_base_ + ".UNSMRY", ec);
+}
+
+bool ECLSummarySnapshot::Update()
+{
+    if (!spec_copied_ && !copySpecification())
+        return false;
+
+    string source = source_base_ + ".UNSMRY";
+    long size = fileSize(source);
+    if (size < 0) return false;
+    if (size < offset_) { // The simulator has started over
+        reset();
+        return false;
+    }
+
+    ifstream in(source, ios::binary);
+    if (!in.good()) return false;
+
+    // Find the end of the last complete ministep
+    long pos = offset_;
+    long end = offset_;
+    int new_ministeps = 0;
+    string name;
+    while (true) {
+        pos = skipKeyword(in, pos, size, name);
+        if (pos < 0) break;
+        if (name == "PARAMS  ") {
+            end = pos;
+            new_ministeps++;
+        }
+    }
+    if (end == offset_) return false;
+
+    vector<char> buffer(end - offset_);
+    in.clear();
+    in.seekg(offset_);
+    in.read(buffer.data(), buffer.size());
+    if (!in.good()) return false;
+
+    ofstream out(snapshot_base_ + ".UNSMRY", ios::binary | ios::app);
+    out.write(buffer.data(), buffer.size());
+    out.close();
+    if (!out.good()) return false;
+
+    offset_ = end;
+    ministeps_ += new_ministeps;
+    return true;
+}
+
+bool ECLSummarySnapshot::copySpecification()
+{
+    string source = source_base_ + ".SMSPEC";
+    long size = fileSize(source);
+    if (size <= 0) return false;
+
+    ifstream in(source, ios::binary);
+    long pos = 0;
+    string name;
+    while (pos >= 0 && pos < size) {
+        pos = skipKeyword(in, pos, size, name);
+    }
+    if (pos != size) return false; // Still being written
+
+    boost::system::error_code ec;
+    boost::filesystem::copy_file(source, snapshot_base_ + ".SMSPEC",
+                                 boost::filesystem::copy_option::overwrite_if_exists, ec);
+    spec_copied_ = !ec;
+    return spec_copied_;
+}
+
+long ECLSummarySnapshot::skipKeyword(ifstream &in, long pos, long file_size, string &name)
+{
+    // Header record: 8 character name, element count and 4 character type
+    if (pos + 24 > file_size) return -1;
+    in.clear();
+    in.seekg(pos);
+    if (readInt(in) != 16) return -1;
+    char header[8];
+    in.read(header, 8);
+    name = string(header, 8);
+    long count = readInt(in);
+    char type[4];
+    in.read(type, 4);
+    if (!in.good() || readInt(in) != 16) return -1;
+    pos += 24;
+
+    int element_size = elementSize(string(type, 4));
+    if (element_size < 0 || count < 0) return -1;
+
+    // Data is split into records of limited length
+    long remaining = count * element_size;
+    while (remaining > 0) {
+        int length;
+        pos = skipRecord(in, pos, file_size, length);
+        if (pos < 0 || length <= 0) return -1;
+        remaining -= length;
+    }
+    return pos;
+}
+
+long ECLSummarySnapshot::skipRecord(ifstream &in, long pos, long file_size, int &length)
+{
+    if (pos + 8 > file_size) return -1;
+    in.clear();
+    in.seekg(pos);
+    length = readInt(in);
+    if (length < 0 || pos + 8 + length > file_size) return -1;
+    in.seekg(pos + 4 + length);
+    if (readInt(in) != length || !in.good()) return -1;
+    return pos + 8 + length;
+}
+
+}
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef ECLSUMMARYSNAPSHOT_H
+#define ECLSUMMARYSNAPSHOT_H
+
+#include <fstream>
+#include <string>
+
+namespace ERTWrapper {
+namespace ECLSummary {
+using namespace std;
+
+/*!
+ * \brief The ECLSummarySnapshot class keeps a readable copy of the unified summary
+ * (SMSPEC/UNSMRY) of a simulation that is still running.
+ *
+ * ERT aborts the process when it reads a truncated summary file, which is what
+ * the simulator's files look like while it is writing them. Each call to Update
+ * scans the part of the UNSMRY file written since the previous call, and appends
+ * everything up to the end of the last complete PARAMS keyword (i.e. the last
+ * complete ministep) to the snapshot. The SMSPEC file is copied once it is
+ * complete. The snapshot can then be opened with ECLSummaryReader at any time.
+ *
+ * Only the unified, unformatted summary format is supported.
+ */
+class ECLSummarySnapshot
+{
+ public:
+  /*!
+   * \param case_path Path to the simulator deck/case, with or without the .DATA suffix.
+   * \param snapshot_dir Existing directory to write the snapshot files to.
+   */
+  ECLSummarySnapshot(const string &case_path, const string &snapshot_dir);
+
+  /*!
+   * \brief Update Append any ministeps completed since the last update to the snapshot.
+   * \return True if the snapshot changed.
+   */
+  bool Update();
+
+  /*!
+   * \brief snapshot_path Path to the snapshot case (without suffix), to be passed to ECLSummaryReader.
+   */
+  string snapshot_path() const { return snapshot_base_; }
+
+  /*!
+   * \brief ministeps Number of complete ministeps in the snapshot.
+   */
+  int ministeps() const { return ministeps_; }
+
+  /*!
+   * \brief IsReadable Whether the snapshot has a specification and at least one ministep.
+   */
+  bool IsReadable() const { return spec_copied_ && ministeps_ > 0; }
+
+ private:
+  string source_base_;
+  string snapshot_base_;
+  bool spec_copied_; //!< Whether the SMSPEC file has been copied.
+  long offset_; //!< Position in the source UNSMRY file up to which data has been copied.
+  int ministeps_;
+
+  bool copySpecification();
+  void reset(); //!< Start over, e.g. when the simulator has truncated its files.
+
+  /*!
+   * \brief skipKeyword Skip the header and data records of the keyword starting at pos.
+   * \return The position after the keyword, or -1 if the keyword is not complete.
+   */
+  static long skipKeyword(ifstream &in, long pos, long file_size, string &name);
+
+  /*!
+   * \brief skipRecord Skip the Fortran record starting at pos.
+   * \return The position after the record, or -1 if the record is not complete.
+   */
+  static long skipRecord(ifstream &in, long pos, long file_size, int &length);
+};
+
+}
+}
+
+#endif // ECLSUMMARYSNAPSHOT_H
@@ -141,5 +141,26 @@ TEST_F(ECLSummaryReaderTest, KeysAndWells) {
     EXPECT_EQ(6, ecl_summary_reader_->well_keys().size());
 }
 
+TEST_F(ECLSummaryReaderTest, VectorsAreCached) {
+    ecl_summary_reader_ = new ECLSummaryReader(file_name_);
+    const std::vector<double> &fopt = ecl_summary_reader_->fopt();
+    const std::vector<double> &wopt = ecl_summary_reader_->wopt("PROD");
+    const std::vector<double> &wopr = ecl_summary_reader_->wopr("PROD");
+
+    // Extracting other vectors does not invalidate the first ones
+    ecl_summary_reader_->fwpt();
+    ecl_summary_reader_->fwit(); // Not in the summary; summed from the wells
+    ecl_summary_reader_->wwit("PROD");
+    ecl_summary_reader_->wgir("PROD");
+    EXPECT_EQ(&fopt, &ecl_summary_reader_->fopt());
+    EXPECT_EQ(&wopt, &ecl_summary_reader_->wopt("PROD"));
+    EXPECT_EQ(&wopr, &ecl_summary_reader_->wopr("PROD"));
+    EXPECT_FLOAT_EQ(187866.44, fopt.back());
+    EXPECT_FLOAT_EQ(187866.44, wopt.back());
+    EXPECT_FLOAT_EQ(628.9869, wopr.back());
+
+    EXPECT_THROW(ecl_summary_reader_->wopt("INJ"), ERTWrapper::SummaryVariableDoesNotExistException);
+}
+
 
 }
@@ -0,0 +1,130 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include "ERTWrapper/eclsummarysnapshot.h"
+#include "ERTWrapper/eclsummaryreader.h"
+#include "Settings/tests/test_resource_example_file_paths.hpp"
+
+using namespace ERTWrapper::ECLSummary;
+namespace fs = boost::filesystem;
+
+namespace {
+
+/*!
+ * Simulates a running simulation by writing the example summary files to a
+ * "running" directory a few bytes at a time.
+ */
+class ECLSummarySnapshotTest : public ::testing::Test {
+ protected:
+  ECLSummarySnapshotTest() {
+      running_dir_ = (fs::temp_directory_path() / "fieldopt_snapshot_running").string();
+      snapshot_dir_ = (fs::temp_directory_path() / "fieldopt_snapshot").string();
+      fs::remove_all(running_dir_);
+      fs::remove_all(snapshot_dir_);
+      fs::create_directories(running_dir_);
+      fs::create_directories(snapshot_dir_);
+      spec_ = readFile(source_ + ".SMSPEC");
+      data_ = readFile(source_ + ".UNSMRY");
+  }
+
+  virtual ~ECLSummarySnapshotTest() {
+      fs::remove_all(running_dir_);
+      fs::remove_all(snapshot_dir_);
+  }
+
+  std::string readFile(const std::string &path) {
+      std::ifstream in(path, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  void writeRunning(const std::string &suffix, const std::string &content) {
+      std::ofstream out(running_dir_ + "/HORZWELL" + suffix, std::ios::binary | std::ios::trunc);
+      out.write(content.data(), content.size());
+  }
+
+  std::string source_ = TestResources::ExampleFilePaths::ecl_base_horzwell;
+  std::string running_dir_;
+  std::string snapshot_dir_;
+  std::string spec_;
+  std::string data_;
+};
+
+TEST_F(ECLSummarySnapshotTest, IncompleteSpecification) {
+    ECLSummarySnapshot snapshot(running_dir_ + "/HORZWELL.DATA", snapshot_dir_);
+    EXPECT_FALSE(snapshot.Update());
+    writeRunning(".SMSPEC", spec_.substr(0, spec_.size() - 10));
+    writeRunning(".UNSMRY", data_);
+    EXPECT_FALSE(snapshot.Update());
+    EXPECT_FALSE(snapshot.IsReadable());
+    writeRunning(".SMSPEC", spec_);
+    EXPECT_TRUE(snapshot.Update());
+    EXPECT_TRUE(snapshot.IsReadable());
+    EXPECT_EQ(snapshot_dir_ + "/HORZWELL", snapshot.snapshot_path());
+}
+
+TEST_F(ECLSummarySnapshotTest, GrowingSummary) {
+    ECLSummarySnapshot snapshot(running_dir_ + "/HORZWELL", snapshot_dir_);
+    writeRunning(".SMSPEC", spec_);
+    ECLSummaryReader complete(source_);
+
+    int last_ministeps = 0;
+    for (size_t length = 0; length <= data_.size(); length += 37) {
+        writeRunning(".UNSMRY", data_.substr(0, length));
+        snapshot.Update();
+        EXPECT_GE(snapshot.ministeps(), last_ministeps);
+        last_ministeps = snapshot.ministeps();
+        if (!snapshot.IsReadable()) continue;
+
+        // The snapshot is always a valid prefix of the complete summary. The last
+        // report step may be incomplete; it then holds the values of its last ministep.
+        ECLSummaryReader partial(snapshot.snapshot_path());
+        const std::vector<double> &partial_fopt = partial.fopt();
+        size_t n = partial_fopt.size();
+        ASSERT_LE(n, complete.fopt().size());
+        for (size_t i = 0; i + 1 < n; ++i) {
+            EXPECT_FLOAT_EQ(complete.fopt()[i], partial_fopt[i]);
+            EXPECT_FLOAT_EQ(complete.time()[i], partial.time()[i]);
+        }
+        EXPECT_LE(partial.time()[n - 1], complete.time()[n - 1]);
+        EXPECT_LE(partial_fopt[n - 1], complete.fopt()[n - 1]);
+    }
+    writeRunning(".UNSMRY", data_);
+    snapshot.Update();
+    EXPECT_EQ(readFile(source_ + ".UNSMRY"), readFile(snapshot.snapshot_path() + ".UNSMRY"));
+    EXPECT_FALSE(snapshot.Update());
+}
+
+TEST_F(ECLSummarySnapshotTest, Restart) {
+    ECLSummarySnapshot snapshot(running_dir_ + "/HORZWELL", snapshot_dir_);
+    writeRunning(".SMSPEC", spec_);
+    writeRunning(".UNSMRY", data_);
+    EXPECT_TRUE(snapshot.Update());
+    int all_ministeps = snapshot.ministeps();
+
+    // The simulator starts over: the snapshot should follow
+    writeRunning(".UNSMRY", data_.substr(0, data_.size() / 2));
+    EXPECT_FALSE(snapshot.Update());
+    EXPECT_TRUE(snapshot.Update());
+    EXPECT_LT(snapshot.ministeps(), all_ministeps);
+    EXPECT_GT(snapshot.ministeps(), 0);
+}
+
+}
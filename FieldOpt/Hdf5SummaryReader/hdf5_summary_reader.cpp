@@ -24,11 +24,25 @@
 #include <boost/current_function.hpp>
 #include <boost/lexical_cast.hpp>
 #include <stdexcept>
+#include <algorithm>
 
 using namespace H5;
+
+namespace {
+// Size (in doubles) of the buffer holding one block of cells read from a cell dataset
+const hsize_t CELL_BLOCK_BUFFER_SIZE = 1 << 19;
+}
+
 Hdf5SummaryReader::Hdf5SummaryReader(const std::string file_path,
                                      bool get_cell_data,
                                      bool debug)
+: Hdf5SummaryReader(file_path, std::vector<int>(), get_cell_data ? CELL_ALL : 0, debug)
+{ }
+
+Hdf5SummaryReader::Hdf5SummaryReader(const std::string file_path,
+                                     const std::vector<int> &time_steps,
+                                     int cell_data_types,
+                                     bool debug)
 : GROUP_NAME_RESTART("RESTART"),
   DATASET_NAME_TIMES("TIMES"),
   GROUP_NAME_FLOW_TRANSPORT("FLOW_TRANSPORT"),
@@ -37,34 +51,46 @@ Hdf5SummaryReader::Hdf5SummaryReader(const std::string file_path,
   DATASET_NAME_PRESSURE("PTZ"),
   DATASET_NAME_SATURATION("GRIDPROPTIME")
 {
+    debug_ = debug;
+    cell_data_ = cell_data_types != 0;
+    cell_data_ncells_ = 0;
     readTimeVector(file_path);
     readWellStates(file_path);
-    debug_ = debug;
 
     /*!
      * These are only called if we want to extract cell data from
      * the h5 file for postprocessing/visualization purposes
      */
-    if (get_cell_data){
+    if (cell_data_){
+        cell_tsteps_ = time_steps;
+        std::sort(cell_tsteps_.begin(), cell_tsteps_.end());
+        cell_tsteps_.erase(std::unique(cell_tsteps_.begin(), cell_tsteps_.end()), cell_tsteps_.end());
+        if (!cell_tsteps_.empty() && cell_tsteps_.front() < 0) {
+            throw std::runtime_error("Negative time step requested for cell data.");
+        }
+
         readActiveCells(file_path);
-        readReservoirPressure(file_path);
-        readSaturation(file_path);
+        if (cell_data_types & CELL_PRESSURE) {
+            readReservoirPressure(file_path);
+        }
+        if (cell_data_types & (CELL_SOIL | CELL_SGAS | CELL_SWAT)) {
+            readSaturation(file_path, cell_data_types);
+        }
     }
 }
 
-void Hdf5SummaryReader::readSaturation(std::string file_path) {
+void Hdf5SummaryReader::readSaturation(std::string file_path, int cell_data_types) {
 
     // Check file exists
     H5File file(file_path, H5F_ACC_RDONLY);
     Group group = Group(file.openGroup(GROUP_NAME_FLOW_TRANSPORT));
     auto dataset_exists = H5Lexists(group.getId(), "GRIDPROPTIME", H5F_ACC_RDONLY);
-    std::vector<std::vector<double>> sgas, soil, swat;
 
     if (dataset_exists) {
 
         hsize_t SOIL, SWAT, SGAS;
         if (number_of_phases() < 3){
-            SGAS = 0;
+            SGAS = 0; // Not present
             SOIL = 2; // col: 3
             SWAT = 1; // col: 2
         }else{
@@ -73,58 +99,35 @@ void Hdf5SummaryReader::readSaturation(std::string file_path) {
             SWAT = 3; // col: 4
         }
 
-        sgas_ = getSaturation(group, SGAS);
-        soil_ = getSaturation(group, SOIL);
-        swat_ = getSaturation(group, SWAT);
-
-    }else{
-
-        sgas_ = reservoir_pressure();
-        soil_ = reservoir_pressure();
-        swat_ = reservoir_pressure();
-    }
-}
-
-std::vector<std::vector<double>> Hdf5SummaryReader::getSaturation(
-        Group group, hsize_t sat_type) {
-
-    // Read the file
-    DataSet dataset = DataSet(group.openDataSet(DATASET_NAME_SATURATION));
-    DataSpace dataspace = dataset.getSpace();
-    hsize_t dims[3];
-    dataspace.getSimpleExtentDims(dims, NULL);
+        // All requested saturations are read in one pass over the dataset
+        std::vector<std::pair<hsize_t, std::vector<double> *>> columns;
+        if (cell_data_types & CELL_SOIL) columns.emplace_back(SOIL, &soil_);
+        if ((cell_data_types & CELL_SGAS) && SGAS > 0) columns.emplace_back(SGAS, &sgas_);
+        if (cell_data_types & CELL_SWAT) columns.emplace_back(SWAT, &swat_);
 
-    std::vector<double> vector;
-    vector.resize(dims[0] * dims[2]);
-    std::vector<std::vector<double>>  sat_; //!< Temporary saturation vector.
-
-    if (sat_type > 0){
-        // Define hyperslab
-        hsize_t count[3] = {dims[0], 1, dims[2]};
-        hsize_t offset[3] = {0, sat_type, 0};
-        dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
-
-        // Size of selected column + define memory space
-        hsize_t col_sz[2] = {dims[0], dims[2]};
-        DataSpace mspace(2, col_sz);
+        DataSet dataset = DataSet(group.openDataSet(DATASET_NAME_SATURATION));
+        if (!columns.empty()) {
+            readCellColumns(dataset, columns);
+        }
+        if ((cell_data_types & CELL_SGAS) && SGAS == 0) {
+            hsize_t dims[3];
+            dataset.getSpace().getSimpleExtentDims(dims, NULL);
+            cell_data_ncells_ = (int)dims[0];
+            if (cell_tsteps_.empty()) {
+                for (int tt = 0; tt < (int)dims[2]; ++tt) cell_tsteps_.push_back(tt);
+            }
+            sgas_.assign(cell_tsteps_.size() * dims[0], 0.0);
+        }
 
-        dataset.read(vector.data(), PredType::NATIVE_DOUBLE, mspace, dataspace);
     }else{
-        vector.resize(dims[0] * dims[2],0);
-    }
-
-    int ncells = (int)dims[0];
-    int ntime_steps = (int)dims[2];
 
-    for (int tt = 0; tt < ntime_steps; ++tt) {
-        std::vector<double> sub;
-        for (int cc = 0; cc < ncells; ++cc) {
-            sub.push_back(vector[ cc * ntime_steps + tt ]);
-        }
-        sat_.push_back(sub);
+        // No saturation data in the file: use the pressure column, as for the pressure
+        std::vector<std::pair<hsize_t, std::vector<double> *>> columns;
+        if (cell_data_types & CELL_SOIL) columns.emplace_back(0, &soil_);
+        if (cell_data_types & CELL_SGAS) columns.emplace_back(0, &sgas_);
+        if (cell_data_types & CELL_SWAT) columns.emplace_back(0, &swat_);
+        readCellColumns(DataSet(group.openDataSet(DATASET_NAME_PRESSURE)), columns);
     }
-
-    return sat_;
 }
 
 void Hdf5SummaryReader::readReservoirPressure(std::string file_path) {
@@ -134,11 +137,9 @@ void Hdf5SummaryReader::readReservoirPressure(std::string file_path) {
     Group group = Group(file.openGroup(GROUP_NAME_FLOW_TRANSPORT));
     DataSet dataset = DataSet(group.openDataSet(DATASET_NAME_PRESSURE));
 
-    DataSpace dataspace = dataset.getSpace();
-    hsize_t dims[3];
-
-    auto rank = dataspace.getSimpleExtentDims(dims, NULL);
     if (debug_){
+        hsize_t dims[3];
+        auto rank = dataset.getSpace().getSimpleExtentDims(dims, NULL);
         std::cout << "[\033[1;33m" << BOOST_CURRENT_FUNCTION << ":\033[0m\n"
                   << "dataset rank " << rank << ", dims "
                   << (unsigned long)(dims[0]) << " x "
@@ -146,42 +147,100 @@ void Hdf5SummaryReader::readReservoirPressure(std::string file_path) {
                   << (unsigned long)(dims[2]) << std::endl;
     }
 
-    // Define hyperslab
-    hsize_t count[3] = {dims[0], 1, dims[2]};
-    hsize_t offset[3] = {0, 0, 0};
-    dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+    // The pressure is the first column
+    readCellColumns(dataset, {std::make_pair(hsize_t(0), &pressure_)});
+}
 
-    // Size of selected column + define memory space
-    hsize_t col_sz[2] = {dims[0], dims[2]};
-    DataSpace mspace(2, col_sz);
+void Hdf5SummaryReader::readCellColumns(DataSet dataset,
+                                        const std::vector<std::pair<hsize_t, std::vector<double> *>> &columns) {
+    if (columns.empty()) return;
+    DataSpace dataspace = dataset.getSpace();
+    hsize_t dims[3];
+    dataspace.getSimpleExtentDims(dims, NULL);
 
-    std::vector<double> vector;
-    vector.resize(dims[0] * dims[2]);
-    dataset.read(vector.data(), PredType::NATIVE_DOUBLE, mspace, dataspace);
-
-    // Reorder pressure vector
-    // Note:
-    // Data/time component ordering inside data vector:
-    // Example: pressure vector with 5 cells over 8 time steps:
-    // size of vector = ncells (x ndata_cols=1) x ntime_steps
+    if (cell_tsteps_.empty()) {
+        for (int tt = 0; tt < (int)dims[2]; ++tt) cell_tsteps_.push_back(tt);
+    }
+    else if (cell_tsteps_.back() >= (int)dims[2]) {
+        throw std::runtime_error("Cell data requested for time step " + std::to_string(cell_tsteps_.back())
+                                     + ", but the summary only has " + std::to_string(dims[2]) + " time steps.");
+    }
+
+    // Data/column/time component ordering inside the dataset:
+    // Example: pressure column, 5 cells over 8 time steps:
     //
     //        cell 1   cell 2   cell 3   cell 4   cell 5
     //time  |--------|--------|--------|--------|--------|
     //steps: 12345678 12345678 12345678 12345678 12345678
+    //
+    // The columns of a cell are adjacent, so a block of cells is read with
+    // one hyperslab spanning the requested columns and time steps.
+    hsize_t col_first = dims[1], col_last = 0;
+    for (auto &column : columns) {
+        if (column.first >= dims[1]) {
+            throw std::runtime_error("Cell data column " + std::to_string(column.first)
+                                         + " not found in dataset with " + std::to_string(dims[1]) + " columns.");
+        }
+        col_first = std::min(col_first, column.first);
+        col_last = std::max(col_last, column.first);
+    }
+    hsize_t ncells = dims[0];
+    hsize_t ncols = col_last - col_first + 1;
+    hsize_t tt_first = cell_tsteps_.front();
+    hsize_t ntimes = cell_tsteps_.back() - tt_first + 1;
+    hsize_t cell_stride = ncols * ntimes;
+    cell_data_ncells_ = (int)ncells;
+
+    for (auto &column : columns) {
+        column.second->resize(cell_tsteps_.size() * ncells);
+    }
 
-         int ncells = (int)dims[0];
-     int ndata_cols = (int)dims[1];
-    int ntime_steps = (int)dims[2];
+    hsize_t block_size = std::min(ncells, std::max(hsize_t(1), CELL_BLOCK_BUFFER_SIZE / cell_stride));
+    std::vector<double> block(block_size * cell_stride);
+    for (hsize_t first_cell = 0; first_cell < ncells; first_cell += block_size) {
+        hsize_t nblock = std::min(block_size, ncells - first_cell);
 
-    for (int tt = 0; tt < ntime_steps; ++tt) {
-        std::vector<double> sub;
-        for (int cc = 0; cc < ncells; ++cc) {
-            sub.push_back(vector[ cc * ntime_steps + tt ]);
+        // Define hyperslab + memory space of the same shape
+        hsize_t count[3] = {nblock, ncols, ntimes};
+        hsize_t offset[3] = {first_cell, col_first, tt_first};
+        dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+        DataSpace mspace(3, count);
+        dataset.read(block.data(), PredType::NATIVE_DOUBLE, mspace, dataspace);
+
+        // Transpose to time-major order
+        for (auto &column : columns) {
+            const double *src = block.data() + (column.first - col_first) * ntimes;
+            for (size_t k = 0; k < cell_tsteps_.size(); ++k) {
+                const double *src_tt = src + (cell_tsteps_[k] - tt_first);
+                double *dst = column.second->data() + k * ncells + first_cell;
+                for (hsize_t cc = 0; cc < nblock; ++cc) {
+                    dst[cc] = src_tt[cc * cell_stride];
+                }
+            }
         }
-        pressure_.push_back(sub);
     }
 }
 
+Hdf5SummaryReader::cell_span Hdf5SummaryReader::cellSpan(const std::vector<double> &data, int time_step) const {
+    auto it = std::lower_bound(cell_tsteps_.begin(), cell_tsteps_.end(), time_step);
+    if (data.empty() || it == cell_tsteps_.end() || *it != time_step) {
+        throw std::runtime_error("Cell data has not been read for time step " + std::to_string(time_step) + ".");
+    }
+    size_t k = it - cell_tsteps_.begin();
+    return cell_span{data.data() + k * cell_data_ncells_, (size_t)cell_data_ncells_};
+}
+
+std::vector<std::vector<double>> Hdf5SummaryReader::cellVectors(const std::vector<double> &data) const {
+    std::vector<std::vector<double>> vectors;
+    if (data.empty()) return vectors;
+    vectors.reserve(cell_tsteps_.size());
+    for (size_t k = 0; k < cell_tsteps_.size(); ++k) {
+        auto begin = data.begin() + k * cell_data_ncells_;
+        vectors.emplace_back(begin, begin + cell_data_ncells_);
+    }
+    return vectors;
+}
+
 void Hdf5SummaryReader::readActiveCells(std::string file_path) {
 
     // Read the file
@@ -440,7 +499,7 @@ int Hdf5SummaryReader::number_of_phases() const {
     return nphases_;
 }
 
-int Hdf5SummaryReader::cells_find_statuses(std::vector<int> &cells_all_vector_) {
+void Hdf5SummaryReader::cells_find_statuses(std::vector<int> &cells_all_vector_) {
 
     for (int i = 0; i < cells_all_vector_.size(); ++i) {
         if (cells_all_vector_[i] < 0){
@@ -30,15 +30,19 @@
  * \todo This must also be tested for a 3 phase black oil model,
  * it has only been tested for 2 phase dead oil.
  *
- * \todo Overall, Hdf5SummaryReader::readSaturation needs a better 
- * implementation that reads soil and sgas at the same time/as a 
- * single chunck from the H5 group, instead of reading from H5 one 
- * vector at a time (the thinking is that the former is probably
- * more efficient that the latter).
- * In either case, the reading functionality needs to be flexible/
- * /robust with respect to the different phase combinations that 
- * might exist in the H5 group (currently GRIDPROPTIME), e.g., 
- * soil/sgas, soil/sgas/swat, soil/swat, etc.
+ * Cell data (pressure and saturations) is stored time-major in one
+ * contiguous vector pr. data type, i.e. the values for all cells
+ * at a time step are adjacent. It is read from the H5 file in
+ * blocks of cells, one hyperslab pr. block covering all the
+ * requested columns (e.g. soil, sgas and swat together) and time
+ * steps, so that only one block is held in memory besides the
+ * result.
+ *
+ * \todo The saturation reading needs to be flexible/robust with
+ * respect to the different phase combinations that might exist
+ * in the H5 group (currently GRIDPROPTIME), e.g., soil/sgas,
+ * soil/sgas/swat, soil/swat, etc. Currently the columns are
+ * determined by the number of phases only.
  *
  * \todo To make thing much tidier, collect variables containing 
  * information about the reservoir cell ensemble, i.e., 
@@ -58,6 +62,28 @@
  */
 class Hdf5SummaryReader {
 public:
+    /*!
+     * Flags selecting which cell data to read from the summary.
+     */
+    enum CellDataType : int {
+        CELL_PRESSURE = 1,
+        CELL_SOIL = 2,
+        CELL_SGAS = 4,
+        CELL_SWAT = 8,
+        CELL_ALL = 15
+    };
+
+    /*!
+     * A read-only view of the values of all cells at one time step.
+     */
+    struct cell_span {
+        const double *data;
+        size_t size;
+        const double *begin() const { return data; }
+        const double *end() const { return data + size; }
+        double operator[](size_t i) const { return data[i]; }
+    };
+
     /*!
      * Read the HDF5 summary file written 
      * by AD-GPRS at the specified path.
@@ -76,30 +102,73 @@ public:
                       bool get_cell_data = false,
                       bool debug = false);
 
+    /*!
+     * Read the HDF5 summary file written by AD-GPRS at the
+     * specified path, including the selected cell data at the
+     * selected time steps only.
+     * @param file_path Path to a .H5 summary file.
+     * @param time_steps Indices of the time steps to read cell data
+     * for. All time steps are read if this is empty.
+     * @param cell_data_types The cell data to read, as a combination
+     * of CellDataType flags.
+     * @param debug Flag to print H5 related data during testing
+     * (defaults to false)
+     */
+    Hdf5SummaryReader(const std::string file_path,
+                      const std::vector<int> &time_steps,
+                      int cell_data_types = CELL_ALL,
+                      bool debug = false);
+
     /*!
      * Get the vector containing all time steps in the summary.
      */
     const std::vector<double> &times_steps() const { return times_; }
 
     /*!
-     * Get reservoir pressure vector.
+     * Get the time steps cell data has been read for, in ascending order.
+     */
+    const std::vector<int> &cell_data_time_steps() const { return cell_tsteps_; }
+
+    /*!
+     * Get reservoir pressure vector (one vector of cell values pr. time step read).
      */
-    std::vector< std::vector<double> > reservoir_pressure() const { return pressure_; }
+    std::vector< std::vector<double> > reservoir_pressure() const { return cellVectors(pressure_); }
 
     /*!
-     * Get sgas vector.
+     * Get sgas vector (one vector of cell values pr. time step read).
      */
-    std::vector< std::vector<double> > sgas() const { return sgas_; }
+    std::vector< std::vector<double> > sgas() const { return cellVectors(sgas_); }
 
     /*!
-     * Get soil vector.
+     * Get soil vector (one vector of cell values pr. time step read).
      */
-    std::vector< std::vector<double> > soil() const { return soil_; }
+    std::vector< std::vector<double> > soil() const { return cellVectors(soil_); }
 
     /*!
-     * Get swat vector.
+     * Get swat vector (one vector of cell values pr. time step read).
      */
-    std::vector< std::vector<double> > swat() const { return swat_; }
+    std::vector< std::vector<double> > swat() const { return cellVectors(swat_); }
+
+    /*!
+     * Get the reservoir pressures of all cells at a time step, without copying.
+     * Throws an exception if the pressure has not been read for the time step.
+     */
+    cell_span reservoir_pressure(int time_step) const { return cellSpan(pressure_, time_step); }
+
+    /*!
+     * Get the gas saturations of all cells at a time step, without copying.
+     */
+    cell_span sgas(int time_step) const { return cellSpan(sgas_, time_step); }
+
+    /*!
+     * Get the oil saturations of all cells at a time step, without copying.
+     */
+    cell_span soil(int time_step) const { return cellSpan(soil_, time_step); }
+
+    /*!
+     * Get the water saturations of all cells at a time step, without copying.
+     */
+    cell_span swat(int time_step) const { return cellSpan(swat_, time_step); }
 
     /*!
      * Return vector of active grid cells.
@@ -340,8 +409,21 @@ private:
     well_data parseWellState(std::vector<wstype_t> &ws, int wnr); //!< Parse the states for a single well and create a well_data object.
 
     void readActiveCells(std::string file_path); //!< Read vector defining which cells are active from the HDF5 summary file.
-    void readReservoirPressure(std::string file_path); //!< Read reservoir cell pressures for each time step.
-    void readSaturation(std::string file_path); //!< Read cell saturations for each time step.
+    void readReservoirPressure(std::string file_path); //!< Read reservoir cell pressures for the selected time steps.
+    void readSaturation(std::string file_path, int cell_data_types); //!< Read the selected cell saturations for the selected time steps.
+
+    /*!
+     * Read columns of a (cells x columns x time steps) cell dataset for the time
+     * steps in cell_tsteps_, and store each column time-major in its target vector.
+     *
+     * The dataset is read in blocks of cells, each with a single hyperslab covering
+     * all the columns and the range of selected time steps. If cell_tsteps_ is empty,
+     * it is set to all the time steps in the dataset.
+     * @param dataset The dataset to read.
+     * @param columns Pairs of column index and the vector to store the column in.
+     */
+    void readCellColumns(H5::DataSet dataset,
+                         const std::vector<std::pair<hsize_t, std::vector<double> *>> &columns);
 
     /*!
      * Variables containing information about the reservoir cell ensemble,
@@ -354,7 +436,7 @@ private:
     int cells_num_active_; //!< Total number of active grid cells in model.
     int cells_num_inactive_; //!< Total number of inactive grid cells in model.
 
-    int cells_find_statuses(std::vector<int> &cells_all_vector_); //!< Fills inactive/active cells numbers and indices
+    void cells_find_statuses(std::vector<int> &cells_all_vector_); //!< Fills inactive/active cells numbers and indices
 
     int nwells_; //!< Number of wells in summary.
     int ntimes_; //!< Number of time steps in the summary.
@@ -363,12 +445,20 @@ private:
     bool cell_data_; //!< Flag for whether to read cell data from h5 file
 
     std::vector<double> times_; //!< Vector containing all time steps.
-    std::vector< std::vector<double> > pressure_; //!< Vector containing reservoir pressures.
-    std::vector< std::vector<double> > soil_; //!< Vector containing oil saturation.
-    std::vector< std::vector<double> > sgas_; //!< Vector containing gas saturation.
-    std::vector< std::vector<double> > swat_; //!< Vector containing water saturation.
 
-    std::vector<std::vector<double>> getSaturation(H5::Group dataset, hsize_t sat_type);
+    /*!
+     * Cell data for the time steps in cell_tsteps_, stored time-major: the value for
+     * cell c at the k'th time step read is found at index k * cell_data_ncells_ + c.
+     */
+    std::vector<int> cell_tsteps_; //!< Time steps cell data has been read for, in ascending order.
+    int cell_data_ncells_; //!< Number of cells in the cell data datasets.
+    std::vector<double> pressure_; //!< Vector containing reservoir pressures.
+    std::vector<double> soil_; //!< Vector containing oil saturation.
+    std::vector<double> sgas_; //!< Vector containing gas saturation.
+    std::vector<double> swat_; //!< Vector containing water saturation.
+
+    cell_span cellSpan(const std::vector<double> &data, int time_step) const; //!< Get the values of a cell data vector at a time step.
+    std::vector<std::vector<double>> cellVectors(const std::vector<double> &data) const; //!< Split a cell data vector into one vector pr. time step.
 
     /*!
      * debug_ Flag used by tests (only) to get additional info from
@@ -93,6 +93,29 @@ namespace {
         // }
     }
 
+    TEST_F(Hdf5SummaryReaderTest, CellDataTimeSteps) {
+        auto reader_all = Hdf5SummaryReader(file_path, true, false);
+        auto pressure_all = reader_all.reservoir_pressure();
+        EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}), reader_all.cell_data_time_steps());
+
+        // Only the requested time steps and data types are read
+        auto reader = Hdf5SummaryReader(file_path, {6, 2, 6}, Hdf5SummaryReader::CELL_PRESSURE);
+        EXPECT_EQ(std::vector<int>({2, 6}), reader.cell_data_time_steps());
+        EXPECT_EQ(2, reader.reservoir_pressure().size());
+        EXPECT_TRUE(reader.soil().empty());
+
+        for (int tt : {2, 6}) {
+            auto pressure = reader.reservoir_pressure(tt);
+            auto pressure_full = reader_all.reservoir_pressure(tt);
+            EXPECT_EQ(3600, pressure.size);
+            EXPECT_TRUE(std::equal(pressure.begin(), pressure.end(), pressure_all[tt].begin()));
+            EXPECT_TRUE(std::equal(pressure_full.begin(), pressure_full.end(), pressure_all[tt].begin()));
+        }
+        EXPECT_THROW(reader.reservoir_pressure(3), std::runtime_error);
+        EXPECT_THROW(reader.soil(2), std::runtime_error);
+        EXPECT_THROW(Hdf5SummaryReader(file_path, std::vector<int>({8})), std::runtime_error);
+    }
+
     TEST_F(Hdf5SummaryReaderTest, IntegerData) {
         auto reader = Hdf5SummaryReader(file_path);
         int expected_types[5] = {1, -1, -1, -1, -1};
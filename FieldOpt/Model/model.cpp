@@ -21,13 +21,15 @@
 #include <boost/lexical_cast.hpp>
 #include "Utilities/verbosity.h"
 #include "Utilities/printer.hpp"
+#include "Utilities/time.hpp"
 
 namespace Model {
 
 Model::Model(Settings::Settings settings, Logger *logger)
 {
     if (settings.paths().IsSet(Paths::GRID_FILE)) {
-        grid_ = new Reservoir::Grid::ECLGrid(settings.paths().GetPath(Paths::GRID_FILE));
+        grid_ = new Reservoir::Grid::ECLGrid(settings.paths().GetPath(Paths::GRID_FILE),
+                                             settings.model()->cache_grid());
         wic_ = new Reservoir::WellIndexCalculation::wicalc_rixx(grid_);
     }
     else {
@@ -35,6 +37,8 @@ Model::Model(Settings::Settings settings, Logger *logger)
         wic_ = nullptr;
     }
     current_case_ = nullptr;
+    cache_grid_ = settings.model()->cache_grid();
+    wic_threads_ = 1;
 
     variable_container_ = new Properties::VariablePropertyContainer();
 
@@ -71,17 +75,25 @@ void Model::ApplyCase(Optimization::Case *c)
         logger_->AddEntry(this);
     }
 
-    for (QUuid key : c->binary_variables().keys()) {
-        variable_container_->SetBinaryVariableValue(key, c->binary_variables()[key]);
+    auto &binary_ids = c->binary_variable_ids();
+    for (int i = 0; i < binary_ids.size(); ++i) {
+        variable_container_->SetBinaryVariableValue(binary_ids[i], c->binary_variable_value(binary_ids[i]));
     }
-    for (QUuid key : c->integer_variables().keys()) {
-        variable_container_->SetDiscreteVariableValue(key, c->integer_variables()[key]);
+    auto &integer_ids = c->integer_variable_ids();
+    auto &integer_values = c->GetIntegerVarVector();
+    for (int i = 0; i < integer_ids.size(); ++i) {
+        variable_container_->SetDiscreteVariableValue(integer_ids[i], integer_values[i]);
     }
-    for (QUuid key : c->real_variables().keys()) {
-        variable_container_->SetContinousVariableValue(key, c->real_variables()[key]);
+    auto &real_ids = c->real_variable_ids();
+    auto &real_values = c->GetRealVarVector();
+    for (int i = 0; i < real_ids.size(); ++i) {
+        variable_container_->SetContinousVariableValue(real_ids[i], real_values[i]);
     }
     int cumulative_wic_time = 0;
     bool wic_used = false;
+    if (wic_threads_ > 1 && wic_ != nullptr) {
+        cumulative_wic_time += computeWellIndicesInBatch();
+    }
     for (Wells::Well *w : *wells_) {
         w->Update();
         if (w->trajectory()->GetDefinitionType() == Settings::Model::WellDefinitionType::WellSpline) {
@@ -205,10 +217,42 @@ map<string, vector<double>> Model::GetValues() {
     }
     return valmap;
 }
+int Model::computeWellIndicesInBatch() {
+    std::vector<Wells::Wellbore::WellSpline *> splines;
+    std::vector<Reservoir::WellIndexCalculation::WellDefinition> well_definitions;
+    for (Wells::Well *w : *wells_) {
+        if (w->trajectory()->GetDefinitionType() != Settings::Model::WellDefinitionType::WellSpline) {
+            continue;
+        }
+        auto spline = w->trajectory()->GetWellSpline();
+        if (spline != 0 && spline->CanBatchWellIndexCalculation()) {
+            splines.push_back(spline);
+            well_definitions.push_back(spline->GetWellDefinition());
+        }
+    }
+    if (splines.size() < 2) {
+        return 0;
+    }
+
+    auto start = QDateTime::currentDateTime();
+    std::vector<std::vector<Reservoir::WellIndexCalculation::IntersectedCell>> block_data;
+    wic_->ComputeWellBlocks(block_data, well_definitions, wic_threads_);
+    for (int i = 0; i < (int)splines.size(); ++i) {
+        splines[i]->SetPrecomputedWellIndices(block_data[i]);
+    }
+    int seconds = time_span_seconds(start, QDateTime::currentDateTime());
+    if (VERB_MOD >= 2) {
+        Printer::ext_info("Computed well indices for " + Printer::num2str((int)splines.size())
+                              + " wells in batch after " + Printer::num2str(seconds) + " seconds.",
+                          "Model", "Model");
+    }
+    return seconds;
+}
+
 void Model::set_grid_path(const std::string &grid_path) {
     if (wic_->HasGrid(grid_path) == false) {
         if (VERB_MOD >= 2) Printer::ext_info("Initializing new Grid: " + grid_path, "Model", "Model");
-        grid_ = new Reservoir::Grid::ECLGrid(grid_path);
+        grid_ = new Reservoir::Grid::ECLGrid(grid_path, cache_grid_);
         wic_->AddGrid(grid_);
         wic_->SetGridActive(grid_);
     }
@@ -59,6 +59,14 @@ class Model : public Loggable
 
   void set_grid_path(const std::string &grid_path);
 
+  /*!
+   * \brief SetWICThreads Set the number of threads used to compute
+   * the well blocks of the spline wells when a case is applied. With
+   * more than one thread, the well indices for all spline wells are
+   * computed in a single batch (see wicalc_rixx::ComputeWellBlocks).
+   */
+  void SetWICThreads(const int n_threads) { wic_threads_ = n_threads; }
+
   /*!
    * \brief variables Get the set of variable properties of all types.
    */
@@ -94,10 +102,20 @@ class Model : public Loggable
  private:
   Reservoir::Grid::Grid *grid_;
   Reservoir::WellIndexCalculation::wicalc_rixx *wic_;
+  bool cache_grid_; //!< Whether grids should be read into memory when loaded (see ECLGrid::CacheGrid()).
+  int wic_threads_; //!< Number of threads used for well index calculations.
   Properties::VariablePropertyContainer *variable_container_;
   QList<Wells::Well *> *wells_;
   void verify(); //!< Verify the model. Throws an exception if it is not.
 
+  /*!
+   * \brief computeWellIndicesInBatch Compute the well indices for all
+   * spline wells that need them in one batch, using wic_threads_ threads.
+   * The results are picked up by the wells when they are updated.
+   * \return The number of seconds spent computing the well indices.
+   */
+  int computeWellIndicesInBatch();
+
   void verifyWells();
   void verifyWellTrajectory(Wells::Well *w);
   void verifyWellBlock(Wells::Wellbore::WellBlock *wb);
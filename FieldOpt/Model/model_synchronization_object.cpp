@@ -58,6 +58,27 @@ namespace Model {
         return convertToQtMapping(binary_variable_ids_);
     }
 
+    QList<QUuid> ModelSynchronizationObject::GetOrderedDiscreteVariableIds() const {
+        return orderedIds(discrete_variable_ids_);
+    }
+
+    QList<QUuid> ModelSynchronizationObject::GetOrderedContinousVariableIds() const {
+        return orderedIds(continous_variable_ids_);
+    }
+
+    QList<QUuid> ModelSynchronizationObject::GetOrderedBinaryVariableIds() const {
+        return orderedIds(binary_variable_ids_);
+    }
+
+    QList<QUuid> ModelSynchronizationObject::orderedIds(const std::map<string, uuid> &map) const {
+        QList<QUuid> ids;
+        ids.reserve(map.size());
+        for (auto const &ent : map) { // std::map is ordered by key
+            ids.append(boostUuidToQuuid(ent.second));
+        }
+        return ids;
+    }
+
     void ModelSynchronizationObject::UpdateVariablePropertyIds(Model *model) {
         auto vpc = model->variable_container_;
 
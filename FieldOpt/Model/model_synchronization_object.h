@@ -36,6 +36,15 @@ namespace Model {
         QHash<QString, QUuid> GetDiscreteVariableMap();
         QHash<QString, QUuid> GetContinousVariableMap();
         QHash<QString, QUuid> GetBinaryVariableMap();
+
+        /*!
+         * @brief Get the variable UUIDs ordered by variable name. The ordering is identical on all
+         * processes that share this object, and is used as a dense index when transferring cases.
+         */
+        QList<QUuid> GetOrderedDiscreteVariableIds() const;
+        QList<QUuid> GetOrderedContinousVariableIds() const;
+        QList<QUuid> GetOrderedBinaryVariableIds() const;
+
         void UpdateVariablePropertyIds(Model *model);
 
     private:
@@ -47,6 +56,7 @@ namespace Model {
         std::map<string, uuid> createNameToIdMapping(const QHash<QUuid, Properties::ContinousProperty *> *qhash) const; //!< Create a standard library hash map from a QHash
         std::map<string, uuid> createNameToIdMapping(const QHash<QUuid, Properties::BinaryProperty *> *qhash) const; //!< Create a standard library hash map from a QHash
         QHash<QString, QUuid> convertToQtMapping(const std::map<string, uuid> map); //!< Convert a std/boost based mapping to a Qt based mapping to be used by the rest of the model.
+        QList<QUuid> orderedIds(const std::map<string, uuid> &map) const; //!< Get the ids in a mapping, ordered by name.
 
         QUuid boostUuidToQuuid(const uuid buuid) const; //!< Create a QUuid from a boost uuid
         uuid qUuidToBoostUuid(const QUuid quuid) const; //!< Create a boost uuid from a QUuid
@@ -93,10 +93,12 @@ WellSpline::WellSpline(Settings::Model::Well well_settings,
 
     last_computed_grid_ = "";
     last_computed_spline_ = std::vector<Eigen::Vector3d>();
+    has_precomputed_block_data_ = false;
 }
 WellSpline::WellSpline() {
     last_computed_grid_ = "";
     last_computed_spline_ = std::vector<Eigen::Vector3d>();
+    has_precomputed_block_data_ = false;
 }
 void WellSpline::spline_points_from_import(Settings::Model::Well &well_settings) {
     QString name_base = "SplinePoint#" + well_settings.name + "#";
@@ -146,32 +148,16 @@ QList<WellBlock *> *WellSpline::computeWellBlocks() {
     last_computed_grid_ = grid_->GetGridFilePath();
     last_computed_spline_ = create_spline_point_vector();
 
-    WellDefinition welldef;
-    welldef.wellname = well_settings_.name.toStdString();
-
-    auto spline_points = getPoints();
-    for (int w = 0; w < spline_points.size() - 1; ++w) {
-        welldef.radii.push_back(well_settings_.wellbore_radius);
-        welldef.skins.push_back(0.0);
-        welldef.skins.push_back(0.0);
-        welldef.heels.push_back(spline_points[w]);
-        welldef.toes.push_back(spline_points[w+1]);
-        if (welldef.heel_md.size() == 0) {
-            welldef.heel_md.push_back(0.0);
-        }
-        else {
-            double prev_toe = welldef.toe_md.back();
-            welldef.heel_md.push_back(prev_toe);
-        }
-        welldef.toe_md.push_back(
-            welldef.heel_md.back() + (welldef.toes.back() - welldef.heels.back()).norm()
-        );
-    }
-
+    WellDefinition welldef = GetWellDefinition();
 
     auto start = QDateTime::currentDateTime();
     vector<IntersectedCell> block_data;
-    if (imported_wellblocks_.empty() || is_variable_) {
+    if (has_precomputed_block_data_) {
+        block_data = precomputed_block_data_;
+        precomputed_block_data_.clear();
+        has_precomputed_block_data_ = false;
+    }
+    else if (imported_wellblocks_.empty() || is_variable_) {
         wic_->ComputeWellBlocks(block_data, welldef);
     }
     else {
@@ -215,6 +201,41 @@ QList<WellBlock *> *WellSpline::GetWellBlocks()
     return computeWellBlocks();
 }
 
+WellDefinition WellSpline::GetWellDefinition() const {
+    WellDefinition welldef;
+    welldef.wellname = well_settings_.name.toStdString();
+
+    auto spline_points = getPoints();
+    for (int w = 0; w < spline_points.size() - 1; ++w) {
+        welldef.radii.push_back(well_settings_.wellbore_radius);
+        welldef.skins.push_back(0.0);
+        welldef.skins.push_back(0.0);
+        welldef.heels.push_back(spline_points[w]);
+        welldef.toes.push_back(spline_points[w+1]);
+        if (welldef.heel_md.size() == 0) {
+            welldef.heel_md.push_back(0.0);
+        }
+        else {
+            double prev_toe = welldef.toe_md.back();
+            welldef.heel_md.push_back(prev_toe);
+        }
+        welldef.toe_md.push_back(
+            welldef.heel_md.back() + (welldef.toes.back() - welldef.heels.back()).norm()
+        );
+    }
+    return welldef;
+}
+
+bool WellSpline::CanBatchWellIndexCalculation() const {
+    return (imported_wellblocks_.empty() || is_variable_)
+        && (HasGridChanged() || HasSplineChanged());
+}
+
+void WellSpline::SetPrecomputedWellIndices(const std::vector<IntersectedCell> &block_data) {
+    precomputed_block_data_ = block_data;
+    has_precomputed_block_data_ = true;
+}
+
 WellBlock *WellSpline::getWellBlock(Reservoir::WellIndexCalculation::IntersectedCell block_data)
 {
     if (VERB_MOD >= 3) {
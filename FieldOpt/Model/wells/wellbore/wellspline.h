@@ -65,6 +65,28 @@ class WellSpline
   bool HasGridChanged() const;
   bool HasSplineChanged() const;
 
+  /*!
+   * \brief CanBatchWellIndexCalculation Check whether the well indices
+   * for the current spline need to be computed and can be computed
+   * from the definition returned by GetWellDefinition(), i.e. as part
+   * of a batch computation for several wells.
+   */
+  bool CanBatchWellIndexCalculation() const;
+
+  /*!
+   * \brief GetWellDefinition Get the WIC definition of the well
+   * for the current spline points.
+   */
+  Reservoir::WellIndexCalculation::WellDefinition GetWellDefinition() const;
+
+  /*!
+   * \brief SetPrecomputedWellIndices Set the intersected cells computed
+   * for this well by a batch computation (see wicalc_rixx::ComputeWellBlocks).
+   * They will be used instead of calling the WIC the next time the well
+   * blocks are computed.
+   */
+  void SetPrecomputedWellIndices(const std::vector<Reservoir::WellIndexCalculation::IntersectedCell> &block_data);
+
   /*!
    * Get spline points (for debugging purposes).
    */
@@ -103,6 +125,9 @@ class WellSpline
   std::string last_computed_grid_; //!< Contains the path to the last grid used by WIC.
   std::vector<Eigen::Vector3d> last_computed_spline_; //!< Contains the last spline points used by WIC. Used to determine if the spline has changed.
 
+  bool has_precomputed_block_data_; //!< Whether precomputed_block_data_ should be used the next time the well blocks are computed.
+  std::vector<Reservoir::WellIndexCalculation::IntersectedCell> precomputed_block_data_; //!< Intersected cells set by SetPrecomputedWellIndices.
+
   /*!
    * \brief getWellBlock Convert the BlockData returned by the WIC to a WellBlock with a Perforation.
    * \note The IJK indexes are incremented by on to account for the zero-inclusive indices used by
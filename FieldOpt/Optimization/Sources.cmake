@@ -2,6 +2,7 @@ SET(OPTIMIZATION_HEADERS
 	case.h
 	case_handler.h
 	case_transfer_object.h
+	case_variable_schema.h
 	constraints/bhp_constraint.h
 	constraints/combined_spline_length_interwell_distance.h
 	constraints/combined_spline_length_interwell_distance_reservoir_boundary.h
@@ -46,12 +47,14 @@ SET(OPTIMIZATION_HEADERS
 	optimizers/bayesian_optimization/af_optimizers/AFPSO.h
 	optimizers/compass_search.h
 	optimizers/gss_patterns.hpp
+	surrogate_screening.h
 )
 
 SET(OPTIMIZATION_SOURCES
 	case.cpp
 	case_handler.cpp
 	case_transfer_object.cpp
+	case_variable_schema.cpp
 	constraints/bhp_constraint.cpp
 	constraints/combined_spline_length_interwell_distance.cpp
 	constraints/combined_spline_length_interwell_distance_reservoir_boundary.cpp
@@ -94,6 +97,7 @@ SET(OPTIMIZATION_SOURCES
 	optimizers/bayesian_optimization/af_optimizers/AFOptimizer.cpp
 	optimizers/bayesian_optimization/af_optimizers/AFPSO.cpp
 	optimizers/compass_search.cpp
+	surrogate_screening.cpp
 )
 
 SET(OPTIMIZATION_TESTS
@@ -120,4 +124,5 @@ SET(OPTIMIZATION_TESTS
 	tests/test_case_handler.cpp
 	tests/test_case_transfer_object.cpp
 	tests/test_normalizer.cpp
+	tests/test_surrogate_screening.cpp
 )
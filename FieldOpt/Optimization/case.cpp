@@ -28,72 +28,183 @@
 
 namespace Optimization {
 
+namespace {
+
+/*!
+ * Write the values of a hash to a vector ordered by ids. Returns false if the keys
+ * of the hash are not exactly the ids.
+ */
+template<typename T, typename V>
+bool scatter(const QHash<QUuid, T> &variables, const QList<QUuid> &ids, V &values) {
+    if (variables.size() != ids.size()) return false;
+    values.resize(ids.size());
+    for (int i = 0; i < ids.size(); ++i) {
+        auto it = variables.constFind(ids[i]);
+        if (it == variables.constEnd()) return false;
+        values[i] = it.value();
+    }
+    return true;
+}
+
+template<typename T, typename V>
+QHash<QUuid, T> gather(const QList<QUuid> &ids, const V &values) {
+    QHash<QUuid, T> variables;
+    variables.reserve(ids.size());
+    for (int i = 0; i < ids.size(); ++i) {
+        variables.insert(ids[i], values[i]);
+    }
+    return variables;
+}
+
+}
+
 Case::Case() {
     id_ = QUuid::createUuid();
-    binary_variables_ = QHash<QUuid, bool>();
-    integer_variables_ = QHash<QUuid, int>();
-    real_variables_ = QHash<QUuid, double>();
+    schema_ = CaseVariableSchema::Empty();
     objective_function_value_ = std::numeric_limits<double>::max();
     sim_time_sec_ = 0;
     wic_time_sec_ = 0;
     ensemble_realization_ = "";
+    realization_selection_key_ = -1;
+    parent_ = nullptr;
+    direction_index_ = -1;
+    step_length_ = 0;
     ensemble_ofvs_ = QHash<QString, double>();
 }
 
 Case::Case(const QHash<QUuid, bool> &binary_variables, const QHash<QUuid, int> &integer_variables, const QHash<QUuid, double> &real_variables)
 {
     id_ = QUuid::createUuid();
-    binary_variables_ = binary_variables;
-    integer_variables_ = integer_variables;
-    real_variables_ = real_variables;
+    schema_ = std::make_shared<const CaseVariableSchema>(binary_variables.keys(),
+                                                         integer_variables.keys(),
+                                                         real_variables.keys());
+    scatter(binary_variables, schema_->binary_ids(), binary_values_);
+    scatter(integer_variables, schema_->integer_ids(), integer_values_);
+    scatter(real_variables, schema_->real_ids(), real_values_);
     objective_function_value_ = std::numeric_limits<double>::max();
 
-    real_id_index_map_ = real_variables_.keys();
-    integer_id_index_map_ = integer_variables_.keys();
     sim_time_sec_ = 0;
     wic_time_sec_ = 0;
     ensemble_realization_ = "";
+    realization_selection_key_ = -1;
+    parent_ = nullptr;
+    direction_index_ = -1;
+    step_length_ = 0;
     ensemble_ofvs_ = QHash<QString, double>();
 }
 
 Case::Case(const Case *c)
 {
     id_ = QUuid::createUuid();
-    binary_variables_ = QHash<QUuid, bool>(c->binary_variables());
-    integer_variables_ = QHash<QUuid, int> (c->integer_variables());
-    real_variables_ = QHash<QUuid, double> (c->real_variables());
+    schema_ = c->schema_;
+    binary_values_ = c->binary_values_;
+    integer_values_ = c->integer_values_;
+    real_values_ = c->real_values_;
     objective_function_value_ = c->objective_function_value_;
 
-    real_id_index_map_ = c->real_id_index_map_;
-    integer_id_index_map_ = c->integer_variables_.keys();
     sim_time_sec_ = 0;
     wic_time_sec_ = 0;
     ensemble_realization_ = "";
+    realization_selection_key_ = -1;
+    parent_ = nullptr;
+    direction_index_ = -1;
+    step_length_ = 0;
     ensemble_ofvs_ = c->ensemble_ofvs_;
 }
 
 bool Case::Equals(const Case *other, double tolerance) const
 {
     // Check if number of variables are equal
-    if (this->binary_variables().size() != other->binary_variables().size()
-        || this->integer_variables().size() != other->integer_variables().size()
-        || this->real_variables().size() != other->real_variables().size())
+    if (binary_values_.size() != other->binary_values_.size()
+        || integer_values_.size() != other->integer_values_.size()
+        || real_values_.size() != other->real_values_.size())
         return false;
-    for (QUuid key : this->binary_variables().keys()) {
-        if (std::abs(this->binary_variables()[key] - other->binary_variables()[key]) > tolerance)
+    if (*schema_ == *other->schema_) { // Compare the values element by element
+        if (binary_values_ != other->binary_values_ && tolerance < 1.0)
+            return false;
+        if (integer_values_.size() > 0
+            && (integer_values_ - other->integer_values_).cwiseAbs().maxCoeff() > tolerance)
+            return false;
+        if (real_values_.size() > 0
+            && (real_values_ - other->real_values_).cwiseAbs().maxCoeff() > tolerance)
             return false;
+        return true;
     }
-    for (QUuid key : this->integer_variables().keys()) {
-        if (std::abs(this->integer_variables()[key] - other->integer_variables()[key]) > tolerance)
+    for (int i = 0; i < binary_values_.size(); ++i) {
+        int j = other->schema_->binary_index(schema_->binary_ids()[i]);
+        if (j < 0 || std::abs(binary_values_[i] - other->binary_values_[j]) > tolerance)
             return false;
     }
-    for (QUuid key : this->real_variables().keys()) {
-        if (std::abs(this->real_variables()[key] - other->real_variables()[key]) > tolerance)
+    for (int i = 0; i < integer_values_.size(); ++i) {
+        int j = other->schema_->integer_index(schema_->integer_ids()[i]);
+        if (j < 0 || std::abs(integer_values_[i] - other->integer_values_[j]) > tolerance)
+            return false;
+    }
+    for (int i = 0; i < real_values_.size(); ++i) {
+        int j = other->schema_->real_index(schema_->real_ids()[i]);
+        if (j < 0 || std::abs(real_values_[i] - other->real_values_[j]) > tolerance)
             return false;
     }
     return true; // All variable values are equal if we reach this point.
 }
 
+QHash<QUuid, bool> Case::binary_variables() const {
+    return gather<bool>(schema_->binary_ids(), binary_values_);
+}
+
+QHash<QUuid, int> Case::integer_variables() const {
+    return gather<int>(schema_->integer_ids(), integer_values_);
+}
+
+QHash<QUuid, double> Case::real_variables() const {
+    return gather<double>(schema_->real_ids(), real_values_);
+}
+
+void Case::set_binary_variables(const QHash<QUuid, bool> &binary_variables) {
+    if (!scatter(binary_variables, schema_->binary_ids(), binary_values_)) {
+        schema_ = std::make_shared<const CaseVariableSchema>(binary_variables.keys(),
+                                                             schema_->integer_ids(),
+                                                             schema_->real_ids());
+        scatter(binary_variables, schema_->binary_ids(), binary_values_);
+    }
+}
+
+void Case::set_integer_variables(const QHash<QUuid, int> &integer_variables) {
+    if (!scatter(integer_variables, schema_->integer_ids(), integer_values_)) {
+        schema_ = std::make_shared<const CaseVariableSchema>(schema_->binary_ids(),
+                                                             integer_variables.keys(),
+                                                             schema_->real_ids());
+        scatter(integer_variables, schema_->integer_ids(), integer_values_);
+    }
+}
+
+void Case::set_real_variables(const QHash<QUuid, double> &real_variables) {
+    if (!scatter(real_variables, schema_->real_ids(), real_values_)) {
+        schema_ = std::make_shared<const CaseVariableSchema>(schema_->binary_ids(),
+                                                             schema_->integer_ids(),
+                                                             real_variables.keys());
+        scatter(real_variables, schema_->real_ids(), real_values_);
+    }
+}
+
+bool Case::binary_variable_value(const QUuid &id) const {
+    int i = schema_->binary_index(id);
+    if (i < 0) throw VariableException("Unable to get value of variable " + id.toString());
+    return binary_values_[i];
+}
+
+int Case::integer_variable_value(const QUuid &id) const {
+    int i = schema_->integer_index(id);
+    if (i < 0) throw VariableException("Unable to get value of variable " + id.toString());
+    return integer_values_[i];
+}
+
+double Case::real_variable_value(const QUuid &id) const {
+    int i = schema_->real_index(id);
+    if (i < 0) throw VariableException("Unable to get value of variable " + id.toString());
+    return real_values_[i];
+}
+
 double Case::objective_function_value() const {
     if (objective_function_value_ == std::numeric_limits<double>::max())
         throw ObjectiveFunctionException("The objective function value has not been set in this Case.");
@@ -104,48 +215,52 @@ double Case::objective_function_value() const {
 
 void Case::set_integer_variable_value(const QUuid id, const int val)
 {
-    if (!integer_variables_.contains(id)) throw VariableException("Unable to set value of variable " + id.toString());
-    integer_variables_[id] = val;
+    int i = schema_->integer_index(id);
+    if (i < 0) throw VariableException("Unable to set value of variable " + id.toString());
+    integer_values_[i] = val;
 }
 
 void Case::set_binary_variable_value(const QUuid id, const bool val)
 {
-    if (!binary_variables_.contains(id)) throw VariableException("Unable to set value of variable " + id.toString());
-    binary_variables_[id] = val;
+    int i = schema_->binary_index(id);
+    if (i < 0) throw VariableException("Unable to set value of variable " + id.toString());
+    binary_values_[i] = val;
 }
 
 void Case::set_real_variable_value(const QUuid id, const double val)
 {
-    if (!real_variables_.contains(id)) throw VariableException("Unable to set value of variable " + id.toString());
-    real_variables_[id] = val;
+    int i = schema_->real_index(id);
+    if (i < 0) throw VariableException("Unable to set value of variable " + id.toString());
+    real_values_[i] = val;
 }
 
 QList<Case *> Case::Perturb(QUuid variabe_id, Case::SIGN sign, double magnitude)
 {
     QList<Case *> new_cases = QList<Case *>();
-    if (this->integer_variables().contains(variabe_id)) {
+    int i;
+    if ((i = schema_->integer_index(variabe_id)) >= 0) {
         if (sign == PLUS || sign == PLUSMINUS) {
             Case *new_case_p = new Case(this);
-            new_case_p->integer_variables_[variabe_id] += magnitude;
+            new_case_p->integer_values_[i] += magnitude;
             new_case_p->objective_function_value_ = std::numeric_limits<double>::max();
             new_cases.append(new_case_p);
         }
         if (sign == MINUS || sign == PLUSMINUS) {
             Case *new_case_m = new Case(this);
-            new_case_m->integer_variables_[variabe_id] -= magnitude;
+            new_case_m->integer_values_[i] -= magnitude;
             new_case_m->objective_function_value_ = std::numeric_limits<double>::max();
             new_cases.append(new_case_m);
         }
-    } else if (real_variables_.contains(variabe_id)) {
+    } else if ((i = schema_->real_index(variabe_id)) >= 0) {
         if (sign == PLUS || sign == PLUSMINUS) {
             Case *new_case_p = new Case(this);
-            new_case_p->real_variables_[variabe_id] += magnitude;
+            new_case_p->real_values_[i] += magnitude;
             new_case_p->objective_function_value_ = std::numeric_limits<double>::max();
             new_cases.append(new_case_p);
         }
         if (sign == MINUS || sign == PLUSMINUS) {
             Case *new_case_m = new Case(this);
-            new_case_m->real_variables_[variabe_id] -= magnitude;
+            new_case_m->real_values_[i] -= magnitude;
             new_case_m->objective_function_value_ = std::numeric_limits<double>::max();
             new_cases.append(new_case_m);
         }
@@ -153,32 +268,18 @@ QList<Case *> Case::Perturb(QUuid variabe_id, Case::SIGN sign, double magnitude)
     return new_cases;
 }
 
-Eigen::VectorXd Case::GetRealVarVector() {
-    Eigen::VectorXd vec(real_id_index_map_.length());
-    for (int i = 0; i < real_id_index_map_.length(); ++i) {
-        vec[i] = real_variables_.value(real_id_index_map_[i]);
-    }
-    return vec;
-}
-
-void Case::SetRealVarValues(Eigen::VectorXd vec) {
-    for (int i = 0; i < vec.size(); ++i) {
-        set_real_variable_value(real_id_index_map_[i], vec[i]);
-    }
+void Case::SetRealVarValues(const Eigen::VectorXd &vec) {
+    if (vec.size() != real_values_.size())
+        throw VariableException("Unable to set real variable values: expected " + QString::number(real_values_.size())
+                                    + " values, got " + QString::number(vec.size()) + ".");
+    real_values_ = vec;
 }
 
-Eigen::VectorXi Case::GetIntegerVarVector() {
-    Eigen::VectorXi vec(integer_id_index_map_.length());
-    for (int i = 0; i < integer_id_index_map_.length(); ++i) {
-        vec[i] = integer_variables_.value(integer_id_index_map_[i]);
-    }
-    return vec;
-}
-
-void Case::SetIntegerVarValues(Eigen::VectorXi vec) {
-    for (int i = 0; i < vec.size(); ++i) {
-        set_integer_variable_value(integer_id_index_map_[i], vec[i]);
-    }
+void Case::SetIntegerVarValues(const Eigen::VectorXi &vec) {
+    if (vec.size() != integer_values_.size())
+        throw VariableException("Unable to set integer variable values: expected " + QString::number(integer_values_.size())
+                                    + " values, got " + QString::number(vec.size()) + ".");
+    integer_values_ = vec;
 }
 
 void Case::set_origin_data(Case *parent, int direction_index, double step_length) {
@@ -192,6 +293,8 @@ Loggable::LogTarget Case::GetLogTarget() {
 map <string, string> Case::GetState() {
     map<string, string> statemap;
     switch (state.eval) {
+        case CaseState::EvalStatus::E_SCREENED: statemap["EvalSt"] = "SCRN"; break;
+        case CaseState::EvalStatus::E_TERMINATED: statemap["EvalSt"] = "TERM"; break;
         case CaseState::EvalStatus::E_FAILED: statemap["EvalSt"] = "FAIL"; break;
         case CaseState::EvalStatus::E_TIMEOUT: statemap["EvalSt"] = "TMOT"; break;
         case CaseState::EvalStatus::E_PENDING: statemap["EvalSt"] = "PEND"; break;
@@ -234,28 +337,28 @@ string Case::StringRepresentation(Model::Properties::VariablePropertyContainer *
     str << "|=========================================================|" << endl;
     str << "| Case:            " << id_stdstr() << " |" << endl;
     str << "|---------------------------------------------------------|" << endl;
-    if (real_variables_.size() > 0) {
+    if (real_values_.size() > 0) {
         str << "| Continuous variable values:                             |" << endl;
-        for (auto key : real_variables_.keys()) {
-            string varname = varcont->GetContinousVariables()->value(key)->name().toStdString();
+        for (int i = 0; i < real_values_.size(); ++i) {
+            string varname = varcont->GetContinousVariables()->value(schema_->real_ids()[i])->name().toStdString();
             str << "| > " << varname << ": " << std::setw (51 - varname.size())
-                << boost::lexical_cast<string>(real_variables_[key]) << " |" << endl;
+                << boost::lexical_cast<string>(real_values_[i]) << " |" << endl;
         }
     }
-    if (integer_variables_.size() > 0) {
+    if (integer_values_.size() > 0) {
         str << "| Discrete variable values:                             |" << endl;
-        for (auto key : integer_variables_.keys()) {
-            string varname = varcont->GetDiscreteVariables()->value(key)->name().toStdString();
+        for (int i = 0; i < integer_values_.size(); ++i) {
+            string varname = varcont->GetDiscreteVariables()->value(schema_->integer_ids()[i])->name().toStdString();
             str << "| > " << varname << ": " << std::setw (51 - varname.size())
-                << boost::lexical_cast<string>(integer_variables_[key]) << " |" << endl;
+                << boost::lexical_cast<string>(integer_values_[i]) << " |" << endl;
         }
     }
-    if (binary_variables_.size() > 0) {
+    if (binary_values_.size() > 0) {
         str << "| Discrete variable values:                             |" << endl;
-        for (auto key : binary_variables_.keys()) {
-            string varname = varcont->GetBinaryVariables()->value(key)->name().toStdString();
+        for (int i = 0; i < binary_values_.size(); ++i) {
+            string varname = varcont->GetBinaryVariables()->value(schema_->binary_ids()[i])->name().toStdString();
             str << "| > " << varname << ": " << std::setw (51 - varname.size())
-                << boost::lexical_cast<string>(binary_variables_[key]) << " |" << endl;
+                << boost::lexical_cast<string>(binary_values_[i]) << " |" << endl;
         }
     }
     str << "|=========================================================|" << endl;
@@ -27,6 +27,7 @@
 #include <Model/properties/variable_property_container.h>
 #include "Runner/loggable.hpp"
 #include "optimization_exceptions.h"
+#include "case_variable_schema.h"
 
 namespace Optimization {
 
@@ -36,6 +37,11 @@ class CaseTransferObject;
 /*!
  * \brief The Case class represents a specific case for the optimizer, i.e. a specific set of variable values
  * and the value of the objective function after evaluation.
+ *
+ * The variable values are stored in contiguous vectors, ordered by a CaseVariableSchema that is shared
+ * with the cases this case was copied from/to. The UUID-based accessors look variables up through
+ * the schema; the hash-returning getters build a new hash on each call, and should be avoided in
+ * code that runs for every case.
  */
 class Case : public Loggable
 {
@@ -44,10 +50,19 @@ class Case : public Loggable
   friend class CaseTransferObject;
 
   Case();
+
+  /*!
+   * @brief Create a case with the given variables. A new schema is created for the case, ordering
+   * the variables as they appear in the hashes.
+   */
   Case(const QHash<QUuid, bool> &binary_variables,
        const QHash<QUuid, int> &integer_variables,
        const QHash<QUuid, double> &real_variables);
   Case(const Case &c) = delete;
+
+  /*!
+   * @brief Create a copy of a case, with a new id. The copy shares the schema of the original.
+   */
   Case(const Case *c);
 
   /*!
@@ -57,6 +72,8 @@ class Case : public Loggable
    */
   struct CaseState {
     enum EvalStatus : int {
+      E_SCREENED=-4, //!< Rejected by surrogate screening and not evaluated; the objective value is the prediction.
+      E_TERMINATED=-3, //!< Killed early because it could not improve on the best case.
       E_FAILED=-2, E_TIMEOUT=-1,
       E_PENDING=0,
       E_CURRENT=1, E_DONE=2,
@@ -108,12 +125,31 @@ class Case : public Loggable
    */
   string StringRepresentation(Model::Properties::VariablePropertyContainer *varcont);
 
-  QHash<QUuid, bool> binary_variables() const { return binary_variables_; }
-  QHash<QUuid, int> integer_variables() const { return integer_variables_; }
-  QHash<QUuid, double> real_variables() const { return real_variables_; }
-  void set_binary_variables(const QHash<QUuid, bool> &binary_variables) { binary_variables_ = binary_variables; }
-  void set_integer_variables(const QHash<QUuid, int> &integer_variables) { integer_variables_ = integer_variables; }
-  void set_real_variables(const QHash<QUuid, double> &real_variables) { real_variables_ = real_variables; }
+  QHash<QUuid, bool> binary_variables() const; //!< Build a hash of the binary variables. Prefer binary_variable_value().
+  QHash<QUuid, int> integer_variables() const; //!< Build a hash of the integer variables. Prefer integer_variable_value().
+  QHash<QUuid, double> real_variables() const; //!< Build a hash of the real variables. Prefer real_variable_value().
+
+  /*!
+   * @brief Set the binary variables of this case. If the ids are the same as in the current schema, the
+   * values are written to the current storage; otherwise the case gets a new schema.
+   */
+  void set_binary_variables(const QHash<QUuid, bool> &binary_variables);
+  void set_integer_variables(const QHash<QUuid, int> &integer_variables); //!< See set_binary_variables().
+  void set_real_variables(const QHash<QUuid, double> &real_variables); //!< See set_binary_variables().
+
+  bool binary_variable_value(const QUuid &id) const; //!< Get the value of a binary variable. Throws VariableException if it does not exist.
+  int integer_variable_value(const QUuid &id) const; //!< Get the value of an integer variable. Throws VariableException if it does not exist.
+  double real_variable_value(const QUuid &id) const; //!< Get the value of a real variable. Throws VariableException if it does not exist.
+
+  const QList<QUuid> &binary_variable_ids() const { return schema_->binary_ids(); } //!< Binary variable ids, in schema order.
+  const QList<QUuid> &integer_variable_ids() const { return schema_->integer_ids(); } //!< Integer variable ids, in schema order.
+  const QList<QUuid> &real_variable_ids() const { return schema_->real_ids(); } //!< Real variable ids, in schema order.
+
+  int NumberOfBinaryVariables() const { return (int)binary_values_.size(); }
+  int NumberOfIntegerVariables() const { return (int)integer_values_.size(); }
+  int NumberOfRealVariables() const { return (int)real_values_.size(); }
+
+  CaseVariableSchema::Ptr variable_schema() const { return schema_; } //!< Get the schema ordering the variables of this case.
 
   double objective_function_value() const; //!< Get the objective function value. Throws an exception if the value has not been defined.
   void set_objective_function_value(double objective_function_value);
@@ -141,58 +177,42 @@ class Case : public Loggable
   /*!
    * Get the real variables of this case as a Vector.
    *
-   * @note This function will not work with Case objects created from CaseTransferObject.
-   * This implies that, when running in parallel, it will only work on the main process.
-   *
-   * This creates an ordering of the variables so that for future
-   * use the i'th index in the vector will always correspond to the
-   * same variable.
+   * The vector is the storage of the case, ordered by its schema, so that the i'th
+   * index in the vector always corresponds to the same variable for all cases sharing
+   * the schema.
    * @return Values of the real variables in a vector
    */
-  Eigen::VectorXd GetRealVarVector();
+  const Eigen::VectorXd &GetRealVarVector() const { return real_values_; }
 
   /*!
    * Sets the real variable values of this case from a given vector.
    *
-   * @note This function will not work with Case objects created from CaseTransferObject.
-   * This implies that, when running in parallel, it will only work on the main process.
-   *
-   * The order of the variables as they appear in vector this case is preserved
-   * given that they were taken from this same case from the function GetRealVector()
+   * The values must be ordered as in the vector from GetRealVarVector(), on this case or
+   * another case sharing its schema. Throws VariableException if the size does not match.
    * @param vec
    */
-  void SetRealVarValues(Eigen::VectorXd vec);
+  void SetRealVarValues(const Eigen::VectorXd &vec);
 
   /*!
    * @brief Get a vector containing the variable UUIDs in the same order they appear
    * in in the vector from GetRealVarVector.
    */
-  QList<QUuid> GetRealVarIdVector() { return real_id_index_map_; }
+  const QList<QUuid> &GetRealVarIdVector() const { return schema_->real_ids(); }
 
   /*!
-   * Get the integer variables of this case as a Vector.
-   *
-   * @note This function will not work with Case objects created from CaseTransferObject.
-   * This implies that, when running in parallel, it will only work on the main process.
-   *
-   * This creates an ordering of the variables so that for future
-   * use the i'th index in the vector will always correspond to the
-   * same variable.
+   * Get the integer variables of this case as a Vector, ordered by the schema
+   * of the case (see GetRealVarVector()).
    * @return Values of the integer variables in a vector
    */
-  Eigen::VectorXi GetIntegerVarVector();
+  const Eigen::VectorXi &GetIntegerVarVector() const { return integer_values_; }
 
   /*!
-   * Sets the integer variable values of this case from a given vector.
-   *
-   * @note This function will not work with Case objects created from CaseTransferObject.
-   * This implies that, when running in parallel, it will only work on the main process.
-   *
-   * The order of the variables as they appear in vector this case is preserved
-   * given that they were taken from this same case from the function GetIntegerVarVector()
+   * Sets the integer variable values of this case from a given vector, ordered
+   * as in the vector from GetIntegerVarVector(). Throws VariableException if the
+   * size does not match.
    * @param vec
    */
-  void SetIntegerVarValues(Eigen::VectorXi vec);
+  void SetIntegerVarValues(const Eigen::VectorXi &vec);
 
   /*!
    * @brief Set the origin info of this Case/trial point, i.e. which point it was generated
@@ -232,6 +252,14 @@ class Case : public Loggable
   // Multiple realizations-support
   void SetEnsembleRealization(const QString &alias) { ensemble_realization_ = alias; }
   QString GetEnsembleRealization() const { return ensemble_realization_; }
+
+  /*!
+   * @brief Set the key used when selecting a subset of the ensemble realizations for this case.
+   * Cases with the same key are evaluated on the same subset (common random numbers). A negative
+   * key (the default) means that the realizations are selected independently for the case.
+   */
+  void SetRealizationSelectionKey(const int key) { realization_selection_key_ = key; }
+  int GetRealizationSelectionKey() const { return realization_selection_key_; }
   void SetRealizationOfv(const QString &alias, const double &ofv);
   bool HasRealizationOfv(const QString &alias);
   double GetRealizationOfv(const QString &alias);
@@ -250,12 +278,10 @@ class Case : public Loggable
   int wic_time_sec_; //!< The number of seconds spent computing the well index for this case.
 
   double objective_function_value_;
-  QHash<QUuid, bool> binary_variables_;
-  QHash<QUuid, int> integer_variables_;
-  QHash<QUuid, double> real_variables_;
-
-  QList<QUuid> real_id_index_map_;
-  QList<QUuid> integer_id_index_map_;
+  CaseVariableSchema::Ptr schema_; //!< Ordering of the variables in the value vectors.
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> binary_values_;
+  Eigen::VectorXi integer_values_;
+  Eigen::VectorXd real_values_;
 
   Case* parent_; //!< The parent of this trial point. Needed by the APPS algorithm.
   int direction_index_; //!< The direction index used to generate this trial point.
@@ -263,6 +289,7 @@ class Case : public Loggable
 
   // Multiple realizations-support
   QString ensemble_realization_; //!< The realization to evaluate next. Used by workers when in parallel mode.
+  int realization_selection_key_; //!< Cases with the same non-negative key are evaluated on the same realizations.
   QHash<QString, double> ensemble_ofvs_; //!< Map of objective function values from realization alias - value.
 };
 
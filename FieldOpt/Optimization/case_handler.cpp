@@ -36,6 +36,7 @@ CaseHandler::CaseHandler()
     nr_timo_ = 0;
     nr_invl_ = 0;
     nr_fail_ = 0;
+    nr_term_ = 0;
 }
 
 CaseHandler::CaseHandler(Case *base_case)
@@ -85,6 +86,7 @@ void CaseHandler::SetCaseEvaluated(const QUuid id)
         case Case::CaseState::EvalStatus::E_BOOKKEEPED: nr_bkpd_++; break;
         case Case::CaseState::EvalStatus::E_TIMEOUT: nr_timo_++; break;
         case Case::CaseState::EvalStatus::E_FAILED: nr_fail_++; break;
+        case Case::CaseState::EvalStatus::E_TERMINATED: nr_term_++; break;
     }
     if (cases_[id]->state.err_msg != Case::CaseState::ErrorMessage::ERR_OK){
         nr_invl_++;
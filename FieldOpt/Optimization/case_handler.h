@@ -111,6 +111,12 @@ class CaseHandler
    */
   QList<Case *> EvaluatedCases() const;
 
+  /*!
+   * \brief EvaluatedCaseIds Get the IDs of the cases that have been marked as evaluated,
+   * in the order they were marked. Cases are only ever appended to this list.
+   */
+  const QList<QUuid> &EvaluatedCaseIds() const { return evaluated_; }
+
   /*!
    * @brief Get _all_ cases.
    */
@@ -128,6 +134,7 @@ class CaseHandler
   int NumberTimeout() const { return  nr_timo_; }
   int NumberInvalid() const { return nr_invl_; }
   int NumberFailed() const { return nr_fail_; }
+  int NumberTerminated() const { return nr_term_; }
 
  private:
   QQueue<QUuid> evaluation_queue_; //!< Queue of the next keys to be evaluated.
@@ -142,6 +149,7 @@ class CaseHandler
   int nr_timo_; //!< Number of cases interrupted because of timeout.
   int nr_invl_; //!< Number of invalid cases (failed while being applied to model).
   int nr_fail_; //!< Number of cases that have failed for some reason.
+  int nr_term_; //!< Number of cases terminated early by the simulation monitor.
 };
 
 }
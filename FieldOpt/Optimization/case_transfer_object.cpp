@@ -20,18 +20,107 @@
 #include <boost/lexical_cast.hpp>
 #include "case_transfer_object.h"
 #include <QString>
+#include <cstdint>
+#include <cstring>
 
 namespace Optimization {
 using namespace boost::uuids;
 using namespace std;
 
+namespace {
+
+const int32_t wire_format_version = 1;
+
+/*!
+ * Append n values to the end of a buffer.
+ */
+template<typename T>
+void append(std::vector<char> &buffer, const T *values, size_t n) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + n * sizeof(T));
+    if (n > 0) std::memcpy(buffer.data() + offset, values, n * sizeof(T));
+}
+
+template<typename T>
+void append(std::vector<char> &buffer, const T &value) {
+    append(buffer, &value, 1);
+}
+
+/*!
+ * Sequential reader for buffers written with append.
+ */
+class BufferReader {
+ public:
+  BufferReader(const std::vector<char> &buffer) : buffer_(buffer), position_(0) {}
+
+  template<typename T>
+  void read(T *values, size_t n) {
+      if (position_ + n * sizeof(T) > buffer_.size())
+          throw std::runtime_error("Unable to unpack cases: the buffer is truncated.");
+      if (n > 0) std::memcpy(values, buffer_.data() + position_, n * sizeof(T));
+      position_ += n * sizeof(T);
+  }
+
+  template<typename T>
+  T read() {
+      T value;
+      read(&value, 1);
+      return value;
+  }
+
+  bool at_end() const { return position_ == buffer_.size(); }
+
+ private:
+  const std::vector<char> &buffer_;
+  size_t position_;
+};
+
+/*!
+ * Gather the values of a case's variables in index order. Values stored in the same
+ * order as the index are copied directly; otherwise they are looked up by id.
+ */
+template<typename V, typename S>
+void gather(const V &case_values, const QList<QUuid> &case_ids, bool same_order,
+            const QList<QUuid> &ids, std::vector<S> &values) {
+    if (case_values.size() != ids.size())
+        throw std::runtime_error("Unable to pack case: its variables do not match the variable index.");
+    values.resize(ids.size());
+    if (same_order) {
+        for (int i = 0; i < ids.size(); ++i) {
+            values[i] = static_cast<S>(case_values[i]);
+        }
+        return;
+    }
+    QHash<QUuid, int> case_indices;
+    case_indices.reserve(case_ids.size());
+    for (int i = 0; i < case_ids.size(); ++i) {
+        case_indices.insert(case_ids[i], i);
+    }
+    for (int i = 0; i < ids.size(); ++i) {
+        auto it = case_indices.constFind(ids[i]);
+        if (it == case_indices.constEnd())
+            throw std::runtime_error("Unable to pack case: its variables do not match the variable index.");
+        values[i] = static_cast<S>(case_values[it.value()]);
+    }
+}
+
+template<typename V, typename S>
+void scatter(const std::vector<S> &values, V &case_values) {
+    case_values.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        case_values[i] = values[i];
+    }
+}
+
+}
+
 
 CaseTransferObject::CaseTransferObject(Optimization::Case *c) {
     id_ = qUuidToBoostUuid(c->id_);
     objective_function_value_ = c->objective_function_value_;
-    binary_variables_ = qHashToStdMap(c->binary_variables_);
-    integer_variables_ = qHashToStdMap(c->integer_variables_);
-    real_variables_ = qHashToStdMap(c->real_variables_);
+    binary_variables_ = qHashToStdMap(c->binary_variables());
+    integer_variables_ = qHashToStdMap(c->integer_variables());
+    real_variables_ = qHashToStdMap(c->real_variables());
     wic_time_secs_ = c->GetWICTime();
     sim_time_secs_ = c->GetSimTime();
     ensemble_realization_ = c->GetEnsembleRealization().toStdString();
@@ -43,10 +132,9 @@ CaseTransferObject::CaseTransferObject(Optimization::Case *c) {
 }
 
 Case *CaseTransferObject::CreateCase() {
-    auto c = new Case();
-    c->binary_variables_ = stdMapToQhash(binary_variables_);
-    c->integer_variables_ = stdMapToQhash(integer_variables_);
-    c->real_variables_ = stdMapToQhash(real_variables_);
+    auto c = new Case(stdMapToQhash(binary_variables_),
+                      stdMapToQhash(integer_variables_),
+                      stdMapToQhash(real_variables_));
     c->id_ = boostUuidToQuuid(id_);
     c->objective_function_value_ = objective_function_value_;
     c->SetWICTime(wic_time_secs_);
@@ -59,6 +147,99 @@ Case *CaseTransferObject::CreateCase() {
     return c;
 }
 
+void CaseTransferObject::Pack(const QList<Case *> &cases, const VariableIndex &index, std::vector<char> &buffer) {
+    const size_t case_size = 16 + sizeof(double) + 7 * sizeof(int32_t)
+        + index.binary_ids().size() * sizeof(uint8_t)
+        + index.integer_ids().size() * sizeof(int32_t)
+        + index.real_ids().size() * sizeof(double);
+    buffer.clear();
+    buffer.reserve(5 * sizeof(int32_t) + cases.size() * case_size);
+    append(buffer, wire_format_version);
+    append(buffer, (int32_t)cases.size());
+    append(buffer, (int32_t)index.binary_ids().size());
+    append(buffer, (int32_t)index.integer_ids().size());
+    append(buffer, (int32_t)index.real_ids().size());
+
+    std::vector<uint8_t> binary_values;
+    std::vector<int32_t> integer_values;
+    std::vector<double> real_values;
+    for (auto c : cases) {
+        QByteArray id = c->id_.toRfc4122();
+        append(buffer, id.constData(), 16);
+        append(buffer, c->objective_function_value_);
+        int32_t header[6] = {c->GetWICTime(), c->GetSimTime(),
+                             c->state.eval, c->state.cons, c->state.queue, c->state.err_msg};
+        append(buffer, header, 6);
+        std::string realization = c->GetEnsembleRealization().toStdString();
+        append(buffer, (int32_t)realization.size());
+        append(buffer, realization.data(), realization.size());
+
+        const CaseVariableSchema &schema = *c->schema_;
+        bool same_order = schema == *index.schema();
+        gather(c->binary_values_, schema.binary_ids(), same_order, index.binary_ids(), binary_values);
+        gather(c->integer_values_, schema.integer_ids(), same_order, index.integer_ids(), integer_values);
+        gather(c->real_values_, schema.real_ids(), same_order, index.real_ids(), real_values);
+        append(buffer, binary_values.data(), binary_values.size());
+        append(buffer, integer_values.data(), integer_values.size());
+        append(buffer, real_values.data(), real_values.size());
+    }
+}
+
+QList<Case *> CaseTransferObject::Unpack(const std::vector<char> &buffer, const VariableIndex &index) {
+    BufferReader reader(buffer);
+    if (reader.read<int32_t>() != wire_format_version)
+        throw std::runtime_error("Unable to unpack cases: unknown wire format version.");
+    int32_t n_cases = reader.read<int32_t>();
+    if (reader.read<int32_t>() != index.binary_ids().size()
+        || reader.read<int32_t>() != index.integer_ids().size()
+        || reader.read<int32_t>() != index.real_ids().size())
+        throw std::runtime_error("Unable to unpack cases: they were packed with a different variable index.");
+
+    std::vector<uint8_t> binary_values(index.binary_ids().size());
+    std::vector<int32_t> integer_values(index.integer_ids().size());
+    std::vector<double> real_values(index.real_ids().size());
+    QList<Case *> cases;
+    try {
+        for (int i = 0; i < n_cases; ++i) {
+            auto c = new Case();
+            cases.append(c);
+            char id[16];
+            reader.read(id, 16);
+            c->id_ = QUuid::fromRfc4122(QByteArray(id, 16));
+            c->objective_function_value_ = reader.read<double>();
+            int32_t header[6];
+            reader.read(header, 6);
+            c->SetWICTime(header[0]);
+            c->SetSimTime(header[1]);
+            c->state.eval = static_cast<Case::CaseState::EvalStatus>(header[2]);
+            c->state.cons = static_cast<Case::CaseState::ConsStatus>(header[3]);
+            c->state.queue = static_cast<Case::CaseState::QueueStatus>(header[4]);
+            c->state.err_msg = static_cast<Case::CaseState::ErrorMessage>(header[5]);
+            int32_t realization_length = reader.read<int32_t>();
+            if (realization_length < 0)
+                throw std::runtime_error("Unable to unpack cases: invalid realization name.");
+            std::string realization(realization_length, '\0');
+            reader.read(&realization[0], realization.size());
+            c->SetEnsembleRealization(QString::fromStdString(realization));
+
+            reader.read(binary_values.data(), binary_values.size());
+            reader.read(integer_values.data(), integer_values.size());
+            reader.read(real_values.data(), real_values.size());
+            c->schema_ = index.schema();
+            scatter(binary_values, c->binary_values_);
+            scatter(integer_values, c->integer_values_);
+            scatter(real_values, c->real_values_);
+        }
+        if (!reader.at_end())
+            throw std::runtime_error("Unable to unpack cases: unexpected data at the end of the buffer.");
+    }
+    catch (std::runtime_error &e) {
+        qDeleteAll(cases);
+        throw;
+    }
+    return cases;
+}
+
 QUuid CaseTransferObject::boostUuidToQuuid(const uuid buuid) const {
     return QUuid(boostUuidToQstring(buuid));
 }
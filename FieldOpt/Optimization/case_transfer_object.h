@@ -28,6 +28,7 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/serialization/map.hpp>
 #include <map>
+#include <vector>
 
 using namespace boost::uuids;
 using namespace std;
@@ -61,6 +62,53 @@ class CaseTransferObject {
  public:
   CaseTransferObject() {}
 
+  /*!
+   * @brief The VariableIndex class holds a dense ordering of the variables in a model. It is used
+   * to transfer cases as contiguous arrays of values instead of maps from variable UUIDs to values.
+   *
+   * The sending and receiving processes must use identical indices. The MPI runners build them
+   * from the ModelSynchronizationObject when the model is synchronized.
+   *
+   * Cases unpacked with an index share its schema. Cases using a schema with the same ordering
+   * as the index are packed by copying their value vectors directly.
+   */
+  class VariableIndex {
+   public:
+    VariableIndex() : schema_(CaseVariableSchema::Empty()) {}
+    VariableIndex(const QList<QUuid> &binary_ids, const QList<QUuid> &integer_ids, const QList<QUuid> &real_ids)
+        : schema_(std::make_shared<const CaseVariableSchema>(binary_ids, integer_ids, real_ids)) {}
+
+    const QList<QUuid> &binary_ids() const { return schema_->binary_ids(); }
+    const QList<QUuid> &integer_ids() const { return schema_->integer_ids(); }
+    const QList<QUuid> &real_ids() const { return schema_->real_ids(); }
+    CaseVariableSchema::Ptr schema() const { return schema_; }
+
+   private:
+    CaseVariableSchema::Ptr schema_;
+  };
+
+  /*!
+   * @brief Pack cases into a compact binary buffer.
+   *
+   * The buffer starts with a header holding the number of cases and the size of the index. Each
+   * case is then written as its raw 16 byte UUID, objective function value, timings, state and
+   * realization, followed by the values of the binary, integer and real variables as contiguous
+   * arrays in the order of the index. Values are written in the native byte order.
+   *
+   * @param cases The cases to pack. The variables of each case must match the index.
+   * @param index The variable index to order the values by.
+   * @param buffer The buffer to write to. Existing content is replaced.
+   */
+  static void Pack(const QList<Case *> &cases, const VariableIndex &index, std::vector<char> &buffer);
+
+  /*!
+   * @brief Create the cases packed in a buffer by Pack.
+   * @param buffer The buffer to read from.
+   * @param index The variable index used when packing the buffer.
+   * @return New Case objects.
+   */
+  static QList<Case *> Unpack(const std::vector<char> &buffer, const VariableIndex &index);
+
   /*!
    * @brief Create a CaseTransferObject representing a Case object.
    * @param c The case to be represented.
@@ -0,0 +1,53 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#include "case_variable_schema.h"
+#include "optimization_exceptions.h"
+
+namespace Optimization {
+
+CaseVariableSchema::CaseVariableSchema(const QList<QUuid> &binary_ids,
+                                       const QList<QUuid> &integer_ids,
+                                       const QList<QUuid> &real_ids)
+    : binary_ids_(binary_ids), integer_ids_(integer_ids), real_ids_(real_ids)
+{
+    binary_indices_ = indices(binary_ids_);
+    integer_indices_ = indices(integer_ids_);
+    real_indices_ = indices(real_ids_);
+}
+
+bool CaseVariableSchema::operator==(const CaseVariableSchema &other) const {
+    return this == &other
+        || (binary_ids_ == other.binary_ids_ && integer_ids_ == other.integer_ids_ && real_ids_ == other.real_ids_);
+}
+
+CaseVariableSchema::Ptr CaseVariableSchema::Empty() {
+    static const Ptr empty = std::make_shared<const CaseVariableSchema>();
+    return empty;
+}
+
+QHash<QUuid, int> CaseVariableSchema::indices(const QList<QUuid> &ids) {
+    QHash<QUuid, int> indices;
+    indices.reserve(ids.size());
+    for (int i = 0; i < ids.size(); ++i) {
+        indices.insert(ids[i], i);
+    }
+    if (indices.size() != ids.size())
+        throw VariableException("Unable to create variable schema: duplicate variable id.");
+    return indices;
+}
+
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#ifndef FIELDOPT_CASE_VARIABLE_SCHEMA_H
+#define FIELDOPT_CASE_VARIABLE_SCHEMA_H
+
+#include <QHash>
+#include <QList>
+#include <QUuid>
+#include <memory>
+
+namespace Optimization {
+
+/*!
+ * @brief The CaseVariableSchema class holds a dense ordering of the binary, integer and real
+ * variables of a Case, along with the position of each variable UUID in it.
+ *
+ * Cases store their variable values in contiguous vectors ordered by a schema. A schema is
+ * immutable once created, and is shared (through a CaseVariableSchema::Ptr) by the case it was
+ * created for and all cases copied from it, so that UUIDs are only mapped to positions once
+ * per run rather than once per case.
+ */
+class CaseVariableSchema {
+ public:
+  typedef std::shared_ptr<const CaseVariableSchema> Ptr;
+
+  CaseVariableSchema() {}
+  CaseVariableSchema(const QList<QUuid> &binary_ids, const QList<QUuid> &integer_ids, const QList<QUuid> &real_ids);
+
+  const QList<QUuid> &binary_ids() const { return binary_ids_; }
+  const QList<QUuid> &integer_ids() const { return integer_ids_; }
+  const QList<QUuid> &real_ids() const { return real_ids_; }
+
+  int binary_index(const QUuid &id) const { return binary_indices_.value(id, -1); } //!< Position of a binary variable, or -1 if it is not in the schema.
+  int integer_index(const QUuid &id) const { return integer_indices_.value(id, -1); } //!< Position of an integer variable, or -1 if it is not in the schema.
+  int real_index(const QUuid &id) const { return real_indices_.value(id, -1); } //!< Position of a real variable, or -1 if it is not in the schema.
+
+  /*!
+   * @brief Check whether two schemas order the same variables in the same way, i.e. whether the
+   * value vectors of cases using them can be compared element by element.
+   */
+  bool operator==(const CaseVariableSchema &other) const;
+  bool operator!=(const CaseVariableSchema &other) const { return !(*this == other); }
+
+  /*!
+   * @brief Get an empty schema, shared by all cases without variables.
+   */
+  static Ptr Empty();
+
+ private:
+  QList<QUuid> binary_ids_;
+  QList<QUuid> integer_ids_;
+  QList<QUuid> real_ids_;
+  QHash<QUuid, int> binary_indices_;
+  QHash<QUuid, int> integer_indices_;
+  QHash<QUuid, int> real_indices_;
+
+  static QHash<QUuid, int> indices(const QList<QUuid> &ids); //!< Map each id to its position in the list.
+};
+
+}
+
+#endif //FIELDOPT_CASE_VARIABLE_SCHEMA_H
@@ -43,7 +43,7 @@ BhpConstraint::BhpConstraint(Settings::Optimizer::Constraint settings, Model::Pr
 bool BhpConstraint::CaseSatisfiesConstraint(Case *c)
 {
     for (auto var : affected_real_variables_) {
-        double case_value = c->real_variables()[var->id()];
+        double case_value = c->real_variable_value(var->id());
         if (case_value > max_ || case_value < min_)
             return false;
     }
@@ -72,9 +72,9 @@ Eigen::VectorXd BhpConstraint::GetUpperBounds(QList<QUuid> id_vector) const {
 void BhpConstraint::SnapCaseToConstraints(Case *c)
 {
     for (auto var : affected_real_variables_) {
-        if (c->real_variables()[var->id()] > max_)
+        if (c->real_variable_value(var->id()) > max_)
             c->set_real_variable_value(var->id(), max_);
-        else if (c->real_variables()[var->id()] < min_)
+        else if (c->real_variable_value(var->id()) < min_)
             c->set_real_variable_value(var->id(), min_);
     }
 }
@@ -45,7 +45,7 @@ ICVConstraint::ICVConstraint(Settings::Optimizer::Constraint settings,
 
 bool ICVConstraint::CaseSatisfiesConstraint(Optimization::Case *c) {
     for (auto id : affected_variables_) {
-        if (c->real_variables()[id] > max_ || c->real_variables()[id] < min_) {
+        if (c->real_variable_value(id) > max_ || c->real_variable_value(id) < min_) {
             return false;
         }
     }
@@ -59,11 +59,11 @@ void ICVConstraint::SnapCaseToConstraints(Optimization::Case *c) {
             );
     }
     for (auto id : affected_variables_) {
-        if (c->real_variables()[id] > max_) {
+        if (c->real_variable_value(id) > max_) {
             c->set_real_variable_value(id, max_);
             if (VERB_OPT >= 1) { Printer::ext_info("Snapped value to upper bound.", "Optimization", "ICVConstraint"); }
         }
-        else if (c->real_variables()[id] < min_) {
+        else if (c->real_variable_value(id) < min_) {
             c->set_real_variable_value(id, min_);
             if (VERB_OPT >= 1) { Printer::ext_info("Snapped value to lower bound.", "Optimization", "ICVConstraint"); }
         }
@@ -47,7 +47,7 @@ string PackerConstraint::name() {
 
 bool PackerConstraint::CaseSatisfiesConstraint(Optimization::Case *c) {
     for (auto id : affected_variables_) {
-        if (c->real_variables()[id] > 1.0 || c->real_variables()[id] < 0.0) {
+        if (c->real_variable_value(id) > 1.0 || c->real_variable_value(id) < 0.0) {
             return false;
         }
     }
@@ -56,13 +56,13 @@ bool PackerConstraint::CaseSatisfiesConstraint(Optimization::Case *c) {
 void PackerConstraint::SnapCaseToConstraints(Optimization::Case *c) {
     // Snap to upper/lower bounds
     for (auto id : affected_variables_) {
-        if (c->real_variables()[id] > 1.0) {
+        if (c->real_variable_value(id) > 1.0) {
             c->set_real_variable_value(id, 1.0);
             if (verbosity_level_ > 1) {
                 if (VERB_OPT >= 1) Printer::ext_info("Snapped value to upper bound.", "Optimization", "PackerConstraint");
             }
         }
-        else if (c->real_variables()[id] < 0.0) {
+        else if (c->real_variable_value(id) < 0.0) {
             c->set_real_variable_value(id, 0.0);
             if (verbosity_level_ > 1) {
                 if (VERB_OPT >= 1) Printer::ext_info("Snapped value to lower bound.", "Optimization", "PackerConstraint");
@@ -71,8 +71,8 @@ void PackerConstraint::SnapCaseToConstraints(Optimization::Case *c) {
     }
     // Enforce packer-ordering
     for (int i = 1; i < affected_variables_.size(); ++i) {
-        if (c->real_variables()[affected_variables_[i]] < c->real_variables()[affected_variables_[i-1]]) {
-            c->set_real_variable_value(affected_variables_[i], c->real_variables()[affected_variables_[i-1]]);
+        if (c->real_variable_value(affected_variables_[i]) < c->real_variable_value(affected_variables_[i-1])) {
+            c->set_real_variable_value(affected_variables_[i], c->real_variable_value(affected_variables_[i-1]));
             if (VERB_OPT >= 1) Printer::ext_info("Enforced packer-ordering.", "Optimization", "PackerConstraint");
         }
     }
@@ -38,8 +38,8 @@ PolarAzimuth::PolarAzimuth(Settings::Optimizer::Constraint settings,
 }
 
 bool PolarAzimuth::CaseSatisfiesConstraint(Optimization::Case *c) {
-  if (c->real_variables()[affected_variable_] <= max_azimuth_
-    && c->real_variables()[affected_variable_] >= min_azimuth_){
+  if (c->real_variable_value(affected_variable_) <= max_azimuth_
+    && c->real_variable_value(affected_variable_) >= min_azimuth_){
     return true;
   } else {
     return false;
@@ -47,9 +47,9 @@ bool PolarAzimuth::CaseSatisfiesConstraint(Optimization::Case *c) {
 }
 
 void PolarAzimuth::SnapCaseToConstraints(Optimization::Case *c) {
-  if (c->real_variables()[affected_variable_] >= max_azimuth_){
+  if (c->real_variable_value(affected_variable_) >= max_azimuth_){
     c->set_real_variable_value(affected_variable_, max_azimuth_);
-  } else if (c->real_variables()[affected_variable_] <= min_azimuth_) {
+  } else if (c->real_variable_value(affected_variable_) <= min_azimuth_) {
     c->set_real_variable_value(affected_variable_, min_azimuth_);
   }
 }
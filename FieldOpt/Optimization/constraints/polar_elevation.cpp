@@ -37,8 +37,8 @@ PolarElevation::PolarElevation(Settings::Optimizer::Constraint settings,
 }
 
 bool PolarElevation::CaseSatisfiesConstraint(Optimization::Case *c) {
-  if (c->real_variables()[affected_variable_] <= max_elevation_
-      && c->real_variables()[affected_variable_] >= min_elevation_){
+  if (c->real_variable_value(affected_variable_) <= max_elevation_
+      && c->real_variable_value(affected_variable_) >= min_elevation_){
     return true;
   } else {
     return false;
@@ -46,9 +46,9 @@ bool PolarElevation::CaseSatisfiesConstraint(Optimization::Case *c) {
 }
 
 void PolarElevation::SnapCaseToConstraints(Optimization::Case *c) {
-  if (c->real_variables()[affected_variable_] >= max_elevation_){
+  if (c->real_variable_value(affected_variable_) >= max_elevation_){
     c->set_real_variable_value(affected_variable_, max_elevation_);
-  } else if (c->real_variables()[affected_variable_] <= min_elevation_) {
+  } else if (c->real_variable_value(affected_variable_) <= min_elevation_) {
     c->set_real_variable_value(affected_variable_, min_elevation_);
   }
 }
@@ -27,9 +27,9 @@ PolarSplineBoundary::PolarSplineBoundary(const Settings::Optimizer::Constraint &
                                          Reservoir::Grid::Grid *grid)
                                          : ReservoirBoundary(settings, variables, grid){}
 bool PolarSplineBoundary::CaseSatisfiesConstraint(Case *c) {
-  double midpoint_x_val = c->real_variables()[affected_well_.midpoint.x];
-  double midpoint_y_val = c->real_variables()[affected_well_.midpoint.y];
-  double midpoint_z_val = c->real_variables()[affected_well_.midpoint.z];
+  double midpoint_x_val = c->real_variable_value(affected_well_.midpoint.x);
+  double midpoint_y_val = c->real_variable_value(affected_well_.midpoint.y);
+  double midpoint_z_val = c->real_variable_value(affected_well_.midpoint.z);
   
   bool midpoint_feasible = false;
 
@@ -44,9 +44,9 @@ bool PolarSplineBoundary::CaseSatisfiesConstraint(Case *c) {
 }
 void PolarSplineBoundary::SnapCaseToConstraints(Case *c) {
 
-  double midpoint_x_val = c->real_variables()[affected_well_.midpoint.x];
-  double midpoint_y_val = c->real_variables()[affected_well_.midpoint.y];
-  double midpoint_z_val = c->real_variables()[affected_well_.midpoint.z];
+  double midpoint_x_val = c->real_variable_value(affected_well_.midpoint.x);
+  double midpoint_y_val = c->real_variable_value(affected_well_.midpoint.y);
+  double midpoint_z_val = c->real_variable_value(affected_well_.midpoint.z);
   
   Eigen::Vector3d projected_midpoint =
       WellConstraintProjections::well_domain_constraint_indices(
@@ -38,17 +38,17 @@ PolarWellLength::PolarWellLength(Settings::Optimizer::Constraint settings,
 }
 
 bool PolarWellLength::CaseSatisfiesConstraint(Case *c) {
-  if (c->real_variables()[affected_variable_] <= maximum_length_
-  && c->real_variables()[affected_variable_] >= minimum_length_){
+  if (c->real_variable_value(affected_variable_) <= maximum_length_
+  && c->real_variable_value(affected_variable_) >= minimum_length_){
     return true;
   } else {
     return false;
   }
 }
 void PolarWellLength::SnapCaseToConstraints(Case *c) {
-  if (c->real_variables()[affected_variable_] > maximum_length_){
+  if (c->real_variable_value(affected_variable_) > maximum_length_){
     c->set_real_variable_value(affected_variable_, maximum_length_);
-  } else if (c-> real_variables()[affected_variable_] < minimum_length_){
+  } else if (c->real_variable_value(affected_variable_) < minimum_length_){
     c->set_real_variable_value(affected_variable_, minimum_length_);
   }
 }
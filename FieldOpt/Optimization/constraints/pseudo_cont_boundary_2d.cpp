@@ -65,21 +65,21 @@ PseudoContBoundary2D::PseudoContBoundary2D(const Settings::Optimizer::Constraint
     }
 }
 bool PseudoContBoundary2D::CaseSatisfiesConstraint(Case *c) {
-    if (c->real_variables()[affected_x_var_id_] < x_min_
-        || c->real_variables()[affected_x_var_id_] > x_max_
-        || c->real_variables()[affected_y_var_id_] < y_min_
-        || c->real_variables()[affected_y_var_id_] > y_max_)
+    if (c->real_variable_value(affected_x_var_id_) < x_min_
+        || c->real_variable_value(affected_x_var_id_) > x_max_
+        || c->real_variable_value(affected_y_var_id_) < y_min_
+        || c->real_variable_value(affected_y_var_id_) > y_max_)
         return false;
     else return true;
 }
 void PseudoContBoundary2D::SnapCaseToConstraints(Case *c) {
-    if (c->real_variables()[affected_x_var_id_] < x_min_)
+    if (c->real_variable_value(affected_x_var_id_) < x_min_)
         c->set_real_variable_value(affected_x_var_id_, x_min_);
-    else if (c->real_variables()[affected_x_var_id_] > x_max_)
+    else if (c->real_variable_value(affected_x_var_id_) > x_max_)
         c->set_real_variable_value(affected_x_var_id_, x_max_);
-    else if (c->real_variables()[affected_y_var_id_] < y_min_)
+    else if (c->real_variable_value(affected_y_var_id_) < y_min_)
         c->set_real_variable_value(affected_y_var_id_, y_min_);
-    else if (c->real_variables()[affected_y_var_id_] > y_max_)
+    else if (c->real_variable_value(affected_y_var_id_) > y_max_)
         c->set_real_variable_value(affected_y_var_id_, y_max_);
 }
 bool PseudoContBoundary2D::IsBoundConstraint() const {
@@ -18,7 +18,7 @@ namespace Optimization {
 
         bool RateConstraint::CaseSatisfiesConstraint(Case *c) {
             for (auto var : affected_real_variables_) {
-                double case_value = c->real_variables()[var->id()];
+                double case_value = c->real_variable_value(var->id());
                 if (case_value > max_ || case_value < min_)
                     return false;
             }
@@ -27,9 +27,9 @@ namespace Optimization {
 
         void RateConstraint::SnapCaseToConstraints(Case *c) {
             for (auto var : affected_real_variables_) {
-                if (c->real_variables()[var->id()] > max_)
+                if (c->real_variable_value(var->id()) > max_)
                     c->set_real_variable_value(var->id(), max_);
-                else if (c->real_variables()[var->id()] < min_)
+                else if (c->real_variable_value(var->id()) < min_)
                     c->set_real_variable_value(var->id(), min_);
             }
         }
@@ -325,13 +325,13 @@ QList<int> ReservoirBoundary::getIndicesOfEdgeCells() {
 
 bool ReservoirBoundary::CaseSatisfiesConstraint(Case *c) {
 
-    double heel_x_val = c->real_variables()[affected_well_.heel.x];
-    double heel_y_val = c->real_variables()[affected_well_.heel.y];
-    double heel_z_val = c->real_variables()[affected_well_.heel.z];
+    double heel_x_val = c->real_variable_value(affected_well_.heel.x);
+    double heel_y_val = c->real_variable_value(affected_well_.heel.y);
+    double heel_z_val = c->real_variable_value(affected_well_.heel.z);
 
-    double toe_x_val = c->real_variables()[affected_well_.toe.x];
-    double toe_y_val = c->real_variables()[affected_well_.toe.y];
-    double toe_z_val = c->real_variables()[affected_well_.toe.z];
+    double toe_x_val = c->real_variable_value(affected_well_.toe.x);
+    double toe_y_val = c->real_variable_value(affected_well_.toe.y);
+    double toe_z_val = c->real_variable_value(affected_well_.toe.z);
 
     bool heel_feasible = false;
     bool toe_feasible = false;
@@ -352,13 +352,13 @@ bool ReservoirBoundary::CaseSatisfiesConstraint(Case *c) {
 
 void ReservoirBoundary::SnapCaseToConstraints(Case *c) {
 
-    double heel_x_val = c->real_variables()[affected_well_.heel.x];
-    double heel_y_val = c->real_variables()[affected_well_.heel.y];
-    double heel_z_val = c->real_variables()[affected_well_.heel.z];
+    double heel_x_val = c->real_variable_value(affected_well_.heel.x);
+    double heel_y_val = c->real_variable_value(affected_well_.heel.y);
+    double heel_z_val = c->real_variable_value(affected_well_.heel.z);
 
-    double toe_x_val = c->real_variables()[affected_well_.toe.x];
-    double toe_y_val = c->real_variables()[affected_well_.toe.y];
-    double toe_z_val = c->real_variables()[affected_well_.toe.z];
+    double toe_x_val = c->real_variable_value(affected_well_.toe.x);
+    double toe_y_val = c->real_variable_value(affected_well_.toe.y);
+    double toe_z_val = c->real_variable_value(affected_well_.toe.z);
 
     Eigen::Vector3d projected_heel =
         WellConstraintProjections::well_domain_constraint_indices(
@@ -45,13 +45,13 @@ ReservoirXYZBoundary::ReservoirXYZBoundary(const Settings::Optimizer::Constraint
 
 bool ReservoirXYZBoundary::CaseSatisfiesConstraint(Case *c) {
 
-  double heel_x_val = c->real_variables()[affected_well_.heel.x];
-  double heel_y_val = c->real_variables()[affected_well_.heel.y];
-  double heel_z_val = c->real_variables()[affected_well_.heel.z];
+  double heel_x_val = c->real_variable_value(affected_well_.heel.x);
+  double heel_y_val = c->real_variable_value(affected_well_.heel.y);
+  double heel_z_val = c->real_variable_value(affected_well_.heel.z);
 
-  double toe_x_val = c->real_variables()[affected_well_.toe.x];
-  double toe_y_val = c->real_variables()[affected_well_.toe.y];
-  double toe_z_val = c->real_variables()[affected_well_.toe.z];
+  double toe_x_val = c->real_variable_value(affected_well_.toe.x);
+  double toe_y_val = c->real_variable_value(affected_well_.toe.y);
+  double toe_z_val = c->real_variable_value(affected_well_.toe.z);
 
   bool heel_feasible = false;
   bool toe_feasible = false;
@@ -72,13 +72,13 @@ bool ReservoirXYZBoundary::CaseSatisfiesConstraint(Case *c) {
 
 void ReservoirXYZBoundary::SnapCaseToConstraints(Case *c) {
 
-  double heel_x_val = c->real_variables()[affected_well_.heel.x];
-  double heel_y_val = c->real_variables()[affected_well_.heel.y];
-  double heel_z_val = c->real_variables()[affected_well_.heel.z];
+  double heel_x_val = c->real_variable_value(affected_well_.heel.x);
+  double heel_y_val = c->real_variable_value(affected_well_.heel.y);
+  double heel_z_val = c->real_variable_value(affected_well_.heel.z);
 
-  double toe_x_val = c->real_variables()[affected_well_.toe.x];
-  double toe_y_val = c->real_variables()[affected_well_.toe.y];
-  double toe_z_val = c->real_variables()[affected_well_.toe.z];
+  double toe_x_val = c->real_variable_value(affected_well_.toe.x);
+  double toe_y_val = c->real_variable_value(affected_well_.toe.y);
+  double toe_z_val = c->real_variable_value(affected_well_.toe.z);
 
   Eigen::Vector3d projected_heel =
       WellConstraintProjections::well_domain_constraint_indices(
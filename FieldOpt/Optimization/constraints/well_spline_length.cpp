@@ -42,13 +42,13 @@ WellSplineLength::WellSplineLength(Settings::Optimizer::Constraint settings,
 
 bool WellSplineLength::CaseSatisfiesConstraint(Case *c)
 {
-    double heel_x_val = c->real_variables()[affected_well_.heel.x];
-    double heel_y_val = c->real_variables()[affected_well_.heel.y];
-    double heel_z_val = c->real_variables()[affected_well_.heel.z];
+    double heel_x_val = c->real_variable_value(affected_well_.heel.x);
+    double heel_y_val = c->real_variable_value(affected_well_.heel.y);
+    double heel_z_val = c->real_variable_value(affected_well_.heel.z);
 
-    double toe_x_val = c->real_variables()[affected_well_.toe.x];
-    double toe_y_val = c->real_variables()[affected_well_.toe.y];
-    double toe_z_val = c->real_variables()[affected_well_.toe.z];
+    double toe_x_val = c->real_variable_value(affected_well_.toe.x);
+    double toe_y_val = c->real_variable_value(affected_well_.toe.y);
+    double toe_z_val = c->real_variable_value(affected_well_.toe.z);
 
     Eigen::Vector3d heel_vals;
     Eigen::Vector3d toe_vals;
@@ -65,13 +65,13 @@ bool WellSplineLength::CaseSatisfiesConstraint(Case *c)
 
 void WellSplineLength::SnapCaseToConstraints(Case *c)
 {
-    double heel_x_val = c->real_variables()[affected_well_.heel.x];
-    double heel_y_val = c->real_variables()[affected_well_.heel.y];
-    double heel_z_val = c->real_variables()[affected_well_.heel.z];
+    double heel_x_val = c->real_variable_value(affected_well_.heel.x);
+    double heel_y_val = c->real_variable_value(affected_well_.heel.y);
+    double heel_z_val = c->real_variable_value(affected_well_.heel.z);
 
-    double toe_x_val = c->real_variables()[affected_well_.toe.x];
-    double toe_y_val = c->real_variables()[affected_well_.toe.y];
-    double toe_z_val = c->real_variables()[affected_well_.toe.z];
+    double toe_x_val = c->real_variable_value(affected_well_.toe.x);
+    double toe_y_val = c->real_variable_value(affected_well_.toe.y);
+    double toe_z_val = c->real_variable_value(affected_well_.toe.z);
 
     Eigen::Vector3d heel_vals;
     Eigen::Vector3d toe_vals;
@@ -80,7 +80,7 @@ NPV::NPV(Settings::Optimizer *settings,
 double NPV::value() const {
   try {
   double value = 0;
-  auto report_times = results_->GetValueVector(results_->Time);
+  const auto &report_times = results_->GetValueVector(results_->Time);
   auto NPV_times = new QList<int>;
   auto NPV_report_times = new QList<int>;
   auto discount_factor_list = new QList<double>;
@@ -126,9 +126,10 @@ double NPV::value() const {
           continue;
       }
       if (components_->at(comp_index)->usediscountfactor == true) {
+        const auto &values = components_->at(comp_index)->resolveValueVector(results_);
         for (int NPV_report_index = 1, discount_index = 0; NPV_report_index < NPV_report_times->size(); ++NPV_report_index, ++discount_index) {
-          auto prod_difference = components_->at(comp_index)->resolveValueDiscount(results_, NPV_report_times->at(NPV_report_index))
-              - components_->at(comp_index)->resolveValueDiscount(results_, NPV_report_times->at(NPV_report_index - 1));
+          auto prod_difference = values.at(NPV_report_times->at(NPV_report_index))
+              - values.at(NPV_report_times->at(NPV_report_index - 1));
           value += prod_difference * components_->at(comp_index)->coefficient * discount_factor_list->at(discount_index);
         }
       } else if (components_->at(comp_index)->usediscountfactor == false) {
@@ -172,12 +173,12 @@ double NPV::Component::resolveValue(Simulation::Results::Results *results) const
   return coefficient * results->GetValue(property);
 
 }
-double NPV::Component::resolveValueDiscount(Simulation::Results::Results *results, int time_step) const {
-    if (is_well_property){
-        return results->GetValue(property, well, time_step);
+const std::vector<double> &NPV::Component::resolveValueVector(Simulation::Results::Results *results) const {
+    if (is_well_property) {
+        return results->GetValueVector(property, well);
     }
-    else{
-        return results->GetValue(property,time_step);
+    else {
+        return results->GetValueVector(property);
     }
 }
 
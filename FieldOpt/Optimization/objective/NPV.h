@@ -53,7 +53,7 @@ class NPV : public Objective {
     Simulation::Results::Results::Property property;
     QString well;
     double resolveValue(Simulation::Results::Results *results) const;
-    double resolveValueDiscount(Simulation::Results::Results *results, int time_step) const;
+    const std::vector<double> &resolveValueVector(Simulation::Results::Results *results) const; //!< Get the (cached) vector of values for the component's property.
     double yearlyToMonthly(double discount_factor);
     std::string interval;
     double discount;
@@ -230,6 +230,7 @@ map<string, vector<double>> Optimizer::Summary::GetValues() {
     valmap["invalid"] = vector<double>{opt_->case_handler_->NumberInvalid()};
     valmap["failed"] = vector<double>{opt_->case_handler_->NumberFailed()};
     valmap["timed out"] = vector<double>{opt_->case_handler_->NumberTimeout()};
+    valmap["terminated early"] = vector<double>{opt_->case_handler_->NumberTerminated()};
     valmap["bookkeeped"] = vector<double>{opt_->case_handler_->NumberBookkeeped()};
     return valmap;
 }
@@ -47,6 +47,7 @@ class Optimizer : public Loggable
 
  public:
   Optimizer() = delete;
+  virtual ~Optimizer() {}
 
   /*!
    * \brief GetCaseForEvaluation Get a new, unevaluated case for evaluation.
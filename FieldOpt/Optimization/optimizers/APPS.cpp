@@ -42,7 +42,6 @@ APPS::APPS(Settings::Optimizer *settings,
 
 
     assert(settings->parameters().max_queue_size >= 1.0);
-    max_queue_length_ = directions_.size() * settings->parameters().max_queue_size;
     is_async_ = true;
     if (enable_logging_) {
         logger_->AddEntry(this);
@@ -119,15 +118,11 @@ void APPS::prune_queue() {
     if (case_handler_->QueuedCases().size() <= max_queue_length_ - directions_.size()) {
         return;
     }
-    else {
-        int queue_size = max_queue_length_ - directions_.size();
-        if (evaluated_cases_ >= max_evaluations_) queue_size = 1;
-        while (case_handler_->QueuedCases().size() > queue_size) {
-            auto dequeued_case = dequeue_case_with_worst_origin();
-            if (dequeued_case->origin_case()->id() == GetTentativeBestCase()->id())
-                set_inactive(vector<int>{dequeued_case->origin_direction_index()});
-        }
-        return;
+    int queue_size = max_queue_length_ - directions_.size();
+    if (evaluated_cases_ >= max_evaluations_) queue_size = 1;
+    for (Case *dequeued_case : GSS::prune_queue(queue_size)) {
+        if (dequeued_case->origin_case()->id() == GetTentativeBestCase()->id())
+            set_inactive(vector<int>{dequeued_case->origin_direction_index()});
     }
 }
 
@@ -44,7 +44,6 @@ namespace Optimization {
             void iterate() override;
 
         private:
-            int max_queue_length_; //!< Maximum length of queue.
             set<int> active_; //!< Set containing the indices of all active search directions.
             void set_active(vector<int> dirs); //!< Mark the direction indices in the vector as active.
             void set_inactive(vector<int> dirs); //!< Mark the direction indices in the vector as inactive.
@@ -70,7 +69,8 @@ namespace Optimization {
             void unsuccessful_iteration(Case *c);
 
             /*!
-             * @brief Prune the evaluation queue to max_queue_length_.
+             * @brief Prune the evaluation queue to max_queue_length_ (see GSS::prune_queue), and mark
+             * the directions of the removed trial points from the tentative best case as inactive.
              */
             void prune_queue();
 
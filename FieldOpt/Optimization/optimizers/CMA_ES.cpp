@@ -24,6 +24,7 @@
 #include "Utilities/stringhelpers.hpp"
 #include "Settings/optimizer.h"
 #include <math.h>
+#include <numeric>
 #include <random>
 
 namespace Optimization {
@@ -76,24 +77,14 @@ CMA_ES::CMA_ES(Settings::Optimizer *settings,
         lambda_ = 4 + floor(3 * log(n_vars_));
     }
     mu_ = lambda_ / 2;
-    for (int i = 1; i <= mu_; i++) {
-        weights_.push_back(log(mu_ + 0.5) - log(i));
+    weights_.resize(int(floor(mu_)));
+    for (int i = 1; i <= weights_.size(); i++) {
+        weights_(i - 1) = log(mu_ + 0.5) - log(i);
     }
     mu_ = floor(mu_);
-    double sum_of_weights = 0;
-    for (int i = 0; i < weights_.size(); i++) {
-        sum_of_weights += weights_[i];
-    }
-
-    for (int i = 0; i < weights_.size(); i++) {
-        weights_[i] = weights_[i] / sum_of_weights;
-    }
-    double temp_sum_of_weights = 0;
-    double temp_sum_of_variance_of_weights = 0;
-    for (int i = 0; i < weights_.size(); i++) {
-        temp_sum_of_weights += weights_[i];
-        temp_sum_of_variance_of_weights += pow(weights_[i], 2);
-    }
+    weights_ /= weights_.sum();
+    double temp_sum_of_weights = weights_.sum();
+    double temp_sum_of_variance_of_weights = weights_.squaredNorm();
 
     mueff_ = temp_sum_of_weights / temp_sum_of_variance_of_weights;
     //Strategy parameter setting: Adaptation
@@ -128,9 +119,21 @@ CMA_ES::CMA_ES(Settings::Optimizer *settings,
     }
     invsqrtC_ = B_ * (temp_D).asDiagonal() * B_.transpose();
     eigeneval_ = 0;
+    eigen_iteration_ = 0;
+    eigen_interval_ = settings->parameters().cma_es_eigen_interval;
+    es_ = SelfAdjointEigenSolver<MatrixXd>(n_vars_);
     chiN_ = pow(n_vars_, 0.5) * (1 - (float(1) / (4 * n_vars_)) + 1 / (21 * pow(n_vars_, 2)));
+
+    // Buffers reused in every generation
+    xold_ = Eigen::VectorXd::Zero(n_vars_);
+    mean_step_ = Eigen::VectorXd::Zero(n_vars_);
+    sample_ = Eigen::VectorXd::Zero(n_vars_);
+    artmp_ = Eigen::MatrixXd::Zero(n_vars_, int(mu_));
+    population_.resize(int(lambda_));
+    temp_population_.resize(int(lambda_));
+    ranking_.resize(int(lambda_));
     for (int i = 0; i < lambda_; ++i) {
-        auto new_case = generateCase(xmean_, i, 1);
+        auto new_case = generateCase(xmean_, i, population_[i]);
         case_handler_->AddNewCase(new_case);
     }
 }
@@ -144,29 +147,14 @@ CMA_ES::Individual::Individual(Optimization::Case *c, boost::random::mt19937 &ge
     penalty_dist_ = penalty_dist;
 }
 
-vector<CMA_ES::Individual> CMA_ES::sortPopulation(vector<CMA_ES::Individual> population) {
-    vector<CMA_ES::Individual> sortedPopulation;
-    int n = population_.size();
-    bool swapped = true;
-    while (swapped) {
-        swapped = false;
-        for (int i = 1; i <= n - 1; i++) {
-            if (population[i - 1].ofv() > population[i].ofv() &&
-                (Settings::Optimizer::Minimize == settings_->mode())) {
-                CMA_ES::Individual temp_individual = population[i];
-                population[i] = population[i - 1];
-                population[i - 1] = temp_individual;
-                swapped = true;
-            } else if (population[i - 1].ofv() < population[i].ofv() &&
-                       (Settings::Optimizer::Maximize == settings_->mode())) {
-                CMA_ES::Individual temp_individual = population[i];
-                population[i] = population[i - 1];
-                population[i - 1] = temp_individual;
-                swapped = true;
-            }
-        }
-    }
-    return population;
+void CMA_ES::sortPopulation() {
+    ranking_.resize(population_.size());
+    std::iota(ranking_.begin(), ranking_.end(), 0);
+    bool minimize = Settings::Optimizer::Minimize == settings_->mode();
+    std::stable_sort(ranking_.begin(), ranking_.end(), [this, minimize](int i, int j) {
+        return minimize ? population_[i].ofv() < population_[j].ofv()
+                        : population_[i].ofv() > population_[j].ofv();
+    });
 }
 
 void CMA_ES::iterate() {
@@ -182,25 +170,21 @@ void CMA_ES::iterate() {
                     population_[i].ofv() - (exp(penalty_ * population_[i].penalty_dist_) - 1));
         }
     }
-    population_ = sortPopulation(population_);
+    sortPopulation();
     xold_ = xmean_;
-    xmean_ = Eigen::VectorXd::Zero(xmean_.size());
-    for (int i = 0; i < n_vars_; i++) {
-        double temp = 0;
-        for (int j = 0; j < mu_; j++) {
-            temp += population_[j].erands_norm_[i] * weights_[j];
-        }
-        xmean_(i) = temp;
+    for (int j = 0; j < mu_; j++) {
+        artmp_.col(j) = population_[ranking_[j]].erands_norm_;
     }
+    xmean_.noalias() = artmp_ * weights_;
     updateEvolutionPath();
     adaptCovarianceMatrix();
     decompositionOfC();
 
     for (int i = 0; i < lambda_; ++i) {
-        auto new_case = generateCase(xmean_, i, 0);
+        auto new_case = generateCase(xmean_, i, temp_population_[i]);
         case_handler_->AddNewCase(new_case);
     }
-    population_ = temp_population_;
+    population_.swap(temp_population_);
     iteration_++;
 }
 
@@ -225,107 +209,76 @@ Optimizer::TerminationCondition CMA_ES::IsFinished() {
 }
 
 void CMA_ES::updateEvolutionPath() {
-    ps_ = (1.0 - cs_) * ps_ + sqrt(cs_ * (2.0 - cs_) * mueff_) * invsqrtC_ * (xmean_ - xold_) / sigma_;
-    hsig_ = ps_.norm() / sqrt(1.0 - pow((1.0 - cs_), 2.0 * case_handler_->EvaluatedCases().size() / lambda_)) /
+    mean_step_ = (xmean_ - xold_) / sigma_;
+    ps_ *= 1.0 - cs_;
+    ps_.noalias() += sqrt(cs_ * (2.0 - cs_) * mueff_) * invsqrtC_ * mean_step_;
+    hsig_ = ps_.norm() / sqrt(1.0 - pow((1.0 - cs_), 2.0 * evaluated_cases_ / lambda_)) /
             chiN_ < 1.4 + 2.0 / (n_vars_ + 1);
-    pc_ = (1.0 - cc_) * pc_ + hsig_ * sqrt(cc_ * (2.0 - cc_) * mueff_) * (xmean_ - xold_) / sigma_;
+    pc_ *= 1.0 - cc_;
+    pc_ += hsig_ * sqrt(cc_ * (2.0 - cc_) * mueff_) * mean_step_;
 }
 
 void CMA_ES::adaptCovarianceMatrix() {
-    Eigen::MatrixXd argument_matrix(n_vars_, int(mu_));
-    for (int i = 0; i < n_vars_; i++) {
-        double temp = 0;
-        for (int j = 0; j < mu_; j++) {
-            argument_matrix(i, j) = population_[j].erands_norm_[i];
-        }
-    }
-    Eigen::VectorXd temp_weights(weights_.size());
-    for (int i = 0; i < weights_.size(); i++) {
-        temp_weights(i) = weights_[i];
+    // artmp_ holds the mu best individuals; turn them into steps from the old mean, weighted so
+    // that artmp_ * artmp_^T is the weighted sum of their outer products.
+    artmp_.colwise() -= xold_;
+    artmp_ /= sigma_;
+    for (int j = 0; j < mu_; j++) {
+        artmp_.col(j) *= sqrt(weights_(j));
     }
-    auto artmp = (1 / sigma_) * (argument_matrix - xold_.replicate(1, int(mu_)));
-    C_ = (1 - c1_ - cmu_) * C_ + c1_ * (pc_ * pc_.transpose() + (1 - hsig_) * cc_ * (2 - cc_) * C_) +
-         cmu_ * artmp * temp_weights.asDiagonal() * artmp.transpose();
+    C_ *= 1 - c1_ - cmu_ + c1_ * (1 - hsig_) * cc_ * (2 - cc_);
+    C_.selfadjointView<Lower>().rankUpdate(pc_, c1_); // Rank-one update
+    C_.selfadjointView<Lower>().rankUpdate(artmp_, cmu_); // Rank-mu update
     sigma_ = sigma_ * exp((cs_ / damps_) * (ps_.norm() / chiN_ - 1));
 }
 
 void CMA_ES::decompositionOfC() {
-    if (case_handler_->EvaluatedCases().size() - eigeneval_ > lambda_ / (c1_ + cmu_) / n_vars_ / 10.0) {
-        eigeneval_ = case_handler_->EvaluatedCases().size();
-        const IOFormat fmt(10, DontAlignCols, "\t", " ", "\n", "", "", "");
-        Eigen::MatrixXd Cupper = Eigen::MatrixXd::Zero(n_vars_, n_vars_);
-        for (int i = 0; i < n_vars_; i++) {
-            for (int j = i; j < n_vars_; j++) {
-                Cupper(i, j) = C_(i, j);
-            }
-        }
-        Eigen::MatrixXd Cupperest = Eigen::MatrixXd::Zero(n_vars_, n_vars_);
-        for (int i = 0; i < n_vars_; i++) {
-            for (int j = i + 1; j < n_vars_; j++) {
-                Cupperest(i, j) = C_(i, j);
-            }
-        }
-        C_ = Cupper + Cupperest.transpose();
-
-        es_.compute(C_);
-        D_ = es_.eigenvalues().real();
-        B_ = es_.eigenvectors().real();
-
-        VectorXd D_diag_sqrt;
-        D_diag_sqrt.resize(D_.size());
-        for (int i = 0; i < D_.size(); i++) {
-            D_diag_sqrt(i) = sqrt(D_(i));
-        }
-
-        VectorXd D_diag_inverse;
-        D_diag_inverse.resize(D_.size());
-        for (int i = 0; i < D_.size(); i++) {
-            D_diag_inverse(i) = 1. / D_(i);
-        }
-
-        D_ = D_diag_sqrt;
-        invsqrtC_ = B_ * D_diag_inverse.asDiagonal() * B_.transpose();
+    bool is_due;
+    if (eigen_interval_ > 0) {
+        is_due = iteration_ + 1 - eigen_iteration_ >= eigen_interval_;
+    } else {
+        is_due = evaluated_cases_ - eigeneval_ > lambda_ / (c1_ + cmu_) / n_vars_ / 10.0;
+    }
+    if (is_due) {
+        eigeneval_ = evaluated_cases_;
+        eigen_iteration_ = iteration_ + 1;
+
+        es_.compute(C_); // Only reads the lower triangle
+        B_ = es_.eigenvectors();
+        D_ = es_.eigenvalues().cwiseMax(0.0).cwiseSqrt();
+        invsqrtC_.noalias() = B_ * D_.cwiseInverse().asDiagonal() * B_.transpose();
     }
 }
 
-Case *CMA_ES::generateCase(Eigen::VectorXd xmean, int index, bool first_iteration) {
+Case *CMA_ES::generateCase(const Eigen::VectorXd &xmean, int index, Individual &individual) {
     Case *new_case;
     new_case = new Case(GetTentativeBestCase());
 
-    Eigen::VectorXd xmeanNormal(n_vars_);
-    Eigen::VectorXd erands_norm(n_vars_);
-    Eigen::VectorXd erands(n_vars_);
+    Eigen::VectorXd &erands_norm = individual.erands_norm_;
+    Eigen::VectorXd &erands = individual.rea_vars_;
+    erands_norm.resize(n_vars_);
+    erands.resize(n_vars_);
     double penalty_dist = 0;
     for (int i = 0; i < n_vars_; ++i) {
-        xmeanNormal(i) = random_normal_distribution(gen_, 0, 1, 1);
+        sample_(i) = D_(i) * random_normal_distribution(gen_, 0, 1, 1);
     }
-    const IOFormat fmt(1, DontAlignCols, "\t", " ", "", "", "", "");
+    erands_norm = xmean;
+    erands_norm.noalias() += sigma_ * B_ * sample_;
     for (int i = 0; i < n_vars_; ++i) {
-        erands_norm(i) = xmean(i) + sigma_ * B_(i, i) * (D_(i) * xmeanNormal(i));
         if (erands_norm(i) > 1.0) {
             penalty_dist += abs(erands_norm(i) - 1.0);
         } else if (erands_norm(i) < 0.0) {
             penalty_dist += abs(erands_norm(i));
-        } else {
-            penalty_dist += 0;
         }
         erands(i) = lower_bound_(i) + erands_norm(i) * (upper_bound_(i) - lower_bound_(i));
-        //if (erands(i) < lower_bound_(i)) {
-        //    erands(i) = lower_bound_(i);
-        //} else if (erands(i) > upper_bound_(i)) {
-        //    erands(i) = upper_bound_(i);
-        //}
     }
     new_case->SetRealVarValues(erands);
     constraint_handler_->CaseSatisfiesConstraints(new_case);
 
-    if (first_iteration) {
-        population_.push_back(Individual(new_case, gen_, index, erands_norm, penalty_dist));
-    } else {
-        temp_population_.push_back(Individual(new_case, gen_, index, erands_norm, penalty_dist));
-    }
+    individual.case_pointer_ = new_case;
+    individual.index_ = index;
+    individual.penalty_dist_ = penalty_dist;
     return new_case;
 }
 }
 }
-
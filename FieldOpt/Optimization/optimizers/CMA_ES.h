@@ -22,6 +22,7 @@
 #define FIELDOPT_CMA_ES_H
 
 #include <boost/random.hpp>
+#include <Eigen/Eigenvalues>
 #include "optimizer.h"
 
 namespace Optimization {
@@ -72,17 +73,19 @@ private:
     Settings::Optimizer *settings_;
     /*!
      * @brief
-     * Generates a set of cases within their given upper and lower bounds, based on the mean (or base case, if utilizied).
+     * Generates a case within the given upper and lower bounds, sampled around the mean (or base case, if utilizied).
+     * The variable values are written into the vectors of the individual, which are reused between generations.
      * @return
      */
-    Case *generateCase(Eigen::VectorXd xmean, int index, bool first_iteration);
+    Case *generateCase(const Eigen::VectorXd &xmean, int index, Individual &individual);
 
     void updateEvolutionPath(); //!< Updated the Evolution Path
     void adaptCovarianceMatrix(); //!< The adaption of Covariance Matrix (the CMA of CMA-ES)
     void decompositionOfC(); //!< Utilizing the Covariance matrix to update the next meanx.
-    vector<Individual> sortPopulation(vector<Individual> population);
+    void sortPopulation(); //!< Rank the population by objective function value into ranking_.
     vector<Individual> population_; //!< The storage vector of the population
-    vector<Individual> temp_population_; //!< Temporary storage for the new generation that will be merged.
+    vector<Individual> temp_population_; //!< Storage for the next generation; swapped with population_ in each iteration.
+    vector<int> ranking_; //!< Indices of the individuals in population_, from best to worst.
     bool improve_base_case_ = false;
     double stagnation_limit_; //!< The stagnation criterion, standard deviation of all particle positions.
     int population_size_ = -1; //!< The number of people in the population
@@ -97,7 +100,7 @@ private:
     double c1_; //!< Learning rate for rank-one update of C
     double cmu_; //!< and for rank-mu update
     double damps_; //!< damping for sigma usually close to 1
-    vector<double> weights_; //!< muXone array for weighted recombination
+    Eigen::VectorXd weights_; //!< muXone array for weighted recombination
     double chiN_; //!< expectation of ||N(0,I)|| == norm(randn(N,1))
     bool hsig_;
     Eigen::VectorXd xmean_; //!< The mean of which the normal distribution is generated around
@@ -106,10 +109,15 @@ private:
     Eigen::VectorXd ps_; //!< evolution paths for C and sigma
     Eigen::VectorXd D_; //!< D defines the scaling
     Eigen::MatrixXd B_; //!< B defines the coordinate system
-    Eigen::MatrixXd C_; //!< Co-variance matrix
+    Eigen::MatrixXd C_; //!< Co-variance matrix. Only the lower triangle is kept up to date.
     Eigen::MatrixXd invsqrtC_; //!< The inverse of the co-variance matrix
-    double eigeneval_;
-    EigenSolver<MatrixXd> es_; //!< The EigenValueSolver from Eigen, which allows us to calculated the eigenvalues and eigenvector.
+    Eigen::MatrixXd artmp_; //!< Steps of the mu best individuals from the old mean (n_vars x mu)
+    Eigen::VectorXd mean_step_; //!< Step of the mean in the last generation, divided by sigma
+    Eigen::VectorXd sample_; //!< Standard normally distributed sample, scaled by D
+    double eigeneval_; //!< Number of evaluated cases at the last eigendecomposition
+    int eigen_iteration_; //!< Iteration of the last eigendecomposition
+    int eigen_interval_; //!< Generations between eigendecompositions (0: determined from the learning rates)
+    SelfAdjointEigenSolver<MatrixXd> es_; //!< The EigenValueSolver from Eigen, which allows us to calculated the eigenvalues and eigenvector.
     Eigen::VectorXd lower_bound_; //!< Lower bounds for the variables (used for generating populations, and maintaining the search space)
     Eigen::VectorXd upper_bound_; //!< Upper bounds for the variables (used for generating populations, and maintaining the search space)
     int n_vars_; //!< Number of variables in the problem.
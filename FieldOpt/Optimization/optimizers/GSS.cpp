@@ -20,6 +20,8 @@
    along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
 ******************************************************************************/
 #include <iostream>
+#include <cmath>
+#include <limits>
 #include "GSS.h"
 #include "Utilities/math.hpp"
 #include "gss_patterns.hpp"
@@ -52,6 +54,10 @@ GSS::GSS(Settings::Optimizer *settings,
     assert(expan_fac_ >= 1.0);
 
     directions_ = GSSPatterns::Compass(num_vars_);
+    max_queue_length_ = directions_.size() * settings->parameters().max_queue_size;
+    speculative_polling_ = settings->parameters().speculative_polling;
+    speculative_expansion_ = settings->parameters().speculative_expansion;
+    direction_values_ = VectorXd::Constant(directions_.size(), std::numeric_limits<double>::quiet_NaN());
 
     if (!settings->parameters().auto_step_lengths) {
         step_lengths_ = Eigen::VectorXd(directions_.size());
@@ -123,19 +129,8 @@ QList<Case *> GSS::generate_trial_points(vector<int> dirs) {
     if (dirs[0] == -1)
         dirs = range(0, (int)directions_.size(), 1);
 
-    VectorXi int_base = GetTentativeBestCase()->GetIntegerVarVector();
-    VectorXd rea_base = GetTentativeBestCase()->GetRealVarVector();
-
     for (int dir : dirs) {
-        auto trial_point = new Case(GetTentativeBestCase());
-        if (int_base.size() > 0) {
-            trial_point->SetIntegerVarValues(perturb(int_base, dir));
-        }
-        else if (rea_base.size() > 0) {
-            trial_point->SetRealVarValues(perturb(rea_base, dir));
-        }
-        trial_point->set_origin_data(GetTentativeBestCase(), dir, step_lengths_(dir));
-        trial_points.append(trial_point);
+        trial_points.append(create_trial_point(GetTentativeBestCase(), dir, step_lengths_(dir)));
     }
 
     for (Case *c : trial_points)
@@ -144,10 +139,68 @@ QList<Case *> GSS::generate_trial_points(vector<int> dirs) {
     return trial_points;
 }
 
+QList<Case *> GSS::generate_speculative_points(const QList<Case *> &poll, int max_points) {
+    auto speculative_points = QList<Case *>();
+    vector<int> dirs;
+    QHash<int, Case *> poll_points;
+    for (Case *c : poll) {
+        dirs.push_back(c->origin_direction_index());
+        poll_points[c->origin_direction_index()] = c;
+    }
+    bool integer_steps = GetTentativeBestCase()->GetIntegerVarVector().size() > 0;
+
+    for (int dir : rank_directions(dirs)) {
+        // Where the next poll goes in this direction if this one fails ...
+        double contracted_step = step_lengths_(dir) * contr_fac_;
+        if (speculative_points.size() < max_points && !(integer_steps && (int)contracted_step == 0))
+            speculative_points.append(create_trial_point(GetTentativeBestCase(), dir, contracted_step));
+
+        // ... and if it succeeds in this direction
+        if (speculative_expansion_ && speculative_points.size() < max_points)
+            speculative_points.append(create_trial_point(poll_points[dir], dir, step_lengths_(dir) * expan_fac_));
+    }
+
+    for (Case *c : speculative_points)
+        constraint_handler_->SnapCaseToConstraints(c);
+
+    return speculative_points;
+}
+
+void GSS::update_direction_value(const Case *c) {
+    if (c->origin_case() != nullptr && c->origin_direction_index() >= 0)
+        direction_values_(c->origin_direction_index()) = c->objective_function_value();
+}
+
+vector<int> GSS::rank_directions(vector<int> dirs) const {
+    std::stable_sort(dirs.begin(), dirs.end(),
+                     [this](int d1, int d2) -> bool {
+                       double v1 = direction_values_(d1);
+                       double v2 = direction_values_(d2);
+                       if (std::isnan(v2)) return !std::isnan(v1);
+                       if (std::isnan(v1)) return false;
+                       if (mode_ == Settings::Optimizer::OptimizerMode::Maximize)
+                           return v1 > v2;
+                       return v1 < v2;
+                     });
+    return dirs;
+}
+
+Case *GSS::create_trial_point(Case *origin, int dir, double step_length) {
+    auto trial_point = new Case(origin);
+    if (origin->GetIntegerVarVector().size() > 0) {
+        trial_point->SetIntegerVarValues(perturb(origin->GetIntegerVarVector(), dir, step_length));
+    }
+    else if (origin->GetRealVarVector().size() > 0) {
+        trial_point->SetRealVarValues(perturb(origin->GetRealVarVector(), dir, step_length));
+    }
+    trial_point->set_origin_data(origin, dir, step_length);
+    return trial_point;
+}
+
 template<typename T>
-Matrix<T, Dynamic, 1> GSS::perturb(Matrix<T, Dynamic, 1> base, int dir) {
+Matrix<T, Dynamic, 1> GSS::perturb(Matrix<T, Dynamic, 1> base, int dir, double step_length) {
     Matrix<T, Dynamic, 1> dirc = directions_[dir].cast<T>();
-    T sl = step_lengths_(dir);
+    T sl = step_length;
     Matrix<T, Dynamic, 1> perturbation = base + dirc * sl;
     return perturbation;
 }
@@ -189,5 +242,26 @@ Case * GSS::dequeue_case_with_worst_origin() {
     return queued_cases.last();
 }
 
+QList<Case *> GSS::dequeue_stale_cases(int queue_size) {
+    auto dequeued_cases = QList<Case *>();
+    for (Case *c : case_handler_->QueuedCases()) {
+        if (case_handler_->QueuedCases().size() <= queue_size)
+            break;
+        if (c->origin_case() != nullptr && c->origin_case()->id() != GetTentativeBestCase()->id()) {
+            case_handler_->DequeueCase(c->id());
+            dequeued_cases.append(c);
+        }
+    }
+    return dequeued_cases;
+}
+
+QList<Case *> GSS::prune_queue(int queue_size) {
+    auto dequeued_cases = dequeue_stale_cases(queue_size);
+    while (case_handler_->QueuedCases().size() > queue_size) {
+        dequeued_cases.append(dequeue_case_with_worst_origin());
+    }
+    return dequeued_cases;
+}
+
 }
 }
@@ -86,6 +86,10 @@ class GSS : public Optimizer {
   double expan_fac_; //!< Step length expansion factor.
   VectorXd step_lengths_; //!< Vector of step lengths.
   vector<VectorXi> directions_; //!< Vector of search directions.
+  int max_queue_length_; //!< Maximum length of queue: max_queue_size * number of directions.
+  bool speculative_polling_; //!< Queue speculative trial points along with each poll.
+  bool speculative_expansion_; //!< Also queue speculative points at expanded step lengths.
+  VectorXd direction_values_; //!< Objective function value of the last evaluated trial point in each direction (NaN if none).
 
   /*!
    * @brief Contract the search pattern: step_lengths_ * contr_fac_
@@ -130,6 +134,32 @@ class GSS : public Optimizer {
    */
   QList<Case *> generate_trial_points(vector<int> dirs = vector<int>{-1});
 
+  /*!
+   * @brief Generate speculative trial points for a poll, i.e. the points the following poll
+   * will contain if this one fails or succeeds.
+   *
+   * For each direction in the poll, starting with the most promising one (see rank_directions()),
+   * a point is created from the tentative best case at the contracted step length. If
+   * speculative_expansion_ is set, a point is also created from the poll point in the direction
+   * at the expanded step length. The points are tagged with their origin, so that they can be
+   * dequeued with dequeue_stale_cases() when the outcome of the poll makes them irrelevant.
+   * @param poll The trial points of the poll, as returned by generate_trial_points().
+   * @param max_points Maximum number of speculative points to create.
+   * @return A list of new speculative trial points.
+   */
+  QList<Case *> generate_speculative_points(const QList<Case *> &poll, int max_points);
+
+  /*!
+   * @brief Record the objective function value of an evaluated trial point in direction_values_.
+   */
+  void update_direction_value(const Case *c);
+
+  /*!
+   * @brief Sort direction indices so that the directions whose last trial point had the best
+   * objective function value come first. Directions without a value keep their order, last.
+   */
+  vector<int> rank_directions(vector<int> dirs) const;
+
   /*!
    * @brief Check if the algorithm has converged, i.e. if all current step lengths
    * are below the step length convergence tolerance.
@@ -143,6 +173,21 @@ class GSS : public Optimizer {
    */
   Case *dequeue_case_with_worst_origin();
 
+  /*!
+   * @brief Remove queued cases that were not generated from the tentative best case, i.e. trial
+   * points from an earlier poll center.
+   * @param queue_size Stop when this number of cases remain in the queue.
+   * @return The cases that were removed.
+   */
+  QList<Case *> dequeue_stale_cases(int queue_size = 0);
+
+  /*!
+   * @brief Prune the evaluation queue to queue_size cases, removing stale cases first and then
+   * the cases with the worst origin.
+   * @return The cases that were removed.
+   */
+  QList<Case *> prune_queue(int queue_size);
+
  private:
 
   /*!
@@ -150,10 +195,17 @@ class GSS : public Optimizer {
    * @tparam T An Eigen::VectorX object.
    * @param base The point to perturb from.
    * @param dir The direction index in which to perturb.
+   * @param step_length The length of the perturbation.
    * @return A perturbation (trial point).
    */
   template <typename T>
-  Matrix<T, Dynamic, 1> perturb(Matrix<T, Dynamic, 1> base, int dir);
+  Matrix<T, Dynamic, 1> perturb(Matrix<T, Dynamic, 1> base, int dir, double step_length);
+
+  /*!
+   * @brief Create a trial point by perturbing a case in a direction, tagged with its origin.
+   * The point is not snapped to the constraints.
+   */
+  Case *create_trial_point(Case *origin, int dir, double step_length);
 };
 
 }
@@ -22,6 +22,7 @@
 #include "Utilities/random.hpp"
 #include "Utilities/stringhelpers.hpp"
 #include <math.h>
+#include <numeric>
 
 namespace Optimization {
 namespace Optimizers {
@@ -64,6 +65,10 @@ GeneticAlgorithm::GeneticAlgorithm(Settings::Optimizer *settings,
         lower_bound_.fill(settings->parameters().lower_bound);
         upper_bound_.fill(settings->parameters().upper_bound);
     }
+    surrogate_screening_ = nullptr;
+    if (settings->parameters().surrogate_screening != "None") {
+        surrogate_screening_ = new SurrogateScreening(settings->parameters(), mode_, lower_bound_, upper_bound_, "GeneticAlgorithm");
+    }
 
     for (int i = 0; i < population_size_; ++i) {
         auto new_case = generateRandomCase();
@@ -75,6 +80,9 @@ GeneticAlgorithm::GeneticAlgorithm(Settings::Optimizer *settings,
         printPopulation();
     }
 }
+GeneticAlgorithm::~GeneticAlgorithm() {
+    delete surrogate_screening_;
+}
 Optimizer::TerminationCondition GeneticAlgorithm::IsFinished() {
     TerminationCondition tc = NOT_FINISHED;
     if (case_handler_->CasesBeingEvaluated().size() > 0)
@@ -82,7 +90,7 @@ Optimizer::TerminationCondition GeneticAlgorithm::IsFinished() {
     if (iteration_ >= max_generations_)
         tc = MAX_ITERATIONS_REACHED;
     if (tc != NOT_FINISHED) {
-        population_ = sortPopulation(population_);
+        sortPopulation(population_);
         if (enable_logging_) {
             logger_->AddEntry(this);
             logger_->AddEntry(new Summary(this, tc));
@@ -99,27 +107,32 @@ void GeneticAlgorithm::Chromosome::createNewCase() {
     new_case->SetRealVarValues(rea_vars);
     case_pointer = new_case;
 }
-void GeneticAlgorithm::printPopulation(vector<Chromosome> population) const {
-    if (population.size() == 0)
-        population = population_;
+void GeneticAlgorithm::printPopulation(const vector<Chromosome> &population) const {
+    const vector<Chromosome> &printed = population.size() == 0 ? population_ : population;
     cout << "Population:" << endl;
-    for (int i = 0; i < population.size(); ++i) {
+    for (int i = 0; i < printed.size(); ++i) {
         cout << "\t" << i << "\t";
-        printChromosome(population[i]);
+        printChromosome(printed[i]);
     }
 }
-void GeneticAlgorithm::printChromosome(Chromosome &chrom) const {
+void GeneticAlgorithm::printChromosome(const Chromosome &chrom) const {
     printf("%4.2f\t\t", chrom.ofv());
     for (int i = 0; i < n_vars_; ++i) {
         printf("%2.4f\t", chrom.rea_vars(i));
     }
     cout << endl;
 }
-vector<GeneticAlgorithm::Chromosome> GeneticAlgorithm::sortPopulation(vector<Chromosome> population) {
-    std::sort(population.begin(), population.end(), [&](Chromosome c1, Chromosome c2) {
-      return isBetter(c1.case_pointer, c2.case_pointer);
+void GeneticAlgorithm::sortPopulation(vector<Chromosome> &population) {
+    sort_order_.resize(population.size());
+    std::iota(sort_order_.begin(), sort_order_.end(), 0);
+    std::sort(sort_order_.begin(), sort_order_.end(), [&](int i, int j) {
+      return isBetter(population[i].case_pointer, population[j].case_pointer);
     });
-    return population;
+    sort_buffer_.resize(population.size());
+    for (size_t i = 0; i < sort_order_.size(); ++i) {
+        sort_buffer_[i] = std::move(population[sort_order_[i]]);
+    }
+    population.swap(sort_buffer_);
 }
 Case *GeneticAlgorithm::generateRandomCase() {
     auto new_case = new Case(GetTentativeBestCase());
@@ -22,6 +22,7 @@
 
 #include <boost/random.hpp>
 #include "optimizer.h"
+#include "surrogate_screening.h"
 
 using namespace std;
 
@@ -47,6 +48,7 @@ class GeneticAlgorithm : public Optimizer {
                    CaseHandler *case_handler=0,
                    Constraints::ConstraintHandler *constraint_handler=0
   );
+  ~GeneticAlgorithm() override;
   TerminationCondition IsFinished() override;
  protected:
   virtual void handleEvaluatedCase(Case *c) = 0;
@@ -63,7 +65,7 @@ class GeneticAlgorithm : public Optimizer {
     Case *case_pointer;
     Chromosome(Case *c);
     Chromosome() {}
-    double ofv() { return case_pointer->objective_function_value(); }
+    double ofv() const { return case_pointer->objective_function_value(); }
     void createNewCase();
   };
 
@@ -77,42 +79,51 @@ class GeneticAlgorithm : public Optimizer {
   Eigen::VectorXd lower_bound_; //!< Lower bounds for the variables (used for randomly generating populations and mutation)
   Eigen::VectorXd upper_bound_; //!< Upper bounds for the variables (used for randomly generating populations and mutation)
   int n_vars_; //!< Number of variables in the problem.
+  vector<int> sort_order_; //!< Buffer for the chromosome indices sorted by sortPopulation().
+  vector<Chromosome> sort_buffer_; //!< Buffer the sorted chromosomes are moved into by sortPopulation().
+  SurrogateScreening *surrogate_screening_; //!< Pre-screens offspring before they are evaluated. nullptr if screening is disabled.
 
   /*!
    * @brief Perform selection on the population.
    * @param population The population to perform selection on.
-   * @return A vector containing the mating pool.
+   * @param mating_pool Vector to write the mating pool to. Its chromosomes are overwritten,
+   * so that the vector can be reused between generations.
    */
-  virtual vector<Chromosome> selection(vector<Chromosome> population) = 0;
+  virtual void selection(const vector<Chromosome> &population, vector<Chromosome> &mating_pool) = 0;
 
   /*!
-   * @brief Perform crossover on the mating pool.
-   * @param mating_pool The mating pool to perform crossover on.
-   * @return A vector containing offspring.
+   * @brief Perform crossover on two parents. The offspring may be the parents themselves,
+   * in which case they are overwritten.
+   * @param p1, p2 The parents.
+   * @param o1, o2 The chromosomes to write the offspring to.
    */
-  virtual vector<Chromosome> crossover(vector<Chromosome> mating_pool) = 0;
+  virtual void crossover(const Chromosome &p1, const Chromosome &p2, Chromosome &o1, Chromosome &o2) = 0;
 
   /*!
-   * @brief Perform mutation on the offspring.
-   * @param offspring The individuals to perform mutation on.
-   * @return Mutated individuals.
+   * @brief Perform mutation on two individuals. The offspring may be the individuals
+   * themselves, in which case they are overwritten.
+   * @param p1, p2 The individuals to perform mutation on.
+   * @param o1, o2 The chromosomes to write the mutated individuals to.
    */
-  virtual vector<Chromosome> mutate(vector<Chromosome> offspring) = 0;
+  virtual void mutate(const Chromosome &p1, const Chromosome &p2, Chromosome &o1, Chromosome &o2) = 0;
 
   /*!
-   * @brief Sort the population according to fitness
+   * @brief Sort the population according to fitness, in place.
+   *
+   * The indices of the chromosomes are sorted, and the chromosomes are then moved into
+   * place, so that their variable vectors are never copied.
    */
-  vector<Chromosome> sortPopulation(vector<Chromosome> population);
+  void sortPopulation(vector<Chromosome> &population);
 
   /*!
    * @brief Print a string representation of the population to stdout.
    */
-  void printPopulation(vector<Chromosome> population = vector<Chromosome>()) const;
+  void printPopulation(const vector<Chromosome> &population = vector<Chromosome>()) const;
 
   /*!
    * @brief Print a string representation of one chromosome to stdout.
    */
-  void printChromosome(Chromosome &chrom) const;
+  void printChromosome(const Chromosome &chrom) const;
 
   /*!
    * @brief Generate a random case with in the bounds.
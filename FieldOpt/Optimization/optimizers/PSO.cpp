@@ -57,6 +57,10 @@ PSO::PSO(Settings::Optimizer *settings,
     }
     auto difference = upper_bound_ - lower_bound_;
     v_max_ = difference * settings->parameters().pso_velocity_scale;
+    surrogate_screening_ = nullptr;
+    if (settings->parameters().surrogate_screening != "None") {
+        surrogate_screening_ = new SurrogateScreening(settings->parameters(), mode_, lower_bound_, upper_bound_, "PSO");
+    }
     if (VERB_OPT > 2) {
         stringstream ss;
         ss << "Using bounds from constraints: " << endl;
@@ -75,6 +79,10 @@ PSO::PSO(Settings::Optimizer *settings,
     }
 }
 
+PSO::~PSO() {
+    delete surrogate_screening_;
+}
+
 void PSO::iterate(){
     if(enable_logging_){
         logger_->AddEntry(this);
@@ -89,14 +97,30 @@ void PSO::iterate(){
         next_generation_swarm.push_back(Particle(new_case, gen_, v_max_, n_vars_));
         next_generation_swarm[i].ParticleAdapt(swarm_[i].rea_vars_velocity, swarm_[i].rea_vars);
     }
+    if (surrogate_screening_ != nullptr) {
+        // Particles rejected by the screening keep moving, but are not evaluated
+        QList<Case *> candidates;
+        for (const auto &particle : next_generation_swarm) {
+            candidates.append(particle.case_pointer);
+        }
+        auto accepted = surrogate_screening_->Screen(candidates, enable_logging_ ? logger_ : nullptr);
+        for (int i = 0; i < number_of_particles_; ++i) {
+            next_generation_swarm[i].screened_out = !accepted[i];
+        }
+    }
     for(int i = 0; i < number_of_particles_; i++){
-        case_handler_->AddNewCase(next_generation_swarm[i].case_pointer);
+        if (!next_generation_swarm[i].screened_out) {
+            case_handler_->AddNewCase(next_generation_swarm[i].case_pointer);
+        }
     }
     swarm_ = next_generation_swarm;
     iteration_++;
 }
 
 void PSO::handleEvaluatedCase(Case *c) {
+    if (surrogate_screening_ != nullptr) {
+        surrogate_screening_->AddSample(c);
+    }
     if(isImprovement(c)){
         updateTentativeBestCase(c);
         if (VERB_OPT > 1) {
@@ -173,7 +197,8 @@ PSO::Particle PSO::get_global_best(){
     }
     for(int i = 0; i < swarm_memory_.size(); i++){
         for(int j = 0; j < swarm_memory_[i].size();j++){
-            if (isBetter(swarm_memory_[i][j].case_pointer, best_particle.case_pointer)) {
+            if (!swarm_memory_[i][j].screened_out
+                && isBetter(swarm_memory_[i][j].case_pointer, best_particle.case_pointer)) {
                 best_particle=swarm_memory_[i][j];
             }
         }
@@ -183,7 +208,8 @@ PSO::Particle PSO::get_global_best(){
 PSO::Particle PSO::find_best_in_particle_memory(int particle_num){
     Particle best_in_particle_memory = swarm_memory_[0][particle_num];
     for(int i = 1; i < swarm_memory_.size(); i++) {
-        if (isBetter(swarm_memory_[i][particle_num].case_pointer, best_in_particle_memory.case_pointer)) {
+        if (!swarm_memory_[i][particle_num].screened_out
+            && isBetter(swarm_memory_[i][particle_num].case_pointer, best_in_particle_memory.case_pointer)) {
             best_in_particle_memory = swarm_memory_[i][particle_num];
         }
     }
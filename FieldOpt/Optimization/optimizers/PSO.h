@@ -20,6 +20,7 @@
 
 #include <boost/random.hpp>
 #include "optimizer.h"
+#include "surrogate_screening.h"
 
 #ifndef FIELDOPT_PSO_H
 #define FIELDOPT_PSO_H
@@ -42,6 +43,7 @@ class PSO : public Optimizer {
       Logger *logger,
       CaseHandler *case_handler=0,
       Constraints::ConstraintHandler *constraint_handler=0);
+  ~PSO() override;
  protected:
   void handleEvaluatedCase(Case *c) override;
   void iterate() override;
@@ -53,6 +55,7 @@ class PSO : public Optimizer {
     Eigen::VectorXd rea_vars; //!< Real variables
     Case *case_pointer; //!< Pointer to the case
     Eigen::VectorXd rea_vars_velocity; //!< The velocity of the real variables
+    bool screened_out = false; //!< The case was rejected by the surrogate screening, and has not been evaluated.
     Particle(Optimization::Case *c, boost::random::mt19937 &gen, Eigen::VectorXd v_max, int n_vars);
     Particle(){}
     void ParticleAdapt(Eigen::VectorXd rea_vars_velocity_swap, Eigen::VectorXd rea_vars);
@@ -126,6 +129,7 @@ class PSO : public Optimizer {
   Eigen::VectorXd lower_bound_; //!< Lower bounds for the variables (used for randomly generating populations and mutation)
   Eigen::VectorXd upper_bound_; //!< Upper bounds for the variables (used for randomly generating populations and mutation)
   int n_vars_; //!< Number of variables in the problem.
+  SurrogateScreening *surrogate_screening_; //!< Pre-screens new particles before they are evaluated. nullptr if screening is disabled.
 
 };
 }
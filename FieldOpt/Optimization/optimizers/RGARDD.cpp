@@ -37,6 +37,7 @@ RGARDD::RGARDD(Settings::Optimizer *settings,
         discard_parameter_ = 1.0/population_size_;
     else discard_parameter_ = settings->parameters().discard_parameter;
     stagnation_limit_ = settings->parameters().stagnation_limit;
+    direction_ = Eigen::VectorXd::Zero(n_vars_);
     mating_pool_ = population_;
     if (enable_logging_) {
         logger_->AddEntry(this);
@@ -52,7 +53,7 @@ void RGARDD::iterate() {
     if (enable_logging_) {
         logger_->AddEntry(this);
     }
-    population_ = sortPopulation(population_);
+    sortPopulation(population_);
 
     if (is_stagnant()) {
         if (VERB_OPT >= 1) {
@@ -65,29 +66,48 @@ void RGARDD::iterate() {
         return;
     }
 
-    mating_pool_ = selection(population_);
+    selection(population_, mating_pool_);
+    QList<Case *> offspring;
     double r;
     for (int i = 0; i < population_size_ / 2; ++i) {
         r = random_double(gen_);
-        Chromosome p1 = mating_pool_[i]; // Parent 1
-        Chromosome p2 = mating_pool_[population_size_ / 2 + i]; // Parent 2
-        vector<Chromosome> offspring;
-        if (r > p_crossover_ && p1.rea_vars != p2.rea_vars) {
-            offspring = crossover(vector<Chromosome>{p1, p2});
+        // The parents are replaced by their offspring in the mating pool
+        Chromosome &c1 = mating_pool_[i];
+        Chromosome &c2 = mating_pool_[population_size_ / 2 + i];
+        if (r > p_crossover_ && c1.rea_vars != c2.rea_vars) {
+            crossover(c1, c2, c1, c2);
         }
         else {
-            offspring = mutate(vector<Chromosome>{p1, p2});
+            mutate(c1, c2, c1, c2);
+        }
+        c1.createNewCase();
+        c2.createNewCase();
+        offspring.append(c1.case_pointer);
+        offspring.append(c2.case_pointer);
+    }
+    // Offspring rejected by the screening are not evaluated, so their parents are kept in the population
+    std::vector<bool> accepted(offspring.size(), true);
+    if (surrogate_screening_ != nullptr) {
+        accepted = surrogate_screening_->Screen(offspring, enable_logging_ ? logger_ : nullptr);
+    }
+    for (int i = 0; i < offspring.size(); ++i) {
+        if (accepted[i]) {
+            case_handler_->AddNewCase(offspring[i]);
+        }
+        else { // Never handed to the case handler, so the case is owned here
+            for (auto &chromosome : mating_pool_) {
+                if (chromosome.case_pointer == offspring[i])
+                    chromosome.case_pointer = nullptr;
+            }
+            delete offspring[i];
         }
-        offspring[0].createNewCase();
-        offspring[1].createNewCase();
-        case_handler_->AddNewCase(offspring[0].case_pointer);
-        case_handler_->AddNewCase(offspring[1].case_pointer);
-        mating_pool_[i] = offspring[0];
-        mating_pool_[population_size_ / 2 + i] = offspring[1];
     }
     iteration_++;
 }
 void RGARDD::handleEvaluatedCase(Case *c) {
+    if (surrogate_screening_ != nullptr) {
+        surrogate_screening_->AddSample(c);
+    }
     int index = -1;
     for (int i = 0; i < mating_pool_.size(); ++i) {
         if (mating_pool_[i].case_pointer == c) {
@@ -118,57 +138,54 @@ void RGARDD::handleEvaluatedCase(Case *c) {
         }
     }
 }
-vector<GeneticAlgorithm::Chromosome> RGARDD::selection(vector<Chromosome> population) {
-    auto mating_pool = population_;
+void RGARDD::selection(const vector<Chromosome> &population, vector<Chromosome> &mating_pool) {
+    mating_pool = population;
     int n_repl = floor(population_size_ * discard_parameter_);
     for (int i = population_size_-n_repl; i < population_size_; ++i) {
-        mating_pool[i] = population_[i-population_size_+n_repl];
+        mating_pool[i] = population[i-population_size_+n_repl];
     }
-    return sortPopulation(mating_pool);
+    sortPopulation(mating_pool);
 }
-vector<GeneticAlgorithm::Chromosome> RGARDD::crossover(vector<Chromosome> mating_pool) {
-    assert(mating_pool.size() == 2);
-    auto p1 = mating_pool[0];
-    auto p2 = mating_pool[1];
+void RGARDD::crossover(const Chromosome &p1, const Chromosome &p2, Chromosome &o1, Chromosome &o2) {
     auto r = random_doubles(gen_, 0, 1, n_vars_);
-    Eigen::VectorXd dirs(n_vars_);
     for (int i = 0; i < n_vars_; ++i) {
         if (r[i] < 0.5) {
-            dirs(i) = 0;
+            direction_(i) = 0;
         }
         else {
-            dirs(i) = p1.rea_vars(i) - p2.rea_vars(i);
+            direction_(i) = p1.rea_vars(i) - p2.rea_vars(i);
         }
     }
-    Chromosome o1 = Chromosome(p1.case_pointer);
-    Chromosome o2 = Chromosome(p2.case_pointer);
-
     double s = abs(p1.ofv() - p2.ofv()) /
         (population_[0].ofv() - population_[population_size_-1].ofv());
-    o1.rea_vars = p1.rea_vars + s * dirs;
-    o2.rea_vars = p2.rea_vars + s * dirs;
+
+    // The offspring may be the parents, so they are only written to once the parents have been used
+    o1.case_pointer = p1.case_pointer;
+    o2.case_pointer = p2.case_pointer;
+    o1.rea_vars = p1.rea_vars;
+    o2.rea_vars = p2.rea_vars;
+    o1.rea_vars += s * direction_;
+    o2.rea_vars += s * direction_;
     snap_to_bounds(o1);
     snap_to_bounds(o2);
-    return vector<Chromosome>{o1, o2};
 }
-vector<GeneticAlgorithm::Chromosome> RGARDD::mutate(vector<Chromosome> mating_pool) {
-    assert(mating_pool.size() == 2);
+void RGARDD::mutate(const Chromosome &p1, const Chromosome &p2, Chromosome &o1, Chromosome &o2) {
     double s = pow(1.0 - (iteration_*1.0/max_generations_), decay_rate_);
-    auto p1 = mating_pool[0];
-    auto p2 = mating_pool[1];
-    auto o1 = Chromosome(p1);
-    auto o2 = Chromosome(p2);
-    Eigen::VectorXd dir = random_doubles_eigen(gen_,
-                                               -mutation_strength_,
-                                               mutation_strength_,
-                                               n_vars_);
-    o1.rea_vars = p1.rea_vars + s * dir.cwiseProduct(upper_bound_ - lower_bound_);
-    o2.rea_vars = p2.rea_vars + s * dir.cwiseProduct(upper_bound_ - lower_bound_);
+    direction_ = random_doubles_eigen(gen_,
+                                      -mutation_strength_,
+                                      mutation_strength_,
+                                      n_vars_);
+    direction_.array() *= s * (upper_bound_ - lower_bound_).array();
+    o1.case_pointer = p1.case_pointer;
+    o2.case_pointer = p2.case_pointer;
+    o1.rea_vars = p1.rea_vars;
+    o2.rea_vars = p2.rea_vars;
+    o1.rea_vars += direction_;
+    o2.rea_vars += direction_;
 
     // Snap to bound  constraints
     snap_to_bounds(o1);
     snap_to_bounds(o2);
-    return vector<Chromosome> {o1, o2};
 }
 void RGARDD::snap_to_bounds(Chromosome &chrom) {
     for (int i = 0; i < chrom.rea_vars.size(); ++i) {
@@ -181,7 +198,8 @@ void RGARDD::snap_to_bounds(Chromosome &chrom) {
 bool RGARDD::is_stagnant() {
     // Using the sums of the variable values in each chromosome
     vector<double> list_of_sums;
-    for (auto chrom : population_) {
+    list_of_sums.reserve(population_.size());
+    for (const auto &chrom : population_) {
         list_of_sums.push_back(chrom.rea_vars.sum());
     }
     double stdev = calc_standard_deviation(list_of_sums);
@@ -64,6 +64,7 @@ class RGARDD : public GeneticAlgorithm {
   vector<Chromosome> mating_pool_; //!< Holds the current mating pool.
   double discard_parameter_; //!< Determines the fraction of parents to be discarded in selection.
   double stagnation_limit_; //!< The threshold for when to regenerate the population.
+  Eigen::VectorXd direction_; //!< Buffer for the crossover/mutation direction.
 
   /*!
    * @brief Perform the next iteration by generating a new mating pool
@@ -86,25 +87,25 @@ class RGARDD : public GeneticAlgorithm {
    * @brief Perform Ranking Selection on the population to generate a
    * new mating pool. Expects a population from best to worst fitness.
    * @param population The population to perform selection on.
-   * @return A new mating pool.
+   * @param mating_pool The mating pool to overwrite.
    */
-  vector<Chromosome> selection(vector<Chromosome> population) override;
+  void selection(const vector<Chromosome> &population, vector<Chromosome> &mating_pool) override;
 
   /*!
    * @brief Perform Direction-Based Crossover on two parents from the
    * mating pool.
-   * @param mating_pool The two parents to be used.
-   * @return Vector containing two new offspring.
+   * @param p1, p2 The two parents to be used.
+   * @param o1, o2 The two new offspring (may be the parents).
    */
-  vector<Chromosome> crossover(vector<Chromosome> mating_pool) override;
+  void crossover(const Chromosome &p1, const Chromosome &p2, Chromosome &o1, Chromosome &o2) override;
 
   /*!
    * @brief Perform Dynamic Random Mutation on two parents from the mating
    * pool.
-   * @param mating_pool The two parents to be used.
-   * @return Vector containing two new offspring.
+   * @param p1, p2 The two parents to be used.
+   * @param o1, o2 The two new offspring (may be the parents).
    */
-  vector<Chromosome> mutate(vector<Chromosome> mating_pool) override;
+  void mutate(const Chromosome &p1, const Chromosome &p2, Chromosome &o1, Chromosome &o2) override;
 
   /*!
    * @brief Check if the population has stagnated.
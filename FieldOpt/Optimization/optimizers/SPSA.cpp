@@ -1,10 +1,23 @@
 #include "Optimization/optimizers/SPSA.h"
 #include "Utilities/stringhelpers.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace Optimization {
 namespace Optimizers {
 
+namespace {
+const double high_gradient_noise = 1.0;  //!< Double the number of pairs above this relative gradient noise.
+const double low_gradient_noise = 0.25;  //!< Halve the number of pairs below this relative gradient noise.
+
+bool isReturned(const Case *c) {
+  return c->state.eval != Case::CaseState::E_PENDING && c->state.eval != Case::CaseState::E_CURRENT;
+}
+
+bool isSuccessful(const Case *c) {
+  return c->state.eval == Case::CaseState::E_DONE || c->state.eval == Case::CaseState::E_BOOKKEEPED;
+}
+}
 
 SPSA::SPSA(Settings::Optimizer *settings,
      Case *base_case,
@@ -27,11 +40,17 @@ SPSA::SPSA(Settings::Optimizer *settings,
   A_ = params.spsa_A;
   a_ = params.spsa_a;
   c_ = params.spsa_c;
+  min_gradient_pairs_ = std::max(1, params.spsa_gradient_pairs);
+  max_gradient_pairs_ = std::max(min_gradient_pairs_, params.spsa_max_gradient_pairs);
+  common_random_numbers_ = params.spsa_common_random_numbers;
   assert(a_ != 0.0 || init_step_magnitude_ != 0.0);
 
   estimate_ = new Case(base_case);
   perturbations_evaluated_ = false;
-  perturbations_valid_ = false;
+  perturbation_evaluation_failed_ = false;
+  gradient_pairs_ = min_gradient_pairs_;
+  gradient_noise_ = -1.0;
+  next_selection_key_ = 0;
 
   ub_ = constraint_handler_->GetUpperBounds(base_case->GetRealVarIdVector());
   lb_ = constraint_handler_->GetLowerBounds(base_case->GetRealVarIdVector());
@@ -62,32 +81,38 @@ void SPSA::handleEvaluatedCase(Case *c)
             "Optimization", "SPSA");
     }
   }
-  bool first_done = perturbations_.first->state.eval == Case::CaseState::E_DONE || perturbations_.first->state.eval == Case::CaseState::E_BOOKKEEPED;
-  bool second_done = perturbations_.second->state.eval == Case::CaseState::E_DONE || perturbations_.second->state.eval == Case::CaseState::E_BOOKKEEPED;
-  if (first_done && second_done)
-  {
-    perturbations_evaluated_ = true;
-    perturbation_evaluation_failed_ = false;
-    if (VERB_OPT >= 3) {
-      Printer::ext_info("Both perturbations evaluated in iteration " + Printer::num2str(iteration_), "Optimization", "SPSA");
-    }
-    updateGradient();
-    if (iteration_ == 1 && init_step_magnitude_ != 0.0) {
-      if (VERB_OPT >= 3) { Printer::ext_info("First iteration done. Computing a.", "Optimization", "SPSA"); }
-      compute_a();
-    }
-    update_a_k();
-    updateEstimate();
+  if (perturbations_evaluated_ || perturbations_.empty()) {
+    return;
   }
-  else if ( ! first_done && ! second_done ) {
-      std::stringstream ss;
-      ss << "Non-successfully evaluated case returned (codes: " 
-          << perturbations_.first->state.eval << ", " << perturbations_.second->state.eval
-          << "). Attempting to recover.";
-      Printer::ext_warn(ss.str(), "Optimization", "SPSA");
-      perturbation_evaluation_failed_ = true;
+  for (auto &pair : perturbations_) {
+    if (!isReturned(pair.first) || !isReturned(pair.second)) {
+      return; // Wait for the rest of the batch
+    }
   }
 
+  perturbations_evaluated_ = true;
+  if (VERB_OPT >= 3) {
+    Printer::ext_info("All perturbations returned in iteration " + Printer::num2str(iteration_), "Optimization", "SPSA");
+  }
+  int pairs_used = updateGradient();
+  if (pairs_used == 0) {
+    Printer::ext_warn("No perturbation pair was successfully evaluated in iteration " + Printer::num2str(iteration_)
+                          + ". Skipping the update of the estimate.", "Optimization", "SPSA");
+    perturbation_evaluation_failed_ = true;
+    return;
+  }
+  perturbation_evaluation_failed_ = false;
+  if (pairs_used < (int)perturbations_.size()) {
+    Printer::ext_warn("Non-successfully evaluated cases returned. Using " + Printer::num2str(pairs_used)
+                          + " of " + Printer::num2str(perturbations_.size()) + " perturbation pairs.", "Optimization", "SPSA");
+  }
+  if (iteration_ == 1 && init_step_magnitude_ != 0.0) {
+    if (VERB_OPT >= 3) { Printer::ext_info("First iteration done. Computing a.", "Optimization", "SPSA"); }
+    compute_a();
+  }
+  update_a_k();
+  updateEstimate();
+  updateGradientPairs();
 }
 
 void SPSA::iterate()
@@ -112,18 +137,35 @@ void SPSA::iterate()
   update_c_k();
 
   int max_attempts = 1*D_;
-  int attempt = 1;
-  perturbations_valid_ = false;
-  auto first = new Case(estimate_);
-  auto second = new Case(estimate_);
-  while (perturbations_valid_ == false && attempt <= max_attempts) {
-    updateSPVector();
-    createPerturbations(first, second);
-    attempt++;
-  }
-  perturbations_ = std::pair<Case *, Case *>(first, second);
-
-  if (perturbations_valid_ == false) {
+  perturbations_.clear();
+  deltas_.clear();
+  for (int p = 0; p < gradient_pairs_; ++p) {
+    int attempt = 1;
+    bool perturbations_valid = false;
+    auto first = new Case(estimate_);
+    auto second = new Case(estimate_);
+    Eigen::VectorXd delta;
+    while (perturbations_valid == false && attempt <= max_attempts) {
+      delta = generateSPVector();
+      perturbations_valid = createPerturbations(first, second, delta);
+      attempt++;
+    }
+    if (perturbations_valid) {
+      if (common_random_numbers_) {
+        first->SetRealizationSelectionKey(next_selection_key_);
+        second->SetRealizationSelectionKey(next_selection_key_);
+        next_selection_key_++;
+      }
+      perturbations_.push_back(std::make_pair(first, second));
+      deltas_.push_back(delta);
+    }
+    else {
+      delete first;
+      delete second;
+    }
+  }
+
+  if (perturbations_.empty()) {
     Printer::ext_warn("Unable to generate valid pair of perturbations after " + Printer::num2str(max_attempts) + " attempts.", "Optimization", "SPSA");
     if ((iteration_ - tentative_best_case_iteration_) > 0.1*max_iterations_) {
       Printer::ext_warn("No new best case found in the last (0.1*max_iterations) iterations. Setting estimate to tentative best case.", "Optimization", "SPSA");
@@ -134,8 +176,15 @@ void SPSA::iterate()
     iterate();
   }
   else {
-    case_handler_->AddNewCase(perturbations_.first);
-    case_handler_->AddNewCase(perturbations_.second);
+    if ((int)perturbations_.size() < gradient_pairs_) {
+      Printer::ext_warn("Only generated " + Printer::num2str(perturbations_.size()) + " of "
+                            + Printer::num2str(gradient_pairs_) + " valid pairs of perturbations.", "Optimization", "SPSA");
+    }
+    QList<Case *> batch;
+    for (auto &pair : perturbations_) {
+      batch << pair.first << pair.second;
+    }
+    case_handler_->AddNewCases(batch);
     perturbations_evaluated_ = false;
   }
 }
@@ -156,50 +205,51 @@ void SPSA::update_c_k()
   }
 }
 
-void SPSA::updateSPVector()
+Eigen::VectorXd SPSA::generateSPVector()
 {
   if (VERB_OPT >= 4) Printer::ext_info("Updating SP vector.", "Optimization", "SPSA");
-  delta_k_ = random_symmetric_bernoulli_eigen(gen_, D_);
+  return random_symmetric_bernoulli_eigen(gen_, D_);
 }
 
-void SPSA::createPerturbations(Case *first, Case *second)
+bool SPSA::createPerturbations(Case *first, Case *second, Eigen::VectorXd &delta)
 {
-  if (VERB_OPT >= 5) Printer::ext_info("Perturbation: +- " + eigenvec_to_str(c_k_ * delta_k_), "Optimization", "SPSA");
-  first->SetRealVarValues( estimate_->GetRealVarVector() + c_k_ * delta_k_ );
-  second->SetRealVarValues(estimate_->GetRealVarVector() - c_k_ * delta_k_ );
+  bool perturbations_valid = false;
+  if (VERB_OPT >= 5) Printer::ext_info("Perturbation: +- " + eigenvec_to_str(c_k_ * delta), "Optimization", "SPSA");
+  first->SetRealVarValues( estimate_->GetRealVarVector() + c_k_ * delta );
+  second->SetRealVarValues(estimate_->GetRealVarVector() - c_k_ * delta );
 
   bool first_ok = constraint_handler_->CaseSatisfiesConstraints(first);
   bool second_ok = constraint_handler_->CaseSatisfiesConstraints(second);
 
   if ( first_ok && second_ok ) {
-    perturbations_valid_ = true;
+    perturbations_valid = true;
   }
   else if ( !first_ok && second_ok ) {
     if (VERB_OPT >= 1) Printer::ext_info("Positive perturbation violates constraints.", "Optimization", "SPSA");
     first->SetRealVarValues( estimate_->GetRealVarVector() );
-    second->SetRealVarValues(estimate_->GetRealVarVector() - 2.0*(c_k_ * delta_k_));
+    second->SetRealVarValues(estimate_->GetRealVarVector() - 2.0*(c_k_ * delta));
     second_ok = constraint_handler_->CaseSatisfiesConstraints(second);
     if (second_ok) {
       if (VERB_OPT >= 1) Printer::ext_info("Using estimate.", "Optimization", "SPSA");
-      perturbations_valid_ = true;
+      perturbations_valid = true;
     }
     else {
       if (VERB_OPT >= 1) Printer::ext_info("Unable to correct.", "Optimization", "SPSA");
-      perturbations_valid_ = false;
+      perturbations_valid = false;
     }
   }
   else if ( first_ok && !second_ok ) {
     if (VERB_OPT >= 1) Printer::ext_info("Negative perturbation violates constraints.", "Optimization", "SPSA");
     second->SetRealVarValues( estimate_->GetRealVarVector() );
-    first->SetRealVarValues( estimate_->GetRealVarVector() + 2.0*(c_k_ * delta_k_) );
+    first->SetRealVarValues( estimate_->GetRealVarVector() + 2.0*(c_k_ * delta) );
     first_ok = constraint_handler_->CaseSatisfiesConstraints(first);
     if (first_ok) {
       if (VERB_OPT >= 1) Printer::ext_info("Using estimate.", "Optimization", "SPSA");
-      perturbations_valid_ = true;
+      perturbations_valid = true;
     }
     else {
       if (VERB_OPT >= 1) Printer::ext_info("Unable to correct.", "Optimization", "SPSA");
-      perturbations_valid_ = false;
+      perturbations_valid = false;
     }
   }
   else {
@@ -207,10 +257,10 @@ void SPSA::createPerturbations(Case *first, Case *second)
     for (int i=0; i < D_; ++i) {
       double first_val = first->GetRealVarVector()[i];
       if (first_val > ub_[i] || first_val < lb_[i]) {
-          delta_k_[i] = -1 * delta_k_[i];
+          delta[i] = -1 * delta[i];
       }
     }
-    first->SetRealVarValues( estimate_->GetRealVarVector() + 2.0*(c_k_ * delta_k_) );
+    first->SetRealVarValues( estimate_->GetRealVarVector() + 2.0*(c_k_ * delta) );
     second->SetRealVarValues( estimate_->GetRealVarVector() );
 
     first_ok = constraint_handler_->CaseSatisfiesConstraints(first);
@@ -218,30 +268,72 @@ void SPSA::createPerturbations(Case *first, Case *second)
 
     if (first_ok && second_ok) {
       if (VERB_OPT >= 1) Printer::ext_info("Managed to correct perturbations.", "Optimization", "SPSA");
-      perturbations_valid_ = true;
+      perturbations_valid = true;
     }
     else {
       if (VERB_OPT >= 1) Printer::ext_info("Unable to correct perturbations.", "Optimization", "SPSA");
-      perturbations_valid_ = false;
+      perturbations_valid = false;
     }
 
   }
+  return perturbations_valid;
 }
 
-void SPSA::updateGradient()
+int SPSA::updateGradient()
 {
   if (VERB_OPT >= 3) Printer::ext_info("Updating gradient.", "Optimization", "SPSA");
-  double yplus = perturbations_.first->objective_function_value();
-  double yminus = perturbations_.second->objective_function_value();
-  if (mode_ == Settings::Optimizer::OptimizerMode::Maximize) {
-    yplus = yplus * -1;
-    yminus = yminus * -1;
+  std::vector<Eigen::VectorXd> estimates;
+  for (int p = 0; p < (int)perturbations_.size(); ++p) {
+    if (!isSuccessful(perturbations_[p].first) || !isSuccessful(perturbations_[p].second)) {
+      continue;
+    }
+    double yplus = perturbations_[p].first->objective_function_value();
+    double yminus = perturbations_[p].second->objective_function_value();
+    if (mode_ == Settings::Optimizer::OptimizerMode::Maximize) {
+      yplus = yplus * -1;
+      yminus = yminus * -1;
+    }
+    estimates.push_back((yplus - yminus) / (2 * c_k_) * deltas_[p].cwiseInverse());
+  }
+  if (estimates.empty()) {
+    return 0;
   }
-  g_k_.resize(D_);
-  for (int i = 0; i < D_; ++i) {
-    g_k_[i] = (yplus - yminus) / (2 * c_k_ * delta_k_[i]);
+
+  g_k_ = Eigen::VectorXd::Zero(D_);
+  for (auto &estimate : estimates) {
+    g_k_ += estimate;
+  }
+  g_k_ /= estimates.size();
+
+  gradient_noise_ = -1.0;
+  if (estimates.size() > 1 && g_k_.norm() > 0.0) {
+    double sum_sq_dev = 0.0;
+    for (auto &estimate : estimates) {
+      sum_sq_dev += (estimate - g_k_).squaredNorm();
+    }
+    double variance_of_mean = sum_sq_dev / (estimates.size() - 1) / estimates.size();
+    gradient_noise_ = std::sqrt(variance_of_mean) / g_k_.norm();
   }
   if (VERB_OPT >= 4) Printer::ext_info("Updated gradient vector: " + eigenvec_to_str(g_k_), "Optimization", "SPSA");
+  return (int)estimates.size();
+}
+
+void SPSA::updateGradientPairs()
+{
+  if (max_gradient_pairs_ <= min_gradient_pairs_ || gradient_noise_ < 0.0) {
+    return;
+  }
+  int previous = gradient_pairs_;
+  if (gradient_noise_ > high_gradient_noise) {
+    gradient_pairs_ = std::min(2 * gradient_pairs_, max_gradient_pairs_);
+  }
+  else if (gradient_noise_ < low_gradient_noise) {
+    gradient_pairs_ = std::max(gradient_pairs_ / 2, min_gradient_pairs_);
+  }
+  if (VERB_OPT >= 2 && gradient_pairs_ != previous) {
+    Printer::ext_info("Relative gradient noise " + Printer::num2str(gradient_noise_) + ". Using "
+                          + Printer::num2str(gradient_pairs_) + " perturbation pairs.", "Optimization", "SPSA");
+  }
 }
 
 void SPSA::updateEstimate() {
@@ -26,6 +26,7 @@
 #include "Utilities/random.hpp"
 #include <Eigen/Core>
 #include <utility>
+#include <vector>
 
 namespace Optimization {
 namespace Optimizers {
@@ -41,6 +42,17 @@ namespace Optimizers {
  * The default parameter values are based on the recommendations described in
  * [2] "Implementation of the simultaneous perturbation algorithm for stochastic optimization",
  *	James C. Spall, IEEE Transactions on Aearospace and Electronic Systems, vol. 34 no. 3 (1998)
+ *
+ * Several perturbation pairs, each with its own perturbation vector, may be generated in each
+ * iteration (SPSA-GradientPairs). They are added to the case handler as one batch, so that they
+ * can be evaluated in parallel, and the gradient used is the average of the estimates from the
+ * pairs (gradient averaging, see [2]). If SPSA-MaxGradientPairs is set, the number of pairs is
+ * doubled when the estimated standard error of the averaged gradient is large compared to its
+ * norm, and halved when it is small.
+ *
+ * If SPSA-CommonRandomNumbers is set, the two cases of a pair are evaluated on the same subset
+ * of ensemble realizations, so that the difference between them is not affected by which
+ * realizations were selected.
  */
 class SPSA : public Optimizer {
  public:
@@ -68,6 +80,9 @@ class SPSA : public Optimizer {
   double A_;     //!< "Stability" constant useful in controlling step lengths in early iterations.
   double c_;     //!< Used to compensate for noise.
   double init_step_magnitude_; //!< Used to compute the a_ parameter.
+  int min_gradient_pairs_; //!< Number of perturbation pairs pr. iteration; the minimum if adaptive.
+  int max_gradient_pairs_; //!< Maximum number of perturbation pairs pr. iteration when adaptive.
+  bool common_random_numbers_; //!< Evaluate both cases of a pair on the same realizations.
 
   // Run-time variables
   bool perturbations_evaluated_; //!< Indicates whether the perturbations used for grad. est. have been evaluated.
@@ -77,22 +92,18 @@ class SPSA : public Optimizer {
   double a_k_;             //!< Gain sequence a at iteration k: \$ a_k = a/(A+k)^{\alpha} \$.
   double c_k_;    //!< Gain sequence c at iteration k: \$ c_k = c/k^{\gamma} \$
   Eigen::VectorXd g_k_;    //!< Gradient at iteration k.
-  Eigen::VectorXd delta_k_; //!< Simultaneous perturbation vector at iteration k.
+  int gradient_pairs_;     //!< Number of perturbation pairs to generate in the next iteration.
+  double gradient_noise_;  //!< Standard error of g_k_ relative to its norm; negative if it could not be estimated.
+  int next_selection_key_; //!< Realization selection key for the next pair, when using common random numbers.
 
-  std::pair<Case *, Case *> perturbations_; //!< Perturbations currently used for gradient computation.
+  std::vector<std::pair<Case *, Case *>> perturbations_; //!< Perturbation pairs currently used for gradient computation.
+  std::vector<Eigen::VectorXd> deltas_; //!< Simultaneous perturbation vector for each pair in perturbations_.
   Case *estimate_; //!< The estimated best case. This is never actually evaluated.
 
   Eigen::VectorXd ub_; //!< Upper bounds
   Eigen::VectorXd lb_; //!< Lower bounds
   Case *base_case_;
 
-  /*!
-   * Indicates whether the perturbations generated are valid.
-   * If they are not, the algorithm will attempt to generate new perturbations
-   * until a valid pair is found.
-   */
-  bool perturbations_valid_;
-
   /*!
    * @brief Update the \$ a_k \$ gain parameter.
    *
@@ -108,11 +119,11 @@ class SPSA : public Optimizer {
   void update_c_k();
 
   /*!
-   * @brief Update the simultaneous perturbation vector delta_k_
+   * @brief Generate a simultaneous perturbation vector.
    *
-   * It is set to a vector with D_ random elements, each on either +1 or -1 with 0.5 probability.
+   * It is a vector with D_ random elements, each on either +1 or -1 with 0.5 probability.
    */
-  void updateSPVector();
+  Eigen::VectorXd generateSPVector();
 
   /*!
    * @brief Generate two perturbations to be used for gradient calculation:
@@ -124,17 +135,29 @@ class SPSA : public Optimizer {
    *
    * @param first New case. Variable values will be changed.
    * @param second New case. Variable values will be changed.
+   * @param delta The perturbation vector. Elements may be flipped to satisfy the bounds.
+   * @return True if the perturbations are valid. If they are not, the algorithm will attempt
+   * to generate new perturbations until a valid pair is found.
    */
-  void createPerturbations(Case *first, Case *second);
+  bool createPerturbations(Case *first, Case *second, Eigen::VectorXd &delta);
 
   /*!
-   * @brief Update g_k_ by using the two cases in perturbations_.
-   * The gradient is updated according to:
+   * @brief Update g_k_ by averaging the gradient estimates from the successfully evaluated pairs
+   * in perturbations_. The estimate from each pair is computed according to:
    * \$ g_k (\theta_k) = \frac{y(\theta_k + c_k \Delta_k)
    *                     - y(\theta_k - c_k \Delta_k}{2c_k}
    *                     * [\Delta^{-1}_{k1}, \Delta^{-1}_{k2}, ... , \Delta^{-1}_{kD} ]^T \$
+   *
+   * Also updates gradient_noise_.
+   * @return The number of pairs used.
+   */
+  int updateGradient();
+
+  /*!
+   * @brief Adapt the number of pairs to generate in the next iteration to gradient_noise_.
+   * Only done when max_gradient_pairs_ > min_gradient_pairs_.
    */
-  void updateGradient();
+  void updateGradientPairs();
 
   /*!
    * @brief Update the estimate_ field (estimated best position).
@@ -26,6 +26,8 @@
 #include "Utilities/time.hpp"
 #include "optimizers/bayesian_optimization/af_optimizers/AFPSO.h"
 #include "EGO.h"
+#include <algorithm>
+#include <cmath>
 
 namespace Optimization {
 namespace Optimizers {
@@ -41,8 +43,17 @@ EGO::EGO(Settings::Optimizer *settings,
 ) : Optimizer(settings, base_case, variables, grid, logger, case_handler, constraint_handler) {
 
     time_fitting_ = 0;
+    time_updating_ = 0;
+    time_checking_ = 0;
     time_af_opt_ = 0;
+    n_fits_ = 0;
+    iterations_since_fit_ = 0;
+    likelihood_at_fit_ = 0.0;
     settings_ = settings;
+    refit_interval_ = settings->parameters().ego_refit_interval;
+    refit_drift_ = settings->parameters().ego_refit_drift;
+    batch_size_ = settings->parameters().ego_batch_size;
+    async_ = settings->parameters().ego_async;
 
     initializeNormalizers();
     
@@ -154,7 +165,10 @@ Optimization::Optimizer::TerminationCondition EGO::IsFinished() {
     if (tc != NOT_FINISHED) {
         map<string, string> ext_state;
         ext_state["Time in AF opt"] = boost::lexical_cast<string>(time_af_opt_);
-        ext_state["Time in GP opt"] = boost::lexical_cast<string>(time_fitting_);
+        ext_state["Time in GP opt"] = Printer::num2str((time_fitting_ + time_updating_ + time_checking_) / 1000.0)
+            + " (hyperparameters: " + Printer::num2str(time_fitting_ / 1000.0) + " in " + Printer::num2str(n_fits_) + " fits"
+            + "; Cholesky updates: " + Printer::num2str(time_updating_ / 1000.0)
+            + "; likelihood checks: " + Printer::num2str(time_checking_ / 1000.0) + ")";
         if (enable_logging_) {
             logger_->AddEntry(this);
             logger_->AddEntry(new Summary(this, tc, ext_state));
@@ -163,20 +177,94 @@ Optimization::Optimizer::TerminationCondition EGO::IsFinished() {
     return tc;
 }
 void EGO::handleEvaluatedCase(Case *c) {
-    gp_->add_pattern(c->GetRealVarVector().data(), normalizer_ofv_.normalize(c->objective_function_value()));
+    observed_x_.push_back(c->GetRealVarVector());
+    observed_y_.push_back(normalizer_ofv_.normalize(c->objective_function_value()));
+    auto start = current_time();
+    gp_->add_pattern(observed_x_.back().data(), observed_y_.back());
+    time_updating_ += time_since_milliseconds(start);
     if (isImprovement(c)) {
         updateTentativeBestCase(c);
         Printer::ext_info("Found new tentative best case: " + Printer::num2str(c->objective_function_value()), "Optimization", "EGO");
     }
+
+    // Refill the pending cases once the first batch has been proposed
+    if (async_ && iteration_ > 0) {
+        int n_cases = casesToPropose();
+        if (n_cases > 0) {
+            proposeCases(n_cases);
+            iteration_++;
+        }
+    }
 }
 void EGO::iterate() {
     if (enable_logging_) {
         logger_->AddEntry(this);
     }
+    proposeCases(std::max(1, casesToPropose()));
+    iteration_++;
+}
+int EGO::casesToPropose() const {
+    int n_pending = case_handler_->QueuedCases().size() + case_handler_->CasesBeingEvaluated().size();
+    int n_remaining = max_evaluations_ + 1 - evaluated_cases_;
+    return std::min(batch_size_, n_remaining) - n_pending;
+}
+void EGO::proposeCases(int n_cases) {
+    fitHyperparameters();
 
-    // Optimize GP hyperparameters
     QDateTime start, end;
     start = QDateTime::currentDateTime();
+    QList<Case *> pending_cases = case_handler_->QueuedCases() + case_handler_->CasesBeingEvaluated();
+    libgp::GaussianProcess *gp = gp_;
+    if (n_cases > 1 || !pending_cases.isEmpty()) {
+        gp = believerProcess();
+        for (Case *pending : pending_cases) {
+            VectorXd position = pending->GetRealVarVector();
+            gp->add_pattern(position.data(), gp->f(position.data()));
+        }
+    }
+
+    double target = normalizer_ofv_.normalize(GetTentativeBestCase()->objective_function_value());
+    for (int k = 0; k < n_cases; ++k) {
+        VectorXd new_position = af_opt_.Optimize(gp, af_, target);
+
+        for (int i = 0; i < new_position.size(); ++i) {
+            if (new_position(i) < lb_(i)) {
+                new_position(i) = lb_(i);
+                cout << "Snapped to LB." << endl;
+            } else if (new_position(i) > ub_(i)) {
+                new_position(i) = ub_(i);
+                cout << "Snapped to UB." << endl;
+            }
+        }
+        Case *new_case = new Case(case_handler_->AllCases()[0]);
+        new_case->SetRealVarValues(new_position);
+        case_handler_->AddNewCase(new_case);
+
+        if (gp != gp_ && k < n_cases - 1) {
+            gp->add_pattern(new_position.data(), gp->f(new_position.data()));
+        }
+    }
+    if (gp != gp_) {
+        delete gp;
+    }
+    end = QDateTime::currentDateTime();
+    time_af_opt_ += time_span_seconds(start, end);
+}
+void EGO::fitHyperparameters() {
+    bool refit = n_fits_ == 0 || iterations_since_fit_ + 1 >= refit_interval_;
+    if (!refit) {
+        auto start = current_time();
+        double likelihood = gp_->log_likelihood() / std::max<size_t>(1, observed_x_.size());
+        time_checking_ += time_since_milliseconds(start);
+        refit = std::abs(likelihood - likelihood_at_fit_) > refit_drift_;
+    }
+    if (!refit) {
+        iterations_since_fit_++;
+        return;
+    }
+
+    // Optimize GP hyperparameters, starting from the current ones
+    auto start = current_time();
     libgp::RProp rprop;
     rprop.init();
     if (VERB_OPT >= 3) {
@@ -186,30 +274,18 @@ void EGO::iterate() {
     else {
         rprop.maximize(gp_, 100, 0);
     }
-    end = QDateTime::currentDateTime();
-    time_fitting_ += time_span_seconds(start, end);
-
-    start = QDateTime::currentDateTime();
-    VectorXd new_position = af_opt_.Optimize(
-        gp_, af_,
-        normalizer_ofv_.normalize(GetTentativeBestCase()->objective_function_value())
-    );
-    end = QDateTime::currentDateTime();
-    time_af_opt_ += time_span_seconds(start, end);
-
-    for (int i = 0; i < new_position.size(); ++i) {
-        if (new_position(i) < lb_(i)) {
-            new_position(i) = lb_(i);
-            cout << "Snapped to LB." << endl;
-        } else if (new_position(i) > ub_(i)) {
-            new_position(i) = ub_(i);
-            cout << "Snapped to UB." << endl;
-        }
+    likelihood_at_fit_ = gp_->log_likelihood() / std::max<size_t>(1, observed_x_.size());
+    time_fitting_ += time_since_milliseconds(start);
+    iterations_since_fit_ = 0;
+    n_fits_++;
+}
+libgp::GaussianProcess *EGO::believerProcess() const {
+    auto gp = new libgp::GaussianProcess(lb_.size(), settings_->parameters().ego_kernel);
+    gp->covf().set_loghyper(gp_->covf().get_loghyper());
+    for (int i = 0; i < observed_x_.size(); ++i) {
+        gp->add_pattern(observed_x_[i].data(), observed_y_[i]);
     }
-    Case *new_case = new Case(case_handler_->AllCases()[0]);
-    new_case->SetRealVarValues(new_position);
-    case_handler_->AddNewCase(new_case);
-    iteration_++;
+    return gp;
 }
 
 Loggable::LogTarget EGO::ConfigurationSummary::GetLogTarget() {
@@ -221,6 +297,8 @@ map<string, string> EGO::ConfigurationSummary::GetState() {
     statemap["Kernel"] = opt_->settings_->parameters().ego_kernel;
     statemap["Acquisition function"] = opt_->settings_->parameters().ego_af;
     statemap["AF Optimizer"] = "PSO";
+    statemap["Batch size"] = boost::lexical_cast<string>(opt_->batch_size_);
+    statemap["Async"] = opt_->async_ ? "Yes" : "No";
     statemap["Mode"] = opt_->mode_ == Settings::Optimizer::OptimizerMode::Maximize ? "Maximize" : "Minimize";
     statemap["Max Evaluations"] = boost::lexical_cast<string>(opt_->max_evaluations_);
     statemap["Num. initial guesses"] = boost::lexical_cast<string>(opt_->n_initial_guesses_);
@@ -34,7 +34,22 @@ namespace BayesianOptimization {
  * i.e. Bayesian Optimization using Gaussian Process models applied to derivative-
  * free optimization.
  *
- * \todo Hyperparameter optimization: after N cases, optimize the GP hyperparameters.
+ * By default one case is proposed pr. iteration. With EGO-BatchSize q > 1, q cases
+ * are proposed at once using the Kriging believer heuristic: after each proposal,
+ * the GP mean at the proposed point is added to a copy of the GP as if it had been
+ * observed, so that the next proposal is drawn away from it. Cases that are queued
+ * or being evaluated are treated the same way.
+ *
+ * With EGO-Async, new cases are also proposed whenever an evaluated case is submitted,
+ * keeping q cases pending at all times, instead of waiting for the whole batch.
+ *
+ * Adding an observation to the GP extends its Cholesky factor by one row, while
+ * optimizing the hyperparameters refactorizes the full covariance matrix for every
+ * RProp step. With EGO-RefitInterval N > 1 the hyperparameters are only optimized
+ * every N iterations, or earlier if the log likelihood pr. observation has drifted
+ * more than EGO-RefitDrift from its value after the last fit. Each fit starts from
+ * the previous hyperparameters.
+ *
  * \todo Convergence criterion: total squared error in model.
  * \todo Convergence criterion: Combination of highest expected value ans total squared uncertainty?
  */
@@ -50,6 +65,8 @@ class EGO : public Optimizer {
       Constraints::ConstraintHandler *constraint_handler=0
   );
 
+  int n_fits() const { return n_fits_; } //!< Number of hyperparameter optimizations performed.
+
  protected:
   void handleEvaluatedCase(Case *c) override;
   void iterate() override;
@@ -61,9 +78,44 @@ class EGO : public Optimizer {
   BayesianOptimization::AcquisitionFunction af_; //!< Acquisition function to be used throughout the optimization run.
   BayesianOptimization::AFOptimizers::AFPSO af_opt_; //!< Aquisition function optimizer to be used throughout the optimization run.
   Settings::Optimizer *settings_;
+  int batch_size_; //!< Number of cases proposed pr. iteration; in async mode the number of cases kept pending.
+  bool async_; //!< Whether new cases should be proposed when evaluated cases are submitted.
+  std::vector<VectorXd> observed_x_; //!< Positions of the cases added to the GP.
+  std::vector<double> observed_y_; //!< Normalized objective function values of the cases added to the GP.
 
   long int time_af_opt_;
-  long int time_fitting_;
+  long int time_fitting_; //!< Milliseconds spent optimizing GP hyperparameters.
+  long int time_updating_; //!< Milliseconds spent adding observations to the GP.
+  long int time_checking_; //!< Milliseconds spent checking the GP log likelihood drift.
+  int refit_interval_; //!< Max. number of iterations between hyperparameter optimizations.
+  double refit_drift_; //!< Log likelihood pr. observation drift that triggers a hyperparameter optimization.
+  int n_fits_; //!< Number of hyperparameter optimizations performed.
+  int iterations_since_fit_; //!< Number of proposal rounds since the last hyperparameter optimization.
+  double likelihood_at_fit_; //!< Log likelihood pr. observation after the last hyperparameter optimization.
+
+  /*!
+   * @brief Optimize the GP hyperparameters if the refit interval has passed or
+   * the log likelihood has drifted; otherwise keep the current ones.
+   */
+  void fitHyperparameters();
+
+  /*!
+   * @brief Fit the GP hyperparameters, then propose n_cases new cases and add them
+   * to the case handler. Pending cases are used as Kriging believer fantasies.
+   */
+  void proposeCases(int n_cases);
+
+  /*!
+   * @brief Create a new GP with the same hyperparameters and observations as gp_,
+   * to which fantasized observations can be added.
+   */
+  libgp::GaussianProcess *believerProcess() const;
+
+  /*!
+   * @brief Get the number of new cases needed to have batch_size_ cases pending,
+   * limited by the remaining evaluation budget.
+   */
+  int casesToPropose() const;
 
   class ConfigurationSummary : public Loggable {
    public:
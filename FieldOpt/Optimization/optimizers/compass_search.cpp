@@ -1,4 +1,6 @@
 #include <iostream>
+#include <cmath>
+#include <set>
 #include "compass_search.h"
 #include "gss_patterns.hpp"
 #include "Utilities/verbosity.h"
@@ -17,6 +19,7 @@ namespace Optimization {
         )
                 : GSS(settings, base_case, variables, grid, logger, case_handler, constraint_handler)
         {
+            pending_poll_points_ = 0;
             if (enable_logging_) {
                 logger_->AddEntry(this);
             }
@@ -31,9 +34,22 @@ namespace Optimization {
             if (enable_logging_) {
                 logger_->AddEntry(this);
             }
-            if (!is_successful_iteration() && iteration_ != 0)
-                contract();
-            case_handler_->AddNewCases(generate_trial_points());
+            vector<int> dirs = {-1};
+            if (iteration_ != 0) {
+                if (!is_successful_iteration())
+                    contract();
+                if (speculative_polling_)
+                    dirs = apply_speculative_results();
+            }
+            auto trial_points = generate_trial_points(dirs);
+            case_handler_->AddNewCases(trial_points);
+            if (speculative_polling_) {
+                pending_poll_points_ = trial_points.size();
+                auto speculative_points = generate_speculative_points(trial_points, max_queue_length_ - trial_points.size());
+                for (Case *c : speculative_points)
+                    speculative_cases_.insert(c->id());
+                case_handler_->AddNewCases(speculative_points);
+            }
             case_handler_->ClearRecentlyEvaluatedCases();
             iteration_++;
         }
@@ -63,12 +79,52 @@ namespace Optimization {
         }
 
         void CompassSearch::handleEvaluatedCase(Case *c) {
+            if (speculative_cases_.contains(c->id()))
+                return; // Applied in iterate(), when the outcome of the poll is known
             if (isImprovement(c))
                 updateTentativeBestCase(c);
+            if (speculative_polling_) {
+                update_direction_value(c);
+                if (--pending_poll_points_ == 0)
+                    dequeue_stale_cases();
+            }
         }
 
         bool CompassSearch::is_successful_iteration() {
             return case_handler_->RecentlyEvaluatedCases().contains(GetTentativeBestCase());
         }
 
+        vector<int> CompassSearch::apply_speculative_results() {
+            Case *origin = GetTentativeBestCase();
+            bool improved = false;
+            set<int> polled;
+            for (Case *c : case_handler_->RecentlyEvaluatedCases()) {
+                if (!speculative_cases_.contains(c->id()) || c->origin_case() != origin)
+                    continue;
+                if (isImprovement(c)) {
+                    updateTentativeBestCase(c);
+                    improved = true;
+                }
+                else {
+                    int dir = c->origin_direction_index();
+                    if (std::abs(c->origin_step_length() - step_lengths_(dir)) <= 1e-9 * step_lengths_(dir))
+                        polled.insert(dir);
+                }
+            }
+            speculative_cases_.clear();
+
+            if (improved || polled.empty())
+                return vector<int>{-1};
+            if (polled.size() == directions_.size()) { // The whole next poll was unsuccessful
+                contract();
+                return vector<int>{-1};
+            }
+            vector<int> dirs;
+            for (size_t dir = 0; dir < directions_.size(); ++dir) {
+                if (polled.count(dir) == 0)
+                    dirs.push_back(dir);
+            }
+            return dirs;
+        }
+
     }}
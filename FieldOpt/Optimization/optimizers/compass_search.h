@@ -1,6 +1,7 @@
 #ifndef COMPASSSEARCH_H
 #define COMPASSSEARCH_H
 
+#include <QSet>
 #include "Optimization/optimizer.h"
 #include "GSS.h"
 
@@ -13,6 +14,12 @@ namespace Optimization {
  *
  * This algorithm only supports integer and real variables, and not both at the same time.
  *
+ * With SpeculativePolling, each poll is queued along with the points of the following poll
+ * (see GSS::generate_speculative_points), so that spare workers can evaluate them in parallel.
+ * The speculative results are only applied when the outcome of the poll is known: the points
+ * that are no longer relevant are then dequeued, and the evaluated ones from the tentative best
+ * case are used in place of the corresponding points of the next poll.
+ *
  * Reference:
  *
  * Kolda, Tamara G., Robert Michael Lewis, and Virginia Torczon.
@@ -38,6 +45,16 @@ namespace Optimization {
             void iterate(); //!< Step or contract, perturb, and clear list of recently evaluated cases.
             bool is_successful_iteration(); //!< Check if this iteration was successful (i.e. if the current tent. best case was found in this iteration).
 
+            /*!
+             * @brief Apply the evaluated speculative points from the tentative best case: move to the
+             * best one if it is an improvement, otherwise treat them as evaluated points of the next poll.
+             * @return The directions that remain to be polled.
+             */
+            vector<int> apply_speculative_results();
+
+            QSet<QUuid> speculative_cases_; //!< Ids of the speculative points queued with the current poll.
+            int pending_poll_points_; //!< Number of points in the current poll that have not been evaluated.
+
         protected:
             void handleEvaluatedCase(Case *c) override;
         };
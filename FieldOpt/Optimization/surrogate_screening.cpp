@@ -0,0 +1,236 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#include "surrogate_screening.h"
+#include "Runner/logger.h"
+#include "Utilities/printer.hpp"
+#include "Utilities/verbosity.h"
+#include "gp/gp.h"
+#include "gp/rprop.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace Optimization {
+
+void RBFSurrogate::Fit(const std::deque<Eigen::VectorXd> &xs, const std::deque<double> &ys) {
+    int m = xs.size();
+    int n = xs[0].size();
+    // The linear tail needs at least n+1 samples to be determined, and one more to be useful
+    int n_tail = m >= n + 2 ? n + 1 : 1;
+
+    centers_.resize(n, m);
+    for (int i = 0; i < m; ++i) {
+        centers_.col(i) = xs[i];
+    }
+
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(m + n_tail, m + n_tail);
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < i; ++j) {
+            A(i, j) = A(j, i) = std::pow((centers_.col(i) - centers_.col(j)).norm(), 3);
+        }
+        A(i, i) = 1e-8; // Small nugget, keeping the system solvable if a position is sampled twice
+        A(i, m) = A(m, i) = 1.0;
+        if (n_tail > 1) {
+            A.block(i, m + 1, 1, n) = centers_.col(i).transpose();
+            A.block(m + 1, i, n, 1) = centers_.col(i);
+        }
+    }
+    Eigen::VectorXd rhs = Eigen::VectorXd::Zero(m + n_tail);
+    for (int i = 0; i < m; ++i) {
+        rhs(i) = ys[i];
+    }
+    Eigen::VectorXd solution = A.colPivHouseholderQr().solve(rhs);
+    weights_ = solution.head(m);
+    tail_ = solution.tail(n_tail);
+}
+
+double RBFSurrogate::Predict(const Eigen::VectorXd &x) {
+    Eigen::VectorXd r = (centers_.colwise() - x).colwise().norm().transpose();
+    double value = weights_.dot(r.array().cube().matrix()) + tail_(0);
+    if (tail_.size() > 1) {
+        value += tail_.tail(x.size()).dot(x);
+    }
+    return value;
+}
+
+GPSurrogate::GPSurrogate(int n_vars, const std::string &kernel) {
+    n_vars_ = n_vars;
+    kernel_ = kernel;
+    gp_ = nullptr;
+    position_.resize(n_vars);
+}
+
+GPSurrogate::~GPSurrogate() {
+    delete gp_;
+}
+
+void GPSurrogate::Fit(const std::deque<Eigen::VectorXd> &xs, const std::deque<double> &ys) {
+    // The window moves, so the process is rebuilt rather than updated
+    delete gp_;
+    gp_ = new libgp::GaussianProcess(n_vars_, kernel_);
+    if (loghyper_.size() == 0) {
+        loghyper_ = Eigen::VectorXd::Constant(gp_->covf().get_param_dim(), -1);
+    }
+    gp_->covf().set_loghyper(loghyper_);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        position_ = xs[i];
+        gp_->add_pattern(position_.data(), ys[i]);
+    }
+    libgp::RProp rprop;
+    rprop.init();
+    rprop.maximize(gp_, 50, 0);
+    loghyper_ = gp_->covf().get_loghyper();
+}
+
+double GPSurrogate::Predict(const Eigen::VectorXd &x) {
+    position_ = x;
+    return gp_->f(position_.data());
+}
+
+SurrogateScreening::SurrogateScreening(const Settings::Optimizer::Parameters &parameters,
+                                       Settings::Optimizer::OptimizerMode mode,
+                                       const Eigen::VectorXd &lower_bound,
+                                       const Eigen::VectorXd &upper_bound,
+                                       const std::string &owner) {
+    mode_ = mode;
+    type_ = parameters.surrogate_screening;
+    owner_ = owner;
+    fraction_ = parameters.surrogate_screening_fraction;
+    window_ = parameters.surrogate_screening_window;
+    int n_vars = lower_bound.size();
+    if (parameters.surrogate_screening_min_samples < 0)
+        min_samples_ = std::min(window_, 2 * (n_vars + 1));
+    else min_samples_ = std::min(window_, parameters.surrogate_screening_min_samples);
+    min_samples_ = std::max(min_samples_, 2);
+
+    if (type_ == "RBF")
+        model_ = new RBFSurrogate();
+    else if (type_ == "GP")
+        model_ = new GPSurrogate(n_vars, parameters.ego_kernel);
+    else throw std::runtime_error("Surrogate screening type " + type_ + " not recognized.");
+    needs_fit_ = false;
+
+    lower_bound_ = lower_bound;
+    scale_ = upper_bound - lower_bound;
+    for (int i = 0; i < n_vars; ++i) {
+        if (scale_(i) <= 0) scale_(i) = 1.0;
+    }
+    ofv_mean_ = 0.0;
+    ofv_std_ = 1.0;
+    screened_cases_ = 0;
+    rejected_cases_ = 0;
+
+    if (VERB_OPT > 1) {
+        Printer::ext_info("Screening candidates with a " + type_ + " surrogate fitted to the last "
+                              + Printer::num2str(window_) + " evaluated cases. Screening starts after "
+                              + Printer::num2str(min_samples_) + " evaluations.", "Optimization", owner_);
+    }
+}
+
+SurrogateScreening::~SurrogateScreening() {
+    delete model_;
+}
+
+void SurrogateScreening::AddSample(Case *c) {
+    double ofv = c->objective_function_value();
+    if (!std::isfinite(ofv)) return;
+    xs_.push_back(normalize(c->GetRealVarVector()));
+    ofvs_.push_back(ofv);
+    if ((int)xs_.size() > window_) {
+        xs_.pop_front();
+        ofvs_.pop_front();
+    }
+    needs_fit_ = true;
+}
+
+std::vector<bool> SurrogateScreening::Screen(const QList<Case *> &candidates, Logger *logger) {
+    int n = candidates.size();
+    std::vector<bool> accepted(n, true);
+    int n_keep = std::max(1, (int)std::ceil(fraction_ * n));
+    if (!IsActive() || n_keep >= n) {
+        return accepted;
+    }
+    if (needs_fit_) {
+        fit();
+    }
+
+    std::vector<double> predictions(n);
+    for (int i = 0; i < n; ++i) {
+        predictions[i] = ofv_mean_ + ofv_std_ * model_->Predict(normalize(candidates[i]->GetRealVarVector()));
+        if (!std::isfinite(predictions[i])) {
+            Printer::ext_warn("The " + type_ + " surrogate predicted a non-finite value. Accepting all candidates.",
+                              "Optimization", owner_);
+            return accepted;
+        }
+    }
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        if (mode_ == Settings::Optimizer::OptimizerMode::Maximize)
+            return predictions[a] > predictions[b];
+        else return predictions[a] < predictions[b];
+    });
+
+    std::stringstream ss;
+    ss.precision(6);
+    ss << std::scientific;
+    ss << "Rejected " << n - n_keep << " of " << n << " candidates using the " << type_ << " surrogate.";
+    for (int k = n_keep; k < n; ++k) {
+        Case *rejected = candidates[order[k]];
+        accepted[order[k]] = false;
+        rejected->state.eval = Case::CaseState::EvalStatus::E_SCREENED;
+        rejected->set_objective_function_value(predictions[order[k]]);
+        if (logger != nullptr) {
+            logger->AddEntry(rejected);
+        }
+        ss << "|Case " << rejected->id_stdstr() << ": predicted OFV " << predictions[order[k]];
+    }
+    screened_cases_ += n;
+    rejected_cases_ += n - n_keep;
+    if (VERB_OPT >= 1) {
+        Printer::ext_info(ss.str(), "Optimization", owner_);
+    }
+    return accepted;
+}
+
+void SurrogateScreening::fit() {
+    int m = ofvs_.size();
+    ofv_mean_ = std::accumulate(ofvs_.begin(), ofvs_.end(), 0.0) / m;
+    double variance = 0.0;
+    for (double ofv : ofvs_) {
+        variance += (ofv - ofv_mean_) * (ofv - ofv_mean_);
+    }
+    ofv_std_ = std::sqrt(variance / m);
+    if (ofv_std_ <= 0.0) ofv_std_ = 1.0;
+
+    ys_.resize(m);
+    for (int i = 0; i < m; ++i) {
+        ys_[i] = (ofvs_[i] - ofv_mean_) / ofv_std_;
+    }
+    model_->Fit(xs_, ys_);
+    needs_fit_ = false;
+}
+
+Eigen::VectorXd SurrogateScreening::normalize(const Eigen::VectorXd &x) const {
+    return (x - lower_bound_).cwiseQuotient(scale_);
+}
+
+}
@@ -0,0 +1,173 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#ifndef FIELDOPT_SURROGATE_SCREENING_H
+#define FIELDOPT_SURROGATE_SCREENING_H
+
+#include "case.h"
+#include "Settings/optimizer.h"
+#include <Eigen/Core>
+#include <QList>
+#include <deque>
+#include <string>
+#include <vector>
+
+class Logger;
+
+namespace libgp {
+class GaussianProcess;
+}
+
+namespace Optimization {
+
+/*!
+ * @brief The SurrogateModel class is the interface for the cheap models used by
+ * SurrogateScreening to predict objective function values.
+ *
+ * The models are fitted to, and evaluated at, normalized positions (each variable scaled
+ * to [0, 1] by its bounds) and standardized objective function values.
+ */
+class SurrogateModel {
+ public:
+  virtual ~SurrogateModel() {}
+
+  /*!
+   * @brief Fit the model to a set of samples, replacing any previous fit.
+   * @param xs The sample positions.
+   * @param ys The objective function values at the sample positions.
+   */
+  virtual void Fit(const std::deque<Eigen::VectorXd> &xs, const std::deque<double> &ys) = 0;
+
+  /*!
+   * @brief Predict the objective function value at a position.
+   */
+  virtual double Predict(const Eigen::VectorXd &x) = 0;
+};
+
+/*!
+ * @brief Radial basis function interpolant with the cubic kernel phi(r) = r^3
+ * and a linear polynomial tail. When there are too few samples to determine the
+ * linear tail, a constant tail is used.
+ */
+class RBFSurrogate : public SurrogateModel {
+ public:
+  void Fit(const std::deque<Eigen::VectorXd> &xs, const std::deque<double> &ys) override;
+  double Predict(const Eigen::VectorXd &x) override;
+
+ private:
+  Eigen::MatrixXd centers_; //!< The sample positions, one pr. column.
+  Eigen::VectorXd weights_; //!< The weight of each radial basis function.
+  Eigen::VectorXd tail_;    //!< Coefficients of the polynomial tail (constant term first).
+};
+
+/*!
+ * @brief Gaussian process model using libgp (the same library as the EGO optimizer).
+ * The process is rebuilt from the samples on each fit, and its hyperparameters are
+ * optimized with RProp.
+ */
+class GPSurrogate : public SurrogateModel {
+ public:
+  GPSurrogate(int n_vars, const std::string &kernel);
+  ~GPSurrogate() override;
+  void Fit(const std::deque<Eigen::VectorXd> &xs, const std::deque<double> &ys) override;
+  double Predict(const Eigen::VectorXd &x) override;
+
+ private:
+  int n_vars_;
+  std::string kernel_;
+  libgp::GaussianProcess *gp_;
+  Eigen::VectorXd loghyper_; //!< Hyperparameters from the last fit, used as starting point for the next one.
+  Eigen::VectorXd position_; //!< Buffer for the position to predict at.
+};
+
+/*!
+ * @brief The SurrogateScreening class pre-screens candidate cases before they are
+ * sent to simulation.
+ *
+ * A surrogate model is fitted to the most recently evaluated cases (a bounded window),
+ * and is used to predict the objective function value of each candidate in a batch.
+ * Only the best predicted fraction of the batch is accepted for simulation. Rejected
+ * candidates are marked E_SCREENED, given their predicted value, and written to the
+ * case log.
+ *
+ * Screening only starts once the window holds enough evaluated cases; until then, all
+ * candidates are accepted.
+ */
+class SurrogateScreening {
+ public:
+  /*!
+   * @param parameters Optimizer parameters holding the surrogate_screening settings.
+   * @param mode Optimization mode, determining which predictions are best.
+   * @param lower_bound Lower bounds of the variables, used to normalize positions.
+   * @param upper_bound Upper bounds of the variables, used to normalize positions.
+   * @param owner Name of the optimizer using the screening, used when printing.
+   */
+  SurrogateScreening(const Settings::Optimizer::Parameters &parameters,
+                     Settings::Optimizer::OptimizerMode mode,
+                     const Eigen::VectorXd &lower_bound,
+                     const Eigen::VectorXd &upper_bound,
+                     const std::string &owner);
+  ~SurrogateScreening();
+
+  /*!
+   * @brief Add an evaluated case to the samples the surrogate is fitted to. The oldest
+   * sample is dropped when the window is full. Cases without a finite objective function
+   * value are ignored.
+   */
+  void AddSample(Case *c);
+
+  /*!
+   * @brief Screen a batch of candidates. Rejected candidates get the E_SCREENED state
+   * and their predicted objective function value.
+   * @param candidates The candidates to be screened.
+   * @param logger Logger to write the rejected candidates to the case log with. Nothing
+   * is logged if it is null.
+   * @return A vector holding, for each candidate, whether it should be simulated.
+   */
+  std::vector<bool> Screen(const QList<Case *> &candidates, Logger *logger=nullptr);
+
+  bool IsActive() const { return (int)xs_.size() >= min_samples_; } //!< Whether enough samples are available to screen candidates.
+  int screened_cases() const { return screened_cases_; } //!< Number of candidates screened while active.
+  int rejected_cases() const { return rejected_cases_; } //!< Number of candidates rejected.
+
+ private:
+  Settings::Optimizer::OptimizerMode mode_;
+  std::string type_;  //!< Surrogate type (RBF or GP).
+  std::string owner_; //!< Name of the optimizer using the screening.
+  double fraction_;   //!< Fraction of each batch to accept.
+  int window_;        //!< Maximum number of samples.
+  int min_samples_;   //!< Number of samples needed before screening starts.
+  SurrogateModel *model_;
+  bool needs_fit_;    //!< Whether samples have been added since the last fit.
+
+  Eigen::VectorXd lower_bound_;
+  Eigen::VectorXd scale_; //!< Width of the bounds of each variable.
+  std::deque<Eigen::VectorXd> xs_; //!< Normalized positions of the samples.
+  std::deque<double> ofvs_;        //!< Objective function values of the samples.
+  std::deque<double> ys_;          //!< Standardized objective function values of the samples, set on fit.
+  double ofv_mean_;
+  double ofv_std_;
+
+  int screened_cases_;
+  int rejected_cases_;
+
+  void fit(); //!< Standardize the objective function values and fit the model.
+  Eigen::VectorXd normalize(const Eigen::VectorXd &x) const;
+};
+
+}
+
+#endif //FIELDOPT_SURROGATE_SCREENING_H
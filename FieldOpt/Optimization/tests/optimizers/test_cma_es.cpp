@@ -90,6 +90,27 @@ namespace {
         EXPECT_NEAR(1.0, best_case->GetRealVarVector()[1], 3);
     }
 
+    TEST_F(CMA_ESTest, EigenInterval) {
+        auto json = get_json_settings_cma_es_minimize_;
+        auto parameters = json["Parameters"].toObject();
+        parameters.insert("CMA-ES-EigenInterval", 5);
+        json["Parameters"] = parameters;
+        auto settings = new Settings::Optimizer(json);
+        EXPECT_EQ(5, settings->parameters().cma_es_eigen_interval);
+        settings->SetRngSeed(5);
+
+        test_case_ga_spherical_6r_->set_objective_function_value(abs(Sphere(test_case_ga_spherical_6r_->GetRealVarVector())));
+        Optimization::Optimizer *minimizer = new CMA_ES(settings, test_case_ga_spherical_6r_, varcont_6r_, grid_5spot_, logger_);
+
+        while (!minimizer->IsFinished()) {
+            auto next_case = minimizer->GetCaseForEvaluation();
+            next_case->set_objective_function_value(abs(Sphere(next_case->GetRealVarVector())));
+            minimizer->SubmitEvaluatedCase(next_case);
+        }
+        auto best_case = minimizer->GetTentativeBestCase();
+        EXPECT_NEAR(0.0, best_case->objective_function_value(), 0.12);
+    }
+
 }
 
 
@@ -102,5 +102,58 @@ namespace {
         EXPECT_NEAR(1.0, best_case->GetRealVarVector()[1], 2.5);
     }
 
+    TEST_F(CompassSearchTest, SpeculativePolling) {
+        auto json = get_json_settings_compass_search_minimize_;
+        auto parameters = json["Parameters"].toObject();
+        parameters.insert("SpeculativePolling", true);
+        parameters.insert("SpeculativeExpansion", true);
+        json["Parameters"] = parameters;
+        auto settings = new Settings::Optimizer(json);
+
+        test_case_2r_->set_objective_function_value(Sphere(test_case_2r_->GetRealVarVector()));
+        Optimization::Optimizer *minimizer = new CompassSearch(settings,
+                                                               test_case_2r_,
+                                                               varcont_prod_bhp_,
+                                                               grid_5spot_,
+                                                               logger_
+        );
+
+        // The poll (4 points) is queued with 4 speculative points, up to MaxQueueSize * 4 cases
+        QList<Optimization::Case *> poll;
+        for (int i = 0; i < 4; ++i)
+            poll << minimizer->GetCaseForEvaluation();
+        EXPECT_EQ(4, minimizer->nr_queued_cases());
+        for (auto c : poll) {
+            EXPECT_EQ(test_case_2r_, c->origin_case());
+            EXPECT_DOUBLE_EQ(0.25, c->origin_step_length());
+        }
+
+        // Contracted from the base case and expanded from the poll point, in the first direction
+        auto contracted = minimizer->GetCaseForEvaluation();
+        auto expanded = minimizer->GetCaseForEvaluation();
+        EXPECT_EQ(test_case_2r_, contracted->origin_case());
+        EXPECT_DOUBLE_EQ(0.125, contracted->origin_step_length());
+        EXPECT_EQ(poll[0], expanded->origin_case());
+        EXPECT_DOUBLE_EQ(poll[0]->GetRealVarVector()[0] + 0.25, expanded->GetRealVarVector()[0]);
+
+        // The base case is in the positive quadrant, so the poll is successful in a negative
+        // direction and the remaining speculative points are dequeued.
+        for (auto c : QList<Optimization::Case *>({contracted, expanded}) + poll) {
+            c->set_objective_function_value(Sphere(c->GetRealVarVector()));
+            minimizer->SubmitEvaluatedCase(c);
+        }
+        EXPECT_EQ(0, minimizer->nr_queued_cases());
+        EXPECT_LT(minimizer->GetTentativeBestCase()->objective_function_value(),
+                  test_case_2r_->objective_function_value());
+
+        while (!minimizer->IsFinished()) {
+            auto next_case = minimizer->GetCaseForEvaluation();
+            next_case->set_objective_function_value(Sphere(next_case->GetRealVarVector()));
+            minimizer->SubmitEvaluatedCase(next_case);
+        }
+        auto best_case = minimizer->GetTentativeBestCase();
+        EXPECT_NEAR(0.0, best_case->objective_function_value(), 0.1);
+    }
+
 }
 
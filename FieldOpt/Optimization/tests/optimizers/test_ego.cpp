@@ -123,6 +123,101 @@ TEST_F(EGOTest, SingleIteration) {
     cout << next_case->objective_function_value() << endl;
 }
 
+TEST_F(EGOTest, BatchProposals) {
+    QJsonObject json_settings = get_json_settings_ego_maximize_;
+    QJsonObject json_parameters = json_settings["Parameters"].toObject();
+    json_parameters["EGO-BatchSize"] = 4;
+    json_parameters["EGO-Async"] = true;
+    json_settings["Parameters"] = json_parameters;
+    auto settings = new Settings::Optimizer(json_settings);
+    EXPECT_EQ(4, settings->parameters().ego_batch_size);
+    EXPECT_TRUE(settings->parameters().ego_async);
+
+    test_case_ga_spherical_6r_->set_objective_function_value(- abs(Sphere(test_case_ga_spherical_6r_->GetRealVarVector())));
+    Optimization::Optimizer *ego = new BayesianOptimization::EGO(settings,
+                                                                 test_case_ga_spherical_6r_,
+                                                                 varcont_6r_,
+                                                                 grid_5spot_,
+                                                                 logger_
+    );
+    auto evaluate = [](Optimization::Case *c) {
+      c->set_objective_function_value(- abs(Sphere(c->GetRealVarVector())));
+      c->state.eval = Optimization::Case::CaseState::EvalStatus::E_DONE;
+    };
+
+    // Evaluate the initial guesses
+    int n_initial = ego->case_handler()->QueuedCases().size();
+    for (int i = 0; i < n_initial; ++i) {
+        auto next_case = ego->GetCaseForEvaluation();
+        evaluate(next_case);
+        ego->SubmitEvaluatedCase(next_case);
+    }
+    EXPECT_EQ(0, ego->case_handler()->QueuedCases().size());
+
+    // The first iteration proposes a full batch of distinct cases
+    auto c1 = ego->GetCaseForEvaluation();
+    EXPECT_EQ(3, ego->case_handler()->QueuedCases().size());
+    for (auto queued : ego->case_handler()->QueuedCases()) {
+        EXPECT_FALSE(queued->Equals(c1));
+    }
+
+    // Cases are proposed as soon as evaluated cases are submitted, keeping four pending
+    auto c2 = ego->GetCaseForEvaluation();
+    evaluate(c1);
+    ego->SubmitEvaluatedCase(c1);
+    EXPECT_EQ(1, ego->case_handler()->CasesBeingEvaluated().size());
+    EXPECT_EQ(3, ego->case_handler()->QueuedCases().size());
+    evaluate(c2);
+    ego->SubmitEvaluatedCase(c2);
+    EXPECT_EQ(4, ego->case_handler()->QueuedCases().size());
+}
+
+TEST_F(EGOTest, SparseHyperparameterFits) {
+    // Run EGO with the given refit settings, returning the number of proposal rounds
+    // and hyperparameter fits
+    auto run = [&](int refit_interval, double refit_drift) {
+        QJsonObject json_settings = get_json_settings_ego_maximize_;
+        QJsonObject json_parameters = json_settings["Parameters"].toObject();
+        json_parameters["EGO-RefitInterval"] = refit_interval;
+        json_parameters["EGO-RefitDrift"] = refit_drift;
+        json_settings["Parameters"] = json_parameters;
+        auto settings = new Settings::Optimizer(json_settings);
+        EXPECT_EQ(refit_interval, settings->parameters().ego_refit_interval);
+        EXPECT_DOUBLE_EQ(refit_drift, settings->parameters().ego_refit_drift);
+
+        test_case_ga_spherical_6r_->set_objective_function_value(- abs(Sphere(test_case_ga_spherical_6r_->GetRealVarVector())));
+        auto ego = new BayesianOptimization::EGO(settings,
+                                                 test_case_ga_spherical_6r_,
+                                                 varcont_6r_,
+                                                 grid_5spot_,
+                                                 logger_
+        );
+        int rounds = 0;
+        while (ego->IsFinished() == Optimization::Optimizer::TerminationCondition::NOT_FINISHED) {
+            if (ego->nr_queued_cases() == 0) rounds++; // New cases are proposed in this call
+            auto next_case = ego->GetCaseForEvaluation();
+            next_case->set_objective_function_value(- abs(Sphere(next_case->GetRealVarVector())));
+            next_case->state.eval = Optimization::Case::CaseState::EvalStatus::E_DONE;
+            ego->SubmitEvaluatedCase(next_case);
+        }
+        return std::make_pair(rounds, ego->n_fits());
+    };
+
+    // Refit every round (the default)
+    auto every = run(1, 0.1);
+    EXPECT_GT(every.first, 10);
+    EXPECT_EQ(every.first, every.second);
+
+    // Refit in the first round, then every fifth round; the drift never triggers a refit
+    auto sparse = run(5, 1e9);
+    EXPECT_GT(sparse.first, 10);
+    EXPECT_EQ((sparse.first - 1) / 5 + 1, sparse.second);
+
+    // Any drift triggers a refit, regardless of the interval
+    auto drift = run(5, 0.0);
+    EXPECT_EQ(drift.first, drift.second);
+}
+
 TEST_F(EGOTest, TestFunctionSpherical) {
     test_case_ga_spherical_6r_->set_objective_function_value(- abs(Sphere(test_case_ga_spherical_6r_->GetRealVarVector())));
     Optimization::Optimizer *ego = new BayesianOptimization::EGO(settings_ego_max_,
@@ -103,4 +103,31 @@ TEST_F(PSOTest, TestFunctionDecayRosenbrock) {
     EXPECT_NEAR(1.0, best_case->GetRealVarVector()[1], 0.5);
 }
 
+TEST_F(PSOTest, SurrogateScreening) {
+    auto json = get_json_settings_pso_minimize_;
+    auto parameters = json["Parameters"].toObject();
+    parameters.insert("MaxGenerations", 20);
+    parameters.insert("SurrogateScreening", "RBF");
+    parameters.insert("SurrogateScreeningFraction", 0.5);
+    json["Parameters"] = parameters;
+    auto settings = new Settings::Optimizer(json);
+
+    test_case_ga_spherical_6r_->set_objective_function_value(Sphere(test_case_ga_spherical_6r_->GetRealVarVector()));
+    Optimization::Optimizer *minimizer = new PSO(settings, test_case_ga_spherical_6r_, varcont_6r_, grid_5spot_, logger_);
+
+    int evaluated = 0;
+    while (!minimizer->IsFinished()) {
+        auto next_case = minimizer->GetCaseForEvaluation();
+        next_case->set_objective_function_value(Sphere(next_case->GetRealVarVector()));
+        minimizer->SubmitEvaluatedCase(next_case);
+        evaluated++;
+    }
+
+    // The initial swarm and the first generation are evaluated in full, until the surrogate
+    // has 2*(6+1) samples. Only half of each of the remaining 19 generations is evaluated.
+    EXPECT_EQ(10 + 10 + 19 * 5, evaluated);
+    EXPECT_LT(minimizer->GetTentativeBestCase()->objective_function_value(),
+              test_case_ga_spherical_6r_->objective_function_value());
+}
+
 }
@@ -86,5 +86,48 @@ TEST_F(SPSATest, TestFunctionSphericalMaximize) {
 //    EXPECT_NEAR(0.0, best_case->objective_function_value(), 1.0);
 }
 
+TEST_F(SPSATest, GradientPairs) {
+    auto json = get_json_settings_spsa_minimize_;
+    auto parameters = json["Parameters"].toObject();
+    parameters.insert("SPSA-MaxIterations", 20);
+    parameters.insert("SPSA-GradientPairs", 3);
+    parameters.insert("SPSA-MaxGradientPairs", 12);
+    parameters.insert("SPSA-CommonRandomNumbers", true);
+    json["Parameters"] = parameters;
+    auto settings = new Settings::Optimizer(json);
+    EXPECT_EQ(3, settings->parameters().spsa_gradient_pairs);
+    EXPECT_EQ(12, settings->parameters().spsa_max_gradient_pairs);
+
+    double initial_ofv = abs(Sphere(test_case_ga_spherical_6r_->GetRealVarVector()));
+    test_case_ga_spherical_6r_->set_objective_function_value(initial_ofv);
+    Optimization::Optimizer *minimizer = new SPSA(settings, test_case_ga_spherical_6r_, varcont_6r_, grid_5spot_, logger_);
+
+    // All pairs of an iteration are queued as one batch
+    QList<Optimization::Case *> batch;
+    batch << minimizer->GetCaseForEvaluation();
+    while (minimizer->nr_queued_cases() > 0) {
+        batch << minimizer->GetCaseForEvaluation();
+    }
+    ASSERT_EQ(6, batch.size());
+
+    // Both cases of a pair share a realization selection key
+    EXPECT_EQ(batch[0]->GetRealizationSelectionKey(), batch[1]->GetRealizationSelectionKey());
+    EXPECT_NE(batch[0]->GetRealizationSelectionKey(), batch[2]->GetRealizationSelectionKey());
+    EXPECT_GE(batch[5]->GetRealizationSelectionKey(), 0);
+
+    for (auto c : batch) {
+        c->set_objective_function_value(abs(Sphere(c->GetRealVarVector())));
+        c->state.eval = Optimization::Case::CaseState::E_DONE;
+        minimizer->SubmitEvaluatedCase(c);
+    }
+    while (!minimizer->IsFinished()) {
+        auto next_case = minimizer->GetCaseForEvaluation();
+        next_case->set_objective_function_value(abs(Sphere(next_case->GetRealVarVector())));
+        next_case->state.eval = Optimization::Case::CaseState::E_DONE;
+        minimizer->SubmitEvaluatedCase(next_case);
+    }
+    EXPECT_LE(minimizer->GetTentativeBestCase()->objective_function_value(), initial_ofv);
+}
+
 }
 
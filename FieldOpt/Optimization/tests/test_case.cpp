@@ -109,4 +109,38 @@ namespace {
         EXPECT_EQ(tc1_updated[2], tc1_ivec_init[2] + delta_vec[2]);
     }
 
+    TEST_F(CaseTest, VariableSchema) {
+        // Copies share the schema of the original, and store values in the same order
+        Optimization::Case *copy = new Optimization::Case(test_case_3_4b3i3r_);
+        EXPECT_EQ(test_case_3_4b3i3r_->variable_schema(), copy->variable_schema());
+        EXPECT_EQ(3, copy->NumberOfRealVariables());
+        for (int i = 0; i < copy->real_variable_ids().size(); ++i) {
+            auto id = copy->real_variable_ids()[i];
+            EXPECT_DOUBLE_EQ(test_case_3_4b3i3r_->real_variables()[id], copy->GetRealVarVector()[i]);
+            EXPECT_DOUBLE_EQ(test_case_3_4b3i3r_->real_variables()[id], copy->real_variable_value(id));
+        }
+        for (auto id : copy->binary_variable_ids()) {
+            EXPECT_EQ(test_case_3_4b3i3r_->binary_variables()[id], copy->binary_variable_value(id));
+        }
+        EXPECT_THROW(copy->real_variable_value(QUuid::createUuid()), Optimization::VariableException);
+
+        // Setting values for the same variables keeps the schema
+        auto real_variables = copy->real_variables();
+        real_variables[real_variables.keys().first()] += 1.0;
+        copy->set_real_variables(real_variables);
+        EXPECT_EQ(test_case_3_4b3i3r_->variable_schema(), copy->variable_schema());
+        EXPECT_FALSE(copy->Equals(test_case_3_4b3i3r_));
+        EXPECT_TRUE(copy->Equals(test_case_3_4b3i3r_, 1.0));
+
+        // Setting other variables creates a new schema
+        copy->set_real_variables(QHash<QUuid, double>{{QUuid::createUuid(), 1.0}});
+        EXPECT_NE(test_case_3_4b3i3r_->variable_schema(), copy->variable_schema());
+        EXPECT_EQ(1, copy->NumberOfRealVariables());
+        EXPECT_EQ(4, copy->NumberOfBinaryVariables());
+        EXPECT_FALSE(copy->Equals(test_case_3_4b3i3r_));
+
+        EXPECT_THROW(copy->SetRealVarValues(Eigen::VectorXd::Zero(2)), Optimization::VariableException);
+        delete copy;
+    }
+
 }
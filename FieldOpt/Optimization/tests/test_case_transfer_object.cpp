@@ -70,4 +70,36 @@ namespace {
 
 
     }
+
+    TEST_F(CaseTransferObjectTest, PackAndUnpack) {
+        auto index = CaseTransferObject::VariableIndex(test_case_3_4b3i3r_->binary_variables().keys(),
+                                                       test_case_3_4b3i3r_->integer_variables().keys(),
+                                                       test_case_3_4b3i3r_->real_variables().keys());
+        test_case_3_4b3i3r_->SetEnsembleRealization("R1");
+        test_case_3_4b3i3r_->state.eval = Case::CaseState::EvalStatus::E_DONE;
+        std::vector<char> buffer;
+        CaseTransferObject::Pack(QList<Case *>() << test_case_3_4b3i3r_ << test_case_4_4b3i3r, index, buffer);
+
+        auto cases = CaseTransferObject::Unpack(buffer, index);
+        ASSERT_EQ(2, cases.size());
+        auto c = cases[0];
+        EXPECT_TRUE(test_case_3_4b3i3r_->Equals(c));
+        EXPECT_EQ(index.schema(), c->variable_schema());
+        EXPECT_TRUE(test_case_3_4b3i3r_->id() == c->id());
+        EXPECT_TRUE(test_case_4_4b3i3r->id() == cases[1]->id());
+        EXPECT_FLOAT_EQ(test_case_3_4b3i3r_->objective_function_value(), c->objective_function_value());
+        EXPECT_EQ(test_case_3_4b3i3r_->GetWICTime(), c->GetWICTime());
+        EXPECT_STREQ("R1", c->GetEnsembleRealization().toStdString().c_str());
+        EXPECT_EQ(Case::CaseState::EvalStatus::E_DONE, c->state.eval);
+        for (auto id : test_case_3_4b3i3r_->binary_variables().keys())
+            EXPECT_EQ(test_case_3_4b3i3r_->binary_variables()[id], c->binary_variables()[id]);
+        for (auto id : test_case_3_4b3i3r_->real_variables().keys())
+            EXPECT_DOUBLE_EQ(test_case_3_4b3i3r_->real_variables()[id], c->real_variables()[id]);
+
+        // The values are sent without ids, so the index must match the case and the receiver
+        auto other_index = CaseTransferObject::VariableIndex(QList<QUuid>(), QList<QUuid>(),
+                                                             test_case_3_4b3i3r_->real_variables().keys());
+        EXPECT_THROW(CaseTransferObject::Unpack(buffer, other_index), std::runtime_error);
+        EXPECT_THROW(CaseTransferObject::Pack(QList<Case *>() << test_case_3_4b3i3r_, other_index, buffer), std::runtime_error);
+    }
 }
@@ -67,7 +67,7 @@ class TestResourceOptimizer : public TestResourceModel, public TestResourceCases
   Settings::Optimizer *settings_ego_max_;
   Settings::Optimizer *settings_cma_es_min_;
 
- private:
+ protected:
   QJsonObject obj_fun_ {
       {"Type", "WeightedSum"},
       {"WeightedSumComponents", QJsonArray{
@@ -0,0 +1,72 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include "Optimization/surrogate_screening.h"
+#include "Optimization/tests/test_resource_optimizer.h"
+#include "Optimization/tests/test_resource_test_functions.h"
+
+using namespace TestResources::TestFunctions;
+
+namespace {
+
+class SurrogateScreeningTest : public ::testing::Test,
+                               public TestResources::TestResourceOptimizer
+{
+ protected:
+  Optimization::Case *sphereCase(const Eigen::VectorXd &x) {
+      auto c = new Optimization::Case(test_case_ga_spherical_6r_);
+      c->SetRealVarValues(x);
+      return c;
+  }
+};
+
+TEST_F(SurrogateScreeningTest, RejectsWorstPredictedCandidates) {
+    Settings::Optimizer::Parameters parameters;
+    parameters.surrogate_screening = "RBF";
+    parameters.surrogate_screening_fraction = 0.5;
+    int n = (int)test_case_ga_spherical_6r_->GetRealVarVector().size();
+    Eigen::VectorXd lower = Eigen::VectorXd::Constant(n, -5.0);
+    Eigen::VectorXd upper = Eigen::VectorXd::Constant(n, 5.0);
+    Optimization::SurrogateScreening screening(parameters, Settings::Optimizer::OptimizerMode::Minimize,
+                                               lower, upper, "Test");
+
+    for (int i = 0; i < 30; ++i) {
+        auto c = sphereCase(Eigen::VectorXd::Random(n) * 5.0);
+        c->set_objective_function_value(Sphere(c->GetRealVarVector()));
+        screening.AddSample(c);
+    }
+    ASSERT_TRUE(screening.IsActive());
+
+    QList<Optimization::Case *> candidates;
+    for (int i = 0; i < 4; ++i) {
+        candidates.append(sphereCase(Eigen::VectorXd::Constant(n, 0.5 + i)));
+    }
+    auto accepted = screening.Screen(candidates, logger_);
+    EXPECT_TRUE(accepted[0]);
+    EXPECT_TRUE(accepted[1]);
+    for (int i = 2; i < 4; ++i) {
+        EXPECT_FALSE(accepted[i]);
+        EXPECT_EQ(Optimization::Case::CaseState::EvalStatus::E_SCREENED, candidates[i]->state.eval);
+        EXPECT_EQ("SCRN", candidates[i]->GetState()["EvalSt"]);
+        EXPECT_TRUE(std::isfinite(candidates[i]->objective_function_value())); // The prediction
+    }
+    EXPECT_EQ(Optimization::Case::CaseState::EvalStatus::E_PENDING, candidates[0]->state.eval);
+    EXPECT_EQ(2, screening.rejected_cases());
+}
+
+}
@@ -3,6 +3,7 @@ SET(RESERVOIR_HEADERS
 	grid/eclgrid.h
 	grid/grid.h
 	grid/ijkcoordinate.h
+	grid/spatial_index.h
 )
 
 SET(RESERVOIR_SOURCES
@@ -10,6 +11,7 @@ SET(RESERVOIR_SOURCES
 	grid/eclgrid.cpp
 	grid/grid.cpp
 	grid/ijkcoordinate.cpp
+	grid/spatial_index.cpp
 )
 
 SET(RESERVOIR_TESTS
@@ -19,3 +21,7 @@ SET(RESERVOIR_TESTS
 	tests/grid/test_ijkcoordinate.cpp
 )
 
+
+SET(RESERVOIR_BENCHMARKS
+	benchmarks/bench_grid_search.cpp
+)
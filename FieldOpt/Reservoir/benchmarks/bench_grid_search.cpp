@@ -0,0 +1,174 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+/*!
+ * Micro-benchmark comparing grid searches using the spatial index
+ * against the linear sweeps they replace.
+ *
+ * Usage: ./bench_reservoir [path/to/GRID.EGRID ...]
+ *
+ * If no grid paths are given, the example grids are used (relative
+ * to FIELDOPT_BUILD_ROOT, or the parent directory if it is not set).
+ */
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <boost/filesystem.hpp>
+#include "Reservoir/grid/eclgrid.h"
+#include "Settings/tests/test_resource_example_file_paths.hpp"
+
+using namespace Reservoir::Grid;
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// The search performed by ECLGrid::GetCellEnvelopingPoint before the spatial index.
+int linear_point_search(Grid *grid, const Eigen::Vector3d &point) {
+    Grid::Dims dims = grid->Dimensions();
+    for (int gi = 0; gi < dims.nx * dims.ny * dims.nz; ++gi) {
+        if (grid->GetCell(gi).EnvelopsPoint(point)) {
+            return gi;
+        }
+    }
+    return -1;
+}
+
+/// The scan performed by ECLGrid::GetBoundingBoxCellIndices before the spatial index.
+std::vector<int> linear_box_search(Grid *grid, const Eigen::Vector3d &lo, const Eigen::Vector3d &hi) {
+    std::vector<int> indices;
+    Grid::Dims dims = grid->Dimensions();
+    for (int gi = 0; gi < dims.nx * dims.ny * dims.nz; ++gi) {
+        Cell cell = grid->GetCell(gi);
+        double dx = (cell.corners()[5] - cell.corners()[4]).norm();
+        double dy = (cell.corners()[6] - cell.corners()[4]).norm();
+        double dz = (cell.corners()[0] - cell.corners()[4]).norm();
+        if ((cell.center().x() >= lo.x() - dx/1.7) && (cell.center().x() <= hi.x() + dx/1.7) &&
+            (cell.center().y() >= lo.y() - dy/1.7) && (cell.center().y() <= hi.y() + dy/1.7) &&
+            (cell.center().z() >= lo.z() - dz/1.7) && (cell.center().z() <= hi.z() + dz/1.7)) {
+            indices.push_back(gi);
+        }
+    }
+    return indices;
+}
+
+void bench_box_search(ECLGrid *grid, const std::vector<Eigen::Vector3d> &points) {
+    // Boxes spanning pairs of cell centers, similar to well bounding boxes
+    std::vector<std::pair<Eigen::Vector3d, Eigen::Vector3d>> boxes;
+    for (int i = 0; i + 3 < points.size(); i += 4) {
+        boxes.push_back(std::make_pair(points[i].cwiseMin(points[i + 3]),
+                                       points[i].cwiseMax(points[i + 3])));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    long n_linear = 0;
+    for (auto box : boxes) {
+        n_linear += linear_box_search(grid, box.first, box.second).size();
+    }
+    double t_linear = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    long n_indexed = 0;
+    double bb_xi, bb_yi, bb_zi, bb_xf, bb_yf, bb_zf;
+    for (auto box : boxes) {
+        n_indexed += grid->GetBoundingBoxCellIndices(
+            box.first.x(), box.first.y(), box.first.z(),
+            box.second.x(), box.second.y(), box.second.z(),
+            bb_xi, bb_yi, bb_zi, bb_xf, bb_yf, bb_zf).size();
+    }
+    double t_indexed = seconds_since(start);
+
+    std::cout << std::setprecision(4)
+              << "  GetBoundingBoxCellIndices (" << boxes.size() << " boxes)  linear: " << t_linear
+              << " s (" << n_linear << " cells)  indexed: " << t_indexed
+              << " s (" << n_indexed << " cells)" << std::endl;
+}
+
+void bench_grid_searches(const std::string &grid_path) {
+    auto grid = new ECLGrid(grid_path, true);
+    Grid::Dims dims = grid->Dimensions();
+    int n_cells = dims.nx * dims.ny * dims.nz;
+
+    std::vector<Eigen::Vector3d> points;
+    int stride = std::max(1, n_cells / 200);
+    for (int gi = 0; gi < n_cells; gi += stride) {
+        if (grid->IsCellActive(gi)) {
+            points.push_back(grid->CellCenter(gi));
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int n_linear = 0;
+    for (auto point : points) {
+        n_linear += linear_point_search(grid, point) >= 0;
+    }
+    double t_linear = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    grid->GetCellEnvelopingPoint(points[0]); // Builds the index
+    double t_build = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    int n_indexed = 0;
+    for (auto point : points) {
+        try {
+            grid->GetCellEnvelopingPoint(point);
+            n_indexed++;
+        }
+        catch (const std::runtime_error &e) { }
+    }
+    double t_indexed = seconds_since(start);
+
+    std::cout << boost::filesystem::path(grid_path).filename().string()
+              << " (" << n_cells << " cells, " << points.size() << " points)" << std::endl;
+    std::cout << std::setprecision(4)
+              << "  GetCellEnvelopingPoint  linear: " << t_linear << " s (" << n_linear << " found)"
+              << "  indexed: " << t_indexed << " s (" << n_indexed << " found)"
+              << "  index build: " << t_build << " s" << std::endl;
+
+    bench_box_search(grid, points);
+    delete grid;
+}
+
+}
+
+int main(int argc, const char *argv[]) {
+    std::vector<std::string> grid_paths;
+    for (int i = 1; i < argc; ++i) {
+        grid_paths.push_back(argv[i]);
+    }
+    if (grid_paths.empty()) {
+        grid_paths = {
+            TestResources::ExampleFilePaths::grid_horzwel_,
+            TestResources::ExampleFilePaths::grid_5spot_,
+            TestResources::ExampleFilePaths::grid_flow_5spot_,
+            TestResources::ExampleFilePaths::norne_atw_grid_
+        };
+    }
+
+    for (auto path : grid_paths) {
+        if (!boost::filesystem::exists(path)) {
+            std::cout << "Skipping " << path << " (not found)" << std::endl;
+            continue;
+        }
+        bench_grid_searches(path);
+    }
+    return 0;
+}
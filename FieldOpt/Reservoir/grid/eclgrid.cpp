@@ -27,7 +27,7 @@ namespace Grid {
 
 using namespace std;
 
-ECLGrid::ECLGrid(string file_path)
+ECLGrid::ECLGrid(string file_path, bool cache_grid)
     : Grid(GridSourceType::ECLIPSE, file_path) {
     if (!boost::filesystem::exists(file_path))
         throw runtime_error("Grid file " + file_path + " not found.");
@@ -47,6 +47,16 @@ ECLGrid::ECLGrid(string file_path)
     ecl_grid_reader_ = new ERTWrapper::ECLGrid::ECLGridReader();
     ecl_grid_reader_->ReadEclGrid(file_path_);
 
+    auto ecl_dims = ecl_grid_reader_->Dimensions();
+    dims_.nx = ecl_dims.nx;
+    dims_.ny = ecl_dims.ny;
+    dims_.nz = ecl_dims.nz;
+    n_cells_ = dims_.nx * dims_.ny * dims_.nz;
+
+    if (cache_grid) {
+        CacheGrid();
+    }
+
     // Calculate the proper corner permutation for cell faces definition:
     // This is a function of the z axis orientation.
     // Somehow the grid reader it re-aranging the cell corners and I could not easily found a logic
@@ -80,18 +90,18 @@ ECLGrid::ECLGrid(string file_path)
 }
 
 ECLGrid::~ECLGrid() {
+    delete spatial_index_;
     delete ecl_grid_reader_;
 }
 
 bool ECLGrid::IndexIsInsideGrid(int global_index) {
-    return global_index >= 0
-        && global_index < (Dimensions().nx * Dimensions().ny * Dimensions().nz);
+    return global_index >= 0 && global_index < n_cells_;
 }
 
 bool ECLGrid::IndexIsInsideGrid(int i, int j, int k) {
-    return i >= 0 && i < Dimensions().nx &&
-        j >= 0 && j < Dimensions().ny &&
-        k >= 0 && k < Dimensions().nz;
+    return i >= 0 && i < dims_.nx &&
+        j >= 0 && j < dims_.ny &&
+        k >= 0 && k < dims_.nz;
 }
 
 bool ECLGrid::IndexIsInsideGrid(IJKCoordinate *ijk) {
@@ -99,13 +109,8 @@ bool ECLGrid::IndexIsInsideGrid(IJKCoordinate *ijk) {
 }
 
 Grid::Dims ECLGrid::Dimensions() {
-    Dims dims;
     if (type_ == GridSourceType::ECLIPSE) {
-        auto eclDims = ecl_grid_reader_->Dimensions();
-        dims.nx = eclDims.nx;
-        dims.ny = eclDims.ny;
-        dims.nz = eclDims.nz;
-        return dims;
+        return dims_;
     } else {
         throw runtime_error("ECLGrid::Dimensions(): Grid "
                                 "source must be defined before "
@@ -120,6 +125,10 @@ Cell ECLGrid::GetCell(int global_index) {
                                 "grid cell. Global index is outside grid.");
     }
 
+    if (cached_) {
+        return getCachedCell(global_index);
+    }
+
     if (type_ == GridSourceType::ECLIPSE) {
         auto ertCell = ecl_grid_reader_->GetGridCell(global_index);
 
@@ -145,7 +154,7 @@ Cell ECLGrid::GetCell(int global_index) {
                     ertCell.dx, ertCell.dy, ertCell.dz,
                     center, corners, faces_permutation_index_,
                     ertCell.matrix_active, ertCell.fracture_active,
-                    Dimensions().nz + ijk_index.k()
+                    dims_.nz + ijk_index.k()
         );
     } else {
         throw runtime_error("ECLGrid::GetCell(int global_index): Grid "
@@ -165,7 +174,7 @@ Cell ECLGrid::GetCell(int i, int j, int k) {
     }
 
     if (type_ == GridSourceType::ECLIPSE) {
-        int global_index = ecl_grid_reader_->ConvertIJKToGlobalIndex(i, j, k);
+        int global_index = i + dims_.nx * (j + dims_.ny * k);
         return GetCell(global_index);
     } else {
         throw runtime_error("ECLGrid::GetCell(int i, int j, int k): Grid "
@@ -181,7 +190,7 @@ Cell ECLGrid::GetCell(IJKCoordinate *ijk) {
     }
 
     if (type_ == GridSourceType::ECLIPSE) {
-        int global_index = ecl_grid_reader_->ConvertIJKToGlobalIndex(ijk->i(), ijk->j(), ijk->k());
+        int global_index = ijk->i() + dims_.nx * (ijk->j() + dims_.ny * ijk->k());
         return GetCell(global_index);
     } else {
         throw runtime_error("ECLGrid::GetCell(*ijk): Grid source must "
@@ -189,6 +198,137 @@ Cell ECLGrid::GetCell(IJKCoordinate *ijk) {
     }
 }
 
+Eigen::Vector3d ECLGrid::CellCenter(int global_index) {
+    if (!IndexIsInsideGrid(global_index)) {
+        throw runtime_error("ECLGrid::CellCenter: Global index is outside grid.");
+    }
+    if (cached_) {
+        const double *c = &store_.centers[3 * global_index];
+        return Eigen::Vector3d(c[0], c[1], c[2]);
+    }
+    return ecl_grid_reader_->GetGridCell(global_index).center;
+}
+
+Eigen::Matrix<double, 3, 8> ECLGrid::CellCorners(int global_index) {
+    if (!IndexIsInsideGrid(global_index)) {
+        throw runtime_error("ECLGrid::CellCorners: Global index is outside grid.");
+    }
+    if (cached_) {
+        return Eigen::Map<const Eigen::Matrix<double, 3, 8>>(&store_.corners[24 * global_index]);
+    }
+    auto ert_corners = ecl_grid_reader_->GetGridCell(global_index).corners;
+    Eigen::Matrix<double, 3, 8> corners;
+    for (int c = 0; c < 8; ++c) {
+        corners.col(c) = ert_corners[c];
+    }
+    return corners;
+}
+
+double ECLGrid::CellVolume(int global_index) {
+    if (!IndexIsInsideGrid(global_index)) {
+        throw runtime_error("ECLGrid::CellVolume: Global index is outside grid.");
+    }
+    if (cached_) {
+        return store_.volumes[global_index];
+    }
+    return ecl_grid_reader_->GetGridCell(global_index).volume;
+}
+
+bool ECLGrid::IsCellActive(int global_index) {
+    if (!IndexIsInsideGrid(global_index)) {
+        throw runtime_error("ECLGrid::IsCellActive: Global index is outside grid.");
+    }
+    if (cached_) {
+        return store_.matrix_active[global_index] || store_.fracture_active[global_index];
+    }
+    return ecl_grid_reader_->IsCellActive(global_index);
+}
+
+void ECLGrid::CacheGrid() {
+    if (cached_) {
+        return;
+    }
+
+    store_.corners.resize(24 * n_cells_);
+    store_.centers.resize(3 * n_cells_);
+    store_.dxdydz.resize(3 * n_cells_);
+    store_.volumes.resize(n_cells_);
+    store_.porosity.assign(2 * n_cells_, 0.0);
+    store_.permx.assign(2 * n_cells_, 0.0);
+    store_.permy.assign(2 * n_cells_, 0.0);
+    store_.permz.assign(2 * n_cells_, 0.0);
+    store_.matrix_active.resize(n_cells_);
+    store_.fracture_active.resize(n_cells_);
+
+    for (int gi = 0; gi < n_cells_; ++gi) {
+        auto ertCell = ecl_grid_reader_->GetGridCell(gi);
+        for (int c = 0; c < 8; ++c) {
+            store_.corners[24 * gi + 3 * c + 0] = ertCell.corners[c].x();
+            store_.corners[24 * gi + 3 * c + 1] = ertCell.corners[c].y();
+            store_.corners[24 * gi + 3 * c + 2] = ertCell.corners[c].z();
+        }
+        store_.centers[3 * gi + 0] = ertCell.center.x();
+        store_.centers[3 * gi + 1] = ertCell.center.y();
+        store_.centers[3 * gi + 2] = ertCell.center.z();
+        store_.dxdydz[3 * gi + 0] = ertCell.dx;
+        store_.dxdydz[3 * gi + 1] = ertCell.dy;
+        store_.dxdydz[3 * gi + 2] = ertCell.dz;
+        store_.volumes[gi] = ertCell.volume;
+        store_.matrix_active[gi] = ertCell.matrix_active;
+        store_.fracture_active[gi] = ertCell.fracture_active;
+
+        // Properties are listed matrix first, then fracture (see ECLGridReader::Cell)
+        size_t p = 0;
+        for (int grid = 0; grid < 2; ++grid) {
+            bool active = grid == 0 ? ertCell.matrix_active : ertCell.fracture_active;
+            if (active && p < ertCell.porosity.size()) {
+                store_.porosity[2 * gi + grid] = ertCell.porosity[p];
+                store_.permx[2 * gi + grid] = ertCell.permx[p];
+                store_.permy[2 * gi + grid] = ertCell.permy[p];
+                store_.permz[2 * gi + grid] = ertCell.permz[p];
+                p++;
+            }
+        }
+    }
+    cached_ = true;
+}
+
+Cell ECLGrid::getCachedCell(int global_index) const {
+    int k = global_index / (dims_.nx * dims_.ny);
+    int j = (global_index - k * dims_.nx * dims_.ny) / dims_.nx;
+    int i = global_index - k * dims_.nx * dims_.ny - j * dims_.nx;
+
+    vector<double> poro, permx, permy, permz;
+    for (int grid = 0; grid < 2; ++grid) {
+        bool active = grid == 0 ? store_.matrix_active[global_index] : store_.fracture_active[global_index];
+        if (active) {
+            poro.push_back(store_.porosity[2 * global_index + grid]);
+            permx.push_back(store_.permx[2 * global_index + grid]);
+            permy.push_back(store_.permy[2 * global_index + grid]);
+            permz.push_back(store_.permz[2 * global_index + grid]);
+        }
+    }
+
+    vector<Eigen::Vector3d> corners(8);
+    for (int c = 0; c < 8; ++c) {
+        const double *xyz = &store_.corners[24 * global_index + 3 * c];
+        corners[c] = Eigen::Vector3d(xyz[0], xyz[1], xyz[2]);
+    }
+    const double *center = &store_.centers[3 * global_index];
+    const double *dxdydz = &store_.dxdydz[3 * global_index];
+
+    return Cell(global_index, IJKCoordinate(i, j, k),
+                store_.volumes[global_index], poro,
+                permx, permy, permz,
+                dxdydz[0], dxdydz[1], dxdydz[2],
+                Eigen::Vector3d(center[0], center[1], center[2]),
+                corners, faces_permutation_index_,
+                store_.matrix_active[global_index],
+                store_.fracture_active[global_index],
+                dims_.nz + k
+    );
+}
+
 vector<int> ECLGrid::GetBoundingBoxCellIndices(
     double xi, double yi, double zi,
     double xf, double yf, double zf,
@@ -211,45 +351,54 @@ vector<int> ECLGrid::GetBoundingBoxCellIndices(
     bb_yf = numeric_limits<double>::min();
     bb_zf = numeric_limits<double>::min();
 
-    int total_cells = Dimensions().nx * Dimensions().ny * Dimensions().nz;
+    // Only cells whose bounding box reaches within the largest
+    // possible slack (max cell size / 1.7) of the box can match
+    double margin = spatialIndex()->MaxCellDiagonal() / 1.7;
+    auto candidates = spatialIndex()->CellsInBox(
+        Eigen::Vector3d(x_i - margin, y_i - margin, z_i - margin),
+        Eigen::Vector3d(x_f + margin, y_f + margin, z_f + margin));
 
     vector<int> indices_list;
-    for (int ii = 0; ii < total_cells; ii++) {
-        // Try is here because we only want to get the list of active
-        // cells - that means defined cells
-        try {
-            Cell cell = GetCell(ii);
-            // Calculate cell size
-            double dx = (cell.corners()[5] - cell.corners()[4]).norm();
-            double dy = (cell.corners()[6] - cell.corners()[4]).norm();
-            double dz = (cell.corners()[0] - cell.corners()[4]).norm();
-
-            if ((cell.center().x() >= x_i - dx/1.7) && (cell.center().x() <= x_f + dx/1.7) &&
-                (cell.center().y() >= y_i - dy/1.7) && (cell.center().y() <= y_f + dy/1.7) &&
-                (cell.center().z() >= z_i - dz/1.7) && (cell.center().z() <= z_f + dz/1.7)) {
-                indices_list.push_back(ii);
-                bb_xi = min(bb_xi, cell.center().x() - dx/2.0);
-                bb_yi = min(bb_yi, cell.center().y() - dy/2.0);
-                bb_zi = min(bb_zi, cell.center().z() - dz/2.0);
-                bb_xf = max(bb_xf, cell.center().x() + dx/2.0);
-                bb_yf = max(bb_yf, cell.center().y() + dy/2.0);
-                bb_zf = max(bb_zf, cell.center().z() + dz/2.0);
-            }
-        }
-        catch(const std::runtime_error& e)
-        {
-            // We should never end up here
+    for (int ii : candidates) {
+        Eigen::Matrix<double, 3, 8> corners = CellCorners(ii);
+        Eigen::Vector3d center = CellCenter(ii);
+
+        // Calculate cell size
+        double dx = (corners.col(5) - corners.col(4)).norm();
+        double dy = (corners.col(6) - corners.col(4)).norm();
+        double dz = (corners.col(0) - corners.col(4)).norm();
+
+        if ((center.x() >= x_i - dx/1.7) && (center.x() <= x_f + dx/1.7) &&
+            (center.y() >= y_i - dy/1.7) && (center.y() <= y_f + dy/1.7) &&
+            (center.z() >= z_i - dz/1.7) && (center.z() <= z_f + dz/1.7)) {
+            indices_list.push_back(ii);
+            bb_xi = min(bb_xi, center.x() - dx/2.0);
+            bb_yi = min(bb_yi, center.y() - dy/2.0);
+            bb_zi = min(bb_zi, center.z() - dz/2.0);
+            bb_xf = max(bb_xf, center.x() + dx/2.0);
+            bb_yf = max(bb_yf, center.y() + dy/2.0);
+            bb_zf = max(bb_zf, center.z() + dz/2.0);
         }
     }
     return indices_list;
 }
 
-Cell ECLGrid::GetCellEnvelopingPoint(double x, double y, double z) {
-    int total_cells = Dimensions().nx * Dimensions().ny * Dimensions().nz;
+SpatialIndex *ECLGrid::spatialIndex() {
+    if (spatial_index_ == nullptr) {
+        spatial_index_ = new SpatialIndex(this);
+    }
+    return spatial_index_;
+}
 
-    for (int ii = 0; ii < total_cells; ii++) {
-        if (GetCell(ii).EnvelopsPoint(Eigen::Vector3d(x, y, z))) {
-            return GetCell(ii);
+Cell ECLGrid::GetCellEnvelopingPoint(double x, double y, double z) {
+    Eigen::Vector3d point(x, y, z);
+
+    // Candidates are in ascending global index order, so the
+    // first match is the same as that of a sweep over the grid
+    for (int gi : spatialIndex()->CellsNearPoint(point)) {
+        Cell cell = GetCell(gi);
+        if (cell.EnvelopsPoint(point)) {
+            return cell;
         }
     }
 
@@ -269,8 +418,9 @@ Cell ECLGrid::GetCellEnvelopingPoint(double x, double y, double z,
     }
 
     for (int iCell = 0; iCell < search_set.size(); iCell++) {
-        if (GetCell(search_set[iCell]).EnvelopsPoint(Eigen::Vector3d(x, y, z))) {
-            return GetCell(search_set[iCell]);
+        Cell cell = GetCell(search_set[iCell]);
+        if (cell.EnvelopsPoint(Eigen::Vector3d(x, y, z))) {
+            return cell;
         }
     }
 
@@ -291,6 +441,16 @@ Cell ECLGrid::GetCellEnvelopingPoint(Eigen::Vector3d xyz,
                                      vector<int> search_set) {
     return GetCellEnvelopingPoint(xyz.x(), xyz.y(), xyz.z(), search_set);
 }
+vector<Cell> ECLGrid::GetCellsEnvelopingPoints(
+    const vector<Eigen::Vector3d> &points) {
+    vector<Cell> cells;
+    cells.reserve(points.size());
+    for (auto point : points) {
+        cells.push_back(GetCellEnvelopingPoint(point.x(), point.y(), point.z()));
+    }
+    return cells;
+}
+
 Cell ECLGrid::GetSmallestCell() {
     return GetCell(ecl_grid_reader_->FindSmallestCell().global_index);
 }
@@ -23,6 +23,7 @@
 
 #include <vector>
 #include "grid.h"
+#include "spatial_index.h"
 
 namespace Reservoir {
 namespace Grid {
@@ -35,6 +36,11 @@ using namespace std;
  *
  * This class uses the ERT to read the generated grid
  * files (.GRID or .EGRID) through the ERTWrapper library.
+ *
+ * If the grid is cached (see CacheGrid()), the geometry and
+ * static properties of all cells are read from ERT once and
+ * kept in contiguous arrays indexed by global index. All
+ * subsequent lookups are then served from these arrays.
  */
 class ECLGrid : public Grid
 {
@@ -42,7 +48,12 @@ private:
 	int faces_permutation_index_;
 
  public:
-  ECLGrid(std::string file_path);
+  /*!
+   * \param file_path Path to the .GRID or .EGRID file.
+   * \param cache_grid Whether the entire grid should be read
+   * into memory on construction (see CacheGrid()).
+   */
+  ECLGrid(std::string file_path, bool cache_grid=false);
   virtual ~ECLGrid();
 
   Dims Dimensions();
@@ -50,6 +61,24 @@ private:
   Cell GetCell(int i, int j, int k);
   Cell GetCell(IJKCoordinate* ijk);
 
+  Eigen::Vector3d CellCenter(int global_index) override;
+  Eigen::Matrix<double, 3, 8> CellCorners(int global_index) override;
+  double CellVolume(int global_index) override;
+  bool IsCellActive(int global_index) override;
+
+  /*!
+   * \brief CacheGrid Read the geometry and properties of all cells
+   * into the in-memory cell store. Does nothing if the grid has
+   * already been cached.
+   */
+  void CacheGrid();
+
+  /*!
+   * \brief IsCached Check whether the grid has been read into
+   * the in-memory cell store.
+   */
+  bool IsCached() const { return cached_; }
+
   vector<int> GetBoundingBoxCellIndices(
       double xi, double yi, double zi,
       double xf, double yf, double zf,
@@ -65,8 +94,47 @@ private:
   Cell GetCellEnvelopingPoint(Eigen::Vector3d xyz,
                               vector<int> search_set);
 
+  vector<Cell> GetCellsEnvelopingPoints(
+      const vector<Eigen::Vector3d> &points) override;
+
  private:
   ERTWrapper::ECLGrid::ECLGridReader* ecl_grid_reader_ = 0;
+  Dims dims_; //!< Grid dimensions, read once on construction.
+  int n_cells_; //!< Total number of cells, i.e. nx*ny*nz.
+
+  /*!
+   * \brief The CellStore struct holds the geometry and static
+   * properties of every cell in the grid in structure-of-arrays
+   * form, indexed by global index. Per-cell blocks are stored
+   * contiguously, e.g. the corners of cell g are found in
+   * corners[24*g] to corners[24*g + 23].
+   *
+   * Properties are stored with two values pr. cell: the first for
+   * the matrix grid and the second for the fracture grid. Values
+   * for grids in which the cell is inactive are undefined.
+   */
+  struct CellStore {
+    vector<double> corners;  //!< 24 values pr. cell: (x, y, z) for each of the 8 corners.
+    vector<double> centers;  //!< 3 values pr. cell: (x, y, z).
+    vector<double> dxdydz;   //!< 3 values pr. cell: (dx, dy, dz).
+    vector<double> volumes;  //!< 1 value pr. cell.
+    vector<double> porosity; //!< 2 values pr. cell: (matrix, fracture).
+    vector<double> permx;    //!< 2 values pr. cell: (matrix, fracture).
+    vector<double> permy;    //!< 2 values pr. cell: (matrix, fracture).
+    vector<double> permz;    //!< 2 values pr. cell: (matrix, fracture).
+    vector<char> matrix_active;
+    vector<char> fracture_active;
+  };
+  CellStore store_;
+  bool cached_ = false;
+
+  SpatialIndex *spatial_index_ = nullptr; //!< Built on first point search.
+
+  /// Get the spatial index, building it if necessary.
+  SpatialIndex *spatialIndex();
+
+  /// Construct a Cell object from the in-memory cell store.
+  Cell getCachedCell(int global_index) const;
 
   /// Check that global_index is less than nx*ny*nz
   bool IndexIsInsideGrid(int global_index);
@@ -73,6 +73,31 @@ class Grid
    */
   virtual Cell GetCell(IJKCoordinate* ijk) = 0;
 
+  /*!
+   * \brief CellCenter Get the (x, y, z) position of a cell's center
+   * without constructing a full Cell object.
+   */
+  virtual Eigen::Vector3d CellCenter(int global_index) = 0;
+
+  /*!
+   * \brief CellCorners Get the (x, y, z) coordinates of a cell's
+   * 8 corners as the columns of a 3x8 matrix, ordered like
+   * Cell::corners(), without constructing a full Cell object.
+   */
+  virtual Eigen::Matrix<double, 3, 8> CellCorners(int global_index) = 0;
+
+  /*!
+   * \brief CellVolume Get the volume of a cell without
+   * constructing a full Cell object.
+   */
+  virtual double CellVolume(int global_index) = 0;
+
+  /*!
+   * \brief IsCellActive Check whether a cell is active in either
+   * the matrix or the fracture grid.
+   */
+  virtual bool IsCellActive(int global_index) = 0;
+
   /*!
    * \brief GetBoundingBoxCellIndices Searches for the bounding
    * box of the space defined by the two point and returns the
@@ -125,6 +150,16 @@ class Grid
   virtual Cell GetCellEnvelopingPoint(Eigen::Vector3d xyz,
                                       std::vector<int> search_set) = 0;
 
+  /*!
+   * \brief GetCellsEnvelopingPoints Get the cells enveloping each of
+   * the points in a list, searching the entire grid. Throws an
+   * exception if no cell is found for one of the points.
+   * \param points Points to check.
+   * \return List of cells, in the same order as the points.
+   */
+  virtual std::vector<Cell> GetCellsEnvelopingPoints(
+      const std::vector<Eigen::Vector3d> &points) = 0;
+
   /*!
    * @brief Get the smallest cell in the reservoir.
    * @return The cell in the reservoir that has the smallest volume.
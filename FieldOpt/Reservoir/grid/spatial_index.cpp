@@ -0,0 +1,192 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "spatial_index.h"
+#include "grid.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace Reservoir {
+namespace Grid {
+
+using namespace std;
+
+SpatialIndex::SpatialIndex(Grid *grid) {
+    Grid::Dims dims = grid->Dimensions();
+    n_cells_ = dims.nx * dims.ny * dims.nz;
+
+    // Bounding box of each cell and of the grid as a whole
+    cell_bounds_.resize(6 * n_cells_);
+    origin_.setConstant(numeric_limits<double>::max());
+    extent_.setConstant(-numeric_limits<double>::max());
+    max_cell_diagonal_ = 0.0;
+    for (int gi = 0; gi < n_cells_; ++gi) {
+        Eigen::Matrix<double, 3, 8> corners = grid->CellCorners(gi);
+        Eigen::Vector3d lo = corners.rowwise().minCoeff();
+        Eigen::Vector3d hi = corners.rowwise().maxCoeff();
+        for (int d = 0; d < 3; ++d) {
+            cell_bounds_[6 * gi + d] = lo(d);
+            cell_bounds_[6 * gi + 3 + d] = hi(d);
+        }
+        origin_ = origin_.cwiseMin(lo);
+        extent_ = extent_.cwiseMax(hi);
+        max_cell_diagonal_ = std::max(max_cell_diagonal_, (hi - lo).norm());
+    }
+    tolerance_ = 1e-9 * std::max(1.0, (extent_ - origin_).norm());
+
+    // One bin pr. cell along each axis; flat axes get a single bin
+    int grid_dims[3] = {dims.nx, dims.ny, dims.nz};
+    for (int d = 0; d < 3; ++d) {
+        double length = extent_(d) - origin_(d);
+        if (length > 0) {
+            n_bins_[d] = std::max(1, grid_dims[d]);
+            bin_size_(d) = length / n_bins_[d];
+        } else {
+            n_bins_[d] = 1;
+            bin_size_(d) = 1.0;
+        }
+    }
+
+    // Count the cells in each bin, then fill in ascending global index order
+    int n_bins = n_bins_[0] * n_bins_[1] * n_bins_[2];
+    bin_offsets_.assign(n_bins + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        vector<int> fill;
+        if (pass == 1) {
+            for (int b = 0; b < n_bins; ++b) {
+                bin_offsets_[b + 1] += bin_offsets_[b];
+            }
+            bin_cells_.resize(bin_offsets_[n_bins]);
+            fill.assign(bin_offsets_.begin(), bin_offsets_.end() - 1);
+        }
+        for (int gi = 0; gi < n_cells_; ++gi) {
+            int bx0 = binCoordinate(cell_bounds_[6 * gi + 0] - tolerance_, 0);
+            int by0 = binCoordinate(cell_bounds_[6 * gi + 1] - tolerance_, 1);
+            int bz0 = binCoordinate(cell_bounds_[6 * gi + 2] - tolerance_, 2);
+            int bx1 = binCoordinate(cell_bounds_[6 * gi + 3] + tolerance_, 0);
+            int by1 = binCoordinate(cell_bounds_[6 * gi + 4] + tolerance_, 1);
+            int bz1 = binCoordinate(cell_bounds_[6 * gi + 5] + tolerance_, 2);
+            for (int bz = bz0; bz <= bz1; ++bz) {
+                for (int by = by0; by <= by1; ++by) {
+                    for (int bx = bx0; bx <= bx1; ++bx) {
+                        int b = binIndex(bx, by, bz);
+                        if (pass == 0) {
+                            bin_offsets_[b + 1]++;
+                        } else {
+                            bin_cells_[fill[b]++] = gi;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+vector<int> SpatialIndex::CellsNearPoint(const Eigen::Vector3d &point) const {
+    vector<int> candidates;
+    for (int d = 0; d < 3; ++d) {
+        if (point(d) < origin_(d) - tolerance_ || point(d) > extent_(d) + tolerance_) {
+            return candidates;
+        }
+    }
+
+    int b = binIndex(binCoordinate(point.x(), 0),
+                     binCoordinate(point.y(), 1),
+                     binCoordinate(point.z(), 2));
+    for (int c = bin_offsets_[b]; c < bin_offsets_[b + 1]; ++c) {
+        if (boundsContain(bin_cells_[c], point)) {
+            candidates.push_back(bin_cells_[c]);
+        }
+    }
+    return candidates;
+}
+
+vector<int> SpatialIndex::CellsInBox(const Eigen::Vector3d &lower,
+                                     const Eigen::Vector3d &upper) const {
+    vector<int> cells;
+    for (int d = 0; d < 3; ++d) {
+        if (upper(d) < origin_(d) - tolerance_ || lower(d) > extent_(d) + tolerance_) {
+            return cells;
+        }
+    }
+
+    int bx0 = binCoordinate(lower.x(), 0), bx1 = binCoordinate(upper.x(), 0);
+    int by0 = binCoordinate(lower.y(), 1), by1 = binCoordinate(upper.y(), 1);
+    int bz0 = binCoordinate(lower.z(), 2), bz1 = binCoordinate(upper.z(), 2);
+    for (int bz = bz0; bz <= bz1; ++bz) {
+        for (int by = by0; by <= by1; ++by) {
+            for (int bx = bx0; bx <= bx1; ++bx) {
+                int b = binIndex(bx, by, bz);
+                for (int c = bin_offsets_[b]; c < bin_offsets_[b + 1]; ++c) {
+                    if (boundsIntersect(bin_cells_[c], lower, upper)) {
+                        cells.push_back(bin_cells_[c]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Cells spanning several bins are found more than once
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+    return cells;
+}
+
+Eigen::Vector3d SpatialIndex::CellBoundsMin(int global_index) const {
+    const double *lo = &cell_bounds_[6 * global_index];
+    return Eigen::Vector3d(lo[0], lo[1], lo[2]);
+}
+
+Eigen::Vector3d SpatialIndex::CellBoundsMax(int global_index) const {
+    const double *hi = &cell_bounds_[6 * global_index + 3];
+    return Eigen::Vector3d(hi[0], hi[1], hi[2]);
+}
+
+int SpatialIndex::binCoordinate(double value, int axis) const {
+    int b = (int) std::floor((value - origin_(axis)) / bin_size_(axis));
+    return std::min(std::max(b, 0), n_bins_[axis] - 1);
+}
+
+int SpatialIndex::binIndex(int bx, int by, int bz) const {
+    return bx + n_bins_[0] * (by + n_bins_[1] * bz);
+}
+
+bool SpatialIndex::boundsContain(int global_index, const Eigen::Vector3d &point) const {
+    const double *bounds = &cell_bounds_[6 * global_index];
+    for (int d = 0; d < 3; ++d) {
+        if (point(d) < bounds[d] - tolerance_ || point(d) > bounds[3 + d] + tolerance_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SpatialIndex::boundsIntersect(int global_index,
+                                   const Eigen::Vector3d &lower,
+                                   const Eigen::Vector3d &upper) const {
+    const double *bounds = &cell_bounds_[6 * global_index];
+    for (int d = 0; d < 3; ++d) {
+        if (upper(d) < bounds[d] - tolerance_ || lower(d) > bounds[3 + d] + tolerance_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+}
@@ -0,0 +1,107 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <vector>
+#include <Eigen/Dense>
+
+namespace Reservoir {
+namespace Grid {
+
+class Grid;
+
+/*!
+ * \brief The SpatialIndex class is a uniform-bin acceleration
+ * structure over the axis-aligned bounding boxes of all cells
+ * in a grid.
+ *
+ * The bounding box of the grid is divided into (at most)
+ * nx*ny*nz equally sized bins, and each cell is registered in
+ * every bin its bounding box overlaps. Point and box queries
+ * then only have to consider the cells registered in the bins
+ * they touch, instead of every cell in the grid.
+ *
+ * Candidate lists are always returned in ascending global index
+ * order, so that searches using the index find the same cell as
+ * a linear sweep over the grid.
+ *
+ * The index is built once from the cell corners and is not
+ * updated if the grid changes.
+ */
+class SpatialIndex
+{
+ public:
+  explicit SpatialIndex(Grid *grid);
+
+  /*!
+   * \brief CellsNearPoint Get the global indices of all cells whose
+   * bounding box contains the point. Returns an empty list if the
+   * point is outside the bounding box of the grid.
+   */
+  std::vector<int> CellsNearPoint(const Eigen::Vector3d &point) const;
+
+  /*!
+   * \brief CellsInBox Get the global indices of all cells whose
+   * bounding box intersects the axis-aligned box [lower, upper].
+   * The cost is proportional to the number of cells registered
+   * in the bins overlapped by the box.
+   */
+  std::vector<int> CellsInBox(const Eigen::Vector3d &lower,
+                              const Eigen::Vector3d &upper) const;
+
+  /*!
+   * \brief MaxCellDiagonal Get the length of the longest bounding
+   * box diagonal of any cell in the grid. No distance between two
+   * corners of a cell can be larger than this.
+   */
+  double MaxCellDiagonal() const { return max_cell_diagonal_; }
+
+  /*!
+   * \brief CellBoundsMin Get the lower corner of a cell's bounding box.
+   */
+  Eigen::Vector3d CellBoundsMin(int global_index) const;
+
+  /*!
+   * \brief CellBoundsMax Get the upper corner of a cell's bounding box.
+   */
+  Eigen::Vector3d CellBoundsMax(int global_index) const;
+
+ private:
+  int n_cells_;
+  int n_bins_[3];             //!< Number of bins in x, y and z direction.
+  Eigen::Vector3d origin_;    //!< Lower corner of the grid bounding box.
+  Eigen::Vector3d extent_;    //!< Upper corner of the grid bounding box.
+  Eigen::Vector3d bin_size_;  //!< Size of a bin in x, y and z direction.
+  double tolerance_;          //!< Slack used when checking bounding box containment.
+  double max_cell_diagonal_;  //!< Longest bounding box diagonal of any cell.
+
+  std::vector<double> cell_bounds_; //!< 6 values pr. cell: (xmin, ymin, zmin, xmax, ymax, zmax).
+  std::vector<int> bin_offsets_;    //!< Cells in bin b are bin_cells_[bin_offsets_[b]] to bin_cells_[bin_offsets_[b+1]-1].
+  std::vector<int> bin_cells_;      //!< Global indices of the cells in each bin, in ascending order.
+
+  int binCoordinate(double value, int axis) const;
+  int binIndex(int bx, int by, int bz) const;
+  bool boundsContain(int global_index, const Eigen::Vector3d &point) const;
+  bool boundsIntersect(int global_index, const Eigen::Vector3d &lower, const Eigen::Vector3d &upper) const;
+};
+
+}
+}
+
+#endif // SPATIAL_INDEX_H
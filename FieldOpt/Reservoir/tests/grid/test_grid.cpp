@@ -109,6 +109,109 @@ TEST_F(GridTest, GetCellEnvelopingPointObject) {
     EXPECT_EQ(cell.global_index(), 20);
 }
 
+TEST_F(GridTest, GetCellEnvelopingPointMatchesLinearSearch) {
+    for (auto grid : {grid_, grid_5sp_}) {
+        Grid::Dims dims = grid->Dimensions();
+        int n_cells = dims.nx * dims.ny * dims.nz;
+        std::vector<Eigen::Vector3d> points;
+        for (int gi = 0; gi < n_cells; gi += 7) {
+            // Cell centers and the shared corner of neighbouring cells
+            points.push_back(grid->CellCenter(gi));
+            points.push_back(grid->CellCorners(gi).col(0));
+        }
+        for (auto point : points) {
+            int expected = -1;
+            for (int gi = 0; gi < n_cells; ++gi) {
+                if (grid->GetCell(gi).EnvelopsPoint(point)) {
+                    expected = gi;
+                    break;
+                }
+            }
+            if (expected >= 0) {
+                EXPECT_EQ(expected, grid->GetCellEnvelopingPoint(point).global_index());
+            }
+            else {
+                EXPECT_THROW(grid->GetCellEnvelopingPoint(point), std::runtime_error);
+            }
+        }
+    }
+}
+
+TEST_F(GridTest, GetCellsEnvelopingPoints) {
+    std::vector<Eigen::Vector3d> points = {
+        Eigen::Vector3d(21, 301, 7025),
+        Eigen::Vector3d(1, 1, 7001),
+        Eigen::Vector3d(50, 50, 7055)
+    };
+    auto cells = grid_->GetCellsEnvelopingPoints(points);
+    ASSERT_EQ(3, cells.size());
+    EXPECT_EQ(20, cells[0].global_index());
+    EXPECT_EQ(0, cells[1].global_index());
+    EXPECT_EQ(grid_->GetCell(0, 0, 1).global_index(), cells[2].global_index());
+
+    points.push_back(Eigen::Vector3d(100.0, 1000.0, 7100.0));
+    EXPECT_THROW(grid_->GetCellsEnvelopingPoints(points), std::runtime_error);
+}
+
+TEST_F(GridTest, GetBoundingBoxCellIndicesMatchesBruteForce) {
+    // Reference: the full scan previously done by ECLGrid
+    auto brute_force = [](Grid *grid,
+                          double x_i, double y_i, double z_i,
+                          double x_f, double y_f, double z_f,
+                          std::vector<double> &bb) {
+        bb = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+              std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+              std::numeric_limits<double>::min(), std::numeric_limits<double>::min()};
+        std::vector<int> indices;
+        Grid::Dims dims = grid->Dimensions();
+        for (int ii = 0; ii < dims.nx * dims.ny * dims.nz; ii++) {
+            Cell cell = grid->GetCell(ii);
+            double dx = (cell.corners()[5] - cell.corners()[4]).norm();
+            double dy = (cell.corners()[6] - cell.corners()[4]).norm();
+            double dz = (cell.corners()[0] - cell.corners()[4]).norm();
+            if ((cell.center().x() >= x_i - dx/1.7) && (cell.center().x() <= x_f + dx/1.7) &&
+                (cell.center().y() >= y_i - dy/1.7) && (cell.center().y() <= y_f + dy/1.7) &&
+                (cell.center().z() >= z_i - dz/1.7) && (cell.center().z() <= z_f + dz/1.7)) {
+                indices.push_back(ii);
+                bb[0] = std::min(bb[0], cell.center().x() - dx/2.0);
+                bb[1] = std::min(bb[1], cell.center().y() - dy/2.0);
+                bb[2] = std::min(bb[2], cell.center().z() - dz/2.0);
+                bb[3] = std::max(bb[3], cell.center().x() + dx/2.0);
+                bb[4] = std::max(bb[4], cell.center().y() + dy/2.0);
+                bb[5] = std::max(bb[5], cell.center().z() + dz/2.0);
+            }
+        }
+        return indices;
+    };
+
+    std::vector<std::vector<double>> boxes = {
+        {0, 0, 7000, 2000, 2700, 7450},     // Entire horzwel grid
+        {20, 300, 7020, 530, 880, 7130},
+        {530, 880, 7130, 20, 300, 7020},    // Same box, reversed order
+        {1000, 1000, 7200, 1000, 1000, 7200},
+        {-500, -500, 6000, -100, -100, 6500} // Outside the grid
+    };
+    for (auto grid : {grid_, grid_5sp_}) {
+        for (auto box : boxes) {
+            std::vector<double> expected_bb;
+            auto expected = brute_force(grid, std::min(box[0], box[3]), std::min(box[1], box[4]),
+                                        std::min(box[2], box[5]), std::max(box[0], box[3]),
+                                        std::max(box[1], box[4]), std::max(box[2], box[5]),
+                                        expected_bb);
+            double bb_xi, bb_yi, bb_zi, bb_xf, bb_yf, bb_zf;
+            auto indices = grid->GetBoundingBoxCellIndices(box[0], box[1], box[2], box[3], box[4], box[5],
+                                                           bb_xi, bb_yi, bb_zi, bb_xf, bb_yf, bb_zf);
+            EXPECT_EQ(expected, indices);
+            EXPECT_EQ(expected_bb[0], bb_xi);
+            EXPECT_EQ(expected_bb[1], bb_yi);
+            EXPECT_EQ(expected_bb[2], bb_zi);
+            EXPECT_EQ(expected_bb[3], bb_xf);
+            EXPECT_EQ(expected_bb[4], bb_yf);
+            EXPECT_EQ(expected_bb[5], bb_zf);
+        }
+    }
+}
+
 TEST_F(GridTest, GetCellEnvelopingPointAdditional) {
     auto cell_100 = grid_->GetCell(0);
     auto cell_200 = grid_->GetCell(1);
@@ -152,6 +255,34 @@ TEST_F(GridTest, GetCellEnvelopingPointAdditional) {
     EXPECT_TRUE(cell_100.EnvelopsPoint(Eigen::Vector3d(1,1,7050)));
 }
 
+TEST_F(GridTest, CachedGridMatchesUncached) {
+    auto cached = new ECLGrid(TestResources::ExampleFilePaths::grid_horzwel_, true);
+    EXPECT_TRUE(cached->IsCached());
+    Grid::Dims dims = grid_->Dimensions();
+    for (int gi = 0; gi < dims.nx * dims.ny * dims.nz; ++gi) {
+        Cell cell = grid_->GetCell(gi);
+        Cell cached_cell = cached->GetCell(gi);
+        EXPECT_EQ(cell.ijk_index().i(), cached_cell.ijk_index().i());
+        EXPECT_EQ(cell.ijk_index().j(), cached_cell.ijk_index().j());
+        EXPECT_EQ(cell.ijk_index().k(), cached_cell.ijk_index().k());
+        EXPECT_DOUBLE_EQ(cell.volume(), cached_cell.volume());
+        EXPECT_TRUE(cell.center().isApprox(cached_cell.center()));
+        EXPECT_EQ(cell.is_active_matrix(), cached_cell.is_active_matrix());
+        EXPECT_EQ(cell.porosity(), cached_cell.porosity());
+        EXPECT_EQ(cell.permx(), cached_cell.permx());
+        EXPECT_EQ(cell.permz(), cached_cell.permz());
+        EXPECT_TRUE(cell.center().isApprox(cached->CellCenter(gi)));
+        EXPECT_DOUBLE_EQ(cell.volume(), cached->CellVolume(gi));
+        EXPECT_EQ(cell.is_active(), cached->IsCellActive(gi));
+        auto corners = cached->CellCorners(gi);
+        for (int c = 0; c < 8; ++c) {
+            EXPECT_TRUE(cell.corners()[c].isApprox(cached_cell.corners()[c]));
+            EXPECT_TRUE(cell.corners()[c].isApprox(corners.col(c)));
+        }
+    }
+    delete cached;
+}
+
 TEST_F(GridTest, FindSmallestCell) {
     auto smallest_horzwell = grid_->GetSmallestCell();
     auto smallest_norne = grid_nor_->GetSmallestCell();
@@ -1,13 +1,16 @@
 SET(RUNNER_HEADERS
 	bookkeeper.h
+	evaluation_cache.h
 	loggable.hpp
 	logger.h
 	runners/abstract_runner.h
+	runners/asynchronous_mpi_runner.h
 	runners/ensemble_helper.h
 	runners/main_runner.h
 	runners/mpi_runner.h
 	runners/oneoff_runner.h
 	runners/overseer.h
+	runners/parallel_runner.h
 	runners/serial_runner.h
 	runners/synchronous_mpi_runner.h
 	runners/worker.h
@@ -16,13 +19,16 @@ SET(RUNNER_HEADERS
 
 SET(RUNNER_SOURCES
 	bookkeeper.cpp
+	evaluation_cache.cpp
 	logger.cpp
 	runners/abstract_runner.cpp
+	runners/asynchronous_mpi_runner.cpp
 	runners/ensemble_helper.cpp
 	runners/main_runner.cpp
 	runners/mpi_runner.cpp
 	runners/oneoff_runner.cpp
 	runners/overseer.cpp
+	runners/parallel_runner.cpp
 	runners/serial_runner.cpp
 	runners/synchronous_mpi_runner.cpp
 	runners/worker.cpp
@@ -32,6 +38,16 @@ SET(RUNNER_SOURCES
 SET(RUNNER_TESTS
 	tests/test_resource_runner.hpp
 	tests/test_bookkeeper.cpp
+	tests/test_evaluation_cache.cpp
+	tests/test_parallel_runner.cpp
 	tests/test_runtime_settings.cpp
 )
 
+
+SET(RUNNER_BENCHMARKS
+	benchmarks/bench_bookkeeper.cpp
+)
+
+SET(RUNNER_MPI_BENCHMARKS
+	benchmarks/bench_mpi_overseer.cpp
+)
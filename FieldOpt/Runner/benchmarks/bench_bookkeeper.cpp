@@ -0,0 +1,129 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+/*!
+ * Micro-benchmark comparing the hash-indexed Bookkeeper lookup against
+ * the linear scan over the evaluated cases it replaces.
+ *
+ * Usage: ./bench_runner [n_cases [n_variables [n_lookups]]]
+ *
+ * A synthetic history of n_cases evaluated cases (default 100000) is
+ * generated by a pattern search-like walk: each case moves one variable
+ * of a previous case by a fixed step. Half of the lookups are cases in
+ * the history, the other half are new.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include "Runner/bookkeeper.h"
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// The lookup performed by Bookkeeper::IsEvaluated before the index.
+bool linear_is_evaluated(Optimization::CaseHandler *case_handler, Optimization::Case *c) {
+    for (auto evaluated_c : case_handler->EvaluatedCases()) {
+        if (evaluated_c->Equals(c)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+int main(int argc, const char *argv[]) {
+    int n_cases = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int n_variables = argc > 2 ? std::atoi(argv[2]) : 20;
+    int n_lookups = argc > 3 ? std::atoi(argv[3]) : 200;
+
+    QList<QUuid> ids;
+    for (int v = 0; v < n_variables; ++v) {
+        ids.append(QUuid::createUuid());
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> pick_variable(0, n_variables - 1);
+    std::uniform_int_distribution<int> pick_direction(0, 1);
+
+    // Pattern search-like history
+    auto case_handler = new Optimization::CaseHandler();
+    std::vector<QHash<QUuid, double>> history;
+    QHash<QUuid, double> center;
+    for (auto id : ids) {
+        center[id] = 100.0;
+    }
+    for (int i = 0; i < n_cases; ++i) {
+        QHash<QUuid, double> values = history.empty() ? center : history[gen() % history.size()];
+        values[ids[pick_variable(gen)]] += pick_direction(gen) ? 12.5 : -12.5;
+        history.push_back(values);
+
+        auto c = new Optimization::Case(QHash<QUuid, bool>(), QHash<QUuid, int>(), values);
+        c->set_objective_function_value(i);
+        case_handler->AddNewCase(c);
+        case_handler->GetNextCaseForEvaluation();
+        case_handler->SetCaseEvaluated(c->id());
+    }
+
+    std::vector<Optimization::Case *> lookups;
+    for (int i = 0; i < n_lookups; ++i) {
+        QHash<QUuid, double> values = history[gen() % history.size()];
+        if (i % 2 == 1) {
+            values[ids[pick_variable(gen)]] += 0.5;
+        }
+        lookups.push_back(new Optimization::Case(QHash<QUuid, bool>(), QHash<QUuid, int>(), values));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int n_linear = 0;
+    for (auto c : lookups) {
+        n_linear += linear_is_evaluated(case_handler, c) ? 1 : 0;
+    }
+    double t_linear = seconds_since(start);
+
+    auto bookkeeper = Runner::Bookkeeper(0.0, case_handler);
+    start = std::chrono::steady_clock::now();
+    bookkeeper.IsEvaluated(lookups[0]); // Builds the index
+    double t_build = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    int n_indexed = 0;
+    for (auto c : lookups) {
+        n_indexed += bookkeeper.IsEvaluated(c) ? 1 : 0;
+    }
+    double t_indexed = seconds_since(start);
+
+    std::cout << std::setprecision(4);
+    std::cout << n_cases << " evaluated cases, " << n_variables << " variables, "
+              << n_lookups << " lookups" << std::endl;
+    std::cout << "  linear:  " << t_linear / n_lookups * 1e3 << " ms/lookup ("
+              << n_linear << " found)" << std::endl;
+    std::cout << "  indexed: " << t_indexed / n_lookups * 1e3 << " ms/lookup ("
+              << n_indexed << " found); index built in " << t_build << " s" << std::endl;
+    std::cout << "  speedup: " << t_linear / t_indexed << "x" << std::endl;
+    if (n_linear != n_indexed) {
+        std::cerr << "Mismatch between linear and indexed lookups." << std::endl;
+        return 1;
+    }
+    return 0;
+}
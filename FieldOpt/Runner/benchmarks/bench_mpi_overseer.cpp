@@ -0,0 +1,209 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+/*!
+ * Benchmark of the case throughput of the synchronous (mpisync) and asynchronous
+ * (mpiasync) overseer loops.
+ *
+ * Usage: mpirun -np <ranks> ./bench_mpi_overseer [sim_ms [prep_ms [cases_per_worker [prefetch_depth]]]]
+ *
+ * The message pattern of the two MPI runners is replayed with synthetic work, so
+ * that no simulator is needed: workers sleep for sim_ms (default 1000, +-25%) pr.
+ * case, and the overseer spends prep_ms (default 5) of CPU time preparing each case
+ * (getting it from the optimizer, bookkeeping) and half of that submitting each
+ * evaluated case. Messages carry a packed case of 1000 real variables.
+ *
+ *  - sync: the overseer blocks until a case is returned, submits it, and only then
+ *    prepares and sends the next case to the idle worker.
+ *  - async: the overseer polls for returned cases, prepares cases ahead of time and
+ *    keeps prefetch_depth (default 2) cases outstanding on each worker.
+ */
+
+#include <mpi.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int TAG_CASE = 1;
+const int TAG_RESULT = 2;
+const int TAG_TERMINATE = 100;
+const int case_bytes = 1000 * sizeof(double) + 64;
+
+void spin(double ms) {
+    auto end = std::chrono::steady_clock::now() + std::chrono::microseconds((long)(ms * 1000));
+    while (std::chrono::steady_clock::now() < end) {}
+}
+
+void worker(double sim_ms) {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    std::mt19937 gen(1234 + rank);
+    std::uniform_real_distribution<double> jitter(0.75, 1.25);
+    std::vector<char> buffer(case_bytes);
+    while (true) {
+        MPI_Status status;
+        MPI_Recv(buffer.data(), case_bytes, MPI_BYTE, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        if (status.MPI_TAG == TAG_TERMINATE) break;
+        std::this_thread::sleep_for(std::chrono::microseconds((long)(sim_ms * jitter(gen) * 1000)));
+        MPI_Send(buffer.data(), case_bytes, MPI_BYTE, 0, TAG_RESULT, MPI_COMM_WORLD);
+    }
+}
+
+void terminate_workers(int n_ranks) {
+    for (int r = 1; r < n_ranks; ++r) {
+        MPI_Send(nullptr, 0, MPI_BYTE, r, TAG_TERMINATE, MPI_COMM_WORLD);
+    }
+}
+
+/// The SynchronousMPIRunner pattern: one case pr. worker; block until a case is returned.
+void sync_overseer(int n_ranks, int n_cases, double prep_ms) {
+    std::vector<char> buffer(case_bytes);
+    int sent = 0, received = 0;
+    for (int r = 1; r < n_ranks && sent < n_cases; ++r, ++sent) {
+        spin(prep_ms);
+        MPI_Send(buffer.data(), case_bytes, MPI_BYTE, r, TAG_CASE, MPI_COMM_WORLD);
+    }
+    while (received < n_cases) {
+        MPI_Status status;
+        MPI_Recv(buffer.data(), case_bytes, MPI_BYTE, MPI_ANY_SOURCE, TAG_RESULT, MPI_COMM_WORLD, &status);
+        received++;
+        spin(prep_ms / 2);
+        if (sent < n_cases) {
+            spin(prep_ms);
+            MPI_Send(buffer.data(), case_bytes, MPI_BYTE, status.MPI_SOURCE, TAG_CASE, MPI_COMM_WORLD);
+            sent++;
+        }
+    }
+}
+
+/// The AsynchronousMPIRunner pattern: poll, prepare ahead and prefetch.
+void async_overseer(int n_ranks, int n_cases, double prep_ms, int prefetch_depth) {
+    struct PendingSend { MPI_Request request; std::vector<char> buffer; };
+    std::list<PendingSend> pending;
+    std::vector<int> assigned(n_ranks, 0);
+    std::vector<char> buffer(case_bytes);
+    int prepared = 0, received = 0, ready = 0;
+    int n_workers = n_ranks - 1;
+
+    auto free_slots = [&]() {
+        // Only prefetch while there are enough cases left to keep all workers busy
+        int depth = (n_cases - prepared) + ready > n_workers ? prefetch_depth : 1;
+        int free = 0;
+        for (int r = 1; r < n_ranks; ++r) free += std::max(0, depth - assigned[r]);
+        return free;
+    };
+    auto receive = [&](bool block) {
+        int available = 1;
+        MPI_Status status;
+        if (!block) MPI_Iprobe(MPI_ANY_SOURCE, TAG_RESULT, MPI_COMM_WORLD, &available, &status);
+        if (!available) return false;
+        MPI_Recv(buffer.data(), case_bytes, MPI_BYTE, MPI_ANY_SOURCE, TAG_RESULT, MPI_COMM_WORLD, &status);
+        assigned[status.MPI_SOURCE]--;
+        received++;
+        spin(prep_ms / 2);
+        return true;
+    };
+
+    while (received < n_cases) {
+        bool progress = false;
+        while (receive(false)) progress = true;
+        for (auto it = pending.begin(); it != pending.end(); ) {
+            int done = 0;
+            MPI_Test(&it->request, &done, MPI_STATUS_IGNORE);
+            it = done ? pending.erase(it) : std::next(it);
+        }
+        auto dispatch = [&]() {
+            while (ready > 0 && free_slots() > 0) {
+                int worker = 1;
+                for (int r = 1; r < n_ranks; ++r) {
+                    if (assigned[r] < assigned[worker]) worker = r;
+                }
+                pending.emplace_back();
+                pending.back().buffer.resize(case_bytes);
+                MPI_Isend(pending.back().buffer.data(), case_bytes, MPI_BYTE, worker, TAG_CASE, MPI_COMM_WORLD,
+                          &pending.back().request);
+                assigned[worker]++;
+                ready--;
+                progress = true;
+            }
+        };
+        dispatch();
+        if (prepared < n_cases && ready < free_slots() + n_workers) { // One at a time, to keep polling
+            spin(prep_ms);
+            prepared++;
+            ready++;
+            progress = true;
+            dispatch();
+        }
+        if (!progress && received < n_cases) receive(true);
+    }
+    for (auto &send : pending) MPI_Wait(&send.request, MPI_STATUS_IGNORE);
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    MPI_Init(&argc, &argv);
+    int rank, n_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &n_ranks);
+    double sim_ms = argc > 1 ? std::atof(argv[1]) : 1000;
+    double prep_ms = argc > 2 ? std::atof(argv[2]) : 5;
+    int cases_per_worker = argc > 3 ? std::atoi(argv[3]) : 8;
+    int prefetch_depth = argc > 4 ? std::atoi(argv[4]) : 2;
+    if (n_ranks < 2) {
+        std::cerr << "At least two ranks are required." << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    int n_cases = cases_per_worker * (n_ranks - 1);
+
+    double hours[2];
+    for (int mode = 0; mode < 2; ++mode) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        auto start = std::chrono::steady_clock::now();
+        if (rank == 0) {
+            if (mode == 0) sync_overseer(n_ranks, n_cases, prep_ms);
+            else async_overseer(n_ranks, n_cases, prep_ms, prefetch_depth);
+            terminate_workers(n_ranks);
+        }
+        else {
+            worker(sim_ms);
+        }
+        hours[mode] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 3600.0;
+    }
+
+    if (rank == 0) {
+        std::cout << std::fixed << std::setprecision(0);
+        std::cout << n_ranks << " ranks, " << n_cases << " cases, " << sim_ms << " ms pr. simulation, "
+                  << std::setprecision(1) << prep_ms << " ms pr. case in the overseer" << std::endl;
+        std::cout << std::setprecision(0);
+        std::cout << "Synchronous:  " << n_cases / hours[0] << " cases/hour" << std::endl;
+        std::cout << "Asynchronous: " << n_cases / hours[1] << " cases/hour (prefetch depth "
+                  << prefetch_depth << ")" << std::endl;
+        std::cout << "Gain:         " << std::setprecision(2) << hours[0] / hours[1] << "x" << std::endl;
+    }
+    MPI_Finalize();
+    return 0;
+}
@@ -1,22 +1,111 @@
 #include "bookkeeper.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
 
 namespace Runner {
 
     Bookkeeper::Bookkeeper(Settings::Settings *settings, Optimization::CaseHandler *case_handler)
+        : Bookkeeper(settings->bookkeeper_tolerance(), case_handler)
     {
-        tolerance_ = settings->bookkeeper_tolerance();
+    }
+
+    Bookkeeper::Bookkeeper(double tolerance, Optimization::CaseHandler *case_handler)
+    {
+        tolerance_ = tolerance;
         case_handler_ = case_handler;
+        n_indexed_ = 0;
+        evaluation_cache_ = nullptr;
     }
 
     bool Bookkeeper::IsEvaluated(Optimization::Case *c, bool set_obj)
     {
-        for (auto evaluated_c : case_handler_->EvaluatedCases()) {
-            if (evaluated_c->Equals(c)) { // Case has been evaluated
-                if (set_obj) c->set_objective_function_value(evaluated_c->objective_function_value());
-                return true;
+        Optimization::Case *evaluated_c = FindEvaluated(c);
+        if (evaluated_c == nullptr) {
+            if (evaluation_cache_ == nullptr) return false;
+            return set_obj ? evaluation_cache_->Restore(c) : evaluation_cache_->Contains(c);
+        }
+        if (set_obj) c->set_objective_function_value(evaluated_c->objective_function_value());
+        return true;
+    }
+
+    Optimization::Case *Bookkeeper::FindEvaluated(Optimization::Case *c)
+    {
+        indexEvaluatedCases();
+
+        int n_variables;
+        double proj = projection(c, n_variables);
+        qint64 b = bucket(proj, n_variables);
+
+        // Equal cases are at most one bucket apart, unless buckets are exact
+        int reach = tolerance_ > 0.0 ? 1 : 0;
+        IndexedCase first_match(-1, nullptr);
+        for (qint64 nb = b - reach; nb <= b + reach; ++nb) {
+            auto candidates = index_.constFind(BucketKey(n_variables, nb));
+            if (candidates == index_.constEnd()) continue;
+            for (const IndexedCase &candidate : candidates.value()) {
+                if (first_match.second != nullptr && candidate.first > first_match.first) break;
+                if (candidate.second->Equals(c, tolerance_)) {
+                    first_match = candidate;
+                    break;
+                }
+            }
+        }
+        return first_match.second;
+    }
+
+    void Bookkeeper::indexEvaluatedCases()
+    {
+        const QList<QUuid> &evaluated = case_handler_->EvaluatedCaseIds();
+        for (; n_indexed_ < evaluated.size(); ++n_indexed_) {
+            Optimization::Case *evaluated_c = case_handler_->GetCase(evaluated[n_indexed_]);
+            int n_variables;
+            double proj = projection(evaluated_c, n_variables);
+            index_[BucketKey(n_variables, bucket(proj, n_variables))].append(IndexedCase(n_indexed_, evaluated_c));
+        }
+    }
+
+    double Bookkeeper::projection(const Optimization::Case *c, int &n_variables) const
+    {
+        std::vector<std::pair<QUuid, double>> values;
+        auto &binary_ids = c->binary_variable_ids();
+        auto &integer_ids = c->integer_variable_ids();
+        auto &integer_values = c->GetIntegerVarVector();
+        auto &real_ids = c->real_variable_ids();
+        auto &real_values = c->GetRealVarVector();
+        values.reserve(binary_ids.size() + integer_ids.size() + real_ids.size());
+        for (auto &id : binary_ids)
+            values.push_back(std::make_pair(id, (double)c->binary_variable_value(id)));
+        for (int i = 0; i < integer_ids.size(); ++i)
+            values.push_back(std::make_pair(integer_ids[i], (double)integer_values[i]));
+        for (int i = 0; i < real_ids.size(); ++i)
+            values.push_back(std::make_pair(real_ids[i], real_values[i]));
+        std::sort(values.begin(), values.end(),
+                  [](const std::pair<QUuid, double> &a, const std::pair<QUuid, double> &b) { return a.first < b.first; });
+
+        double proj = 0.0;
+        for (auto &value : values) {
+            double weight = 1.0 + (qHash(value.first) & 0xffff) / 65536.0;
+            proj += weight * value.second;
+        }
+        n_variables = (int)values.size();
+        return proj + 0.0; // Normalizes -0.0
+    }
+
+    qint64 Bookkeeper::bucket(double projection, int n_variables) const
+    {
+        // Projections of cases that are equal within the tolerance differ by at
+        // most tolerance*sum(w_i) < 2*tolerance*n_variables
+        if (tolerance_ > 0.0 && n_variables > 0) {
+            double q = std::floor(projection / (2.0 * tolerance_ * n_variables));
+            if (std::abs(q) < 1e18) {
+                return (qint64)q;
             }
         }
-        return false;
+        qint64 bits;
+        std::memcpy(&bits, &projection, sizeof(bits));
+        return bits;
     }
 
 }
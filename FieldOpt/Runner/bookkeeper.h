@@ -3,6 +3,10 @@
 
 #include "Settings/settings.h"
 #include "Optimization/case_handler.h"
+#include "evaluation_cache.h"
+#include <QHash>
+#include <QPair>
+#include <QVector>
 
 namespace Runner {
 
@@ -16,6 +20,16 @@ namespace Runner {
  * The Bookkeeper uses the case_handler from the optimizer to keep track of which cases
  * have been evaluated.
  *
+ * Evaluated cases are indexed in a hash table as they appear in the case handler, so
+ * that a lookup only has to compare the case with the few evaluated cases in its own
+ * and the neighbouring buckets, instead of with every evaluated case. The bucket of a
+ * case is found by projecting its variable values onto a fixed direction (see
+ * projection()) and quantizing the result with a bucket width that is at least as
+ * large as the largest projected distance between two cases considered equal.
+ *
+ * If an EvaluationCache is set, cases not found among the evaluated cases are also
+ * looked up in the cache, which may hold cases evaluated in earlier runs.
+ *
  * \todo Handle the case where a case is currently being evaluated; i.e. there exists a case
  * in the "under evaluation" list which is equal to the case being checked, but has a different
  * UUID.
@@ -24,6 +38,7 @@ class Bookkeeper
 {
 public:
     Bookkeeper(Settings::Settings *settings, Optimization::CaseHandler *case_handler);
+    Bookkeeper(double tolerance, Optimization::CaseHandler *case_handler);
 
     /*!
      * \brief IsEvaluated Check if a case has already been evaluated. If the set_obj parameter
@@ -35,9 +50,49 @@ public:
      */
     bool IsEvaluated(Optimization::Case *c, bool set_obj=false);
 
+    /*!
+     * \brief FindEvaluated Find the first evaluated case (in the order the cases were
+     * evaluated) whose variable values are equal to those of c within the tolerance.
+     * \param c The case to look for.
+     * \return The evaluated case if one is found; otherwise nullptr.
+     */
+    Optimization::Case *FindEvaluated(Optimization::Case *c);
+
+    /*!
+     * \brief SetEvaluationCache Set a persistent cache to be consulted for cases that
+     * have not been evaluated in this run. The cache is not owned by the Bookkeeper.
+     */
+    void SetEvaluationCache(EvaluationCache *evaluation_cache) { evaluation_cache_ = evaluation_cache; }
+
 private:
     double tolerance_;
     Optimization::CaseHandler *case_handler_;
+    EvaluationCache *evaluation_cache_; //!< Cache of cases evaluated in earlier runs. May be nullptr.
+
+    typedef QPair<int, qint64> BucketKey; //!< Number of variables and quantized projection.
+    typedef QPair<int, Optimization::Case *> IndexedCase; //!< Evaluation order and case.
+
+    QHash<BucketKey, QVector<IndexedCase>> index_; //!< Evaluated cases pr. bucket.
+    int n_indexed_; //!< Number of cases from the case handler's evaluated list that have been indexed.
+
+    /*!
+     * \brief indexEvaluatedCases Add the cases evaluated since the last call to the index.
+     */
+    void indexEvaluatedCases();
+
+    /*!
+     * \brief projection Compute the sum of w_i*x_i over all variables x_i of a case, where
+     * the weight w_i in [1, 2) is derived from the UUID of the variable. The variables are
+     * summed in UUID order, so equal cases get bitwise equal projections.
+     * \param c Case to project.
+     * \param n_variables Set to the total number of variables in the case.
+     */
+    double projection(const Optimization::Case *c, int &n_variables) const;
+
+    /*!
+     * \brief bucket Get the bucket a projected case belongs to.
+     */
+    qint64 bucket(double projection, int n_variables) const;
 };
 
 }
@@ -0,0 +1,296 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "evaluation_cache.h"
+#include "Model/properties/property_exceptions.h"
+#include "Utilities/printer.hpp"
+#include "Utilities/verbosity.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace Runner {
+
+namespace {
+const QByteArray cache_magic("FOEVCACH");
+const quint32 cache_version = 1;
+const QDataStream::Version stream_version = QDataStream::Qt_5_0;
+
+void addFile(QCryptographicHash &hash, const QString &file_path) {
+    QFile file(file_path);
+    if (file.open(QIODevice::ReadOnly)) {
+        hash.addData(QByteArray::number(file.size()));
+        hash.addData(&file);
+    }
+}
+
+/*!
+ * Add the relative paths and contents of all files below a directory, in sorted order,
+ * skipping the excluded files and the files in the excluded directories.
+ */
+void addDirectory(QCryptographicHash &hash, const QString &dir_path,
+                  const QStringList &excluded_dirs, const QStringList &excluded_files) {
+    QDir dir(QFileInfo(dir_path).canonicalFilePath());
+    QStringList files;
+    QDirIterator it(dir.path(), QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QString file_path = QFileInfo(it.next()).canonicalFilePath();
+        bool skip = excluded_files.contains(file_path);
+        for (const QString &excluded_dir : excluded_dirs) {
+            skip = skip || file_path.startsWith(excluded_dir + "/");
+        }
+        if (!skip) files.append(file_path);
+    }
+    files.sort();
+    for (const QString &file_path : files) {
+        hash.addData(dir.relativeFilePath(file_path).toUtf8());
+        addFile(hash, file_path);
+    }
+}
+}
+
+EvaluationCache::EvaluationCache(const QString &file_path,
+                                 const QByteArray &context,
+                                 Model::Properties::VariablePropertyContainer *variables)
+    : file_(file_path), lock_(file_path + ".lock")
+{
+    context_ = context;
+    variables_ = variables;
+    if (!file_.open(QIODevice::ReadWrite)) {
+        throw std::runtime_error("Unable to open evaluation cache file " + file_path.toStdString());
+    }
+    if (!lock_.lock()) {
+        throw std::runtime_error("Unable to lock evaluation cache file " + file_path.toStdString());
+    }
+    try {
+        load();
+    } catch (...) {
+        lock_.unlock();
+        throw;
+    }
+    lock_.unlock();
+}
+
+EvaluationCache::~EvaluationCache()
+{
+    file_.close();
+}
+
+QByteArray EvaluationCache::ModelContext(Paths &paths, const QString &cache_path)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    QFile driver(QString::fromStdString(paths.GetPath(Paths::DRIVER_FILE)));
+    if (driver.open(QIODevice::ReadOnly)) {
+        QJsonObject json = QJsonDocument::fromJson(driver.readAll()).object();
+        QJsonObject relevant;
+        relevant["Model"] = json["Model"];
+        relevant["Simulator"] = json["Simulator"];
+        relevant["Objective"] = json["Optimizer"].toObject()["Objective"];
+        // Keys in a QJsonObject are sorted, so the compact form is canonical
+        hash.addData(QJsonDocument(relevant).toJson(QJsonDocument::Compact));
+    }
+
+    for (Paths::Path path : {Paths::SIM_DRIVER_FILE, Paths::SIM_SCH_INSET_FILE,
+                             Paths::SIM_EXEC_SCRIPT_FILE, Paths::GRID_FILE}) {
+        hash.addData(QByteArray::number(path));
+        if (paths.IsSet(path)) {
+            addFile(hash, QString::fromStdString(paths.GetPath(path)));
+        }
+    }
+
+    // Covers the files included from the driver file (property data, INIT files etc.)
+    QStringList excluded_dirs, excluded_files;
+    for (Paths::Path path : {Paths::OUTPUT_DIR, Paths::SIM_WORK_DIR}) {
+        if (paths.IsSet(path)) {
+            excluded_dirs.append(QFileInfo(QString::fromStdString(paths.GetPath(path))).canonicalFilePath());
+        }
+    }
+    if (!cache_path.isEmpty()) {
+        QFileInfo cache(cache_path);
+        QString cache_file = QDir(cache.absolutePath()).canonicalPath() + "/" + cache.fileName();
+        excluded_files << cache_file << cache_file + ".lock";
+    }
+    for (Paths::Path path : {Paths::SIM_DRIVER_DIR, Paths::SIM_AUX_DIR}) {
+        hash.addData(QByteArray::number(path));
+        if (paths.IsSet(path)) {
+            addDirectory(hash, QString::fromStdString(paths.GetPath(path)), excluded_dirs, excluded_files);
+        }
+    }
+    return hash.result();
+}
+
+bool EvaluationCache::Contains(Optimization::Case *c) const
+{
+    QByteArray key = canonicalKey(c);
+    return !key.isEmpty() && entries_.contains(key);
+}
+
+bool EvaluationCache::Restore(Optimization::Case *c) const
+{
+    QByteArray key = canonicalKey(c);
+    if (key.isEmpty()) return false;
+    auto entry = entries_.constFind(key);
+    if (entry == entries_.constEnd()) return false;
+    c->set_objective_function_value(entry->objective_function_value);
+    c->SetSimTime(entry->sim_time);
+    c->SetWICTime(entry->wic_time);
+    return true;
+}
+
+void EvaluationCache::Add(Optimization::Case *c)
+{
+    QByteArray key = canonicalKey(c);
+    if (key.isEmpty() || entries_.contains(key)) return;
+
+    Entry entry;
+    entry.objective_function_value = c->objective_function_value();
+    entry.sim_time = c->GetSimTime();
+    entry.wic_time = c->GetWICTime();
+
+    QByteArray record;
+    QDataStream rs(&record, QIODevice::WriteOnly);
+    rs.setVersion(stream_version);
+    rs << context_ << key << entry.objective_function_value
+       << (qint32)entry.sim_time << (qint32)entry.wic_time;
+
+    if (!lock_.lock()) {
+        Printer::ext_warn("Unable to lock evaluation cache " + file_.fileName().toStdString(),
+                          "Runner", "EvaluationCache");
+        return;
+    }
+    file_.seek(file_.size());
+    QDataStream out(&file_);
+    out.setVersion(stream_version);
+    out << record << qChecksum(record.constData(), record.size());
+    bool written = out.status() == QDataStream::Ok && file_.flush();
+    lock_.unlock();
+    if (!written) {
+        Printer::ext_warn("Unable to write case to evaluation cache " + file_.fileName().toStdString(),
+                          "Runner", "EvaluationCache");
+        return;
+    }
+    entries_.insert(key, entry);
+}
+
+void EvaluationCache::load()
+{
+    QDataStream in(&file_);
+    in.setVersion(stream_version);
+
+    if (file_.size() == 0) {
+        in << cache_magic << cache_version;
+        file_.flush();
+        return;
+    }
+
+    QByteArray magic;
+    quint32 version;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != cache_magic) {
+        throw std::runtime_error(file_.fileName().toStdString() + " is not an evaluation cache file.");
+    }
+    if (version != cache_version) {
+        throw std::runtime_error("Unsupported evaluation cache version in " + file_.fileName().toStdString());
+    }
+
+    int n_records = 0;
+    qint64 valid_end = file_.pos();
+    while (!file_.atEnd()) {
+        QByteArray record;
+        quint16 checksum;
+        in >> record >> checksum;
+        if (in.status() != QDataStream::Ok || checksum != qChecksum(record.constData(), record.size())) {
+            break;
+        }
+
+        QByteArray context, key;
+        double ofv;
+        qint32 sim_time, wic_time;
+        QDataStream rs(record);
+        rs.setVersion(stream_version);
+        rs >> context >> key >> ofv >> sim_time >> wic_time;
+        if (rs.status() != QDataStream::Ok) {
+            break;
+        }
+        valid_end = file_.pos();
+        n_records++;
+        if (context == context_) {
+            entries_.insert(key, Entry{ofv, sim_time, wic_time});
+        }
+    }
+
+    if (valid_end < file_.size()) {
+        Printer::ext_warn("Discarding incomplete record at the end of evaluation cache " + file_.fileName().toStdString(),
+                          "Runner", "EvaluationCache");
+        file_.resize(valid_end);
+    }
+    if (VERB_RUN >= 1) {
+        Printer::ext_info("Loaded " + Printer::num2str(entries_.size()) + " of " + Printer::num2str(n_records)
+                              + " cached evaluations from " + file_.fileName().toStdString(),
+                          "Runner", "EvaluationCache");
+    }
+}
+
+QByteArray EvaluationCache::canonicalKey(Optimization::Case *c) const
+{
+    typedef std::tuple<quint8, QString, double> Variable; //!< Type (0: binary, 1: integer, 2: real), name and value.
+    std::vector<Variable> values;
+
+    try {
+        for (auto &id : c->binary_variable_ids()) {
+            auto name = variables_->GetBinaryVariable(id)->name();
+            values.push_back(Variable(0, name, c->binary_variable_value(id) ? 1.0 : 0.0));
+        }
+        auto &integer_ids = c->integer_variable_ids();
+        auto &integer_values = c->GetIntegerVarVector();
+        for (int i = 0; i < integer_ids.size(); ++i) {
+            auto name = variables_->GetDiscreteVariable(integer_ids[i])->name();
+            values.push_back(Variable(1, name, (double)integer_values[i]));
+        }
+        auto &real_ids = c->real_variable_ids();
+        auto &real_values = c->GetRealVarVector();
+        for (int i = 0; i < real_ids.size(); ++i) {
+            auto name = variables_->GetContinousVariable(real_ids[i])->name();
+            values.push_back(Variable(2, name, real_values[i] + 0.0)); // + 0.0 normalizes -0.0
+        }
+    } catch (Model::Properties::VariableIdDoesNotExistException &e) {
+        return QByteArray();
+    }
+    std::sort(values.begin(), values.end(), [](const Variable &a, const Variable &b) {
+      return std::get<0>(a) != std::get<0>(b) ? std::get<0>(a) < std::get<0>(b) : std::get<1>(a) < std::get<1>(b);
+    });
+
+    QByteArray key;
+    QDataStream ks(&key, QIODevice::WriteOnly);
+    ks.setVersion(stream_version);
+    ks << (quint32)values.size();
+    for (auto &value : values) {
+        ks << std::get<0>(value) << std::get<1>(value) << std::get<2>(value);
+    }
+    return key;
+}
+
+}
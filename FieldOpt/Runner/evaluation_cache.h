@@ -0,0 +1,139 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef EVALUATION_CACHE_H
+#define EVALUATION_CACHE_H
+
+#include "Optimization/case.h"
+#include "Model/properties/variable_property_container.h"
+#include "Settings/paths.h"
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QLockFile>
+
+namespace Runner {
+
+/*!
+ * \brief The EvaluationCache class is a persistent store of evaluated cases that
+ * can be shared between runs, and survives a run being aborted and restarted.
+ *
+ * The cache is an append-only binary file. It starts with a magic string and a
+ * format version, followed by one record pr. evaluated case. Each record holds
+ * the model context, the canonical variable key, the objective function value,
+ * the simulation time and the WIC time, and ends with a checksum. The file is
+ * read into an in-memory hash table when the cache is opened; new records are
+ * appended and flushed as soon as a case has been evaluated. A record that was
+ * only partially written (e.g. because the run was killed) is cut off when the
+ * file is opened.
+ *
+ * Variable UUIDs are regenerated every run, so the canonical key of a case is
+ * built from the variable names instead: the (type, name, value) triples of all
+ * variables, sorted by type and name. Cases are only considered equal if their
+ * keys are identical, i.e. the lookup is exact.
+ *
+ * The model context (see ModelContext()) identifies the model, schedule and grid
+ * a case was evaluated with. Records with a different context than the one the
+ * cache was opened with are ignored, so several problems may share one file.
+ *
+ * Runs sharing a cache file take a lock file (the cache path with a .lock suffix)
+ * while reading the file and while appending a record, so that records written by
+ * concurrent runs are never interleaved.
+ */
+class EvaluationCache
+{
+public:
+    /*!
+     * \brief EvaluationCache Open the cache file at file_path, creating it if
+     * it does not exist. Throws a runtime_error if the file can not be opened
+     * or is not an evaluation cache.
+     * \param file_path Path to the cache file.
+     * \param context Model context of the current run (see ModelContext()).
+     * \param variables Variable container used to look up variable names.
+     */
+    EvaluationCache(const QString &file_path,
+                    const QByteArray &context,
+                    Model::Properties::VariablePropertyContainer *variables);
+    ~EvaluationCache();
+
+    /*!
+     * \brief ModelContext Compute a hash identifying the model a case is evaluated
+     * with. It covers the Model, Simulator and Optimizer.Objective sections of the
+     * FieldOpt driver file, and the contents of the simulator driver file, schedule
+     * inset file, simulator execution script and grid file (those that are set).
+     *
+     * Files included from the simulator driver file are not resolved; instead, the
+     * names and contents of all files in the simulator driver directory and the
+     * auxiliary directory are hashed (except the output and work directories, if
+     * they are inside them, and the cache file itself).
+     * \param paths Paths of the run.
+     * \param cache_path Path to the cache file, if it is to be opened with this context.
+     */
+    static QByteArray ModelContext(Paths &paths, const QString &cache_path = QString());
+
+    /*!
+     * \brief Contains Check whether the cache holds a case with the same variable
+     * values as c.
+     */
+    bool Contains(Optimization::Case *c) const;
+
+    /*!
+     * \brief Restore Set the objective function value, simulation time and WIC
+     * time of c to those of the cached case with the same variable values.
+     * \return True if the case was found in the cache; otherwise false.
+     */
+    bool Restore(Optimization::Case *c) const;
+
+    /*!
+     * \brief Add Append an evaluated case to the cache. Cases already in the
+     * cache, and cases with variables not found in the variable container,
+     * are not added.
+     */
+    void Add(Optimization::Case *c);
+
+    int size() const { return entries_.size(); } //!< Number of cached cases for the current context.
+
+private:
+    struct Entry {
+        double objective_function_value;
+        int sim_time;
+        int wic_time;
+    };
+
+    QFile file_;
+    QLockFile lock_; //!< Held while reading or appending to the file.
+    QByteArray context_;
+    Model::Properties::VariablePropertyContainer *variables_;
+    QHash<QByteArray, Entry> entries_; //!< Cached cases with the current context, by canonical key.
+
+    /*!
+     * \brief load Read all complete records from the file, and truncate the
+     * file after the last one.
+     */
+    void load();
+
+    /*!
+     * \brief canonicalKey Get the canonical key for the variable values of c.
+     * Returns an empty array if any of the variables is not found in the
+     * variable container.
+     */
+    QByteArray canonicalKey(Optimization::Case *c) const;
+};
+
+}
+
+#endif // EVALUATION_CACHE_H
@@ -42,6 +42,7 @@
 #include "Utilities/math.hpp"
 #include "Utilities/printer.hpp"
 #include "Utilities/verbosity.h"
+#include <limits>
 
 namespace Runner {
 
@@ -56,6 +57,9 @@ AbstractRunner::AbstractRunner(RuntimeSettings *runtime_settings)
     base_case_ = 0;
     optimizer_ = 0;
     bookkeeper_ = 0;
+    evaluation_cache_ = 0;
+    base_case_cached_ = false;
+    best_objective_ = std::numeric_limits<double>::quiet_NaN();
 }
 
 double AbstractRunner::sentinelValue() const
@@ -97,6 +101,7 @@ void AbstractRunner::InitializeModel()
     }
 
     model_ = new Model::Model(*settings_, logger_);
+    model_->SetWICThreads(runtime_settings_->wic_threads());
 }
 
 void AbstractRunner::InitializeSimulator()
@@ -104,27 +109,48 @@ void AbstractRunner::InitializeSimulator()
     if (model_ == 0)
         throw std::runtime_error("The Model must be initialized before the simulator.");
 
-    switch (settings_->simulator()->type()) {
+    simulator_ = createSimulator(settings_, model_);
+}
+
+Simulation::Simulator *AbstractRunner::createSimulator(Settings::Settings *settings, Model::Model *model) const
+{
+    Simulation::Simulator *simulator;
+    switch (settings->simulator()->type()) {
         case ::Settings::Simulator::SimulatorType::ECLIPSE:
             if (VERB_RUN >= 1) Printer::info("Using ECLIPSE reservoir simulator.");
-            simulator_ = new Simulation::ECLSimulator(settings_, model_);
+            simulator = new Simulation::ECLSimulator(settings, model);
             break;
         case ::Settings::Simulator::SimulatorType::ADGPRS:
             if (VERB_RUN >= 1) Printer::info("Using AD-GPRS reservoir simulator.");
-            simulator_ = new Simulation::AdgprsSimulator(settings_, model_);
+            simulator = new Simulation::AdgprsSimulator(settings, model);
             break;
         case ::Settings::Simulator::SimulatorType::Flow:
             if (VERB_RUN >= 1) Printer::info("Using Flow reservoir simulator.");
-            simulator_ = new Simulation::ECLSimulator(settings_, model_);
+            simulator = new Simulation::ECLSimulator(settings, model);
             break;
         case ::Settings::Simulator::SimulatorType::INTERSECT:
             if (VERB_RUN >= 1) Printer::info("Using INTERSECT reservoir simulator.");
-            simulator_ = new Simulation::IXSimulator(settings_, model_);
+            simulator = new Simulation::IXSimulator(settings, model);
             break;
         default:
             throw std::runtime_error("Unable to initialize runner: simulator set in driver file not recognized.");
     }
-    simulator_->SetVerbosityLevel(runtime_settings_->verbosity_level());
+    simulator->SetVerbosityLevel(runtime_settings_->verbosity_level());
+    return simulator;
+}
+
+void AbstractRunner::InitializeEvaluationCache()
+{
+    if (model_ == 0)
+        throw std::runtime_error("The Model must be initialized before the evaluation cache.");
+    if (runtime_settings_->evaluation_cache_path().empty() || is_ensemble_run_)
+        return;
+
+    if (VERB_RUN >= 1) Printer::ext_info("Using evaluation cache " + runtime_settings_->evaluation_cache_path(), "Runner", "AbstractRunner");
+    QString cache_path = QString::fromStdString(runtime_settings_->evaluation_cache_path());
+    evaluation_cache_ = new EvaluationCache(cache_path,
+                                            EvaluationCache::ModelContext(settings_->paths(), cache_path),
+                                            model_->variables());
 }
 
 void AbstractRunner::EvaluateBaseModel()
@@ -135,6 +161,10 @@ void AbstractRunner::EvaluateBaseModel()
         if (runtime_settings_->verbosity_level()) std::cout << "Simulating ensemble base case." << std::endl;
         simulator_->Evaluate(ensemble_helper_.GetBaseRealization(), 10000, 4);
     }
+    else if (evaluation_cache_ != 0 && evaluation_cache_->Restore(createBaseCase())) {
+        if (runtime_settings_->verbosity_level()) std::cout << "Base case found in evaluation cache." << std::endl;
+        base_case_cached_ = true;
+    }
     else if (!simulator_->results()->isAvailable()) {
         if (runtime_settings_->verbosity_level()) std::cout << "Simulating base case." << std::endl;
         simulator_->Evaluate();
@@ -146,34 +176,96 @@ void AbstractRunner::InitializeObjectiveFunction()
     if (simulator_ == 0 || settings_ == 0)
         throw std::runtime_error("The Simulator and the Settings must be initialized before the Objective Function.");
 
-    switch (settings_->optimizer()->objective().type) {
+    objective_function_ = createObjectiveFunction(settings_, simulator_, model_);
+}
+
+Optimization::Objective::Objective *AbstractRunner::createObjectiveFunction(Settings::Settings *settings,
+                                                                           Simulation::Simulator *simulator,
+                                                                           Model::Model *model) const
+{
+    return createObjectiveFunction(settings, simulator->results(), model);
+}
+
+Optimization::Objective::Objective *AbstractRunner::createObjectiveFunction(Settings::Settings *settings,
+                                                                           Simulation::Results::Results *results,
+                                                                           Model::Model *model) const
+{
+    switch (settings->optimizer()->objective().type) {
         case Settings::Optimizer::ObjectiveType::WeightedSum:
             if (VERB_RUN >=1) Printer::ext_info("Using WeightedSum-type objective function.", "Runner", "AbstractRunner");
-            objective_function_ = new Optimization::Objective::WeightedSum(settings_->optimizer(), simulator_->results(), model_);
-            break;
+            return new Optimization::Objective::WeightedSum(settings->optimizer(), results, model);
         case Settings::Optimizer::ObjectiveType::NPV:
             if (VERB_RUN >=1) Printer::ext_info("Using NPV-type objective function.", "Runner", "AbstractRunner");
-            objective_function_ = new Optimization::Objective::NPV(settings_->optimizer(), simulator_->results(), model_);
-            break;
+            return new Optimization::Objective::NPV(settings->optimizer(), results, model);
 
         case Settings::Optimizer::ObjectiveType::ExternalResult:
             if (VERB_RUN >=1) Printer::ext_info("Using ExternalResult-type objective function.", "Runner", "AbstractRunner");
-            objective_function_ = new Optimization::Objective::ExternalResult(settings_->optimizer(), model_);
-            break;
+            return new Optimization::Objective::ExternalResult(settings->optimizer(), model);
 
         default:
             throw std::runtime_error("Unable to initialize runner: objective function type not recognized.");
     }
 }
 
+Simulation::SimulationMonitor *AbstractRunner::createSimulationMonitor(Settings::Settings *settings,
+                                                                      Simulation::Simulator *simulator,
+                                                                      Model::Model *model)
+{
+    if (!settings->simulator()->early_termination())
+        return nullptr;
+    if (is_ensemble_run_) {
+        Printer::ext_warn("Early termination is not supported for ensemble runs.", "Runner", "AbstractRunner");
+        return nullptr;
+    }
+    bool maximize = settings->optimizer()->mode() == Settings::Optimizer::OptimizerMode::Maximize;
+    auto monitor = new Simulation::SimulationMonitor(settings->simulator(), maximize);
+    if (settings->optimizer()->objective().type == Settings::Optimizer::ObjectiveType::ExternalResult) {
+        Printer::ext_warn("The objective bound can not be computed for ExternalResult objectives. "
+                          "Only terminating simulations on convergence failures.", "Runner", "AbstractRunner");
+    }
+    else {
+        auto partial_objective = createObjectiveFunction(settings, monitor->partial_results(), model);
+        monitor->SetObjective([partial_objective, settings, model] {
+            model->wellCost(settings->optimizer());
+            return partial_objective->value();
+        });
+    }
+    monitor->SetReference([this] { return best_objective_.load(); });
+    simulator->SetMonitor(monitor);
+    return monitor;
+}
+
+void AbstractRunner::updateBestObjective()
+{
+    Optimization::Case *best_case = optimizer_ != 0 ? optimizer_->GetTentativeBestCase() : nullptr;
+    if (best_case != nullptr)
+        best_objective_ = best_case->objective_function_value();
+}
+
+void AbstractRunner::setTerminatedCaseState(Optimization::Case *c, const Simulation::SimulationMonitor *monitor) const
+{
+    // The bound is an extrapolation, so it is not passed on to the optimizer as the objective
+    c->state.eval = Optimization::Case::CaseState::EvalStatus::E_TERMINATED;
+    c->set_objective_function_value(sentinelValue());
+    if (monitor->verdict() == Simulation::SimulationMonitor::BOUND_EXCEEDED) {
+        if (VERB_RUN >= 2) Printer::ext_info("Case terminated with objective bound " + Printer::num2str(monitor->bound())
+                                                 + ". Setting obj. fun. value to sentinel value.", "Runner", "AbstractRunner");
+    }
+    else {
+        c->state.err_msg = Optimization::Case::CaseState::ErrorMessage::ERR_SIM;
+    }
+}
+
 void AbstractRunner::InitializeBaseCase()
 {
     if (objective_function_ == 0 || model_ == 0)
         throw std::runtime_error("The Objective Function and the Model must be initialized before the Base Case.");
-    base_case_ = new Optimization::Case(model_->variables()->GetBinaryVariableValues(),
-                                        model_->variables()->GetDiscreteVariableValues(),
-                                        model_->variables()->GetContinousVariableValues());
-    if (!simulator_->results()->isAvailable()) {
+    if (base_case_ == 0)
+        createBaseCase();
+    if (base_case_cached_) {
+        if (VERB_RUN >= 1) Printer::ext_info("Base case objective function value restored from evaluation cache.", "Runner", "AbstractRunner");
+    }
+    else if (!simulator_->results()->isAvailable()) {
         if (runtime_settings_->verbosity_level())
             std::cout << "Simulation results are unavailable. Setting base case objective function value to sentinel value." << std::endl;
         base_case_->set_objective_function_value(sentinelValue());
@@ -181,10 +273,20 @@ void AbstractRunner::InitializeBaseCase()
     else{
         model_->wellCost(settings_->optimizer());
         base_case_->set_objective_function_value(objective_function_->value());
+        if (evaluation_cache_ != 0)
+            evaluation_cache_->Add(base_case_);
     }
     if (VERB_RUN >= 1) Printer::ext_info("Base case objective function value set to " + Printer::num2str(base_case_->objective_function_value()), "Runner", "AbstractRunner");
 }
 
+Optimization::Case *AbstractRunner::createBaseCase()
+{
+    base_case_ = new Optimization::Case(model_->variables()->GetBinaryVariableValues(),
+                                        model_->variables()->GetDiscreteVariableValues(),
+                                        model_->variables()->GetContinousVariableValues());
+    return base_case_;
+}
+
 void AbstractRunner::InitializeOptimizer()
 {
     if (base_case_ == 0 || model_ == 0)
@@ -303,6 +405,7 @@ void AbstractRunner::InitializeBookkeeper()
         throw std::runtime_error("The Settings and the Optimizer must be initialized before the Bookkeeper.");
 
     bookkeeper_ = new Bookkeeper(settings_, optimizer_->case_handler());
+    bookkeeper_->SetEvaluationCache(evaluation_cache_);
 }
 
 void AbstractRunner::InitializeLogger(QString output_subdir, bool write_logs)
@@ -324,19 +427,20 @@ void AbstractRunner::PrintCompletionMessage() const {
 
     std::cout << "Best case at termination:" << optimizer_->GetTentativeBestCase()->id().toString().toStdString() << std::endl;
     std::cout << "Variable values: " << std::endl;
-    for (auto var : optimizer_->GetTentativeBestCase()->integer_variables().keys()) {
+    auto best_case = optimizer_->GetTentativeBestCase();
+    for (auto var : best_case->integer_variable_ids()) {
         auto prop_name = model_->variables()->GetDiscreteVariable(var)->name();
-        auto prop_val = optimizer_->GetTentativeBestCase()->integer_variables()[var];
+        auto prop_val = best_case->integer_variable_value(var);
         std::cout << "\t" << prop_name.toStdString() << "\t" << prop_val << std::endl;
     }
-    for (auto var : optimizer_->GetTentativeBestCase()->real_variables().keys()) {
+    for (auto var : best_case->real_variable_ids()) {
         auto prop_name = model_->variables()->GetContinousVariable(var)->name();
-        auto prop_val = optimizer_->GetTentativeBestCase()->real_variables()[var];
+        auto prop_val = best_case->real_variable_value(var);
         std::cout << "\t" << prop_name.toStdString() << "\t" << prop_val << std::endl;
     }
-    for (auto var : optimizer_->GetTentativeBestCase()->binary_variables().keys()) {
+    for (auto var : best_case->binary_variable_ids()) {
         auto prop_name = model_->variables()->GetBinaryVariable(var)->name();
-        auto prop_val = optimizer_->GetTentativeBestCase()->binary_variables()[var];
+        auto prop_val = best_case->binary_variable_value(var);
         std::cout << "\t" << prop_name.toStdString() << "\t" << prop_val << std::endl;
     }
 }
@@ -34,8 +34,10 @@
 #include "Simulation/simulator_interfaces/simulator.h"
 #include "Settings/settings.h"
 #include "bookkeeper.h"
+#include "evaluation_cache.h"
 #include "Runner/logger.h"
 #include "ensemble_helper.h"
+#include <atomic>
 #include <vector>
 #include "Optimization/objective/NPV.h"
 
@@ -68,15 +70,18 @@ class AbstractRunner
   AbstractRunner(RuntimeSettings *runtime_settings);
 
   Bookkeeper *bookkeeper_;
+  EvaluationCache *evaluation_cache_; //!< Persistent cache of evaluated cases. Null if no cache file was given.
   Model::Model *model_;
   Settings::Settings *settings_;
   RuntimeSettings *runtime_settings_;
   Optimization::Case *base_case_;
+  bool base_case_cached_; //!< Whether the base case objective was restored from the evaluation cache.
   Optimization::Optimizer *optimizer_;
   Optimization::Objective::Objective *objective_function_;
   Simulation::Simulator *simulator_;
   Logger *logger_;
   std::vector<int> simulation_times_;
+  std::atomic<double> best_objective_; //!< Objective value of the tentative best case; read by simulation monitors. NaN until known.
   bool is_ensemble_run_;
   EnsembleHelper ensemble_helper_;
 
@@ -101,9 +106,57 @@ class AbstractRunner
    */
   int timeoutValue() const;
 
+  /*!
+   * @brief Create a simulator of the type set in the settings for the given model.
+   */
+  Simulation::Simulator *createSimulator(Settings::Settings *settings, Model::Model *model) const;
+
+  /*!
+   * @brief Create an objective function of the type set in the settings, reading results from the given simulator.
+   */
+  Optimization::Objective::Objective *createObjectiveFunction(Settings::Settings *settings,
+                                                              Simulation::Simulator *simulator,
+                                                              Model::Model *model) const;
+
+  /*!
+   * @brief Create an objective function of the type set in the settings, reading from the given results.
+   */
+  Optimization::Objective::Objective *createObjectiveFunction(Settings::Settings *settings,
+                                                              Simulation::Results::Results *results,
+                                                              Model::Model *model) const;
+
+  /*!
+   * @brief Create a monitor for early termination of simulations and attach it to the
+   * simulator, if early termination is enabled in the settings. The monitor evaluates
+   * the objective on the partial results, and compares it against best_objective_.
+   * @return The monitor; null if early termination is disabled.
+   */
+  Simulation::SimulationMonitor *createSimulationMonitor(Settings::Settings *settings,
+                                                         Simulation::Simulator *simulator,
+                                                         Model::Model *model);
+
+  /*!
+   * @brief Update best_objective_ from the optimizer's tentative best case. Must be
+   * called from the main thread.
+   */
+  void updateBestObjective();
+
+  /*!
+   * @brief Set the state and objective value of a case whose simulation was terminated
+   * by the monitor. The case is marked E_TERMINATED and gets the sentinel value, both when
+   * it could not beat the best case and when the simulator failed to converge (ERR_SIM).
+   */
+  void setTerminatedCaseState(Optimization::Case *c, const Simulation::SimulationMonitor *monitor) const;
+
   void InitializeSettings(QString output_subdirectory="");
   void InitializeModel();
   void InitializeSimulator();
+
+  /*!
+   * @brief Open the persistent evaluation cache, if a cache file was given. Must be
+   * called after the model has been initialized and before the base model is evaluated.
+   */
+  void InitializeEvaluationCache();
   void EvaluateBaseModel();
   void InitializeObjectiveFunction();
   void InitializeBaseCase();
@@ -117,6 +170,9 @@ class AbstractRunner
    * @param output_subdir Optional subdir in the output dir to write the logs in.
    */
   void InitializeLogger(QString output_subdir="", bool write_logs=true);
+
+ private:
+  Optimization::Case *createBaseCase(); //!< Create base_case_ from the current variable values of the model.
 };
 
 }
@@ -0,0 +1,126 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#include "asynchronous_mpi_runner.h"
+#include "Utilities/printer.hpp"
+
+namespace Runner {
+namespace MPI {
+
+AsynchronousMPIRunner::AsynchronousMPIRunner(RuntimeSettings *rts) : SynchronousMPIRunner(rts) {
+    prefetch_depth_ = rts->prefetch_depth();
+}
+
+void AsynchronousMPIRunner::Execute() {
+    if (rank() != 0) {
+        executeWorker();
+        return;
+    }
+    if (is_ensemble_run_) {
+        Printer::ext_warn("Ensemble runs are not supported by the asynchronous overseer. "
+                              "Falling back to the synchronous MPI runner.", "Runner", "AsynchronousMPIRunner");
+        SynchronousMPIRunner::Execute();
+        return;
+    }
+
+    typedef Optimization::Optimizer::TerminationCondition TC;
+    while (optimizer_->IsFinished() == TC::NOT_FINISHED) {
+        bool progress = false;
+        while (auto evaluated_case = overseer_->TryRecvEvaluatedCase()) {
+            submitEvaluatedCase(evaluated_case);
+            progress = true;
+        }
+        if (optimizer_->IsFinished() != TC::NOT_FINISHED) break;
+
+        progress = dispatchReadyCases() || progress;
+        if (prepareQueuedCase()) { // One case at a time, so that evaluated cases are received in between
+            dispatchReadyCases();
+            continue;
+        }
+        if (progress) continue;
+
+        if (overseer_->NumberOfOutstandingCases() == 0 && ready_queue_.empty()) {
+            printMessage("No cases queued or outstanding. Starting next iteration.", 2);
+            prepareCase(optimizer_->GetCaseForEvaluation());
+        }
+        else {
+            printMessage("Nothing to prepare. Waiting for an evaluated case.", 2);
+            submitEvaluatedCase(overseer_->RecvEvaluatedCase());
+        }
+    }
+
+    // Workers evaluate their queued cases before they read the termination signal
+    printMessage("Waiting for " + std::to_string(overseer_->NumberOfOutstandingCases()) + " outstanding cases.", 2);
+    while (overseer_->NumberOfOutstandingCases() > 0) {
+        delete overseer_->RecvEvaluatedCase();
+    }
+    FinalizeRun(true);
+    overseer_->TerminateWorkers();
+    printMessage("Terminating workers.", 2);
+    overseer_->EnsureWorkerTermination();
+    WaitForPendingSends();
+    env_.~environment();
+}
+
+int AsynchronousMPIRunner::currentPrefetchDepth() {
+    int undispatched = (int)ready_queue_.size() + optimizer_->nr_queued_cases();
+    return undispatched > world_.size() - 1 ? prefetch_depth_ : 1;
+}
+
+bool AsynchronousMPIRunner::prepareQueuedCase() {
+    int capacity = overseer_->NumberOfFreeSlots(currentPrefetchDepth()) + world_.size() - 1;
+    if (optimizer_->nr_queued_cases() == 0 || (int)ready_queue_.size() >= capacity) return false;
+    prepareCase(optimizer_->GetCaseForEvaluation());
+    return true;
+}
+
+bool AsynchronousMPIRunner::dispatchReadyCases() {
+    bool dispatched = false;
+    while (!ready_queue_.empty() && overseer_->NumberOfFreeSlots(currentPrefetchDepth()) > 0) {
+        overseer_->QueueCase(ready_queue_.front(), currentPrefetchDepth());
+        ready_queue_.pop_front();
+        dispatched = true;
+    }
+    return dispatched;
+}
+
+void AsynchronousMPIRunner::prepareCase(Optimization::Case *c) {
+    if (bookkeeper_->IsEvaluated(c, true)) {
+        printMessage("Case found in bookkeeper");
+        c->state.eval = Optimization::Case::CaseState::EvalStatus::E_BOOKKEEPED;
+        optimizer_->SubmitEvaluatedCase(c);
+    }
+    else {
+        ready_queue_.push_back(c);
+    }
+}
+
+void AsynchronousMPIRunner::submitEvaluatedCase(Optimization::Case *evaluated_case) {
+    if (overseer_->last_case_tag == MPIRunner::MsgTag::CASE_EVAL_SUCCESS) {
+        evaluated_case->state.eval = Optimization::Case::CaseState::EvalStatus::E_DONE;
+        if (evaluated_case->GetSimTime() > 0) {
+            simulation_times_.push_back(evaluated_case->GetSimTime());
+        }
+        if (evaluation_cache_ != 0) {
+            evaluation_cache_->Add(evaluated_case);
+        }
+    }
+    optimizer_->SubmitEvaluatedCase(evaluated_case);
+    delete evaluated_case; // The values have been copied to the optimizer's case
+}
+
+}
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#ifndef FIELDOPT_ASYNCHRONOUS_MPI_RUNNER_H
+#define FIELDOPT_ASYNCHRONOUS_MPI_RUNNER_H
+
+#include "synchronous_mpi_runner.h"
+#include <deque>
+
+namespace Runner {
+namespace MPI {
+
+/*!
+ * @brief The AsynchronousMPIRunner class performs the optimization in parallel like the
+ * SynchronousMPIRunner, but the overseer never blocks while it has other work to do.
+ *
+ * The workers are identical to the ones in the SynchronousMPIRunner. The overseer:
+ *   - polls for evaluated cases instead of blocking in a receive, and submits every case that has
+ *     arrived before doing anything else;
+ *   - keeps a ready-queue of cases taken from the optimizer (already snapped to the constraints by
+ *     the optimizer), checked against the bookkeeper while the workers are busy;
+ *   - sends cases without waiting for them to be received, and keeps up to prefetch_depth cases
+ *     outstanding on each worker (the --prefetch-depth argument) while there is enough work for
+ *     all workers, so that a worker receives its next case before it has finished the current one;
+ *   - only blocks in a receive when there is nothing to prepare or send.
+ *
+ * As in the synchronous runner, the optimizer is only asked for a new case (i.e. allowed to
+ * iterate) when its queue is empty once all outstanding cases have been returned.
+ *
+ * Ensemble runs, where realizations are assigned to specific workers, fall back to the
+ * synchronous runner. The --sim-delay argument is not used.
+ */
+class AsynchronousMPIRunner : public SynchronousMPIRunner {
+ public:
+  AsynchronousMPIRunner(RuntimeSettings *rts);
+
+  void Execute() override;
+
+ private:
+  int prefetch_depth_; //!< Maximum number of cases outstanding on each worker.
+  std::deque<Optimization::Case *> ready_queue_; //!< Cases ready to be sent to a worker.
+
+  /*!
+   * @brief The number of cases that may be outstanding on a worker: prefetch_depth_ while there are
+   * more undispatched cases than workers, otherwise 1. Cases queued on a worker can not be moved to
+   * another one that becomes free, so the last cases of an iteration are not prefetched.
+   */
+  int currentPrefetchDepth();
+
+  /*!
+   * @brief Take one queued case from the optimizer and prepare it, unless the ready-queue holds
+   * enough cases to fill all free worker slots and one more for each worker.
+   * @return True if a case was taken.
+   */
+  bool prepareQueuedCase();
+
+  /*!
+   * @brief Send cases from the ready-queue to workers with free slots.
+   * @return True if any case was sent.
+   */
+  bool dispatchReadyCases();
+
+  /*!
+   * @brief Submit a case to the optimizer if it has been evaluated before; otherwise add it to
+   * the ready-queue.
+   */
+  void prepareCase(Optimization::Case *c);
+
+  /*!
+   * @brief Submit an evaluated case received from a worker to the optimizer, and delete it.
+   */
+  void submitEvaluatedCase(Optimization::Case *evaluated_case);
+};
+
+}
+}
+
+#endif //FIELDOPT_ASYNCHRONOUS_MPI_RUNNER_H
@@ -28,6 +28,10 @@
 
 namespace Runner {
 
+namespace {
+const size_t max_keyed_selections = 64; //!< Number of keyed realization selections to remember.
+}
+
 EnsembleHelper::EnsembleHelper() {
     current_case_ = 0;
     rzn_queue_ = std::vector<std::string>();
@@ -111,6 +115,18 @@ Optimization::Case *EnsembleHelper::GetEvaluatedCase() {
 void EnsembleHelper::selectRealizations() {
     auto all_aliases = ensemble_.GetAliases();
 
+    int key = current_case_->GetRealizationSelectionKey();
+    if (key >= 0 && n_select_ < all_aliases.size()) {
+        if (keyed_selections_.count(key) > 0) {
+            if (VERB_RUN >=2) Printer::ext_info("Reusing subset of realizations selected for key " + Printer::num2str(key), "Runner", "EnsembleHelper");
+            rzn_queue_ = keyed_selections_[key];
+            return;
+        }
+        if (keyed_selections_.size() >= max_keyed_selections) { // Keys are increasing; forget the oldest
+            keyed_selections_.erase(keyed_selections_.begin());
+        }
+    }
+
     if (n_select_ == all_aliases.size()) {
         if (VERB_RUN >=2) Printer::ext_info("Selecting all realizations", "Runner", "EnsembleHelper");
         for (auto alias : all_aliases) {
@@ -123,6 +139,9 @@ void EnsembleHelper::selectRealizations() {
         for (auto idx : indices) {
             rzn_queue_.push_back(all_aliases[idx]);
         }
+        if (key >= 0) {
+            keyed_selections_[key] = rzn_queue_;
+        }
     }
 }
 Settings::Ensemble::Realization EnsembleHelper::GetRealization(const std::string &alias) const {
@@ -136,7 +136,9 @@ class EnsembleHelper {
 
   /*!
    * Pick a set of realizations from the ensemble and add
-   * them to the queue.
+   * them to the queue. If the current case has a realization
+   * selection key, the set picked for the last cases with
+   * the same key is reused.
    */
   void selectRealizations();
 
@@ -202,6 +204,11 @@ class EnsembleHelper {
    */
   std::map<std::string, std::vector<int> > assigend_workers_;
 
+  /*!
+   * Realizations selected for the most recent realization selection keys.
+   */
+  std::map<int, std::vector<std::string> > keyed_selections_;
+
 };
 
 }
@@ -2,6 +2,8 @@
 #include "serial_runner.h"
 #include "oneoff_runner.h"
 #include "synchronous_mpi_runner.h"
+#include "asynchronous_mpi_runner.h"
+#include "parallel_runner.h"
 
 namespace Runner {
 
@@ -19,6 +21,12 @@ namespace Runner {
             case RuntimeSettings::RunnerType::MPISYNC:
                 runner_ = new MPI::SynchronousMPIRunner(runtime_settings_);
                 break;
+            case RuntimeSettings::RunnerType::PARALLEL:
+                runner_ = new ParallelRunner(runtime_settings_);
+                break;
+            case RuntimeSettings::RunnerType::MPIASYNC:
+                runner_ = new MPI::AsynchronousMPIRunner(runtime_settings_);
+                break;
             default:
                 throw std::runtime_error("Runner type not recognized.");
         }
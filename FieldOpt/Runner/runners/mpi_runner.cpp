@@ -1,8 +1,8 @@
 #include "mpi_runner.h"
 #include "Optimization/case_transfer_object.h"
 #include "Model/model_synchronization_object.h"
-#include <boost/archive/text_oarchive.hpp>
-#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
 #include <boost/mpi/status.hpp>
 #include <boost/lexical_cast.hpp>
 #include <iostream>
@@ -20,37 +20,68 @@ MPIRunner::MPIRunner(RuntimeSettings *rts) : AbstractRunner(rts) {
 }
 
 void MPIRunner::SendMessage(Message &message) {
-    std::string s;
-    if (message.c != nullptr) {
-        auto cto = Optimization::CaseTransferObject(message.c);
-        std::ostringstream oss;
-        boost::archive::text_oarchive oa(oss);
-        oa << cto;
-        s = oss.str();
-    }
-    else {
-        s = "";
-    }
-    world_.send(message.destination, message.tag, s);
+    std::vector<char> buffer;
+    packMessage(message, buffer);
+    sendBuffer(buffer, message.destination, message.tag);
     printMessage("Sent a message to " + boost::lexical_cast<std::string>(message.destination)
                      + " with tag " + boost::lexical_cast<std::string>(message.tag) + " (" + tag_to_string[message.tag] + ")", 2);
 }
 
+void MPIRunner::ISendMessage(Message &message) {
+    testPendingSends();
+    pending_sends_.emplace_back();
+    PendingSend &send = pending_sends_.back();
+    packMessage(message, send.buffer);
+    MPI_Isend(send.buffer.data(), (int)send.buffer.size(), MPI_BYTE, message.destination, message.tag, world_, &send.request);
+    printMessage("Started sending a message to " + boost::lexical_cast<std::string>(message.destination)
+                     + " with tag " + boost::lexical_cast<std::string>(message.tag) + " (" + tag_to_string[message.tag] + ")", 2);
+}
+
+bool MPIRunner::TryRecvMessage(Message &message) {
+    testPendingSends();
+    int available = 0;
+    MPI_Iprobe(message.source, ANY_TAG, world_, &available, MPI_STATUS_IGNORE);
+    if (!available) return false;
+    RecvMessage(message);
+    return true;
+}
+
+void MPIRunner::WaitForPendingSends() {
+    for (auto &send : pending_sends_) {
+        MPI_Wait(&send.request, MPI_STATUS_IGNORE);
+    }
+    pending_sends_.clear();
+}
+
+void MPIRunner::packMessage(Message &message, std::vector<char> &buffer) {
+    QList<Optimization::Case *> cases = message.cases;
+    if (cases.isEmpty() && message.c != nullptr) cases.append(message.c);
+    if (!cases.isEmpty() && message.tag != TERMINATE) {
+        Optimization::CaseTransferObject::Pack(cases, variable_index_, buffer);
+    }
+}
+
+void MPIRunner::testPendingSends() {
+    for (auto it = pending_sends_.begin(); it != pending_sends_.end(); ) {
+        int done = 0;
+        MPI_Test(&it->request, &done, MPI_STATUS_IGNORE);
+        if (done) it = pending_sends_.erase(it);
+        else ++it;
+    }
+}
+
 void MPIRunner::RecvMessage(Message &message) {
-    Optimization::CaseTransferObject cto;
-    std::string s;
+    std::vector<char> buffer;
     printMessage("Waiting to receive a message with tag " + boost::lexical_cast<std::string>(message.tag)
                      + " (" + tag_to_string[message.tag] + ") "
                      + " from source " + boost::lexical_cast<std::string>(message.source), 2);
-    mpi::status status = world_.recv(message.source, ANY_TAG, s);
+    mpi::status status = recvBuffer(buffer, message.source, ANY_TAG);
     message.set_status(status);
     message.tag = status.tag();
 
     auto handle_received_case = [&]() mutable {
-      std::istringstream iss(s);
-      boost::archive::text_iarchive ia(iss);
-      ia >> cto;
-      message.c = cto.CreateCase();
+      message.cases = Optimization::CaseTransferObject::Unpack(buffer, variable_index_);
+      message.c = message.cases.isEmpty() ? nullptr : message.cases.first();
     };
 
     if (message.tag == TERMINATE) {
@@ -88,23 +119,51 @@ void MPIRunner::BroadcastModel() {
     if (rank() != 0) throw std::runtime_error("BroadcastModel should only be called on the root process.");
     auto mso = Model::ModelSynchronizationObject(model_);
     std::ostringstream oss;
-    boost::archive::text_oarchive oa(oss);
-    oa << mso;
+    {
+        boost::archive::binary_oarchive oa(oss);
+        oa << mso;
+    }
     std::string s = oss.str();
+    std::vector<char> buffer(s.begin(), s.end());
     for (int r = 1; r < world_.size(); ++r) {
-        world_.send(r, MODEL_SYNC, s);
+        sendBuffer(buffer, r, MODEL_SYNC);
     }
+    setVariableIndex(mso);
 }
 
 void MPIRunner::RecvModelSynchronizationObject() {
     if (rank() == 0) std::runtime_error("RecvModelSynchronizationObject should not be called on the root process.");
     Model::ModelSynchronizationObject mso;
-    std::string s;
-    world_.recv(0, MODEL_SYNC, s);
-    std::istringstream iss(s);
-    boost::archive::text_iarchive ia(iss);
-    ia >> mso;
+    std::vector<char> buffer;
+    recvBuffer(buffer, 0, MODEL_SYNC);
+    std::istringstream iss(std::string(buffer.begin(), buffer.end()));
+    {
+        boost::archive::binary_iarchive ia(iss);
+        ia >> mso;
+    }
     mso.UpdateVariablePropertyIds(model_);
+    setVariableIndex(mso);
+}
+
+void MPIRunner::setVariableIndex(const Model::ModelSynchronizationObject &mso) {
+    variable_index_ = Optimization::CaseTransferObject::VariableIndex(mso.GetOrderedBinaryVariableIds(),
+                                                                      mso.GetOrderedDiscreteVariableIds(),
+                                                                      mso.GetOrderedContinousVariableIds());
+}
+
+void MPIRunner::sendBuffer(const std::vector<char> &buffer, int destination, int tag) {
+    MPI_Send(const_cast<char *>(buffer.data()), (int)buffer.size(), MPI_BYTE, destination, tag, world_);
+}
+
+mpi::status MPIRunner::recvBuffer(std::vector<char> &buffer, int source, int tag) {
+    // Probe first to size the buffer, then receive exactly the probed message
+    MPI_Status status;
+    MPI_Probe(source, tag, world_, &status);
+    int size;
+    MPI_Get_count(&status, MPI_BYTE, &size);
+    buffer.resize(size);
+    MPI_Recv(buffer.data(), size, MPI_BYTE, status.MPI_SOURCE, status.MPI_TAG, world_, &status);
+    return mpi::status(status);
 }
 
 int MPIRunner::SimulatorDelay() const {
@@ -2,10 +2,16 @@
 #define FIELDOPT_MPIRUNNER_H
 
 #include "abstract_runner.h"
+#include "Optimization/case_transfer_object.h"
 #include <boost/mpi/environment.hpp>
 #include <boost/mpi/communicator.hpp>
+#include <list>
 namespace mpi = boost::mpi;
 
+namespace Model {
+class ModelSynchronizationObject;
+}
+
 namespace Runner {
 namespace MPI {
 class Worker;
@@ -78,6 +84,7 @@ class MPIRunner : public AbstractRunner {
         }
     }
     Optimization::Case *c; //!< The case associated with the message (if any).
+    QList<Optimization::Case *> cases; //!< All cases carried by the message. Set this instead of c to send several cases in one message.
     int tag; //!< The tag for the message.
     int source; //!< The rank of the process sending the message.
     int destination; //!< The rank of the process receiving the message.
@@ -85,7 +92,10 @@ class MPIRunner : public AbstractRunner {
   };
 
   /*!
-   * @brief Send a message potentially containing a case.
+   * @brief Send a message potentially containing one or more cases.
+   *
+   * The cases are packed into a single binary buffer (see Optimization::CaseTransferObject::Pack)
+   * using the variable index set up when the model was synchronized.
    * @param message The message to be sent.
    */
   void SendMessage(Message &message);
@@ -98,12 +108,36 @@ class MPIRunner : public AbstractRunner {
    * will be received. If not, a message will be received from any source and/or with any tag, and the
    * values will be entered in the Message object.
    *
-   * If a case is received, the c field in the parameter message object will be set to it.
+   * If cases are received, the cases field in the parameter message object will be set to them, and
+   * the c field will be set to the first one.
    * @param message
    * @return
    */
   void RecvMessage(Message &message);
 
+  /*!
+   * @brief Send a message without waiting for it to be received.
+   *
+   * The packed message is kept until the send has completed. Completed sends are cleaned up on
+   * subsequent calls to ISendMessage and TryRecvMessage; call WaitForPendingSends to complete all.
+   * Messages to the same destination are received in the order they were sent.
+   * @param message The message to be sent.
+   */
+  void ISendMessage(Message &message);
+
+  /*!
+   * @brief Receive a message if one is available, without blocking.
+   *
+   * Works like RecvMessage, except that it returns immediately if no matching message has arrived.
+   * @return True if a message was received.
+   */
+  bool TryRecvMessage(Message &message);
+
+  /*!
+   * @brief Block until all messages sent with ISendMessage have been sent.
+   */
+  void WaitForPendingSends();
+
   /*!
    * @brief Create a ModelSynchronizationObject and send it to all other processes.
    *
@@ -128,6 +162,7 @@ class MPIRunner : public AbstractRunner {
   int rank_;
   int scheduler_rank_ = 0;
   int simulator_delay_;
+  Optimization::CaseTransferObject::VariableIndex variable_index_; //!< Dense variable index set up at model synchronization.
 
   /*!
    * @brief Print a message to the console.
@@ -135,6 +170,26 @@ class MPIRunner : public AbstractRunner {
    * @param min_verb The minimum verbosity level requred for the message to be printed.
    */
   void printMessage(std::string message, int min_verb=1);
+
+ private:
+  /*!
+   * @brief Set the variable index used to transfer cases from a model synchronization object.
+   */
+  void setVariableIndex(const Model::ModelSynchronizationObject &mso);
+
+  /*!
+   * @brief A message sent with ISendMessage that may not have completed.
+   */
+  struct PendingSend {
+    MPI_Request request;
+    std::vector<char> buffer;
+  };
+  std::list<PendingSend> pending_sends_;
+
+  void packMessage(Message &message, std::vector<char> &buffer); //!< Pack the cases in a message.
+  void testPendingSends(); //!< Release the buffers of completed sends.
+  void sendBuffer(const std::vector<char> &buffer, int destination, int tag); //!< Send a raw buffer.
+  mpi::status recvBuffer(std::vector<char> &buffer, int source, int tag); //!< Receive a raw buffer of any size.
 };
 }
 }
@@ -60,9 +60,53 @@ void Overseer::AssignCase(Optimization::Case *c, int preferred_worker) {
     runner_->printMessage("Current status for workers:\n" + workerStatusSummary(), 2);
 }
 
+void Overseer::QueueCase(Optimization::Case *c, int prefetch_depth) {
+    WorkerStatus *worker = nullptr;
+    for (int i = 1; i < runner_->world_.size(); ++i) {
+        if (workers_[i]->assigned < prefetch_depth && (worker == nullptr || workers_[i]->assigned < worker->assigned))
+            worker = workers_[i];
+    }
+    if (worker == nullptr) throw std::runtime_error("Cannot queue Case. All workers have a full queue.");
+    auto msg = MPIRunner::Message();
+    msg.tag = MPIRunner::MsgTag::CASE_UNEVAL;
+    msg.destination = worker->rank;
+    msg.c = c;
+    runner_->ISendMessage(msg);
+    worker->start();
+    c->state.eval = Optimization::Case::CaseState::EvalStatus::E_CURRENT;
+    runner_->printMessage("Queued case on worker " + boost::lexical_cast<std::string>(worker->rank)
+                              + " (" + boost::lexical_cast<std::string>(worker->assigned) + " outstanding)", 2);
+}
+
+Optimization::Case *Overseer::TryRecvEvaluatedCase() {
+    auto message = MPIRunner::Message();
+    if (!runner_->TryRecvMessage(message)) return nullptr;
+    return handleEvaluatedCaseMessage(message);
+}
+
+int Overseer::NumberOfFreeSlots(int prefetch_depth) {
+    int free_slots = 0;
+    for (int i = 1; i < runner_->world_.size(); ++i) {
+        free_slots += std::max(0, prefetch_depth - workers_[i]->assigned);
+    }
+    return free_slots;
+}
+
+int Overseer::NumberOfOutstandingCases() {
+    int outstanding = 0;
+    for (int i = 1; i < runner_->world_.size(); ++i) {
+        outstanding += workers_[i]->assigned;
+    }
+    return outstanding;
+}
+
 Optimization::Case *Overseer::RecvEvaluatedCase() {
     auto message = MPIRunner::Message();
     runner_->RecvMessage(message);
+    return handleEvaluatedCaseMessage(message);
+}
+
+Optimization::Case *Overseer::handleEvaluatedCaseMessage(MPIRunner::Message &message) {
     workers_[message.source]->stop();
     runner_->printMessage("Received case with tag " + boost::lexical_cast<std::string>(message.tag)
                               + " from worker " + boost::lexical_cast<std::string>(message.source), 2);
@@ -21,6 +21,7 @@
 
 #include "mpi_runner.h"
 #include "Utilities/time.hpp"
+#include <algorithm>
 #include <chrono>
 
 namespace Runner {
@@ -46,6 +47,32 @@ class Overseer {
    */
   Optimization::Case *RecvEvaluatedCase();
 
+  /*!
+   * @brief Send a Case to the worker with the fewest outstanding cases, without waiting for it to be
+   * received. A worker may be sent up to prefetch_depth cases before returning any, so that it
+   * receives its next case while evaluating the current one.
+   * @param c The case to be evaluated.
+   * @param prefetch_depth The maximum number of cases outstanding on one worker.
+   */
+  void QueueCase(Optimization::Case *c, int prefetch_depth);
+
+  /*!
+   * @brief Receive an evaluated case if one has arrived, without blocking.
+   * @return An evaluated case object; null if no case has arrived.
+   */
+  Optimization::Case *TryRecvEvaluatedCase();
+
+  /*!
+   * @brief Get the number of cases that can be queued with QueueCase before all workers have
+   * prefetch_depth outstanding cases.
+   */
+  int NumberOfFreeSlots(int prefetch_depth);
+
+  /*!
+   * @brief Get the number of cases sent to workers that have not been returned.
+   */
+  int NumberOfOutstandingCases();
+
   /*!
    * @brief Wait for a message with the TERMINATE tag from each of the workers to confirm termination
    * before moving on to finalization.
@@ -80,6 +107,7 @@ class Overseer {
     WorkerStatus(int r) { rank = r;}
     int rank; //!< The rank of the process the worker is running on.
     bool working = false; //!< Indicates if the worker is currently performing simulations.
+    int assigned = 0; //!< The number of cases sent to the worker that have not been returned.
     QDateTime working_since; //!< The last time a job was sent to the worker.
     int working_seconds() { //!< Number of seconds since last work was sent to the process.
         return time_since_seconds(working_since);
@@ -89,15 +117,18 @@ class Overseer {
      * working.
      */
     void start() {
+        if (assigned == 0) working_since = QDateTime::currentDateTime();
+        assigned++;
         working = true;
-        working_since = QDateTime::currentDateTime();
     }
     /*!
      * @brief Stop the worker. This should be called whenever results are received from the worker. This
      * marks the worker as not working.
      */
     void stop() {
-        working = false;
+        assigned = std::max(0, assigned - 1);
+        working = assigned > 0;
+        if (working) working_since = QDateTime::currentDateTime(); // Started on its next case
     }
   };
 
@@ -121,6 +152,8 @@ class Overseer {
   std::string workerStatusSummary();
 
   std::chrono::system_clock::time_point last_sim_start_; //!< Time stamp for the start of the previous simulation.
+
+  Optimization::Case *handleEvaluatedCaseMessage(MPIRunner::Message &message); //!< Update the worker status for a received case.
 };
 }
 }
@@ -0,0 +1,234 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#include "parallel_runner.h"
+#include "Model/model_synchronization_object.h"
+#include "Utilities/printer.hpp"
+#include "Utilities/verbosity.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Runner {
+
+ParallelRunner::ParallelRunner(Runner::RuntimeSettings *runtime_settings)
+    : AbstractRunner(runtime_settings)
+{
+    InitializeLogger();
+    InitializeSettings();
+    if (is_ensemble_run_)
+        throw std::runtime_error("The parallel runner does not support ensemble runs. Use the mpisync runner.");
+    InitializeModel();
+    InitializeSimulator();
+    InitializeEvaluationCache();
+    EvaluateBaseModel();
+    InitializeObjectiveFunction();
+    InitializeBaseCase();
+    InitializeOptimizer();
+    InitializeBookkeeper();
+    initializeSlots();
+    FinalizeInitialization(true);
+}
+
+ParallelRunner::ParallelRunner(Runner::RuntimeSettings *runtime_settings, bool)
+    : AbstractRunner(runtime_settings)
+{
+    InitializeLogger("", false);
+    InitializeSettings();
+    InitializeModel();
+    initializeSlots();
+}
+
+void ParallelRunner::Execute()
+{
+    typedef Optimization::Optimizer::TerminationCondition TC;
+    while (optimizer_->IsFinished() == TC::NOT_FINISHED) {
+        if (optimizer_->nr_queued_cases() > 0) {
+            if (freeSlot() != nullptr) handleNewCase();
+            else waitForEvaluatedCase();
+        }
+        else {
+            // Only let the optimizer iterate when no evaluations are outstanding
+            if (numberOfBusySlots() == 0) handleNewCase();
+            else waitForEvaluatedCase();
+        }
+    }
+    while (numberOfBusySlots() > 0) {
+        waitForEvaluatedCase(false);
+    }
+    FinalizeRun(true);
+}
+
+int ParallelRunner::numberOfSlots() const
+{
+    if (runtime_settings_->max_parallel_sims() > 0)
+        return runtime_settings_->max_parallel_sims();
+    int cores = (int)std::thread::hardware_concurrency();
+    return std::max(1, cores / std::max(1, runtime_settings_->threads_per_sim()));
+}
+
+void ParallelRunner::initializeSlots()
+{
+    int n_slots = numberOfSlots();
+    if (VERB_RUN >= 1) Printer::ext_info("Setting up " + Printer::num2str(n_slots) + " evaluation slots with "
+                                             + Printer::num2str(runtime_settings_->threads_per_sim()) + " threads pr. simulation.",
+                                         "Runner", "ParallelRunner");
+    for (int i = 0; i < n_slots; ++i) {
+        QString subdir = "slot" + QString::number(i);
+        Slot *slot = new Slot();
+        slot->index = i;
+        slot->logger = new Logger(runtime_settings_, subdir, false); // Also creates the slot directory
+
+        Paths slot_paths = runtime_settings_->paths();
+        slot_paths.SetPath(Paths::OUTPUT_DIR, runtime_settings_->paths().GetPath(Paths::OUTPUT_DIR) + "/" + subdir.toStdString());
+        slot->settings = new Settings::Settings(slot_paths);
+        slot->settings->set_verbosity(runtime_settings_->verbosity_level());
+
+        slot->model = new Model::Model(*slot->settings, slot->logger);
+        // Give the slot model the variable ids of model_, which are the ids used in the cases
+        Model::ModelSynchronizationObject(model_).UpdateVariablePropertyIds(slot->model);
+        slot->model->SetWICThreads(runtime_settings_->wic_threads());
+        slot->simulator = createSimulator(slot->settings, slot->model);
+        slot->objective = createObjectiveFunction(slot->settings, slot->simulator, slot->model);
+        slot->monitor = createSimulationMonitor(slot->settings, slot->simulator, slot->model);
+        slot->current_case = nullptr;
+        slot->timeout = 0;
+        slots_.push_back(slot);
+    }
+}
+
+int ParallelRunner::numberOfBusySlots() const
+{
+    int busy = 0;
+    for (auto slot : slots_) {
+        if (slot->current_case != nullptr) busy++;
+    }
+    return busy;
+}
+
+ParallelRunner::Slot *ParallelRunner::freeSlot() const
+{
+    for (auto slot : slots_) {
+        if (slot->current_case == nullptr) return slot;
+    }
+    return nullptr;
+}
+
+int ParallelRunner::slotTimeout() const
+{
+    int max_seconds = settings_->simulator()->max_minutes() > 0 ? settings_->simulator()->max_minutes() * 60 : 0;
+    if (simulation_times_.size() == 0 || runtime_settings_->simulation_timeout() == 0)
+        return max_seconds;
+    if (max_seconds > 0)
+        return std::min(timeoutValue(), max_seconds);
+    return timeoutValue();
+}
+
+void ParallelRunner::handleNewCase()
+{
+    if (VERB_RUN >= 3) Printer::ext_info("Getting case from Optimizer.", "Runner", "ParallelRunner");
+    Optimization::Case *new_case = optimizer_->GetCaseForEvaluation();
+
+    if (bookkeeper_->IsEvaluated(new_case, true)) {
+        if (VERB_RUN >= 3) Printer::ext_info("Bookkeeped case.", "Runner", "ParallelRunner");
+        new_case->state.eval = Optimization::Case::CaseState::EvalStatus::E_BOOKKEEPED;
+        optimizer_->SubmitEvaluatedCase(new_case);
+        return;
+    }
+
+    Slot *slot = freeSlot();
+    if (VERB_RUN >= 3) Printer::ext_info("Assigning case to slot " + Printer::num2str(slot->index) + ".", "Runner", "ParallelRunner");
+    new_case->state.eval = Optimization::Case::CaseState::EvalStatus::E_CURRENT;
+    slot->current_case = new_case;
+    slot->timeout = slotTimeout();
+    updateBestObjective();
+    slot->thread = std::thread(&ParallelRunner::evaluate, this, slot);
+}
+
+void ParallelRunner::waitForEvaluatedCase(bool submit)
+{
+    Slot *slot;
+    {
+        std::unique_lock<std::mutex> lock(finished_mutex_);
+        finished_cv_.wait(lock, [this] { return !finished_slots_.empty(); });
+        slot = finished_slots_.front();
+        finished_slots_.pop_front();
+    }
+    slot->thread.join();
+
+    Optimization::Case *evaluated_case = slot->current_case;
+    slot->current_case = nullptr;
+    if (VERB_RUN >= 3) Printer::ext_info("Slot " + Printer::num2str(slot->index) + " done evaluating case.", "Runner", "ParallelRunner");
+
+    if (evaluated_case->state.eval == Optimization::Case::CaseState::EvalStatus::E_DONE) {
+        simulation_times_.push_back(evaluated_case->GetSimTime());
+        if (evaluation_cache_ != 0)
+            evaluation_cache_->Add(evaluated_case);
+    }
+    if (submit) {
+        if (VERB_RUN >= 3) Printer::ext_info("Submitting evaluated case to Optimizer.", "Runner", "ParallelRunner");
+        optimizer_->SubmitEvaluatedCase(evaluated_case);
+    }
+}
+
+void ParallelRunner::evaluate(Slot *slot)
+{
+    Optimization::Case *c = slot->current_case;
+    try {
+        slot->model->ApplyCase(c);
+        bool simulation_success = true;
+        if (slot->timeout <= 0 && slot->monitor == nullptr)
+            slot->simulator->Evaluate();
+        else
+            simulation_success = slot->simulator->Evaluate(slot->timeout, runtime_settings_->threads_per_sim());
+        int sim_time = (int)std::round(slot->simulator->last_run().wall_time);
+        if (slot->simulator->WasTerminatedEarly()) {
+            setTerminatedCaseState(c, slot->monitor);
+        }
+        else if (simulation_success) {
+            slot->model->wellCost(slot->settings->optimizer());
+            c->set_objective_function_value(slot->objective->value());
+            c->state.eval = Optimization::Case::CaseState::EvalStatus::E_DONE;
+            c->SetSimTime(sim_time);
+        }
+        else {
+            c->set_objective_function_value(sentinelValue());
+            c->state.eval = Optimization::Case::CaseState::EvalStatus::E_FAILED;
+            c->state.err_msg = Optimization::Case::CaseState::ErrorMessage::ERR_SIM;
+            if (slot->simulator->last_run().timed_out)
+                c->state.eval = Optimization::Case::CaseState::EvalStatus::E_TIMEOUT;
+        }
+    } catch (const std::exception &e) {
+        Printer::ext_warn("Exception thrown while applying/simulating case in slot " + Printer::num2str(slot->index) + ": "
+                              + std::string(e.what()) + ". Setting obj. fun. value to sentinel value.", "Runner", "ParallelRunner");
+        c->set_objective_function_value(sentinelValue());
+        c->state.eval = Optimization::Case::CaseState::EvalStatus::E_FAILED;
+        c->state.err_msg = Optimization::Case::CaseState::ErrorMessage::ERR_WIC;
+    } catch (...) {
+        // Nothing may escape the slot thread: it would terminate the run, and the
+        // main thread waits for the slot to be pushed to finished_slots_.
+        Printer::ext_warn("Unknown exception thrown while applying/simulating case in slot " + Printer::num2str(slot->index)
+                              + ". Setting obj. fun. value to sentinel value.", "Runner", "ParallelRunner");
+        c->set_objective_function_value(sentinelValue());
+        c->state.eval = Optimization::Case::CaseState::EvalStatus::E_FAILED;
+        c->state.err_msg = Optimization::Case::CaseState::ErrorMessage::ERR_UNKNOWN;
+    }
+
+    std::lock_guard<std::mutex> lock(finished_mutex_);
+    finished_slots_.push_back(slot);
+    finished_cv_.notify_one();
+}
+
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#ifndef PARALLELRUNNER_H
+#define PARALLELRUNNER_H
+
+#include "abstract_runner.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Runner {
+
+class MainRunner;
+class ParallelRunnerTest;
+
+/*!
+ * \brief The ParallelRunner class runs several simulations concurrently on the
+ * local machine, without MPI.
+ *
+ * The runner has a number of evaluation slots. Each slot has its own work directory
+ * (slot<i> in the output directory), and its own Settings, Model, Simulator and
+ * Objective instances, so that slots never share model state or result readers.
+ * Cases are evaluated (applied to the slot's model, simulated and read back) on one
+ * thread pr. busy slot. All interaction with the optimizer, bookkeeper, evaluation
+ * cache and loggers happens on the main thread, through the same
+ * GetCaseForEvaluation/SubmitEvaluatedCase interface as the other runners.
+ *
+ * The number of slots is the --max-parallel-simulations argument if it is set;
+ * otherwise it is the number of cores divided by --threads-per-simulation. Each
+ * simulation is started with threads_per_sim threads.
+ *
+ * Cases are handed out the same way as in the SynchronousMPIRunner: as long as the
+ * optimizer has queued cases they are assigned to free slots; when the queue is
+ * empty the optimizer is only asked for a new case (i.e. allowed to iterate) once
+ * all slots are free. Asynchronous optimizers (APPS, PSO, GA) that queue
+ * new cases as evaluated cases are submitted will keep all slots busy.
+ *
+ * Ensemble runs are not supported; use the MPI runner for those.
+ */
+class ParallelRunner : public AbstractRunner
+{
+  friend class MainRunner;
+  friend class ParallelRunnerTest;
+ private:
+  ParallelRunner(RuntimeSettings *runtime_settings);
+
+  /*!
+   * \brief Set up the settings, model and slots only; no simulator, optimizer or
+   * base case. Used by the unit tests to evaluate cases in single slots.
+   */
+  ParallelRunner(RuntimeSettings *runtime_settings, bool slots_only);
+
+  // AbstractRunner interface
+ private:
+  void Execute();
+
+ private:
+  /*!
+   * \brief The Slot struct holds the objects used to evaluate cases in one slot.
+   */
+  struct Slot {
+    int index;
+    Settings::Settings *settings;
+    Logger *logger;
+    Model::Model *model;
+    Simulation::Simulator *simulator;
+    Optimization::Objective::Objective *objective;
+    Simulation::SimulationMonitor *monitor; //!< Null if early termination is disabled.
+    Optimization::Case *current_case; //!< Case being evaluated. Null if the slot is free.
+    int timeout; //!< Simulation timeout (seconds) for the current case. No timeout if <= 0.
+    std::thread thread;
+  };
+
+  std::vector<Slot *> slots_;
+  std::mutex finished_mutex_;
+  std::condition_variable finished_cv_;
+  std::deque<Slot *> finished_slots_; //!< Slots whose case has been evaluated, in order of completion.
+
+  int numberOfSlots() const; //!< Number of slots to create, from the runtime settings.
+  void initializeSlots(); //!< Create the work directory and model objects for all slots.
+  int numberOfBusySlots() const;
+  Slot *freeSlot() const; //!< Get a free slot. Null if all slots are busy.
+
+  /*!
+   * \brief slotTimeout Get the timeout for the next case. Follows the serial and
+   * MPI runners: no timeout when --sim-timeout is 0 or no simulation time has been
+   * recorded yet (or MaxMinutes if that is set); otherwise the median-based timeout,
+   * capped by MaxMinutes.
+   */
+  int slotTimeout() const;
+
+  /*!
+   * \brief handleNewCase Get a case from the optimizer. If it has already been
+   * evaluated it is submitted right away; otherwise it is assigned to a free slot.
+   */
+  void handleNewCase();
+
+  /*!
+   * \brief waitForEvaluatedCase Block until a slot has finished evaluating its
+   * case, and submit the case to the optimizer.
+   * \param submit Whether to submit the case to the optimizer. Cases still being
+   * evaluated when the optimizer terminates are not submitted.
+   */
+  void waitForEvaluatedCase(bool submit=true);
+
+  /*!
+   * \brief evaluate Apply the slot's current case to its model, simulate it and
+   * compute the objective. Runs on the slot's thread.
+   */
+  void evaluate(Slot *slot);
+};
+
+}
+
+#endif // PARALLELRUNNER_H
@@ -16,7 +16,7 @@
    You should have received a copy of the GNU General Public License
    along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
 ******************************************************************************/
-#include <Utilities/time.hpp>
+#include <cmath>
 #include "serial_runner.h"
 #include "Utilities/printer.hpp"
 #include "Model/model.h"
@@ -30,11 +30,13 @@ SerialRunner::SerialRunner(Runner::RuntimeSettings *runtime_settings)
     InitializeSettings();
     InitializeModel();
     InitializeSimulator();
+    InitializeEvaluationCache();
     EvaluateBaseModel();
     InitializeObjectiveFunction();
     InitializeBaseCase();
     InitializeOptimizer();
     InitializeBookkeeper();
+    createSimulationMonitor(settings_, simulator_, model_);
     FinalizeInitialization(true);
 }
 
@@ -66,10 +68,12 @@ void SerialRunner::Execute()
                 new_case->state.eval = Optimization::Case::CaseState::EvalStatus::E_CURRENT;
                 if (VERB_RUN >= 3) Printer::ext_info("Applying case to model.", "Runner", "Serial Runner");
                 model_->ApplyCase(new_case);
-                auto start = QDateTime::currentDateTime();
+                bool monitored = simulator_->monitor() != nullptr;
+                if (monitored) updateBestObjective();
                 if (!is_ensemble_run_ && (simulation_times_.size() == 0 || runtime_settings_->simulation_timeout() == 0)) {
                     if (VERB_RUN >= 3) Printer::ext_info("Simulating case.", "Runner", "Serial Runner");
-                    simulator_->Evaluate();
+                    if (monitored) simulation_success = simulator_->Evaluate(0, runtime_settings_->threads_per_sim()); // Monitored, no timeout
+                    else simulator_->Evaluate();
                 }
                 else {
                     if (is_ensemble_run_) {
@@ -89,20 +93,24 @@ void SerialRunner::Execute()
                     }
                 }
                 if (VERB_RUN >= 3) Printer::ext_info("Done simulating case.", "Runner", "Serial Runner");
-                auto end = QDateTime::currentDateTime();
-                int sim_time = time_span_seconds(start, end);
-                if (simulation_success) {
+                int sim_time = (int)std::round(simulator_->last_run().wall_time);
+                if (simulator_->WasTerminatedEarly()) {
+                    setTerminatedCaseState(new_case, simulator_->monitor());
+                }
+                else if (simulation_success) {
                     model_->wellCost(settings_->optimizer());
                     new_case->set_objective_function_value(objective_function_->value());
                     new_case->state.eval = Optimization::Case::CaseState::EvalStatus::E_DONE;
                     new_case->SetSimTime(sim_time);
                     simulation_times_.push_back((sim_time));
+                    if (!is_ensemble_run_ && evaluation_cache_ != 0)
+                        evaluation_cache_->Add(new_case);
                 }
                 else {
                     new_case->set_objective_function_value(sentinelValue());
                     new_case->state.eval = Optimization::Case::CaseState::EvalStatus::E_FAILED;
                     new_case->state.err_msg = Optimization::Case::CaseState::ErrorMessage::ERR_SIM;
-                    if (sim_time >= timeoutValue())
+                    if (simulator_->last_run().timed_out)
                         new_case->state.eval = Optimization::Case::CaseState::EvalStatus::E_TIMEOUT;
                 }
             } catch (std::runtime_error e) {
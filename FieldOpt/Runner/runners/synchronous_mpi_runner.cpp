@@ -17,6 +17,7 @@
    along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
 ******************************************************************************/
 #include "synchronous_mpi_runner.h"
+#include <cmath>
 
 namespace Runner {
 namespace MPI {
@@ -30,6 +31,7 @@ SynchronousMPIRunner::SynchronousMPIRunner(RuntimeSettings *rts) : MPIRunner(rts
         InitializeLogger();
         InitializeModel();
         InitializeSimulator();
+        InitializeEvaluationCache();
         EvaluateBaseModel();
         InitializeObjectiveFunction();
         InitializeBaseCase();
@@ -44,6 +46,7 @@ SynchronousMPIRunner::SynchronousMPIRunner(RuntimeSettings *rts) : MPIRunner(rts
         InitializeModel();
         InitializeSimulator();
         InitializeObjectiveFunction();
+        createSimulationMonitor(settings_, simulator_, model_); // Workers don't know the best case; only convergence failures are checked
         worker_ = new MPI::Worker(this);
         FinalizeInitialization(false);
     }
@@ -84,7 +87,7 @@ void SynchronousMPIRunner::Execute() {
 
     auto wait_for_evaluated_case = [&]() mutable {
       printMessage("Waiting to receive evaluated case...", 2);
-      auto evaluated_case = overseer_->RecvEvaluatedCase(); // TODO: This is a duplicate case that wont get deleted, i.e. a MEMORY LEAK.
+      auto evaluated_case = overseer_->RecvEvaluatedCase(); // A copy of the case held by the optimizer
       printMessage("Evaluated case received.", 2);
       if (overseer_->last_case_tag == MPIRunner::MsgTag::CASE_EVAL_SUCCESS) {
           printMessage("Setting state for evaluated case.", 2);
@@ -94,6 +97,9 @@ void SynchronousMPIRunner::Execute() {
               printMessage("Setting timings for evaluated case.", 2);
               simulation_times_.push_back(optimizer_->GetSimulationDuration(evaluated_case));
           }
+          if (!is_ensemble_run_ && evaluation_cache_ != 0) {
+              evaluation_cache_->Add(evaluated_case);
+          }
       }
       if (is_ensemble_run_) {
           printMessage("Submitting evaluated realization to ensemble helper.", 2);
@@ -109,6 +115,7 @@ void SynchronousMPIRunner::Execute() {
       }
       else {
           optimizer_->SubmitEvaluatedCase(evaluated_case);
+          delete evaluated_case; // The values have been copied to the optimizer's case
           printMessage("Submitted evaluated case to optimizer.", 2);
       }
     };
@@ -168,98 +175,106 @@ void SynchronousMPIRunner::Execute() {
     }
 
     else { // Worker
-        printMessage("Waiting to receive initial unevaluated case...", 2);
-        worker_->RecvUnevaluatedCase();
-        printMessage("Reveived initial unevaluated case.", 2);
-        while (worker_->GetCurrentCase() != nullptr) {
-            MPIRunner::MsgTag tag = MPIRunner::MsgTag::CASE_EVAL_SUCCESS; // Tag to be sent along with the case.
-            try {
-                model_update_done_ = false;
-                simulation_done_ = false;
-                logger_->AddEntry(this);
-                bool simulation_success = true;
-                if (is_ensemble_run_) {
-                    printMessage("Updating grid path.", 2);
-                    model_->set_grid_path(ensemble_helper_.GetRealization(worker_->GetCurrentCase()->GetEnsembleRealization().toStdString()).grid());
-                }
-                printMessage("Applying case to model.", 2);
-                model_->ApplyCase(worker_->GetCurrentCase());
-                model_update_done_ = true; logger_->AddEntry(this);
-                auto start = QDateTime::currentDateTime();
-                if (runtime_settings_->simulation_timeout() == 0 && settings_->simulator()->max_minutes() < 0) {
-                    printMessage("Starting model evaluation.", 2);
-                    simulator_->Evaluate();
-                }
-                else if (simulation_times_.size() == 0 && settings_->simulator()->max_minutes() > 0) {
-                    if (!is_ensemble_run_) {
-                        printMessage("Starting model evaluation with timeout.", 2);
-                        simulation_success = simulator_->Evaluate(settings_->simulator()->max_minutes() * 60,
-                                                                  runtime_settings_->threads_per_sim());
-                    }
-                    else {
-                        printMessage("Starting ensemble model evaluation with timeout.", 2);
-                        simulation_success = simulator_->Evaluate(ensemble_helper_.GetRealization(worker_->GetCurrentCase()->GetEnsembleRealization().toStdString()),
-                                                                  settings_->simulator()->max_minutes() * 60,
-                                                                  runtime_settings_->threads_per_sim());
-                    }
+        executeWorker();
+    }
+}
+
+void SynchronousMPIRunner::executeWorker() {
+    printMessage("Waiting to receive initial unevaluated case...", 2);
+    worker_->RecvUnevaluatedCase();
+    printMessage("Reveived initial unevaluated case.", 2);
+    while (worker_->GetCurrentCase() != nullptr) {
+        MPIRunner::MsgTag tag = MPIRunner::MsgTag::CASE_EVAL_SUCCESS; // Tag to be sent along with the case.
+        try {
+            model_update_done_ = false;
+            simulation_done_ = false;
+            logger_->AddEntry(this);
+            bool simulation_success = true;
+            if (is_ensemble_run_) {
+                printMessage("Updating grid path.", 2);
+                model_->set_grid_path(ensemble_helper_.GetRealization(worker_->GetCurrentCase()->GetEnsembleRealization().toStdString()).grid());
+            }
+            printMessage("Applying case to model.", 2);
+            model_->ApplyCase(worker_->GetCurrentCase());
+            model_update_done_ = true; logger_->AddEntry(this);
+            if (runtime_settings_->simulation_timeout() == 0 && settings_->simulator()->max_minutes() < 0) {
+                printMessage("Starting model evaluation.", 2);
+                if (simulator_->monitor() != nullptr) simulation_success = simulator_->Evaluate(0, runtime_settings_->threads_per_sim()); // Monitored, no timeout
+                else simulator_->Evaluate();
+            }
+            else if (simulation_times_.size() == 0 && settings_->simulator()->max_minutes() > 0) {
+                if (!is_ensemble_run_) {
+                    printMessage("Starting model evaluation with timeout.", 2);
+                    simulation_success = simulator_->Evaluate(settings_->simulator()->max_minutes() * 60,
+                                                              runtime_settings_->threads_per_sim());
                 }
                 else {
-                    if (!is_ensemble_run_) {
-                        printMessage("Starting model evaluation with timeout.", 2);
-                        simulation_success = simulator_->Evaluate(timeoutValue(), runtime_settings_->threads_per_sim());
-                    }
-                    else {
-                        printMessage("Starting ensemble model evaluation with timeout.", 2);
-                        simulation_success = simulator_->Evaluate(ensemble_helper_.GetRealization(worker_->GetCurrentCase()->GetEnsembleRealization().toStdString()),
-                                                                  settings_->simulator()->max_minutes() * 60,
-                                                                  runtime_settings_->threads_per_sim());
-                    }
+                    printMessage("Starting ensemble model evaluation with timeout.", 2);
+                    simulation_success = simulator_->Evaluate(ensemble_helper_.GetRealization(worker_->GetCurrentCase()->GetEnsembleRealization().toStdString()),
+                                                              settings_->simulator()->max_minutes() * 60,
+                                                              runtime_settings_->threads_per_sim());
                 }
-                simulation_done_ = true; logger_->AddEntry(this);
-                auto end = QDateTime::currentDateTime();
-                int sim_time = time_span_seconds(start, end);
-                if (simulation_success) {
-                    tag = MPIRunner::MsgTag::CASE_EVAL_SUCCESS;
-                    printMessage("Setting objective function value.", 2);
-                    model_->wellCost(settings_->optimizer());
-                    worker_->GetCurrentCase()->set_objective_function_value(objective_function_->value());
-                    worker_->GetCurrentCase()->SetSimTime(sim_time);
-                    worker_->GetCurrentCase()->state.eval = Optimization::Case::CaseState::EvalStatus::E_DONE;
-                    simulation_times_.push_back(sim_time);
+            }
+            else {
+                if (!is_ensemble_run_) {
+                    printMessage("Starting model evaluation with timeout.", 2);
+                    simulation_success = simulator_->Evaluate(timeoutValue(), runtime_settings_->threads_per_sim());
                 }
                 else {
-                    tag = MPIRunner::MsgTag::CASE_EVAL_TIMEOUT;
-                    printMessage("Timed out. Setting objective function value to SENTINEL VALUE.", 2);
-                    worker_->GetCurrentCase()->state.eval = Optimization::Case::CaseState::EvalStatus::E_TIMEOUT;
-                    worker_->GetCurrentCase()->state.err_msg = Optimization::Case::CaseState::ErrorMessage::ERR_SIM;
-                    worker_->GetCurrentCase()->set_objective_function_value(sentinelValue());
+                    printMessage("Starting ensemble model evaluation with timeout.", 2);
+                    simulation_success = simulator_->Evaluate(ensemble_helper_.GetRealization(worker_->GetCurrentCase()->GetEnsembleRealization().toStdString()),
+                                                              settings_->simulator()->max_minutes() * 60,
+                                                              runtime_settings_->threads_per_sim());
                 }
-            } catch (std::runtime_error e) {
-                std::cout << e.what() << std::endl;
-                tag = MPIRunner::MsgTag::CASE_EVAL_INVALID;
-                worker_->GetCurrentCase()->state.eval = Optimization::Case::CaseState::EvalStatus::E_FAILED;
-                worker_->GetCurrentCase()->state.err_msg = Optimization::Case::CaseState::ErrorMessage::ERR_WIC;
-                printMessage("Invalid case. Setting objective function value to SENTINEL VALUE.", 2);
-                worker_->GetCurrentCase()->set_objective_function_value(sentinelValue());
             }
-            printMessage("Sending back evaluated case.", 2);
-            worker_->SendEvaluatedCase(tag);
-            printMessage("Waiting to reveive an unevaluated case...", 2);
-            worker_->RecvUnevaluatedCase();
-            if (worker_->GetCurrentTag() == TERMINATE) {
-                printMessage("Received termination message. Breaking.", 2);
-                break;
+            simulation_done_ = true; logger_->AddEntry(this);
+            int sim_time = (int)std::round(simulator_->last_run().wall_time);
+            if (simulator_->WasTerminatedEarly()) {
+                tag = MPIRunner::MsgTag::CASE_EVAL_TIMEOUT;
+                printMessage("Terminated early by the simulation monitor.", 2);
+                setTerminatedCaseState(worker_->GetCurrentCase(), simulator_->monitor());
+            }
+            else if (simulation_success) {
+                tag = MPIRunner::MsgTag::CASE_EVAL_SUCCESS;
+                printMessage("Setting objective function value.", 2);
+                model_->wellCost(settings_->optimizer());
+                worker_->GetCurrentCase()->set_objective_function_value(objective_function_->value());
+                worker_->GetCurrentCase()->SetSimTime(sim_time);
+                worker_->GetCurrentCase()->state.eval = Optimization::Case::CaseState::EvalStatus::E_DONE;
+                simulation_times_.push_back(sim_time);
             }
             else {
-                printMessage("Received an unevaluated case.", 2);
+                tag = MPIRunner::MsgTag::CASE_EVAL_TIMEOUT;
+                printMessage("Timed out. Setting objective function value to SENTINEL VALUE.", 2);
+                worker_->GetCurrentCase()->state.eval = Optimization::Case::CaseState::EvalStatus::E_TIMEOUT;
+                worker_->GetCurrentCase()->state.err_msg = Optimization::Case::CaseState::ErrorMessage::ERR_SIM;
+                worker_->GetCurrentCase()->set_objective_function_value(sentinelValue());
             }
+        } catch (std::runtime_error e) {
+            std::cout << e.what() << std::endl;
+            tag = MPIRunner::MsgTag::CASE_EVAL_INVALID;
+            worker_->GetCurrentCase()->state.eval = Optimization::Case::CaseState::EvalStatus::E_FAILED;
+            worker_->GetCurrentCase()->state.err_msg = Optimization::Case::CaseState::ErrorMessage::ERR_WIC;
+            printMessage("Invalid case. Setting objective function value to SENTINEL VALUE.", 2);
+            worker_->GetCurrentCase()->set_objective_function_value(sentinelValue());
+        }
+        printMessage("Sending back evaluated case.", 2);
+        worker_->SendEvaluatedCase(tag);
+        printMessage("Waiting to reveive an unevaluated case...", 2);
+        worker_->RecvUnevaluatedCase();
+        if (worker_->GetCurrentTag() == TERMINATE) {
+            printMessage("Received termination message. Breaking.", 2);
+            break;
+        }
+        else {
+            printMessage("Received an unevaluated case.", 2);
         }
-        FinalizeRun(false);
-        printMessage("Finalized on worker.", 2);
-        worker_->ConfirmFinalization();
-        env_.~environment();
-        return;
     }
+    FinalizeRun(false);
+    printMessage("Finalized on worker.", 2);
+    worker_->ConfirmFinalization();
+    env_.~environment();
+    return;
 }
 
 void SynchronousMPIRunner::initialDistribution() {
@@ -44,13 +44,21 @@ class SynchronousMPIRunner : public MPIRunner, public Loggable {
 
   virtual void Execute();
 
- private:
+ protected:
   MPI::Overseer *overseer_;
   MPI::Worker *worker_;
 
   bool model_update_done_;
   bool simulation_done_;
 
+  /*!
+   * @brief Receive, evaluate and send back cases until the overseer sends the termination signal.
+   * This is what Execute does on all processes except the root.
+   */
+  void executeWorker();
+
+ private:
+
   /*!
    * @brief Distribute cases to be evaluated to all but one worker.
    */
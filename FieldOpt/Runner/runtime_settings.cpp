@@ -52,10 +52,26 @@ RuntimeSettings::RuntimeSettings(int argc, const char *argv[])
         max_parallel_sims_ = vm["max-parallel-simulations"].as<int>();
     } else max_parallel_sims_ = 0;
 
+    if (vm.count("prefetch-depth")) {
+        prefetch_depth_ = vm["prefetch-depth"].as<int>();
+        if (prefetch_depth_ < 1)
+            throw std::runtime_error("The prefetch depth must be at least 1.");
+    } else prefetch_depth_ = 2;
+
     if (vm.count("threads-per-simulation")) {
         threads_per_sim_ = vm["threads-per-simulation"].as<int>();
     } else threads_per_sim_ = 1;
 
+    if (vm.count("wic-threads")) {
+        wic_threads_ = vm["wic-threads"].as<int>();
+        if (wic_threads_ < 1)
+            throw std::runtime_error("The number of WIC threads must be at least 1.");
+    } else wic_threads_ = 1;
+
+    if (vm.count("eval-cache")) {
+        evaluation_cache_path_ = GetAbsoluteFilePath(vm["eval-cache"].as<std::string>());
+    } else evaluation_cache_path_ = "";
+
     if (vm.count("simulation-timeout")) {
         simulation_timeout_ = vm["simulation-timeout"].as<int>();
     } else simulation_timeout_ = 0;
@@ -68,6 +84,10 @@ RuntimeSettings::RuntimeSettings(int argc, const char *argv[])
             runner_type_ = RunnerType::ONEOFF;
         else if (QString::compare(runner_str, "mpisync") == 0)
             runner_type_ = RunnerType::MPISYNC;
+        else if (QString::compare(runner_str, "parallel") == 0)
+            runner_type_ = RunnerType::PARALLEL;
+        else if (QString::compare(runner_str, "mpiasync") == 0)
+            runner_type_ = RunnerType::MPIASYNC;
     } else runner_type_ = RunnerType::SERIAL;
 
     if (vm.count("sim-drv-path")) {
@@ -129,8 +149,11 @@ RuntimeSettings::RuntimeSettings(int argc, const char *argv[])
         std::cout << "Runner type:      " << runnerTypeString().toStdString() << std::endl;
         std::cout << "Overwr. old out files: " << overwrite_existing_ << std::endl;
         std::cout << "Max parallel sims:   " << (max_parallel_sims_ > 0 ? boost::lexical_cast<std::string>(max_parallel_sims_) : "default") << std::endl;
+        std::cout << "Prefetch depth:      " << boost::lexical_cast<std::string>(prefetch_depth_) << std::endl;
         std::cout << "Simulation delay:    " << simulation_delay_ << " seconds" << std::endl;
         std::cout << "Threads pr sim:      " << boost::lexical_cast<std::string>(threads_per_sim_) << std::endl;
+        std::cout << "WIC threads:         " << boost::lexical_cast<std::string>(wic_threads_) << std::endl;
+        std::cout << "Evaluation cache:    " << (evaluation_cache_path_.empty() ? "none" : evaluation_cache_path_) << std::endl;
         str_out = "Current/specified paths:";
         std::cout << "\n" << str_out << "\n" << std::string(str_out.length(),'-') << std::endl;
         std::cout << "Current dir:-------" << GetCurrentDirectoryPath().toStdString() << std::endl;
@@ -164,12 +187,18 @@ QString RuntimeSettings::runnerTypeString() const {
         return "oneoff";
     else if (runner_type_ == RunnerType::MPISYNC)
         return "mpisync";
+    else if (runner_type_ == RunnerType::PARALLEL)
+        return "parallel";
+    else if (runner_type_ == RunnerType::MPIASYNC)
+        return "mpiasync";
     else return "NOT SET";
 }
 
 po::variables_map RuntimeSettings::createVariablesMap(int argc, const char **argv) {
     int max_par_sims;
     int thr_per_sim;
+    int prefetch_depth;
+    int wic_threads;
     int simulation_timeout;
     int verbosity_level;
     po::options_description desc("FieldOpt options");
@@ -182,11 +211,17 @@ po::variables_map RuntimeSettings::createVariablesMap(int argc, const char **arg
         ("force,f", po::value<int>()->implicit_value(0),
          "overwrite existing output files")
         ("max-parallel-simulations,m", po::value<int>(&max_par_sims)->default_value(0),
-         "start max <arg> parallel simulations")
+         "start max <arg> parallel simulations (parallel runner default: cores/threads-per-simulation)")
+        ("prefetch-depth", po::value<int>(&prefetch_depth)->default_value(2),
+         "max number of cases queued on each worker by the mpiasync runner")
         ("threads-per-simulation,n", po::value<int>(&thr_per_sim)->default_value(1),
          "number of threads allocated to each simulation")
+        ("wic-threads", po::value<int>(&wic_threads)->default_value(1),
+         "number of threads used to compute well indices for the wells in a case")
+        ("eval-cache", po::value<std::string>(),
+         "path to persistent evaluation cache file (created if it does not exist)")
         ("runner-type,r", po::value<std::string>(),
-         "type of runner (serial/oneoff/mpisync)")
+         "type of runner (serial/oneoff/mpisync/mpiasync/parallel)")
         ("grid-path,g", po::value<std::string>(),
          "path to model grid file (e.g. *.GRID)")
         ("sim-exec-path,e", po::value<std::string>(),
@@ -242,6 +277,9 @@ map<string, string> RuntimeSettings::GetState() {
     statemap["verbosity"] = boost::lexical_cast<string>(verbosity_level_);
     statemap["Max. parallel sims"] = boost::lexical_cast<string>(max_parallel_sims_);
     statemap["Threads pr. sim"] = boost::lexical_cast<string>(threads_per_sim_);
+    statemap["Prefetch depth"] = boost::lexical_cast<string>(prefetch_depth_);
+    statemap["WIC threads"] = boost::lexical_cast<string>(wic_threads_);
+    statemap["Evaluation cache"] = evaluation_cache_path_.empty() ? "None" : evaluation_cache_path_;
     statemap["Simulator timeout"] = boost::lexical_cast<string>(simulation_timeout_);
 
     statemap["Overwrite existing files"] = overwrite_existing_ ? "Yes" : "No";
@@ -250,6 +288,8 @@ map<string, string> RuntimeSettings::GetState() {
         case SERIAL: statemap["runner"] = "Serial"; break;
         case ONEOFF: statemap["runner"] = "One-off"; break;
         case MPISYNC: statemap["runner"] = "MPI Parallel"; break;
+        case PARALLEL: statemap["runner"] = "Local Parallel"; break;
+        case MPIASYNC: statemap["runner"] = "MPI Parallel (asynchronous)"; break;
     }
 
     statemap["path FieldOpt driver"] = paths_.GetPath(Paths::DRIVER_FILE);
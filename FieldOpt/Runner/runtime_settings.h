@@ -47,13 +47,16 @@ class RuntimeSettings : public Loggable
   /*!
    * \brief The RunnerType enum lists the names of available runners.
    */
-  enum RunnerType { SERIAL, ONEOFF, MPISYNC };
+  enum RunnerType { SERIAL, ONEOFF, MPISYNC, PARALLEL, MPIASYNC };
 
   Paths &paths() { return paths_; }
   int verbosity_level() const { return verbosity_level_; }
   bool overwrite_existing() const { return overwrite_existing_; }
   int max_parallel_sims() const { return max_parallel_sims_; }
+  int prefetch_depth() const { return prefetch_depth_; }
   int threads_per_sim() const { return threads_per_sim_; }
+  int wic_threads() const { return wic_threads_; }
+  std::string evaluation_cache_path() const { return evaluation_cache_path_; }
   int simulation_timeout() const { return simulation_timeout_; }
   int simulation_delay() const { return simulation_delay_; }
   RunnerType runner_type() const { return runner_type_; }
@@ -71,7 +74,10 @@ class RuntimeSettings : public Loggable
   bool overwrite_existing_; //!< Whether or not files in the specified output directory should be overwritten (only relevant if the directory is not empty).
   int simulation_delay_; //!< Minimum delay between start of each simulation (in seconds).
   int max_parallel_sims_; //!< Maximum number of parallel simulations to start. This is important to define if you for example have a limited number of simulator licenses.
+  int prefetch_depth_; //!< Maximum number of cases queued on each worker by the asynchronous MPI runner.
   int threads_per_sim_; //!< Number of threads to be used pr. simulation. Only works for ADGPRS.
+  int wic_threads_; //!< Number of threads to be used when computing well indices for the spline wells in a case.
+  std::string evaluation_cache_path_; //!< Path to the persistent evaluation cache file. Empty if no cache should be used.
   int simulation_timeout_; //!< Simulations will be terminated after running for simulation_timeout_ times the lowest recorded simulation time up to that point.
   RunnerType runner_type_; //!< The type of runner to be used (e.g. serial or parallel).
   QPair<QVector<double>, QVector<double>> prod_coords_; //!< The spline coordinates for the production well
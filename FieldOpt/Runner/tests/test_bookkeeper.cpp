@@ -68,4 +68,49 @@ TEST_F(BookkeeperTest, Bookkeeping) {
     EXPECT_TRUE(bookkeeper_->IsEvaluated(c1));
 }
 
+TEST_F(BookkeeperTest, ToleranceLookup) {
+    QList<QUuid> ids = {QUuid::createUuid(), QUuid::createUuid(), QUuid::createUuid()};
+    auto make_case = [&ids](double x, double y, int k) {
+        QHash<QUuid, double> real_variables;
+        real_variables[ids[0]] = x;
+        real_variables[ids[1]] = y;
+        QHash<QUuid, int> integer_variables;
+        integer_variables[ids[2]] = k;
+        return new Optimization::Case(QHash<QUuid, bool>(), integer_variables, real_variables);
+    };
+
+    auto case_handler = new Optimization::CaseHandler();
+    auto bookkeeper = Runner::Bookkeeper(0.01, case_handler);
+    for (int i = 0; i < 1000; ++i) {
+        auto c = make_case(0.1 * (i % 50), 0.25 * (i / 50), i % 3);
+        c->set_objective_function_value(i);
+        case_handler->AddNewCase(c);
+        case_handler->GetNextCaseForEvaluation();
+        case_handler->SetCaseEvaluated(c->id());
+    }
+
+    // Exact and within-tolerance matches give the first equal case
+    auto exact = make_case(0.1 * 7, 0.25 * 3, (3 * 50 + 7) % 3);
+    EXPECT_TRUE(bookkeeper.IsEvaluated(exact, true));
+    EXPECT_DOUBLE_EQ(3 * 50 + 7, exact->objective_function_value());
+
+    auto close = make_case(0.1 * 7 + 0.009, 0.25 * 3 - 0.009, (3 * 50 + 7) % 3);
+    EXPECT_TRUE(bookkeeper.IsEvaluated(close, true));
+    EXPECT_DOUBLE_EQ(3 * 50 + 7, close->objective_function_value());
+
+    // Outside the tolerance in one variable, or different integer value
+    EXPECT_FALSE(bookkeeper.IsEvaluated(make_case(0.1 * 7 + 0.02, 0.25 * 3, (3 * 50 + 7) % 3)));
+    EXPECT_FALSE(bookkeeper.IsEvaluated(make_case(0.1 * 7, 0.25 * 3, (3 * 50 + 8) % 3)));
+
+    // Cases evaluated after the first lookup are found as well
+    auto late = make_case(123.0, 456.0, 1);
+    late->set_objective_function_value(-1.0);
+    case_handler->AddNewCase(late);
+    case_handler->GetNextCaseForEvaluation();
+    case_handler->SetCaseEvaluated(late->id());
+    auto late_copy = make_case(123.0, 456.0, 1);
+    EXPECT_TRUE(bookkeeper.IsEvaluated(late_copy, true));
+    EXPECT_DOUBLE_EQ(-1.0, late_copy->objective_function_value());
+}
+
 }
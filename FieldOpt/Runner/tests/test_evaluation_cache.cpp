@@ -0,0 +1,168 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include "Optimization/tests/test_resource_optimizer.h"
+#include "../Runner/evaluation_cache.h"
+#include "Settings/paths.h"
+
+namespace {
+
+class EvaluationCacheTest : public ::testing::Test,
+                            public TestResources::TestResourceOptimizer
+{
+ protected:
+  EvaluationCacheTest() {
+      cache_path_ = QDir::tempPath() + "/fieldopt_test_evaluation_cache.bin";
+      QFile::remove(cache_path_);
+  }
+  virtual ~EvaluationCacheTest() { QFile::remove(cache_path_); }
+
+  Optimization::Case *perturbedCase(double delta) {
+      auto c = new Optimization::Case(base_case_);
+      auto id = c->real_variables().keys().first();
+      c->set_real_variable_value(id, c->real_variables()[id] + delta);
+      return c;
+  }
+
+  QString cache_path_;
+};
+
+TEST_F(EvaluationCacheTest, PersistsAcrossInstances) {
+    auto c = perturbedCase(1.0);
+    c->set_objective_function_value(42.0);
+    c->SetSimTime(120);
+    c->SetWICTime(3);
+    {
+        Runner::EvaluationCache cache(cache_path_, "context", model_->variables());
+        EXPECT_EQ(0, cache.size());
+        EXPECT_FALSE(cache.Contains(c));
+        cache.Add(c);
+        cache.Add(c); // Duplicates are not written
+        EXPECT_EQ(1, cache.size());
+    }
+
+    Runner::EvaluationCache reopened(cache_path_, "context", model_->variables());
+    EXPECT_EQ(1, reopened.size());
+    auto copy = perturbedCase(1.0);
+    EXPECT_TRUE(reopened.Restore(copy));
+    EXPECT_DOUBLE_EQ(42.0, copy->objective_function_value());
+    EXPECT_EQ(120, copy->GetSimTime());
+    EXPECT_EQ(3, copy->GetWICTime());
+    EXPECT_FALSE(reopened.Contains(perturbedCase(1.0 + 1e-12)));
+
+    // Records from other model contexts are ignored
+    Runner::EvaluationCache other(cache_path_, "other context", model_->variables());
+    EXPECT_EQ(0, other.size());
+    EXPECT_FALSE(other.Contains(copy));
+}
+
+TEST_F(EvaluationCacheTest, DiscardsIncompleteRecord) {
+    qint64 complete_size;
+    {
+        Runner::EvaluationCache cache(cache_path_, "context", model_->variables());
+        for (int i = 0; i < 3; ++i) {
+            auto c = perturbedCase(i);
+            c->set_objective_function_value(i);
+            cache.Add(c);
+        }
+        complete_size = QFileInfo(cache_path_).size();
+    }
+
+    // Simulate a run killed while writing a record
+    QFile file(cache_path_);
+    ASSERT_TRUE(file.open(QIODevice::Append));
+    file.write(QByteArray(7, '\x01'));
+    file.close();
+
+    Runner::EvaluationCache cache(cache_path_, "context", model_->variables());
+    EXPECT_EQ(3, cache.size());
+    EXPECT_EQ(complete_size, QFileInfo(cache_path_).size());
+
+    auto c = perturbedCase(3);
+    c->set_objective_function_value(3);
+    cache.Add(c);
+    Runner::EvaluationCache reopened(cache_path_, "context", model_->variables());
+    EXPECT_EQ(4, reopened.size());
+}
+
+TEST_F(EvaluationCacheTest, RejectsOtherFiles) {
+    QFile file(cache_path_);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("not a cache file");
+    file.close();
+    EXPECT_THROW(Runner::EvaluationCache(cache_path_, "context", model_->variables()), std::runtime_error);
+}
+
+TEST_F(EvaluationCacheTest, SharedFile) {
+    // Two runs appending to the same file
+    Runner::EvaluationCache first(cache_path_, "context", model_->variables());
+    Runner::EvaluationCache second(cache_path_, "context", model_->variables());
+    for (int i = 0; i < 3; ++i) {
+        auto c1 = perturbedCase(i);
+        c1->set_objective_function_value(i);
+        first.Add(c1);
+        auto c2 = perturbedCase(10 + i);
+        c2->set_objective_function_value(10 + i);
+        second.Add(c2);
+    }
+    EXPECT_FALSE(QFile::exists(cache_path_ + ".lock"));
+
+    Runner::EvaluationCache reopened(cache_path_, "context", model_->variables());
+    EXPECT_EQ(6, reopened.size());
+}
+
+TEST_F(EvaluationCacheTest, ModelContextCoversDriverDirectory) {
+    QString driver_dir = QDir::tempPath() + "/fieldopt_test_evaluation_cache_driver";
+    QDir(driver_dir).removeRecursively();
+    QDir().mkpath(driver_dir + "/include");
+    auto write = [](const QString &path, const QByteArray &contents) {
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write(contents);
+        file.close();
+    };
+    write(driver_dir + "/MODEL.DATA", "INCLUDE\n 'include/PERMX.INC' /\n");
+    write(driver_dir + "/include/PERMX.INC", "PERMX\n 100*100 /\n");
+
+    Paths paths;
+    paths.SetPath(Paths::SIM_DRIVER_FILE, (driver_dir + "/MODEL.DATA").toStdString());
+    paths.SetPath(Paths::SIM_DRIVER_DIR, driver_dir.toStdString());
+    QString cache_in_driver_dir = driver_dir + "/cache.bin";
+    auto context = Runner::EvaluationCache::ModelContext(paths, cache_in_driver_dir);
+    EXPECT_EQ(context, Runner::EvaluationCache::ModelContext(paths, cache_in_driver_dir));
+
+    // The cache file itself is not part of the context
+    {
+        Runner::EvaluationCache cache(cache_in_driver_dir, context, model_->variables());
+        auto c = perturbedCase(1.0);
+        c->set_objective_function_value(1.0);
+        cache.Add(c);
+    }
+    EXPECT_EQ(context, Runner::EvaluationCache::ModelContext(paths, cache_in_driver_dir));
+
+    // Changing an included file changes the context
+    write(driver_dir + "/include/PERMX.INC", "PERMX\n 100*200 /\n");
+    EXPECT_NE(context, Runner::EvaluationCache::ModelContext(paths, cache_in_driver_dir));
+
+    QDir(driver_dir).removeRecursively();
+}
+
+}
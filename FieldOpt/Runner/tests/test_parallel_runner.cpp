@@ -0,0 +1,124 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include "Runner/runners/parallel_runner.h"
+#include "Settings/tests/test_resource_example_file_paths.hpp"
+
+namespace Runner {
+
+/*!
+ * Simulator that does not run anything; the slot's objective is computed from the
+ * model variables alone.
+ */
+class NullSimulator : public Simulation::Simulator {
+ public:
+  NullSimulator(Settings::Settings *settings) : Simulation::Simulator(settings) {}
+  void Evaluate() override { evaluations++; }
+  bool Evaluate(int, int) override { evaluations++; return true; }
+  bool Evaluate(const Settings::Ensemble::Realization &, int, int) override { evaluations++; return true; }
+  void WriteDriverFilesOnly() override {}
+  void CleanUp() override {}
+  int evaluations = 0;
+ private:
+  void UpdateFilePaths() override {}
+};
+
+/*!
+ * Objective equal to the sum of the continous variable values in a model.
+ */
+class VariableSumObjective : public Optimization::Objective::Objective {
+ public:
+  VariableSumObjective(Model::Model *model) : model_(model) {}
+  double value() const override {
+      double sum = 0.0;
+      for (double value : model_->variables()->GetContinousVariableValues().values())
+          sum += value;
+      return sum;
+  }
+ private:
+  Model::Model *model_;
+};
+
+class ParallelRunnerTest : public ::testing::Test {
+ protected:
+  ParallelRunnerTest() {
+      rts_ = new RuntimeSettings(argc_, argv_);
+      runner_ = new ParallelRunner(rts_, true);
+  }
+
+  int numberOfSlots() const { return runner_->numberOfSlots(); }
+  ParallelRunner::Slot *slot() { return runner_->slots_.front(); }
+
+  Optimization::Case *baseCase() {
+      return new Optimization::Case(runner_->model_->variables()->GetBinaryVariableValues(),
+                                    runner_->model_->variables()->GetDiscreteVariableValues(),
+                                    runner_->model_->variables()->GetContinousVariableValues());
+  }
+
+  /*!
+   * Evaluate a case in the first slot, on the slot's thread, and wait for it.
+   */
+  void evaluateInSlot(Optimization::Case *c) {
+      auto s = slot();
+      s->current_case = c;
+      s->timeout = runner_->slotTimeout();
+      s->thread = std::thread(&ParallelRunner::evaluate, runner_, s);
+      runner_->waitForEvaluatedCase(false);
+  }
+
+  RuntimeSettings *rts_;
+  ParallelRunner *runner_;
+
+ private:
+  const int argc_ = 16;
+  const char *argv_[16] = {"FieldOpt",
+                           TestResources::ExampleFilePaths::driver_5spot_.c_str(),
+                           TestResources::ExampleFilePaths::directory_output_.c_str(),
+                           "-g", TestResources::ExampleFilePaths::grid_flow_5spot_.c_str(),
+                           "-s", TestResources::ExampleFilePaths::deck_flow_5spot_.c_str(),
+                           "-b", ".",
+                           "-r", "parallel",
+                           "-f",
+                           "-v", "0",
+                           "-m", "1"
+  };
+};
+
+TEST_F(ParallelRunnerTest, EvaluatesCaseInSlot) {
+    ASSERT_EQ(1, numberOfSlots());
+    auto simulator = new NullSimulator(slot()->settings);
+    slot()->simulator = simulator;
+    slot()->objective = new VariableSumObjective(slot()->model);
+
+    // Case variable ids are the ids of the runner's model; the slot model must accept them
+    auto c = baseCase();
+    auto id = c->real_variables().keys().first();
+    c->set_real_variable_value(id, c->real_variables()[id] + 1.0);
+    double expected = 0.0;
+    for (double value : c->real_variables().values())
+        expected += value;
+
+    evaluateInSlot(c);
+    EXPECT_EQ(1, simulator->evaluations);
+    EXPECT_EQ(Optimization::Case::CaseState::EvalStatus::E_DONE, c->state.eval);
+    EXPECT_EQ(Optimization::Case::CaseState::ErrorMessage::ERR_OK, c->state.err_msg);
+    EXPECT_DOUBLE_EQ(expected, c->objective_function_value());
+    EXPECT_EQ(nullptr, slot()->current_case);
+}
+
+}
@@ -157,6 +157,11 @@ void Model::readReservoir(QJsonObject json_reservoir, Paths &paths)
     if (!paths.IsSet(Paths::GRID_FILE) && json_reservoir.contains("Path")) {
         paths.SetPath(Paths::GRID_FILE, json_reservoir["Path"].toString().toStdString());
     }
+
+    // Keep the entire grid in memory
+    if (json_reservoir.contains("CacheGrid")) {
+        cache_grid_ = json_reservoir["CacheGrid"].toBool();
+    }
 }
 
 Model::Well Model::readSingleWell(QJsonObject json_well)
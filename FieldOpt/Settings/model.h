@@ -166,10 +166,12 @@ class Model
 
   QList<Well> wells() const { return wells_; }                //!< Get the struct containing settings for the well(s) in the model.
   QList<int> control_times() const { return control_times_; } //!< Get the control times for the schedule
+  bool cache_grid() const { return cache_grid_; }             //!< Whether the entire grid should be read into memory on load.
 
  private:
   QList<Well> wells_;
   QList<int> control_times_;
+  bool cache_grid_ = false;
 
   void readReservoir(QJsonObject json_reservoir, Paths &paths);
   Well readSingleWell(QJsonObject json_well);
@@ -312,6 +312,10 @@ Optimizer::Parameters Optimizer::parseParameters(QJsonObject &json_parameters) {
         if (json_parameters.contains("MaxQueueSize"))
             params.max_queue_size = json_parameters["MaxQueueSize"].toDouble();
         else params.max_queue_size = 2;
+        if (json_parameters.contains("SpeculativePolling"))
+            params.speculative_polling = json_parameters["SpeculativePolling"].toBool();
+        if (json_parameters.contains("SpeculativeExpansion"))
+            params.speculative_expansion = json_parameters["SpeculativeExpansion"].toBool();
         if (json_parameters.contains("Pattern"))
             params.pattern = json_parameters["Pattern"].toString();
         else params.pattern = "Compass";
@@ -371,6 +375,32 @@ Optimizer::Parameters Optimizer::parseParameters(QJsonObject &json_parameters) {
             params.pso_velocity_scale = json_parameters["PSO-VelocityScale"].toDouble();
         }else params.pso_velocity_scale = 1.0;
 
+        // Surrogate screening parameters (PSO and GA)
+        if (json_parameters.contains("SurrogateScreening")) {
+            QStringList available_surrogates = { "None", "RBF", "GP" };
+            if (available_surrogates.contains(json_parameters["SurrogateScreening"].toString())) {
+                params.surrogate_screening = json_parameters["SurrogateScreening"].toString().toStdString();
+            }
+            else {
+                Printer::error("SurrogateScreening " + json_parameters["SurrogateScreening"].toString().toStdString() + " not recognized.");
+                Printer::info("Available surrogates: " + available_surrogates.join(", ").toStdString());
+                throw std::runtime_error("Failed reading surrogate screening settings.");
+            }
+        }
+        if (json_parameters.contains("SurrogateScreeningFraction")) {
+            params.surrogate_screening_fraction = json_parameters["SurrogateScreeningFraction"].toDouble();
+            if (params.surrogate_screening_fraction <= 0.0 || params.surrogate_screening_fraction > 1.0)
+                throw std::runtime_error("SurrogateScreeningFraction must be in (0, 1].");
+        }
+        if (json_parameters.contains("SurrogateScreeningWindow")) {
+            params.surrogate_screening_window = json_parameters["SurrogateScreeningWindow"].toInt();
+            if (params.surrogate_screening_window < 2)
+                throw std::runtime_error("SurrogateScreeningWindow must be at least 2.");
+        }
+        if (json_parameters.contains("SurrogateScreeningMinSamples")) {
+            params.surrogate_screening_min_samples = json_parameters["SurrogateScreeningMinSamples"].toInt();
+        }
+
         // EGO Parameters
         if (json_parameters.contains("EGO-InitGuesses")) {
             params.ego_init_guesses = json_parameters["EGO-InitGuesses"].toInt();
@@ -408,11 +438,34 @@ Optimizer::Parameters Optimizer::parseParameters(QJsonObject &json_parameters) {
                 throw std::runtime_error("Failed reading EGO settings.");
             }
         }
+        if (json_parameters.contains("EGO-BatchSize")) {
+            params.ego_batch_size = json_parameters["EGO-BatchSize"].toInt();
+            if (params.ego_batch_size < 1) {
+                Printer::error("EGO-BatchSize must be at least 1.");
+                throw std::runtime_error("Failed reading EGO settings.");
+            }
+        }
+        if (json_parameters.contains("EGO-Async")) {
+            params.ego_async = json_parameters["EGO-Async"].toBool();
+        }
+        if (json_parameters.contains("EGO-RefitInterval")) {
+            params.ego_refit_interval = json_parameters["EGO-RefitInterval"].toInt();
+            if (params.ego_refit_interval < 1) {
+                Printer::error("EGO-RefitInterval must be at least 1.");
+                throw std::runtime_error("Failed reading EGO settings.");
+            }
+        }
+        if (json_parameters.contains("EGO-RefitDrift")) {
+            params.ego_refit_drift = json_parameters["EGO-RefitDrift"].toDouble();
+        }
 
         // CMA-ES Parameters
         if (json_parameters.contains("ImproveBaseCase")) {
             params.improve_base_case = json_parameters["ImproveBaseCase"].toBool();
         }
+        if (json_parameters.contains("CMA-ES-EigenInterval")) {
+            params.cma_es_eigen_interval = json_parameters["CMA-ES-EigenInterval"].toInt();
+        }
 
         // VFSA Parameters
         if (json_parameters.contains("VFSA-EvalsPrIteration")) {
@@ -453,6 +506,19 @@ Optimizer::Parameters Optimizer::parseParameters(QJsonObject &json_parameters) {
         if (json_parameters.contains("SPSA-InitStepMagnitude")) {
             params.spsa_init_step_magnitude = json_parameters["SPSA-InitStepMagnitude"].toDouble();
         }
+        if (json_parameters.contains("SPSA-GradientPairs")) {
+            params.spsa_gradient_pairs = json_parameters["SPSA-GradientPairs"].toInt();
+            if (params.spsa_gradient_pairs < 1)
+                throw std::runtime_error("SPSA-GradientPairs must be at least 1.");
+        }
+        if (json_parameters.contains("SPSA-MaxGradientPairs")) {
+            params.spsa_max_gradient_pairs = json_parameters["SPSA-MaxGradientPairs"].toInt();
+            if (params.spsa_max_gradient_pairs < params.spsa_gradient_pairs)
+                throw std::runtime_error("SPSA-MaxGradientPairs must be at least SPSA-GradientPairs.");
+        }
+        if (json_parameters.contains("SPSA-CommonRandomNumbers")) {
+            params.spsa_common_random_numbers = json_parameters["SPSA-CommonRandomNumbers"].toBool();
+        }
 
 
         // Hybrid parameters
@@ -66,6 +66,8 @@ class Optimizer
     double contraction_factor;  //!< The contraction factor for GSS algorithms.
     double expansion_factor;    //!< The expansion factor for GSS algorithms.
     int max_queue_size;      //!< Maximum size of evaluation queue.
+    bool speculative_polling = false;   //!< Queue the points of the next poll along with each poll (Compass search).
+    bool speculative_expansion = false; //!< Also queue speculative points at expanded step lengths.
     bool auto_step_lengths = false;     //!< Automatically determine appropriate step lengths from bound constraints.
     double auto_step_init_scale = 0.25; //!< Scaling factor for auto-determined initial step lengths (e.g. 0.25*(upper-lower)
     double auto_step_conv_scale = 0.01; //!< Scaling factor for auto-determined convergence step lengths (e.g. 0.01*(upper-lower)
@@ -92,11 +94,21 @@ class Optimizer
     double pso_swarm_size; //!< The number of particles in the swarm. Default: 50
     double pso_velocity_scale; //!< Scaling factor for particle velocities. Default: 1.0
 
+    // Surrogate screening parameters (PSO and GA)
+    std::string surrogate_screening = "None";  //!< Surrogate used to pre-screen new candidates before simulating them (None, RBF or GP). Default: None.
+    double surrogate_screening_fraction = 0.5; //!< Fraction of the candidates in each generation that is sent to simulation. Default: 0.5.
+    int surrogate_screening_window = 200;      //!< Number of most recently evaluated cases the surrogate is fitted to. Default: 200.
+    int surrogate_screening_min_samples = -1;  //!< Number of evaluated cases needed before screening starts. Default: 2*(number of variables + 1), at most the window size.
+
     // EGO Parameters
     int ego_init_guesses = -1; //!< Number of initial guesses to be made (default is two times the number of variables).
     std::string ego_init_sampling_method = "Random"; //!< Sampling method to be used for initial guesses (Random or Uniform)
     std::string ego_kernel = "CovMatern5iso";        //!< Which kernel function to use for the gaussian process model.
     std::string ego_af = "ExpectedImprovement";      //!< Which acquisiton function to use.
+    int ego_batch_size = 1; //!< Number of cases to propose pr. iteration; in async mode, the number of cases to keep pending. Default: 1.
+    bool ego_async = false; //!< Propose new cases whenever an evaluated case is submitted, instead of once pr. batch. Default: false.
+    int ego_refit_interval = 1; //!< Optimize the GP hyperparameters at most every N iterations. Default: 1 (every iteration).
+    double ego_refit_drift = 0.1; //!< Optimize the GP hyperparameters early if the log likelihood pr. observation has changed by more than this since the last fit. Default: 0.1.
 
     // VFSA Parameters
     int vfsa_evals_pr_iteration = 1; //!< Number of evaluations to be performed pr. iteration (temperature). Default: 1.
@@ -107,6 +119,7 @@ class Optimizer
 
     // CMA-ES Parameters
     bool improve_base_case = false;
+    int cma_es_eigen_interval = 0; //!< Generations between eigendecompositions of the covariance matrix. Default: 0 (determined from the learning rates, as recommended by Hansen).
 
     // SPSA Parameters
     int spsa_max_iterations = 50; //!< Maximum number of iterations to be performed. Default: 50.
@@ -116,6 +129,9 @@ class Optimizer
     double spsa_A = 5;            //!< Affects step length in early iterations. Default: 10% of max iterations.
     double spsa_a = 0.0;          //!< Affects step lengths. Default and recommended: automatically compute from spsa_init_step_magnitude.
     double spsa_init_step_magnitude = 0.0; //!< Smallest desired step magnitude in early iterations.
+    int spsa_gradient_pairs = 1;       //!< Number of perturbation pairs evaluated pr. iteration; the gradient estimates are averaged. Default: 1.
+    int spsa_max_gradient_pairs = 0;   //!< Adapt the number of pairs to the gradient noise, up to this number. Default: 0 (not adaptive).
+    bool spsa_common_random_numbers = false; //!< Evaluate both cases of a pair on the same subset of ensemble realizations. Default: false.
 
     // Hybrid parameters
     /*!
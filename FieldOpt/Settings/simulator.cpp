@@ -81,6 +81,23 @@ void Simulator::setParams(QJsonObject json_simulator) {
     set_opt_prop_bool(ecl_use_actionx_, json_simulator, "UseACTIONX");
     set_opt_prop_bool(use_post_sim_script_, json_simulator, "UsePostSimScript");
     set_opt_prop_bool(read_external_json_results_, json_simulator, "ReadExternalJsonResults");
+    set_opt_prop_bool(early_termination_, json_simulator, "EarlyTermination");
+    set_opt_prop_double(early_termination_margin_, json_simulator, "EarlyTerminationMargin");
+    set_opt_prop_double(early_termination_min_fraction_, json_simulator, "EarlyTerminationMinFraction");
+    set_opt_prop_int(early_termination_max_conv_failures_, json_simulator, "EarlyTerminationMaxConvergenceFailures");
+    set_opt_prop_int(monitor_interval_, json_simulator, "MonitorInterval");
+    if (early_termination_ && (type_ == ADGPRS || type_ == INTERSECT)) {
+        Printer::ext_warn("Early termination is only supported for ECLIPSE and Flow. Disabling it.", "Settings", "Simulator");
+        early_termination_ = false;
+    }
+    set_opt_prop_bool(link_driver_files_, json_simulator, "LinkDriverFiles");
+    set_opt_prop_bool(restart_cache_, json_simulator, "RestartCache");
+    set_opt_prop_int(restart_cache_size_, json_simulator, "RestartCacheSize");
+    if (restart_cache_ && (type_ != ECLIPSE || ecl_use_actionx_ || is_ensemble_)) {
+        Printer::ext_warn("The restart cache is only supported for single-deck ECLIPSE runs without ACTIONX. Disabling it.",
+                          "Settings", "Simulator");
+        restart_cache_ = false;
+    }
 }
 
 void Simulator::setCommands(QJsonObject json_simulator) {
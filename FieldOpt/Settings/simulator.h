@@ -95,6 +95,55 @@ class Simulator
    */
   bool read_external_json_results() const { return read_external_json_results_; }
 
+  /*!
+   * @brief Check whether running simulations should be monitored, and terminated
+   * early when they cannot beat the best case found so far, or when the simulator
+   * reports convergence failures. Only supported for ECLIPSE and Flow.
+   */
+  bool early_termination() const { return early_termination_; }
+
+  /*!
+   * @brief Relative margin by which the optimistic bound on the objective of a running
+   * simulation must be worse than the best objective before it is terminated.
+   */
+  double early_termination_margin() const { return early_termination_margin_; }
+
+  /*!
+   * @brief Fraction of the simulated time span that must be completed before a
+   * simulation may be terminated because of its objective bound.
+   */
+  double early_termination_min_fraction() const { return early_termination_min_fraction_; }
+
+  /*!
+   * @brief Number of convergence failures reported by the simulator after which the
+   * simulation is terminated. Zero (default) disables this check.
+   */
+  int early_termination_max_conv_failures() const { return early_termination_max_conv_failures_; }
+
+  /*!
+   * @brief Seconds between each check of a running simulation's output.
+   */
+  int monitor_interval() const { return monitor_interval_; }
+
+  /*!
+   * @brief Check whether the files in the driver directory should be linked (reflinked or
+   * hard linked) into simulation work directories instead of copied. Files named after the
+   * driver file are always copied, as the simulator writes its output to such files.
+   */
+  bool link_driver_files() const { return link_driver_files_; }
+
+  /*!
+   * @brief Check whether the restart files of simulated cases should be kept, so that
+   * cases sharing the first control intervals with a previous case can be simulated
+   * from a restart. Only supported for ECLIPSE.
+   */
+  bool restart_cache() const { return restart_cache_; }
+
+  /*!
+   * @brief Maximum number of cases to keep restart files for.
+   */
+  int restart_cache_size() const { return restart_cache_size_; }
+
  private:
   SimulatorType type_;
   SimulatorFluidModel fluid_model_;
@@ -105,6 +154,14 @@ class Simulator
   bool use_post_sim_script_ = false;
   bool read_external_json_results_ = false;
   int max_minutes_ = -1;
+  bool early_termination_ = false;
+  double early_termination_margin_ = 0.1;
+  double early_termination_min_fraction_ = 0.2;
+  int early_termination_max_conv_failures_ = 0;
+  int monitor_interval_ = 10;
+  bool link_driver_files_ = true;
+  bool restart_cache_ = false;
+  int restart_cache_size_ = 10;
   Ensemble ensemble_;
 
 
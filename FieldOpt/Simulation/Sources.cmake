@@ -15,6 +15,7 @@ SET(SIMULATION_HEADERS
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/compsegs.h
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/ecldriverpart.h
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/schedule_section.h
+	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/schedule_cache.h
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/wellcontrols.h
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/welsegs.h
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/welspecs.h
@@ -27,9 +28,11 @@ SET(SIMULATION_HEADERS
 	simulator_interfaces/driver_file_writers/ecldriverfilewriter.h
 	simulator_interfaces/driver_file_writers/flowdriverfilewriter.h
 	simulator_interfaces/driver_file_writers/ix_driver_file_writer.h
+	simulator_interfaces/ecl_restart_cache.h
 	simulator_interfaces/eclsimulator.h
 	simulator_interfaces/flowsimulator.h
 	simulator_interfaces/ix_simulator.h
+	simulator_interfaces/simulation_monitor.h
 	simulator_interfaces/simulator.h
 	simulator_interfaces/simulator_exceptions.h
 )
@@ -46,6 +49,7 @@ SET(SIMULATION_SOURCES
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/compsegs.cpp
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/ecldriverpart.cpp
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/schedule_section.cpp
+	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/schedule_cache.cpp
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/wellcontrols.cpp
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/welsegs.cpp
 	simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/welspecs.cpp
@@ -54,9 +58,11 @@ SET(SIMULATION_SOURCES
 	simulator_interfaces/driver_file_writers/ecldriverfilewriter.cpp
 	simulator_interfaces/driver_file_writers/flowdriverfilewriter.cpp
 	simulator_interfaces/driver_file_writers/ix_driver_file_writer.cpp
+	simulator_interfaces/ecl_restart_cache.cpp
 	simulator_interfaces/eclsimulator.cpp
 	simulator_interfaces/flowsimulator.cpp
 	simulator_interfaces/ix_simulator.cpp
+	simulator_interfaces/simulation_monitor.cpp
 	simulator_interfaces/simulator.cpp
     results/json_results.cpp
 )
@@ -68,11 +74,18 @@ SET(SIMULATION_TESTS
 	tests/simulator_interfaces/driver_file_writers/adgprs_driver_file_writer.cpp
 	tests/simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/test_compdat.cpp
 	tests/simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/test_schedule_section.cpp
+	tests/simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/test_schedule_cache.cpp
 	tests/simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/test_wellcontrols.cpp
 	tests/simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/test_welspecs.cpp
 	tests/simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/test_schedule_inset.cpp
 	tests/simulator_interfaces/driver_file_writers/flow_driver_file_writer.cpp
 	tests/simulator_interfaces/test_adgprssimulator.cpp
+	tests/simulator_interfaces/test_ecl_restart_cache.cpp
 	tests/simulator_interfaces/test_eclsimulator.cpp
 	tests/simulator_interfaces/test_ix_simulator.cpp
+	tests/simulator_interfaces/test_simulation_monitor.cpp
+)
+
+SET(SIMULATION_BENCHMARKS
+	benchmarks/bench_results.cpp
 )
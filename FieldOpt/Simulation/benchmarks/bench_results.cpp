@@ -0,0 +1,128 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+/*!
+ * Micro-benchmark of the result access pattern of a discounted NPV
+ * evaluation: for every component, the difference between the values
+ * at each pair of consecutive report steps.
+ *
+ * Usage: ./bench_simulation [summary_path [well [n_evaluations]]]
+ *
+ * The default summary is the HORZWELL example. Use a summary with a
+ * long history to see the difference. The zero-copy access through the
+ * references returned by ECLResults is compared against copying the
+ * value vector for every lookup, which is what GetValue did before.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include "Simulation/results/eclresults.h"
+#include "Settings/tests/test_resource_example_file_paths.hpp"
+
+using Simulation::Results::Results;
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Component {
+    Results::Property property;
+    bool is_well_property;
+};
+
+/// One discounted NPV-like sweep, copying the value vector for every lookup.
+double copying_sweep(Simulation::Results::ECLResults &results, const std::vector<Component> &components,
+                     const QString &well, int n_steps) {
+    double value = 0.0;
+    for (auto &comp : components) {
+        for (int t = 1; t < n_steps; ++t) {
+            std::vector<double> current = comp.is_well_property
+                                          ? results.GetValueVector(comp.property, well)
+                                          : results.GetValueVector(comp.property);
+            std::vector<double> previous = comp.is_well_property
+                                           ? results.GetValueVector(comp.property, well)
+                                           : results.GetValueVector(comp.property);
+            value += current[t] - previous[t - 1];
+        }
+    }
+    return value;
+}
+
+/// The same sweep, indexing into the cached vectors.
+double zero_copy_sweep(Simulation::Results::ECLResults &results, const std::vector<Component> &components,
+                       const QString &well, int n_steps) {
+    double value = 0.0;
+    for (auto &comp : components) {
+        const std::vector<double> &values = comp.is_well_property
+                                            ? results.GetValueVector(comp.property, well)
+                                            : results.GetValueVector(comp.property);
+        for (int t = 1; t < n_steps; ++t) {
+            value += values[t] - values[t - 1];
+        }
+    }
+    return value;
+}
+
+}
+
+int main(int argc, const char *argv[]) {
+    std::string summary_path = argc > 1 ? argv[1] : TestResources::ExampleFilePaths::ecl_base_horzwell;
+    QString well = argc > 2 ? QString(argv[2]) : QString("PROD");
+    int n_evaluations = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+    Simulation::Results::ECLResults results;
+    results.ReadResults(QString::fromStdString(summary_path));
+    int n_steps = results.GetValueVector(Results::Time).size();
+
+    std::vector<Component> components = {
+        {Results::CumulativeOilProduction, false},
+        {Results::CumulativeWaterProduction, false},
+        {Results::CumulativeWaterInjection, false},
+        {Results::CumulativeWellOilProduction, true},
+        {Results::CumulativeWellWaterProduction, true},
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    double copying_value = 0.0;
+    for (int i = 0; i < n_evaluations; ++i) {
+        copying_value += copying_sweep(results, components, well, n_steps);
+    }
+    double copying_time = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    double zero_copy_value = 0.0;
+    for (int i = 0; i < n_evaluations; ++i) {
+        zero_copy_value += zero_copy_sweep(results, components, well, n_steps);
+    }
+    double zero_copy_time = seconds_since(start);
+
+    std::cout << "Report steps: " << n_steps << ", components: " << components.size()
+              << ", evaluations: " << n_evaluations << std::endl;
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << "Copying:   " << copying_time / n_evaluations << " s pr. evaluation" << std::endl;
+    std::cout << "Zero-copy: " << zero_copy_time / n_evaluations << " s pr. evaluation" << std::endl;
+    std::cout << "Speedup:   " << std::setprecision(1) << copying_time / zero_copy_time << "x" << std::endl;
+    if (copying_value != zero_copy_value) {
+        std::cerr << "Mismatch between copying and zero-copy values." << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -21,6 +21,7 @@ void AdgprsResults::ReadResults(QString file_path)
     if (file_path.split(".vars.h5").length() == 1)
         file_path = file_path + ".vars.h5"; // Append the suffix if it's not already there
     file_path_ = file_path;
+    field_vectors_.clear();
     summary_reader_ = new Hdf5SummaryReader(file_path_.toStdString());
     setAvailable();
 }
@@ -28,19 +29,13 @@ void AdgprsResults::ReadResults(QString file_path)
 void AdgprsResults::DumpResults()
 {
     delete summary_reader_;
+    field_vectors_.clear();
     setUnavailable();
 }
 
 double AdgprsResults::GetValue(Results::Property prop)
 {
-    if (!isAvailable()) throw ResultsNotAvailableException();
-    switch(prop) {
-        case CumulativeOilProduction : return summary_reader_->field_cumulative_oil_production_sc().back();
-        case CumulativeGasProduction : return summary_reader_->field_cumulative_gas_production_sc().back();
-        case CumulativeWaterProduction : return summary_reader_->field_cumulative_water_production_sc().back();
-        case Time : return summary_reader_->times_steps().back();
-        default : throw std::runtime_error("Property type not recognized by AdgprsResults::GetValue");
-    }
+    return GetValueVector(prop).back();
 }
 
 double AdgprsResults::GetValue(Results::Property prop, QString well)
@@ -50,14 +45,7 @@ double AdgprsResults::GetValue(Results::Property prop, QString well)
 
 double AdgprsResults::GetValue(Results::Property prop, int time_index)
 {
-    if (!isAvailable()) throw ResultsNotAvailableException();
-    switch(prop) {
-        case CumulativeOilProduction : return summary_reader_->field_cumulative_oil_production_sc()[time_index];
-        case CumulativeGasProduction : return summary_reader_->field_cumulative_gas_production_sc()[time_index];
-        case CumulativeWaterProduction : return summary_reader_->field_cumulative_water_production_sc()[time_index];
-        case Time : return summary_reader_->times_steps()[time_index];
-        default : throw std::runtime_error("Property type not recognized by AdgprsResults::GetValue");
-    }
+    return GetValueVector(prop)[time_index];
 }
 
 double AdgprsResults::GetValue(Results::Property prop, QString well, int time_index)
@@ -65,17 +53,25 @@ double AdgprsResults::GetValue(Results::Property prop, QString well, int time_in
     throw std::runtime_error("Well properties are not available for ADGPRS results.");
 }
 
-std::vector<double> AdgprsResults::GetValueVector(Results::Property prop)
+const std::vector<double> &AdgprsResults::GetValueVector(Results::Property prop)
 {
     if (!isAvailable()) throw ResultsNotAvailableException();
+    if (prop == Time) return summary_reader_->times_steps();
+
+    auto cached = field_vectors_.find(prop);
+    if (cached != field_vectors_.end()) return cached->second;
     switch(prop) {
-        case CumulativeOilProduction : return summary_reader_->field_cumulative_oil_production_sc();
-        case CumulativeGasProduction : return summary_reader_->field_cumulative_gas_production_sc();
-        case CumulativeWaterProduction : return summary_reader_->field_cumulative_water_production_sc();
-        case Time : return summary_reader_->times_steps();
+        case CumulativeOilProduction : return field_vectors_[prop] = summary_reader_->field_cumulative_oil_production_sc();
+        case CumulativeGasProduction : return field_vectors_[prop] = summary_reader_->field_cumulative_gas_production_sc();
+        case CumulativeWaterProduction : return field_vectors_[prop] = summary_reader_->field_cumulative_water_production_sc();
         default : throw std::runtime_error("Property type not recognized by AdgprsResults::GetValue");
     }
 }
 
+const std::vector<double> &AdgprsResults::GetValueVector(Results::Property prop, QString well)
+{
+    throw std::runtime_error("Well properties are not available for ADGPRS results.");
+}
+
 
 }}
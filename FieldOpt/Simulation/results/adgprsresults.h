@@ -3,6 +3,7 @@
 
 #include "results.h"
 #include <QHash>
+#include <map>
 #include "Hdf5SummaryReader/hdf5_summary_reader.h"
 
 namespace Simulation { namespace Results {
@@ -28,11 +29,13 @@ public:
     double GetValue(Property prop, QString well);
     double GetValue(Property prop, int time_index);
     double GetValue(Property prop, QString well, int time_index);
-    std::vector<double> GetValueVector(Property prop);
+    const std::vector<double> &GetValueVector(Property prop);
+    const std::vector<double> &GetValueVector(Property prop, QString well);
 
 private:
     QString file_path_;
     Hdf5SummaryReader *summary_reader_;
+    std::map<Property, std::vector<double>> field_vectors_; //!< Field vectors summed from the well vectors, computed on first access.
 };
 
 }}
@@ -71,7 +71,7 @@ double ECLResults::GetValue(Results::Property prop, QString well, int time_index
     return GetValueVector(prop, well)[time_index];
 }
 
-std::vector<double> ECLResults::GetValueVector(Results::Property prop)
+const std::vector<double> &ECLResults::GetValueVector(Results::Property prop)
 {
     if (!isAvailable()) throw ResultsNotAvailableException();
     switch (prop) {
@@ -85,7 +85,7 @@ std::vector<double> ECLResults::GetValueVector(Results::Property prop)
     }
 }
 
-std::vector<double> ECLResults::GetValueVector(Results::Property prop, QString well_name) {
+const std::vector<double> &ECLResults::GetValueVector(Results::Property prop, QString well_name) {
     if (!isAvailable()) throw ResultsNotAvailableException();
     switch (prop) {
         case CumulativeWellOilProduction:   return summary_reader_->wopt(well_name.toStdString());
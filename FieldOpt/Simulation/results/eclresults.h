@@ -26,8 +26,8 @@ class ECLResults : public Results
   double GetValue(Property prop, int time_index);
   double GetValue(Property prop, QString well);
   double GetValue(Property prop, QString well, int time_index);
-  std::vector<double> GetValueVector(Property prop);
-  std::vector<double> GetValueVector(Property prop, QString well_name);
+  const std::vector<double> &GetValueVector(Property prop);
+  const std::vector<double> &GetValueVector(Property prop, QString well_name);
 
  private:
   QString file_path_;
@@ -73,9 +73,20 @@ namespace Simulation {
 
             /*!
              * \brief GetValueVector Get the vector containing all values for the specified property.
+             *
+             * The returned reference points to data cached by the results object, and is valid
+             * until the results are dumped or re-read.
+             * \param prop The property to be retrieved.
+             */
+            virtual const std::vector<double> &GetValueVector(Property prop) = 0;
+
+            /*!
+             * \brief GetValueVector Get the vector containing all values for the specified property
+             * for the given well. The reference is valid until the results are dumped or re-read.
              * \param prop The property to be retrieved.
+             * \param well The well to get the values from.
              */
-            virtual std::vector<double> GetValueVector(Property prop) = 0;
+            virtual const std::vector<double> &GetValueVector(Property prop, QString well) = 0;
 
             /*!
              * \brief GetFinalValue Gets the value of the given property for the given well at the
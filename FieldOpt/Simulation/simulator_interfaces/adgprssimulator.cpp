@@ -41,7 +41,7 @@ void AdgprsSimulator::Evaluate()
     if (results_->isAvailable()) results()->DumpResults();
     copyDriverFiles();
     driver_file_writer_->WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_WORK_DIR)));
-    ::Utilities::Unix::ExecShellScript(QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)), script_args_);
+    last_run_ = ::Utilities::Unix::RunShellScript(QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)), script_args_);
     paths_.SetPath(Paths::SIM_HDF5_FILE,
         paths_.GetPath(Paths::SIM_WORK_DIR) + "/"
         + driver_file_name_.split(".").first().toStdString() + ".vars.h5"
@@ -60,11 +60,11 @@ void AdgprsSimulator::copyDriverFiles()
     auto workdir = paths_.GetPath(Paths::OUTPUT_DIR) + driver_parent_dir_name_.toStdString();
     if (!DirectoryExists(workdir)) {
         if (VERB_SIM >= 1) {
-            Printer::ext_info("Output deck directory not found. Copying input deck:"
+            Printer::ext_info("Output deck directory not found. Provisioning input deck:"
                                   + paths_.GetPath(Paths::SIM_DRIVER_DIR) + " -> " + workdir, "Simulation", "ADGPRSSimulator" );
         }
         CreateDirectory(workdir);
-        CopyDirectory(paths_.GetPath(Paths::SIM_DRIVER_DIR), workdir, true);
+        provisionDirectory(paths_.GetPath(Paths::SIM_DRIVER_DIR), workdir, true);
     }
     paths_.SetPath(Paths::SIM_WORK_DIR, workdir);
 }
@@ -91,14 +91,15 @@ void AdgprsSimulator::UpdateFilePaths()
 bool AdgprsSimulator::Evaluate(int timeout, int threads) {
     script_args_[2] = QString::number(threads);
     int t = timeout;
-    if (timeout < 10) t = 10; // Always let simulations run for at least 10 seconds
+    if (timeout > 0 && timeout < 10) t = 10; // Always let simulations run for at least 10 seconds
     if (results_->isAvailable()) results()->DumpResults();
     copyDriverFiles();
     driver_file_writer_->WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_WORK_DIR )));
     std::cout << "Starting monitored simulation with timeout " << timeout << std::endl;
-    bool success = ::Utilities::Unix::ExecShellScriptTimeout(
+    last_run_ = ::Utilities::Unix::RunShellScript(
         QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)),
         script_args_, t);
+    bool success = !last_run_.timed_out;
     if (success) {
         paths_.SetPath(Paths::SIM_HDF5_FILE,
                        paths_.GetPath(Paths::SIM_WORK_DIR) + "/"
@@ -16,19 +16,19 @@ AdgprsDriverFileWriter::AdgprsDriverFileWriter(Settings::Settings *settings, Mod
 
 void AdgprsDriverFileWriter::WriteDriverFile(QString output_dir)
 {
-    auto welspecs = ECLDriverParts::Welspecs(model_->wells());
-    auto compdat = ECLDriverParts::Compdat(model_->wells());
-    model_->SetCompdatString(compdat.GetPartString());
+    QString welspecs = schedule_cache_.GetWelspecs(model_->wells());
+    QString compdat = schedule_cache_.GetCompdat(model_->wells());
+    model_->SetCompdatString(compdat);
     auto wellstre = AdgprsDriverParts::Wellstre(model_->wells(), settings_->simulator()->fluid_model());
     auto wellcontrols = AdgprsDriverParts::WellControls(model_->wells(), settings_->model()->control_times());
 
     if (!Utilities::FileHandling::FileExists(output_dir+"/include/wells.in"))
         throw std::runtime_error("Unable to find include/wells.in file to write to.");
-    else Utilities::FileHandling::WriteStringToFile(welspecs.GetPartString(), output_dir+"/include/welspecs.in");
+    else Utilities::FileHandling::WriteStringToFile(welspecs, output_dir+"/include/welspecs.in");
 
     if (!Utilities::FileHandling::FileExists(output_dir+"/include/compdat.in"))
         throw std::runtime_error("Unable to find include/compdat.in file to write to.");
-    else Utilities::FileHandling::WriteStringToFile(compdat.GetPartString(), output_dir+"/include/compdat.in");
+    else Utilities::FileHandling::WriteStringToFile(compdat, output_dir+"/include/compdat.in");
 
     if (!Utilities::FileHandling::FileExists(output_dir+"/include/controls.in"))
         throw std::runtime_error("Unable to find include/controls.in file to write to.");
@@ -4,6 +4,7 @@
 #include "Settings/settings.h"
 #include "Settings/simulator.h"
 #include "Model/model.h"
+#include "driver_parts/ecl_driver_parts/schedule_cache.h"
 
 namespace Simulation {
     class AdgprsSimulator;
@@ -25,6 +26,7 @@ private:
 
     Model::Model *model_;
     Settings::Settings *settings_;
+    ECLDriverParts::ScheduleCache schedule_cache_; //!< WELSPECS and COMPDAT entries from the previous evaluations.
 };
 
 }
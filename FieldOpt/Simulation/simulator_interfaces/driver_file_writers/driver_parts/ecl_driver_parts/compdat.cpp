@@ -26,8 +26,6 @@ namespace ECLDriverParts {
 Compdat::Compdat(QList<Model::Wells::Well *> *wells)
 {
     initializeBaseEntryLine(13);
-    head_ = "COMPDAT";
-    foot_ = "/\n\n";
     for (int i = 0; i < wells->size(); ++i) {
         if (wells->at(i)->trajectory()->GetWellBlocks()->size() > 0)
             entries_.append(createWellEntries(wells->at(i)));
@@ -36,8 +34,6 @@ Compdat::Compdat(QList<Model::Wells::Well *> *wells)
 
 Compdat::Compdat(QList<Model::Wells::Well *> *wells, int timestep) {
     initializeBaseEntryLine(13);
-    head_ = "COMPDAT";
-    foot_ = "/\n\n";
     for (auto well : *wells) {
         if (well->controls()->first()->time_step() == timestep) {
             entries_.append(createWellEntries(well));
@@ -46,19 +42,25 @@ Compdat::Compdat(QList<Model::Wells::Well *> *wells, int timestep) {
 }
 
 QString Compdat::GetPartString() const {
-    // Return empty string if there are no entries (at this timestep)
-    if (entries_.size() == 0) {
-        return "";
-    }
+    return BuildPartString(GetEntryString());
+}
 
-    QString entries = head_ + "\n";
+QString Compdat::GetEntryString() const {
+    QString entries = "";
     for (QStringList entry : entries_) {
         entries.append("    " + entry.join(" ") + " /\n");
     }
-    entries.append("\n" + foot_);
     return entries;
 }
 
+QString Compdat::BuildPartString(const QString &entry_string) {
+    // Return empty string if there are no entries (at this timestep)
+    if (entry_string.isEmpty()) {
+        return "";
+    }
+    return "COMPDAT\n" + entry_string + "\n/\n\n";
+}
+
 QList<QStringList> Compdat::createWellEntries(Model::Wells::Well *well)
 {
     QList<QStringList> block_entries = QList<QStringList>();
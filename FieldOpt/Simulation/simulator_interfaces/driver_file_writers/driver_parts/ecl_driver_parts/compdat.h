@@ -52,6 +52,18 @@ class Compdat : public ECLDriverPart
 
   QString GetPartString() const;
 
+  /*!
+   * Get the entry lines only, without the keyword and terminator. The part string
+   * for several wells is BuildPartString applied to their concatenated entry strings.
+   */
+  QString GetEntryString() const;
+
+  /*!
+   * Build the COMPDAT keyword around entry lines from GetEntryString(). Returns an
+   * empty string if there are no entry lines.
+   */
+  static QString BuildPartString(const QString &entry_string);
+
  private:
   QList<QStringList> createWellEntries(Model::Wells::Well *well);
   QStringList createBlockEntry(QString well_name, double wellbore_radius, Model::Wells::Wellbore::WellBlock *well_block);
@@ -0,0 +1,246 @@
+/******************************************************************************
+ * This file is part of the FieldOpt project.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ *****************************************************************************/
+
+#include "schedule_cache.h"
+#include "welspecs.h"
+#include "compdat.h"
+#include "wellcontrols.h"
+#include "welsegs.h"
+#include "compsegs.h"
+#include "wsegvalv.h"
+
+namespace Simulation {
+namespace ECLDriverParts {
+
+using Model::Wells::Well;
+
+ScheduleCache::ScheduleCache() {
+    generated_entries_ = 0;
+}
+
+QString ScheduleCache::GetSchedule(QList<Well *> *wells, const QList<int> &control_times, ScheduleInsets &insets)
+{
+    generated_entries_ = 0;
+    updateTimeStepEntries(control_times);
+    QList<WellEntries *> well_entries;
+    for (Well *well : *wells) {
+        WellEntries &entries = updateCompletionEntries(well);
+        if (well->IsSegmented()) {
+            updateSegmentEntries(well, entries);
+        }
+        updateControlEntries(well, control_times, entries);
+        well_entries.append(&entries);
+    }
+
+    // Assembled in the same order as in the Schedule class
+    QString schedule = "";
+    time_entry_strings_.clear();
+    for (int i = 0; i < control_times.size(); ++i) {
+        int control_time = control_times[i];
+        QString welspecs, compdat, welsegs, compsegs, wsegvalv, controls;
+        for (int w = 0; w < wells->size(); ++w) {
+            Well *well = wells->at(w);
+            const WellEntries &entries = *well_entries[w];
+            if (well->controls()->first()->time_step() == control_time) {
+                welspecs.append(entries.welspecs);
+                compdat.append(entries.compdat);
+                if (well->IsSegmented()) {
+                    welsegs.append(entries.welsegs);
+                    compsegs.append(entries.compsegs);
+                    wsegvalv.append(entries.wsegvalv);
+                }
+            }
+            controls.append(entries.controls.value(control_time));
+        }
+
+        QString entry_string = "";
+        if (i == 0 && insets.HasInset(-1)) {
+            entry_string.append(QString::fromStdString(insets.GetInset(-1)));
+        }
+        entry_string.append(Welspecs::BuildPartString(welspecs));
+        if (insets.HasInset(control_time)) {
+            entry_string.append(QString::fromStdString(insets.GetInset(control_time)));
+        }
+        entry_string.append(Compdat::BuildPartString(compdat));
+        entry_string.append(welsegs);
+        entry_string.append(compsegs);
+        entry_string.append(Wsegvalv::BuildPartString(wsegvalv));
+        entry_string.append(controls);
+        entry_string.append(time_step_entries_[i]);
+        time_entry_strings_.append(entry_string);
+        schedule.append(entry_string);
+    }
+    if (time_entry_strings_.isEmpty() && insets.HasInset(-1)) {
+        schedule.append(QString::fromStdString(insets.GetInset(-1)));
+    }
+    schedule.append("\n\n");
+    return schedule;
+}
+
+QString ScheduleCache::GetWelspecs(QList<Well *> *wells)
+{
+    generated_entries_ = 0;
+    QString welspecs = "";
+    for (Well *well : *wells) {
+        if (well->trajectory()->GetWellBlocks()->size() > 0) {
+            welspecs.append(updateCompletionEntries(well).welspecs);
+        }
+    }
+    return Welspecs::BuildPartString(welspecs);
+}
+
+QString ScheduleCache::GetCompdat(QList<Well *> *wells)
+{
+    generated_entries_ = 0;
+    QString compdat = "";
+    for (Well *well : *wells) {
+        if (well->trajectory()->GetWellBlocks()->size() > 0) {
+            compdat.append(updateCompletionEntries(well).compdat);
+        }
+    }
+    return Compdat::BuildPartString(compdat);
+}
+
+ScheduleCache::WellEntries &ScheduleCache::updateCompletionEntries(Well *well)
+{
+    WellEntries &entries = well_entries_[well->name()];
+    Fingerprint fingerprint = completionFingerprint(well);
+    if (!entries.has_completion_entries || entries.completion_fingerprint != fingerprint) {
+        QList<Well *> single_well({well});
+        if (well->trajectory()->GetWellBlocks()->size() > 0) {
+            entries.welspecs = Welspecs(&single_well).GetEntryString();
+            entries.compdat = Compdat(&single_well).GetEntryString();
+        }
+        else { // Only included in schedules
+            int first_control_time = well->controls()->first()->time_step();
+            entries.welspecs = Welspecs(&single_well, first_control_time).GetEntryString();
+            entries.compdat = Compdat(&single_well, first_control_time).GetEntryString();
+        }
+        entries.completion_fingerprint = fingerprint;
+        entries.has_completion_entries = true;
+        generated_entries_++;
+    }
+    return entries;
+}
+
+void ScheduleCache::updateSegmentEntries(Well *well, WellEntries &entries)
+{
+    Fingerprint fingerprint = segmentFingerprint(well);
+    if (!entries.has_segment_entries || entries.segment_fingerprint != fingerprint) {
+        QList<Well *> single_well({well});
+        int first_control_time = well->controls()->first()->time_step();
+        entries.welsegs = Welsegs(&single_well, first_control_time).GetPartString();
+        entries.compsegs = Compsegs(&single_well, first_control_time).GetPartString();
+        entries.wsegvalv = Wsegvalv(&single_well, first_control_time).GetEntryString();
+        entries.segment_fingerprint = fingerprint;
+        entries.has_segment_entries = true;
+        generated_entries_++;
+    }
+}
+
+void ScheduleCache::updateControlEntries(Well *well, const QList<int> &control_times, WellEntries &entries)
+{
+    QMap<int, Fingerprint> fingerprints;
+    for (auto control : *well->controls()) {
+        Fingerprint &fingerprint = fingerprints[control->time_step()];
+        fingerprint.values.insert(fingerprint.values.end(), {
+            (double)well->IsInjector(), (double)control->open(), (double)control->mode(),
+            (double)control->injection_fluid(), control->bhp(), control->liquidRate(), control->oilRate(),
+            control->gasRate(), control->waterRate(), control->reservoirRate()
+        });
+    }
+
+    QList<Well *> single_well({well});
+    for (int control_time : control_times) {
+        if (!fingerprints.contains(control_time)) {
+            entries.controls.remove(control_time);
+            entries.control_fingerprints.remove(control_time);
+        }
+        else if (!entries.controls.contains(control_time)
+            || entries.control_fingerprints[control_time] != fingerprints[control_time]) {
+            entries.controls[control_time] = WellControls(&single_well, control_times, control_time)
+                .GetWellEntryList().join("");
+            entries.control_fingerprints[control_time] = fingerprints[control_time];
+            generated_entries_++;
+        }
+    }
+}
+
+void ScheduleCache::updateTimeStepEntries(const QList<int> &control_times)
+{
+    if (control_times == control_times_ && time_step_entries_.size() == control_times.size()) {
+        return;
+    }
+    // Without wells, the control entries only contain the time progression keyword
+    const QList<Well *> no_wells;
+    time_step_entries_.clear();
+    for (int control_time : control_times) {
+        time_step_entries_.append(WellControls(&no_wells, control_times, control_time).GetPartString());
+    }
+    control_times_ = control_times;
+}
+
+ScheduleCache::Fingerprint ScheduleCache::completionFingerprint(Well *well)
+{
+    Fingerprint fingerprint;
+    fingerprint.names = well->name() + "\n" + well->group();
+    auto &values = fingerprint.values;
+    auto well_blocks = well->trajectory()->GetWellBlocks();
+    values.reserve(4 + 6 * well_blocks->size());
+    values.insert(values.end(), {
+        (double)well->heel_i(), (double)well->heel_j(), (double)well->preferred_phase(), well->wellbore_radius()
+    });
+    for (auto block : *well_blocks) {
+        values.insert(values.end(), {
+            (double)block->i(), (double)block->j(), (double)block->k(), (double)block->directionOfPenetration(),
+            (double)block->HasPerforation()
+        });
+        if (block->HasPerforation()) {
+            values.push_back(block->GetPerforation()->transmissibility_factor());
+        }
+    }
+    return fingerprint;
+}
+
+ScheduleCache::Fingerprint ScheduleCache::segmentFingerprint(Well *well)
+{
+    Fingerprint fingerprint;
+    fingerprint.names = well->name();
+    auto &values = fingerprint.values;
+    auto entry_point = well->trajectory()->GetWellBlocks()->at(0)->getEntryPoint();
+    values.insert(values.end(), {entry_point.x(), entry_point.y()});
+    for (auto segment : well->GetSegments()) {
+        values.insert(values.end(), {
+            (double)segment.Type(), (double)segment.Index(), (double)segment.Branch(), (double)segment.Outlet(),
+            (double)segment.OutletMD(), segment.TVDChange(), segment.Length(), segment.Diameter(), segment.Roughness(),
+            (double)segment.HasParentBlock(), (double)segment.HasParentICD()
+        });
+        if (segment.HasParentBlock()) {
+            auto block = segment.ParentBlock();
+            values.insert(values.end(), {(double)block->i(), (double)block->j(), (double)block->k()});
+        }
+        if (segment.HasParentICD()) {
+            auto icd = segment.ParentICD();
+            values.insert(values.end(), {icd->flowCoefficient(), icd->valveSize()});
+        }
+    }
+    return fingerprint;
+}
+
+}
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * This file is part of the FieldOpt project.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ *****************************************************************************/
+
+#ifndef FIELDOPT_SCHEDULE_CACHE_H
+#define FIELDOPT_SCHEDULE_CACHE_H
+
+#include "Model/wells/well.h"
+#include "schedule_insets.h"
+#include <QMap>
+#include <QStringList>
+#include <map>
+#include <vector>
+
+namespace Simulation {
+namespace ECLDriverParts {
+
+/*!
+ * @brief The ScheduleCache class generates the same strings as the Schedule class and the
+ * Welspecs and Compdat parts, but keeps the entries generated for each well between calls.
+ * The entries of a well are only regenerated when the properties they are generated from
+ * change: the WELSPECS/COMPDAT entries when the well is moved or its completions change,
+ * the WELSEGS/COMPSEGS/WSEGVALV entries when its segments change, and the control entries
+ * at a control time when the controls at that time change.
+ *
+ * Changes are detected by comparing fingerprints of the wells: the names and numbers the
+ * entries are formatted from, which are much cheaper to gather than the entries are to format.
+ *
+ * A cache should only be used with one model, and kept for as long as the model; wells are
+ * identified by name.
+ */
+class ScheduleCache
+{
+ public:
+  ScheduleCache();
+
+  /*!
+   * @brief Get the complete schedule for the current state of the wells. This is equal to
+   * Schedule(wells, control_times, insets).GetPartString().
+   */
+  QString GetSchedule(QList<Model::Wells::Well *> *wells, const QList<int> &control_times, ScheduleInsets &insets);
+
+  /*!
+   * @brief Get the part of the last schedule belonging to each control time, in order (see
+   * Schedule::GetTimeEntryStrings()).
+   */
+  QStringList GetTimeEntryStrings() const { return time_entry_strings_; }
+
+  /*!
+   * @brief Get the WELSPECS keyword for all wells with well blocks. This is equal to
+   * Welspecs(wells).GetPartString().
+   */
+  QString GetWelspecs(QList<Model::Wells::Well *> *wells);
+
+  /*!
+   * @brief Get the COMPDAT keyword for all wells with well blocks. This is equal to
+   * Compdat(wells).GetPartString().
+   */
+  QString GetCompdat(QList<Model::Wells::Well *> *wells);
+
+  /*!
+   * @brief The number of entry sets (the completion entries, segment entries or control
+   * entries at one control time of one well) generated, rather than taken from the cache,
+   * by the last call.
+   */
+  int generated_entries() const { return generated_entries_; }
+
+ private:
+  /*!
+   * The names and numbers a set of entries is formatted from.
+   */
+  struct Fingerprint {
+    QString names;
+    std::vector<double> values;
+    bool operator==(const Fingerprint &other) const { return values == other.values && names == other.names; }
+    bool operator!=(const Fingerprint &other) const { return !(*this == other); }
+  };
+
+  /*!
+   * The entries generated for a well, along with the fingerprints they were generated from.
+   */
+  struct WellEntries {
+    bool has_completion_entries = false;
+    Fingerprint completion_fingerprint;
+    QString welspecs; //!< WELSPECS entry lines.
+    QString compdat; //!< COMPDAT entry lines.
+
+    bool has_segment_entries = false;
+    Fingerprint segment_fingerprint;
+    QString welsegs; //!< WELSEGS keyword.
+    QString compsegs; //!< COMPSEGS keyword.
+    QString wsegvalv; //!< WSEGVALV entry lines.
+
+    QMap<int, Fingerprint> control_fingerprints; //!< Fingerprint of the controls at each control time.
+    QMap<int, QString> controls; //!< WCONPROD/WCONINJE keywords at each control time.
+  };
+
+  std::map<QString, WellEntries> well_entries_; //!< Entries for each well, by well name.
+  QList<int> control_times_; //!< The control times time_step_entries_ were generated for.
+  QStringList time_step_entries_; //!< Time progression keyword from each control time to the next.
+  QStringList time_entry_strings_;
+  int generated_entries_;
+
+  WellEntries &updateCompletionEntries(Model::Wells::Well *well);
+  void updateSegmentEntries(Model::Wells::Well *well, WellEntries &entries);
+  void updateControlEntries(Model::Wells::Well *well, const QList<int> &control_times, WellEntries &entries);
+  void updateTimeStepEntries(const QList<int> &control_times);
+
+  static Fingerprint completionFingerprint(Model::Wells::Well *well);
+  static Fingerprint segmentFingerprint(Model::Wells::Well *well);
+};
+
+}
+}
+
+#endif //FIELDOPT_SCHEDULE_CACHE_H
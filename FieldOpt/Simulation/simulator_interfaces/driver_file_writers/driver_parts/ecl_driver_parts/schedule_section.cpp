@@ -44,19 +44,25 @@ Schedule::Schedule(QList<Model::Wells::Well *> *wells, QList<int> control_times,
         schedule_time_entries_.append(time_entry);
     }
 
-    if (insets.HasInset(-1)) {
-        schedule_.append(QString::fromStdString(insets.GetInset(-1)));
-    }
     for (auto time_entry : schedule_time_entries_) {
-        schedule_.append(time_entry.welspecs.GetPartString());
+        QString entry_string = "";
+        if (time_entry_strings_.isEmpty() && insets.HasInset(-1)) {
+            entry_string.append(QString::fromStdString(insets.GetInset(-1)));
+        }
+        entry_string.append(time_entry.welspecs.GetPartString());
         if (insets.HasInset(time_entry.control_time)) {
-            schedule_.append(QString::fromStdString(insets.GetInset(time_entry.control_time)));
+            entry_string.append(QString::fromStdString(insets.GetInset(time_entry.control_time)));
         }
-        schedule_.append(time_entry.compdat.GetPartString());
-        schedule_.append(time_entry.welsegs.GetPartString());
-        schedule_.append(time_entry.compsegs.GetPartString());
-        schedule_.append(time_entry.wsegvalv.GetPartString());
-        schedule_.append(time_entry.well_controls.GetPartString());
+        entry_string.append(time_entry.compdat.GetPartString());
+        entry_string.append(time_entry.welsegs.GetPartString());
+        entry_string.append(time_entry.compsegs.GetPartString());
+        entry_string.append(time_entry.wsegvalv.GetPartString());
+        entry_string.append(time_entry.well_controls.GetPartString());
+        time_entry_strings_.append(entry_string);
+        schedule_.append(entry_string);
+    }
+    if (time_entry_strings_.isEmpty() && insets.HasInset(-1)) {
+        schedule_.append(QString::fromStdString(insets.GetInset(-1)));
     }
     schedule_.append("\n\n");
 }
@@ -47,6 +47,14 @@ class Schedule : public ECLDriverPart
   Schedule(QList<Model::Wells::Well *> *wells, QList<int> control_times, ScheduleInsets &insets);
   QString GetPartString() const;
 
+  /*!
+   * @brief Get the part of the schedule belonging to each control time, in order. The
+   * parts are the schedule entries for the control time followed by the time step to
+   * the next control time; the inset for time -1 (if any) is part of the first entry.
+   * GetPartString() is the concatenation of these.
+   */
+  QStringList GetTimeEntryStrings() const { return time_entry_strings_; }
+
   struct ScheduleTimeEntry {
     ScheduleTimeEntry(int control_time,
                       Welspecs welspecs,
@@ -75,6 +83,7 @@ class Schedule : public ECLDriverPart
   QList<ScheduleTimeEntry> schedule_time_entries_;
 
   QString schedule_;
+  QStringList time_entry_strings_;
 
  public:
   QList<ScheduleTimeEntry> GetScheduleTimeEntries() { return schedule_time_entries_; }
@@ -26,8 +26,6 @@ namespace ECLDriverParts {
 Welspecs::Welspecs(QList<Model::Wells::Well *> *wells)
 {
     initializeBaseEntryLine(10);
-    head_ = "WELSPECS";
-    foot_ = "/\n\n";
     for (int i = 0; i < wells->size(); ++i) {
         if (wells->at(i)->trajectory()->GetWellBlocks()->size() > 0)
             entries_.append(createWellEntry(wells->at(i)));
@@ -36,8 +34,6 @@ Welspecs::Welspecs(QList<Model::Wells::Well *> *wells)
 
 Welspecs::Welspecs(QList<Model::Wells::Well *> *wells, int timestep) {
     initializeBaseEntryLine(10);
-    head_ = "WELSPECS";
-    foot_ = "/\n\n";
     for (auto well : *wells) {
         if (well->controls()->first()->time_step() == timestep) {
             entries_.append(createWellEntry(well));
@@ -46,19 +42,25 @@ Welspecs::Welspecs(QList<Model::Wells::Well *> *wells, int timestep) {
 }
 
 QString Welspecs::GetPartString() const {
-    // Return an empty string if there are no entries (at the timestep)
-    if (entries_.size() == 0){
-        return "";
-    }
+    return BuildPartString(GetEntryString());
+}
 
-    QString entries = head_ + "\n";
+QString Welspecs::GetEntryString() const {
+    QString entries = "";
     for (QStringList entry : entries_) {
         entries.append("    " + entry.join(" ") + " /\n");
     }
-    entries.append("\n" + foot_);
     return entries;
 }
 
+QString Welspecs::BuildPartString(const QString &entry_string) {
+    // Return an empty string if there are no entries (at the timestep)
+    if (entry_string.isEmpty()) {
+        return "";
+    }
+    return "WELSPECS\n" + entry_string + "\n/\n\n";
+}
+
 QStringList Welspecs::createWellEntry(Model::Wells::Well *well)
 {
     QStringList entry = QStringList(base_entry_line_);
@@ -55,6 +55,18 @@ class Welspecs : public ECLDriverPart
 
   QString GetPartString() const;
 
+  /*!
+   * Get the entry lines only, without the keyword and terminator. The part string
+   * for several wells is BuildPartString applied to their concatenated entry strings.
+   */
+  QString GetEntryString() const;
+
+  /*!
+   * Build the WELSPECS keyword around entry lines from GetEntryString(). Returns an
+   * empty string if there are no entry lines.
+   */
+  static QString BuildPartString(const QString &entry_string);
+
  private:
   QStringList createWellEntry(::Model::Wells::Well *well);
 };
@@ -25,9 +25,6 @@ namespace Simulation {
 namespace ECLDriverParts {
 
 Wsegvalv::Wsegvalv(Well *well) {
-    head_ = "WSEGVALV\n";
-    foot_ = "/\n\n";
-
     if (well->HasSimpleICVs()) {
         auto icvs = well->GetSimpleICDs();
 
@@ -59,8 +56,6 @@ Wsegvalv::Wsegvalv(Well *well) {
 }
 
 Wsegvalv::Wsegvalv(QList<Model::Wells::Well *> *wells, int ts) {
-    head_ = "WSEGVALV\n";
-    foot_ = "/\n\n";
     for (Well *well : *wells) {
         if (well->IsSegmented() && well->controls()->first()->time_step() == ts) {
             auto isegs = well->GetICDSegments();
@@ -73,12 +68,19 @@ Wsegvalv::Wsegvalv(QList<Model::Wells::Well *> *wells, int ts) {
 
 
 QString Wsegvalv::GetPartString() const {
+    return BuildPartString(GetEntryString());
+}
+
+QString Wsegvalv::GetEntryString() const {
     if (entries_.size() == 0)
         return "";
-    QString keyword = head_;
-    keyword += entries_.join("\n") + "\n";
-    keyword += foot_;
-    return keyword;
+    return entries_.join("\n") + "\n";
+}
+
+QString Wsegvalv::BuildPartString(const QString &entry_string) {
+    if (entry_string.isEmpty())
+        return "";
+    return "WSEGVALV\n" + entry_string + "/\n\n";
 }
 
 QString Wsegvalv::generateEntry(Segment seg, QString wname) {
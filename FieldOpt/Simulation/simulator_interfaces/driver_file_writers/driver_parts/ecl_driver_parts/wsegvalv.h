@@ -43,6 +43,18 @@ class Wsegvalv : public ECLDriverPart {
   Wsegvalv() {}
   QString GetPartString() const override;
 
+  /*!
+   * Get the entry lines only, without the keyword and terminator. The part string
+   * for several wells is BuildPartString applied to their concatenated entry strings.
+   */
+  QString GetEntryString() const;
+
+  /*!
+   * Build the WSEGVALV keyword around entry lines from GetEntryString(). Returns an
+   * empty string if there are no entry lines.
+   */
+  static QString BuildPartString(const QString &entry_string);
+
  private:
   QString generateEntry(Segment seg, QString wname);
   QString generateEntry(Wellbore::Completions::ICD icd, QString wname);
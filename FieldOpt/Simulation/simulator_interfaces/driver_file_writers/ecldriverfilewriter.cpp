@@ -28,6 +28,7 @@
 #include "driver_parts/ecl_driver_parts/schedule_section.h"
 #include "driver_parts/ecl_driver_parts/actionx.hpp"
 #include "Simulation/simulator_interfaces/simulator_exceptions.h"
+#include "Simulation/simulator_interfaces/ecl_restart_cache.h"
 #include "Utilities/filehandling.hpp"
 #include "Utilities/verbosity.h"
 
@@ -41,6 +42,7 @@ EclDriverFileWriter::EclDriverFileWriter(Settings::Settings *settings, Model::Mo
     model_ = model;
     settings_ = settings;
     use_actionx_ = settings->simulator()->use_actionx();
+    write_restarts_ = false;
 
     if (settings->paths().IsSet(Paths::SIM_SCH_INSET_FILE)) {
         insets_ = ECLDriverParts::ScheduleInsets(settings->paths().GetPath(Paths::SIM_SCH_INSET_FILE));
@@ -55,10 +57,21 @@ void EclDriverFileWriter::WriteDriverFile(QString schedule_file_path)
     }
     assert(FileExists(schedule_file_path));
 
+    time_entries_.clear();
     if (use_actionx_ == false) {
-        Schedule schedule = ECLDriverParts::Schedule(model_->wells(), settings_->model()->control_times(), insets_);
-        model_->SetCompdatString(schedule.GetPartString());
-        Utilities::FileHandling::WriteStringToFile(schedule.GetPartString(), schedule_file_path);
+        QString schedule_string = schedule_cache_.GetSchedule(model_->wells(), settings_->model()->control_times(), insets_);
+        if (VERB_SIM >= 3) {
+            Printer::ext_info("Generated " + Printer::num2str(schedule_cache_.generated_entries())
+                                  + " well entry sets; reused the others.", "Simulation", "EclDriverFileWriter");
+        }
+        model_->SetCompdatString(schedule_string);
+        for (auto entry : schedule_cache_.GetTimeEntryStrings()) {
+            time_entries_.push_back(entry.toStdString());
+        }
+        if (write_restarts_) {
+            schedule_string.prepend(QString::fromStdString(EclRestartCache::RestartOutputKeyword()));
+        }
+        Utilities::FileHandling::WriteStringToFile(schedule_string, schedule_file_path);
     }
     else {
         Utilities::FileHandling::WriteStringToFile(QString::fromStdString(buildActionStrings()), schedule_file_path);
@@ -30,6 +30,7 @@
 #include "Settings/simulator.h"
 #include "Model/model.h"
 #include "driver_parts/ecl_driver_parts/schedule_insets.h"
+#include "driver_parts/ecl_driver_parts/schedule_cache.h"
 
 namespace Simulation {
     class ECLSimulator;
@@ -41,6 +42,9 @@ namespace Simulation {
  * \brief The EclDriverFileWriter class writes driver files that can be executed
  * by the ECL100 reservoir simulator. This class should _only_ be used by the
  * ECLSimulator class.
+ *
+ * The schedule entries of each well are kept in a ScheduleCache, so the writer
+ * should be kept between evaluations of the same model.
  */
 class EclDriverFileWriter
 {
@@ -50,10 +54,24 @@ private:
     void WriteDriverFile(QString schedule_file_path);
     std::string buildActionStrings();
 
+    /*!
+     * \brief SetWriteRestarts Make the written schedules request a restart file at every report step.
+     */
+    void SetWriteRestarts(bool write_restarts) { write_restarts_ = write_restarts; }
+
+    /*!
+     * \brief time_entries The time entries of the last schedule written (see
+     * ECLDriverParts::Schedule::GetTimeEntryStrings). Empty when ACTIONX is used.
+     */
+    std::vector<std::string> time_entries() const { return time_entries_; }
+
     Model::Model *model_;
     ::Settings::Settings *settings_;
     ECLDriverParts::ScheduleInsets insets_;
+    ECLDriverParts::ScheduleCache schedule_cache_; //!< Well entries from the previous schedules.
     bool use_actionx_;
+    bool write_restarts_;
+    std::vector<std::string> time_entries_;
 };
 
 }
@@ -13,19 +13,19 @@ FlowDriverFileWriter::FlowDriverFileWriter(::Settings::Settings *settings,
 }
 
 void FlowDriverFileWriter::WriteDriverFile(QString output_dir) {
-    auto welspecs = ECLDriverParts::Welspecs(model_->wells());
-    auto compdat = ECLDriverParts::Compdat(model_->wells());
+    QString welspecs = schedule_cache_.GetWelspecs(model_->wells());
+    QString compdat = schedule_cache_.GetCompdat(model_->wells());
     auto wellcontrols = ECLDriverParts::WellControls(model_->wells(), settings_->model()->control_times());
-    model_->SetCompdatString(compdat.GetPartString());
+    model_->SetCompdatString(compdat);
 
     if (!Utilities::FileHandling::FileExists(output_dir+"/include/wells.in")
         || !Utilities::FileHandling::FileExists(output_dir+"/include/welspecs.in"))
         throw std::runtime_error("Unable to find include/wells.in or include/welspecs.in file to write to.");
-    else Utilities::FileHandling::WriteStringToFile(welspecs.GetPartString(), output_dir+"/include/welspecs.in");
+    else Utilities::FileHandling::WriteStringToFile(welspecs, output_dir+"/include/welspecs.in");
 
     if (!Utilities::FileHandling::FileExists(output_dir+"/include/compdat.in"))
         throw std::runtime_error("Unable to find include/compdat.in file to write to.");
-    else Utilities::FileHandling::WriteStringToFile(compdat.GetPartString(), output_dir+"/include/compdat.in");
+    else Utilities::FileHandling::WriteStringToFile(compdat, output_dir+"/include/compdat.in");
 
     if (!Utilities::FileHandling::FileExists(output_dir+"/include/controls.in"))
         throw std::runtime_error("Unable to find include/controls.in file to write to.");
@@ -33,7 +33,7 @@ void FlowDriverFileWriter::WriteDriverFile(QString output_dir) {
 }
 
 QString FlowDriverFileWriter::GetCompdatString() {
-    return ECLDriverParts::Compdat(model_->wells()).GetPartString();
+    return schedule_cache_.GetCompdat(model_->wells());
 }
 
 }
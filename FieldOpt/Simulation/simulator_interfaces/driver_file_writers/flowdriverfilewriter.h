@@ -4,6 +4,7 @@
 #include "Settings/settings.h"
 #include "Settings/simulator.h"
 #include "Model/model.h"
+#include "driver_parts/ecl_driver_parts/schedule_cache.h"
 
 namespace Simulation {
 class FlowSimulator;
@@ -20,6 +21,7 @@ class FlowDriverFileWriter {
   Model::Model *model_;
   ::Settings::Settings *settings_;
   QString output_driver_file_name_; //!< Path to the driver file to be written.
+  ECLDriverParts::ScheduleCache schedule_cache_; //!< WELSPECS and COMPDAT entries from the previous evaluations.
   QString GetCompdatString();
 };
 }
@@ -0,0 +1,263 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#include "ecl_restart_cache.h"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+namespace Simulation {
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+/*!
+ * Get the keyword on a deck line: the first token if the line starts with an
+ * upper case letter (keywords start in the first column); otherwise an empty string.
+ */
+std::string keywordOnLine(const std::string &line) {
+    if (line.empty() || line[0] < 'A' || line[0] > 'Z') return "";
+    size_t end = line.find_first_of(" \t\r/");
+    return line.substr(0, end);
+}
+
+std::vector<std::string> splitLines(const std::string &text) {
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line)) lines.push_back(line);
+    return lines;
+}
+
+/*!
+ * Find the line of a section header.
+ * @return The line index; -1 if not found.
+ */
+int findSection(const std::vector<std::string> &lines, const std::string &section, int from = 0) {
+    for (int i = from; i < (int)lines.size(); ++i) {
+        if (keywordOnLine(lines[i]) == section) return i;
+    }
+    return -1;
+}
+
+bool isSectionHeader(const std::string &keyword) {
+    static const std::vector<std::string> sections = {"RUNSPEC", "GRID", "EDIT", "PROPS", "REGIONS",
+                                                      "SOLUTION", "SUMMARY", "SCHEDULE", "END"};
+    return std::find(sections.begin(), sections.end(), keyword) != sections.end();
+}
+
+/*!
+ * Find the end (exclusive) of the section starting at the given header line.
+ */
+int sectionEnd(const std::vector<std::string> &lines, int header) {
+    for (int i = header + 1; i < (int)lines.size(); ++i) {
+        if (isSectionHeader(keywordOnLine(lines[i]))) return i;
+    }
+    return (int)lines.size();
+}
+
+bool sectionHasKeyword(const std::vector<std::string> &lines, int header, const std::string &keyword) {
+    for (int i = header + 1; i < sectionEnd(lines, header); ++i) {
+        if (keywordOnLine(lines[i]) == keyword) return true;
+    }
+    return false;
+}
+
+int countOccurrences(const std::string &text, const std::string &pattern) {
+    int count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+}
+
+EclRestartCache::EclRestartCache(const std::string &output_dir, const std::string &deck_name, int max_entries)
+{
+    output_dir_ = output_dir;
+    deck_name_ = deck_name;
+    max_entries_ = std::max(1, max_entries);
+    next_id_ = 1;
+    clock_ = 0;
+}
+
+bool EclRestartCache::FindRestart(const std::vector<std::string> &time_entries, Restart &restart)
+{
+    if (!HasOneReportStepPerEntry(time_entries)) return false;
+
+    // At least one report step must remain to be simulated after the restart
+    int max_step = (int)time_entries.size() - 2;
+    Entry *best = nullptr;
+    int best_step = 0;
+    for (auto &entry : entries_) {
+        int common = 0;
+        while (common < (int)std::min(entry.time_entries.size(), time_entries.size())
+            && entry.time_entries[common] == time_entries[common]) {
+            common++;
+        }
+        int step = std::min(common, std::min(max_step, (int)entry.time_entries.size() - 1));
+        if (step < 1 || step < entry.first_step) continue;
+        if (step > best_step || (step == best_step && entry.last_used > best->last_used)) {
+            best = &entry;
+            best_step = step;
+        }
+    }
+    if (best == nullptr) return false;
+
+    best->last_used = ++clock_;
+    restart.entry = best->id;
+    restart.step = best_step;
+    restart.root = "../" + fs::path(entryDirectory(best->id)).filename().string() + "/" + deck_name_;
+    return true;
+}
+
+bool EclRestartCache::Add(const std::string &case_root,
+                          const std::vector<std::string> &time_entries,
+                          const Restart *restart)
+{
+    if (time_entries.size() < 2 || !HasOneReportStepPerEntry(time_entries)) return false;
+    for (std::string suffix : {".UNRST", ".SMSPEC", ".UNSMRY"}) {
+        if (!fs::exists(case_root + suffix)) return false;
+    }
+
+    if (!evict(restart == nullptr ? -1 : restart->entry)) return false;
+    Entry entry;
+    entry.id = next_id_++;
+    entry.time_entries = time_entries;
+    entry.first_step = restart == nullptr ? 1 : restart->step + 1;
+    entry.parent = restart == nullptr ? -1 : restart->entry;
+    entry.last_used = ++clock_;
+
+    std::string dir = entryDirectory(entry.id);
+    try {
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+        for (std::string suffix : {".UNRST", ".SMSPEC", ".UNSMRY"}) {
+            fs::copy_file(case_root + suffix, dir + "/" + deck_name_ + suffix, fs::copy_option::overwrite_if_exists);
+        }
+    }
+    catch (fs::filesystem_error &e) {
+        fs::remove_all(dir);
+        return false;
+    }
+    entries_.push_back(entry);
+    return true;
+}
+
+bool EclRestartCache::SupportsRestarts(const std::string &deck, const std::string &schedule_file, std::string &reason)
+{
+    auto lines = splitLines(deck);
+    int runspec = findSection(lines, "RUNSPEC");
+    int solution = findSection(lines, "SOLUTION");
+    int schedule = findSection(lines, "SCHEDULE");
+    if (runspec < 0 || solution < 0 || schedule < 0) {
+        reason = "The RUNSPEC, SOLUTION and SCHEDULE sections must be in the main deck file.";
+        return false;
+    }
+    if (!sectionHasKeyword(lines, runspec, "UNIFOUT")) {
+        reason = "The deck must use unified output (UNIFOUT).";
+        return false;
+    }
+    // Time may not be advanced before the generated schedule is included
+    for (int i = schedule + 1; i < sectionEnd(lines, schedule); ++i) {
+        if (lines[i].find(schedule_file) != std::string::npos && lines[i].find("--") != 0)
+            return true;
+        std::string keyword = keywordOnLine(lines[i]);
+        if (keyword == "TSTEP" || keyword == "DATES") {
+            reason = "The SCHEDULE section must not advance time before the schedule file is included.";
+            return false;
+        }
+    }
+    reason = "The schedule file must be included in the SCHEDULE section of the main deck file.";
+    return false;
+}
+
+std::string EclRestartCache::RestartDeck(const std::string &deck, const Restart &restart)
+{
+    auto lines = splitLines(deck);
+    int runspec = findSection(lines, "RUNSPEC");
+    bool has_unifin = sectionHasKeyword(lines, runspec, "UNIFIN");
+
+    std::ostringstream out;
+    for (int i = 0; i < (int)lines.size(); ++i) {
+        std::string keyword = keywordOnLine(lines[i]);
+        out << lines[i] << "\n";
+        if (keyword == "RUNSPEC" && !has_unifin) {
+            out << "UNIFIN\n\n";
+        }
+        else if (keyword == "SOLUTION") {
+            out << "RESTART\n '" << restart.root << "' " << restart.step << " /\n\n";
+            out << RestartOutputKeyword();
+            i = sectionEnd(lines, i) - 1; // Skip the original initialization
+        }
+        else if (keyword == "SCHEDULE") {
+            out << "SKIPREST\n\n";
+        }
+    }
+    return out.str();
+}
+
+bool EclRestartCache::HasOneReportStepPerEntry(const std::vector<std::string> &time_entries)
+{
+    if (time_entries.empty()) return false;
+    for (int i = 0; i < (int)time_entries.size(); ++i) {
+        const std::string &entry = time_entries[i];
+        if (countOccurrences(entry, "DATES") > 0) return false;
+        int expected = i + 1 < (int)time_entries.size() ? 1 : 0;
+        if (countOccurrences(entry, "TSTEP") != expected) return false;
+        if (expected == 1) {
+            // The TSTEP record must hold a single step
+            std::istringstream record(entry.substr(entry.find("TSTEP") + 5));
+            std::string token;
+            int tokens = 0;
+            while (record >> token && token != "/") {
+                if (token.find('*') != std::string::npos) return false;
+                tokens++;
+            }
+            if (tokens != 1) return false;
+        }
+    }
+    return true;
+}
+
+std::string EclRestartCache::entryDirectory(int id) const
+{
+    char name[16];
+    std::snprintf(name, sizeof(name), "RST_C%04d", id);
+    return output_dir_ + "/" + name;
+}
+
+bool EclRestartCache::evict(int keep)
+{
+    while ((int)entries_.size() >= max_entries_) {
+        auto victim = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            bool is_parent = std::any_of(entries_.begin(), entries_.end(),
+                                         [&it](const Entry &e) { return e.parent == it->id; });
+            if (!is_parent && it->id != keep && (victim == entries_.end() || it->last_used < victim->last_used))
+                victim = it;
+        }
+        if (victim == entries_.end()) return false;
+        fs::remove_all(entryDirectory(victim->id));
+        entries_.erase(victim);
+    }
+    return true;
+}
+
+}
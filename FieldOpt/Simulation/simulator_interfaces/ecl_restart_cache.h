@@ -0,0 +1,137 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#ifndef ECL_RESTART_CACHE_H
+#define ECL_RESTART_CACHE_H
+
+#include <string>
+#include <vector>
+
+namespace Simulation {
+
+/*!
+ * \brief The EclRestartCache class keeps the restart files of previously simulated
+ * cases, so that new cases sharing the first control intervals with one of them can
+ * be simulated from a restart instead of from time zero.
+ *
+ * The schedule of a case is described by its time entries (see
+ * ECLDriverParts::Schedule::GetTimeEntryStrings): the keywords written at each control
+ * time, followed by the time step to the next. Each entry except the last must advance
+ * exactly one report step, so that report step j is control time j. If the first j
+ * entries of a new case are identical to those of a cached case, the state at report
+ * step j is identical as well, and the new case can be restarted from it.
+ *
+ * Each cache entry is a directory RST_C<id> next to the simulation work directory,
+ * holding copies of the case's UNRST, SMSPEC and UNSMRY files. Restart decks refer to
+ * the entry as ../RST_C<id>/<deck name>, which is valid both from the work directory
+ * and from other cache entries. A case simulated from a restart therefore gets an
+ * SMSPEC that points to its parent entry, and ERT splices the parent's summary prefix
+ * with the new tail when the results are read. Entries that are the parent of another
+ * entry are never evicted; among the others the least recently used is evicted when
+ * the cache is full.
+ *
+ * Restart decks are generated from the original deck by adding UNIFIN to RUNSPEC,
+ * replacing the SOLUTION section with RESTART (and RPTRST, so that the restarted run
+ * writes restart files too), and adding SKIPREST to SCHEDULE. This requires unified
+ * output (UNIFOUT), the section keywords being in the main deck file, and time not
+ * being advanced in the SCHEDULE section before the generated schedule is included.
+ */
+class EclRestartCache {
+ public:
+  /*!
+   * \brief A restart point for a new case.
+   */
+  struct Restart {
+    int entry = -1; //!< Id of the cache entry to restart from.
+    int step = 0; //!< Report step to restart from.
+    std::string root; //!< Root name of the restart files, relative to the work directory.
+  };
+
+  /*!
+   * \param output_dir Directory holding the simulation work directory; the cache entries are created here.
+   * \param deck_name Name of the deck, without the .DATA suffix.
+   * \param max_entries Maximum number of cases to keep restart files for.
+   */
+  EclRestartCache(const std::string &output_dir, const std::string &deck_name, int max_entries);
+
+  /*!
+   * \brief FindRestart Find the latest report step at which the given schedule can be
+   * restarted from a cached case.
+   * \param time_entries Schedule time entries of the new case.
+   * \param restart Set to the restart point if one is found.
+   * \return True if a restart point at report step 1 or later was found.
+   */
+  bool FindRestart(const std::vector<std::string> &time_entries, Restart &restart);
+
+  /*!
+   * \brief Add Copy the restart and summary files of a simulated case into the cache.
+   * \param case_root Path to the simulated deck, without the .DATA suffix.
+   * \param time_entries Schedule time entries of the case.
+   * \param restart The restart point the case was simulated from; null if it was simulated from time zero.
+   * \return True if the case was added; false if its files were not found, or the
+   * cache is full of entries that other entries were restarted from.
+   */
+  bool Add(const std::string &case_root, const std::vector<std::string> &time_entries, const Restart *restart);
+
+  int size() const { return (int)entries_.size(); }
+
+  /*!
+   * \brief SupportsRestarts Check whether restart decks can be generated from a deck.
+   * \param deck Contents of the main deck file.
+   * \param schedule_file Name of the schedule file included in the deck.
+   * \param reason Set to the reason if restarts are not supported.
+   */
+  static bool SupportsRestarts(const std::string &deck, const std::string &schedule_file, std::string &reason);
+
+  /*!
+   * \brief RestartDeck Generate a deck restarting from the given restart point.
+   * \param deck Contents of the original main deck file.
+   */
+  static std::string RestartDeck(const std::string &deck, const Restart &restart);
+
+  /*!
+   * \brief RestartOutputKeyword The RPTRST keyword making the simulator write a restart at every report step.
+   */
+  static std::string RestartOutputKeyword() { return "RPTRST\n 'BASIC=2' /\n\n"; }
+
+  /*!
+   * \brief HasOneReportStepPerEntry Check that each time entry except the last advances exactly one report step.
+   */
+  static bool HasOneReportStepPerEntry(const std::vector<std::string> &time_entries);
+
+ private:
+  struct Entry {
+    int id;
+    std::vector<std::string> time_entries;
+    int first_step; //!< First report step in the entry's restart file.
+    int parent; //!< Id of the entry this one was restarted from; -1 if none.
+    long last_used;
+  };
+
+  std::string output_dir_;
+  std::string deck_name_;
+  int max_entries_;
+  int next_id_;
+  long clock_; //!< Counter used to order entries by last use.
+  std::vector<Entry> entries_;
+
+  std::string entryDirectory(int id) const;
+  bool evict(int keep); //!< Evict entries, except keep, until there is room for a new one.
+};
+
+}
+
+#endif // ECL_RESTART_CACHE_H
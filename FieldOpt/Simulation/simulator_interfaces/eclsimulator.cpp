@@ -17,6 +17,8 @@
    along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
 ******************************************************************************/
 #include <iostream>
+#include <fstream>
+#include <iterator>
 #include <boost/algorithm/string.hpp>
 #include <Utilities/printer.hpp>
 #include <Utilities/verbosity.h>
@@ -42,6 +44,12 @@ ECLSimulator::ECLSimulator(Settings::Settings *settings, Model::Model *model)
     }
 
     results_ = new Results::ECLResults();
+    driver_file_writer_ = new EclDriverFileWriter(settings_, model_);
+    restart_cache_ = nullptr;
+    restarted_ = false;
+    if (settings->simulator()->restart_cache()) {
+        initializeRestartCache();
+    }
 }
 
 void ECLSimulator::Evaluate()
@@ -52,17 +60,19 @@ void ECLSimulator::Evaluate()
     if (VERB_SIM >= 2) { Printer::info("Updating file paths."); }
     UpdateFilePaths();
     script_args_ = (QStringList() << QString::fromStdString(paths_.GetPath(Paths::SIM_WORK_DIR)) << deck_name_);
-    auto driver_file_writer = EclDriverFileWriter(settings_, model_);
+    driver_file_writer_->SetWriteRestarts(restart_cache_ != nullptr);
     if (VERB_SIM >= 2) { Printer::info("Writing schedule."); }
-    driver_file_writer.WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_SCH_FILE)));
+    driver_file_writer_->WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_SCH_FILE)));
+    writeDeck(*driver_file_writer_);
     if (VERB_SIM >= 2) { Printer::info("Starting unmonitored simulation."); }
-    Utilities::Unix::ExecShellScript(
+    last_run_ = ::Utilities::Unix::RunShellScript(
         QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)),
         script_args_
     );
     if (VERB_SIM >= 2) { Printer::info("Unmonitored simulation done. Reading results."); }
     PostSimWork();
     results_->ReadResults(QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_DRIVER_FILE)));
+    cacheRestartFiles();
     updateResultsInModel();
 }
 
@@ -70,25 +80,26 @@ bool ECLSimulator::Evaluate(int timeout, int threads) {
     copyDriverFiles();
     UpdateFilePaths();
     script_args_ = (QStringList() << QString::fromStdString(paths_.GetPath(Paths::SIM_WORK_DIR)) << deck_name_ << QString::number(threads));
-    auto driver_file_writer = EclDriverFileWriter(settings_, model_);
-    driver_file_writer.WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_SCH_FILE)));
+    driver_file_writer_->SetWriteRestarts(restart_cache_ != nullptr);
+    driver_file_writer_->WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_SCH_FILE)));
+    writeDeck(*driver_file_writer_);
     int t = timeout;
-    if (timeout < 10) {
+    if (timeout > 0 && timeout < 10) {
         t = 10; // Always let simulations run for at least 10 seconds
     }
 
     if (VERB_SIM >= 2) {
         Printer::info("Starting monitored simulation with timeout.");
     }
-    bool success = ::Utilities::Unix::ExecShellScriptTimeout(
-        QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)),
-        script_args_, t);
+    runExecutionScript(t, QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_DRIVER_FILE)));
+    bool success = !last_run_.timed_out && !last_run_.killed;
     if (VERB_SIM >= 2) Printer::info("Monitored simulation done.");
     if (success) {
         if (VERB_SIM >= 2) Printer::info("Simulation successful. Reading results.");
         PostSimWork();
         results_->DumpResults();
         results_->ReadResults(QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_DRIVER_FILE)));
+        cacheRestartFiles();
     }
     updateResultsInModel();
     return success;
@@ -129,8 +140,48 @@ void ECLSimulator::UpdateFilePaths()
 
 void ECLSimulator::WriteDriverFilesOnly() {
     UpdateFilePaths();
-    auto driver_file_writer = EclDriverFileWriter(settings_, model_);
-    driver_file_writer.WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_SCH_FILE)));
+    driver_file_writer_->SetWriteRestarts(false);
+    driver_file_writer_->WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_SCH_FILE)));
+    if (restart_cache_ != nullptr && DirectoryExists(paths_.GetPath(Paths::SIM_WORK_DIR))) {
+        // The work directory may hold a restart deck from the last evaluation
+        WriteStringToFile(QString::fromStdString(original_deck_),
+                          QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_DRIVER_FILE)));
+    }
+}
+
+void ECLSimulator::initializeRestartCache() {
+    std::ifstream deck_file(paths_.GetPath(Paths::SIM_DRIVER_FILE));
+    original_deck_ = std::string(std::istreambuf_iterator<char>(deck_file), std::istreambuf_iterator<char>());
+    std::string reason;
+    if (!EclRestartCache::SupportsRestarts(original_deck_, FileName(paths_.GetPath(Paths::SIM_SCH_FILE)), reason)) {
+        Printer::ext_warn("Restart cache disabled: " + reason, "Simulation", "ECLSimulator");
+        return;
+    }
+    restart_cache_ = new EclRestartCache(paths_.GetPath(Paths::OUTPUT_DIR), deck_name_.toStdString(),
+                                         settings_->simulator()->restart_cache_size());
+}
+
+void ECLSimulator::writeDeck(const EclDriverFileWriter &driver_file_writer) {
+    if (restart_cache_ == nullptr) return;
+    time_entries_ = driver_file_writer.time_entries();
+    restarted_ = restart_cache_->FindRestart(time_entries_, restart_);
+    std::string deck = original_deck_;
+    if (restarted_) {
+        if (VERB_SIM >= 2) {
+            Printer::ext_info("Restarting from report step " + Printer::num2str(restart_.step)
+                                  + " of " + restart_.root + ".", "Simulation", "ECLSimulator");
+        }
+        deck = EclRestartCache::RestartDeck(original_deck_, restart_);
+    }
+    WriteStringToFile(QString::fromStdString(deck), QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_DRIVER_FILE)));
+}
+
+void ECLSimulator::cacheRestartFiles() {
+    if (restart_cache_ == nullptr) return;
+    std::string case_root = QString::fromStdString(paths_.GetPath(Paths::SIM_OUT_DRIVER_FILE)).split(".DATA").first().toStdString();
+    if (!restart_cache_->Add(case_root, time_entries_, restarted_ ? &restart_ : nullptr) && VERB_SIM >= 2) {
+        Printer::ext_warn("Unable to add case to the restart cache.", "Simulation", "ECLSimulator");
+    }
 }
 
 void ECLSimulator::copyDriverFiles() {
@@ -138,21 +189,21 @@ void ECLSimulator::copyDriverFiles() {
 
     if (!DirectoryExists(workdir)) {
         if (VERB_SIM >= 1) {
-            Printer::ext_info("Output deck directory not found. Copying input deck:"
+            Printer::ext_info("Output deck directory not found. Provisioning input deck:"
             + paths_.GetPath(Paths::SIM_DRIVER_DIR) + " -> " + workdir, "Simulation", "ECLSimulator" );
         }
         CreateDirectory(workdir);
-        CopyDirectory(paths_.GetPath(Paths::SIM_DRIVER_DIR), workdir, false);
+        provisionDirectory(paths_.GetPath(Paths::SIM_DRIVER_DIR), workdir, false);
     }
     if (paths_.IsSet(Paths::SIM_AUX_DIR)) {
         std::string auxdir = paths_.GetPath(Paths::OUTPUT_DIR) + "/" + FileName(paths_.GetPath(Paths::SIM_AUX_DIR));
         if (!DirectoryExists(auxdir)) {
             if (VERB_SIM >= 1) {
-                Printer::ext_info("Copying simulation aux. directory:"
+                Printer::ext_info("Provisioning simulation aux. directory:"
                                       + paths_.GetPath(Paths::SIM_AUX_DIR) + " -> " + auxdir, "Simulation", "Simulator" );
             }
             CreateDirectory(auxdir);
-            CopyDirectory(paths_.GetPath(Paths::SIM_AUX_DIR), auxdir, false);
+            provisionDirectory(paths_.GetPath(Paths::SIM_AUX_DIR), auxdir, false);
         }
     }
     paths_.SetPath(Paths::SIM_WORK_DIR, workdir);
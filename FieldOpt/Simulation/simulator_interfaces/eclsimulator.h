@@ -21,6 +21,7 @@
 
 #include "simulator.h"
 #include "driver_file_writers/ecldriverfilewriter.h"
+#include "ecl_restart_cache.h"
 #include "Model/model.h"
 #include <QStringList>
 
@@ -40,6 +41,11 @@ namespace Simulation {
  *  sim.CleanUp();
  * \endcode
  *
+ * When the RestartCache simulator setting is enabled, the restart files of simulated cases
+ * are kept in an EclRestartCache, and cases sharing the first control intervals with a
+ * kept case are simulated from a restart deck. The summary of such a case refers to the
+ * restart case it was started from, and is spliced with it by ERT when the results are read.
+ *
  * \todo Support custom execution commands.
  */
 class ECLSimulator : public Simulator
@@ -66,6 +72,27 @@ class ECLSimulator : public Simulator
   Settings::Settings *settings_;
   void copyDriverFiles();
 
+  EclDriverFileWriter *driver_file_writer_; //!< Kept between evaluations, as it caches the schedule entries of the wells.
+  EclRestartCache *restart_cache_; //!< Null unless the restart cache is enabled and supported by the deck.
+  std::string original_deck_; //!< Contents of the original deck; used to generate restart decks.
+  std::vector<std::string> time_entries_; //!< Schedule time entries of the current case.
+  bool restarted_; //!< Whether the current case is simulated from a restart.
+  EclRestartCache::Restart restart_; //!< The restart point of the current case, if restarted_.
+
+  void initializeRestartCache();
+
+  /*!
+   * \brief writeDeck Write the deck for the current case to the work directory: a restart
+   * deck if the restart cache holds a restart for the schedule just written, otherwise the
+   * original deck. Does nothing when the restart cache is disabled.
+   */
+  void writeDeck(const EclDriverFileWriter &driver_file_writer);
+
+  /*!
+   * \brief cacheRestartFiles Add the output of the current case to the restart cache.
+   */
+  void cacheRestartFiles();
+
   // Simulator interface
  protected:
   void UpdateFilePaths() override;
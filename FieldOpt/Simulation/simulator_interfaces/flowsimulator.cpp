@@ -45,7 +45,7 @@ void FlowSimulator::Evaluate() {
     if (results_->isAvailable()) results_->DumpResults();
     copyDriverFiles();
     driver_file_writer_->WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_WORK_DIR )));
-    ::Utilities::Unix::ExecShellScript(QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)), script_args_);
+    last_run_ = ::Utilities::Unix::RunShellScript(QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)), script_args_);
     results_->ReadResults(driver_file_writer_->output_driver_file_name_);
 }
 
@@ -74,11 +74,11 @@ void FlowSimulator::copyDriverFiles() {
     auto workdir = paths_.GetPath(Paths::OUTPUT_DIR) + driver_parent_dir_name_.toStdString();
     if (!DirectoryExists(workdir)) {
         if (VERB_SIM >= 1) {
-            Printer::ext_info("Output deck directory not found. Copying input deck:"
+            Printer::ext_info("Output deck directory not found. Provisioning input deck:"
                                   + paths_.GetPath(Paths::SIM_DRIVER_DIR) + " -> " + workdir, "Simulation", "FlowSimulator" );
         }
         CreateDirectory(workdir);
-        CopyDirectory(paths_.GetPath(Paths::SIM_DRIVER_DIR), workdir, true);
+        provisionDirectory(paths_.GetPath(Paths::SIM_DRIVER_DIR), workdir, true);
     }
     paths_.SetPath(Paths::SIM_WORK_DIR, workdir);
 }
@@ -93,14 +93,13 @@ void FlowSimulator::UpdateFilePaths()
 bool FlowSimulator::Evaluate(int timeout, int threads) {
     int t = timeout;
     script_args_[2] = QString::number(threads);
-    if (timeout < 10) t = 10; // Always let simulations run for at least 10 seconds
+    if (timeout > 0 && timeout < 10) t = 10; // Always let simulations run for at least 10 seconds
     if (results_->isAvailable()) results()->DumpResults();
     copyDriverFiles();
     driver_file_writer_->WriteDriverFile(QString::fromStdString(paths_.GetPath(Paths::SIM_WORK_DIR)));
     std::cout << "Starting monitored simulation with timeout " << timeout << std::endl;
-    bool success = ::Utilities::Unix::ExecShellScriptTimeout(
-        QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)),
-        script_args_, t);
+    runExecutionScript(t, driver_file_writer_->output_driver_file_name_);
+    bool success = !last_run_.timed_out && !last_run_.killed;
     if (success) {
         results_->ReadResults(driver_file_writer_->output_driver_file_name_);
     }
@@ -46,7 +46,7 @@ void IXSimulator::Evaluate() {
     auto driver_file_writer = IXDriverFileWriter(model_);
     driver_file_writer.WriteDriverFile(paths_.GetPath(Paths::SIM_OUT_SCH_FILE));
     if (VERB_SIM >= 1) { Printer::ext_info("Starting unmonitored evaluation.", "Simulation", "IXSimulator"); }
-    Utilities::Unix::ExecShellScript(
+    last_run_ = ::Utilities::Unix::RunShellScript(
         QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)),
         script_args_
     );
@@ -66,14 +66,15 @@ bool IXSimulator::Evaluate(int timeout, int threads) {
     auto driver_file_writer = IXDriverFileWriter(model_);
     driver_file_writer.WriteDriverFile(paths_.GetPath(Paths::SIM_OUT_SCH_FILE));
     int t = timeout;
-    if (timeout < 10) {
+    if (timeout > 0 && timeout < 10) {
         t = 10; // Always let simulations run for at least 10 seconds
     }
 
     if (VERB_SIM >= 1) { Printer::info("Starting monitored simulation with timeout."); }
-    bool success = ::Utilities::Unix::ExecShellScriptTimeout(
+    last_run_ = ::Utilities::Unix::RunShellScript(
         QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE)),
         script_args_, t);
+    bool success = !last_run_.timed_out;
     if (success) {
         results_->DumpResults();
         if (result_path_.size() == 0) {
@@ -114,22 +115,22 @@ void IXSimulator::copyDriverFiles() {
 
     if (!DirectoryExists(workdir)) {
         if (VERB_SIM >= 1) {
-            Printer::ext_info("Output deck directory not found. Copying input deck:"
+            Printer::ext_info("Output deck directory not found. Provisioning input deck:"
                                   + paths_.GetPath(Paths::SIM_DRIVER_DIR) + " -> " + workdir,
                                   "Simulation", "IXSimulator" );
         }
         CreateDirectory(workdir);
-        CopyDirectory(paths_.GetPath(Paths::SIM_DRIVER_DIR), workdir, false);
+        provisionDirectory(paths_.GetPath(Paths::SIM_DRIVER_DIR), workdir, false);
         if (paths_.IsSet(Paths::SIM_AUX_DIR)) {
             std::string auxdir = paths_.GetPath(Paths::OUTPUT_DIR) + "/" + FileName(paths_.GetPath(Paths::SIM_AUX_DIR));
             if (!DirectoryExists(auxdir)) {
                 if (VERB_SIM >= 1) {
-                    Printer::ext_info("Copying simulation aux. directory:"
+                    Printer::ext_info("Provisioning simulation aux. directory:"
                                           + paths_.GetPath(Paths::SIM_AUX_DIR) + " -> " + auxdir,
                                           "Simulation", "IXSimulator" );
                 }
                 CreateDirectory(auxdir);
-                CopyDirectory(paths_.GetPath(Paths::SIM_AUX_DIR), auxdir, false);
+                provisionDirectory(paths_.GetPath(Paths::SIM_AUX_DIR), auxdir, false);
             }
         }
     }
@@ -0,0 +1,164 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#include "simulation_monitor.h"
+#include "Utilities/filehandling.hpp"
+#include "Utilities/printer.hpp"
+#include "Utilities/verbosity.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace Simulation {
+
+using namespace Utilities::FileHandling;
+
+SimulationMonitor::SimulationMonitor(Settings::Simulator *settings, bool maximize)
+{
+    maximize_ = maximize;
+    margin_ = settings->early_termination_margin();
+    min_fraction_ = settings->early_termination_min_fraction();
+    max_conv_failures_ = settings->early_termination_max_conv_failures();
+    interval_ = std::max(1, settings->monitor_interval());
+    partial_results_ = new Results::ECLResults();
+    snapshot_ = nullptr;
+    Start("", 0);
+}
+
+SimulationMonitor::~SimulationMonitor()
+{
+    delete snapshot_;
+    delete partial_results_;
+}
+
+void SimulationMonitor::Start(const std::string &case_path, double end_time)
+{
+    delete snapshot_;
+    snapshot_ = nullptr;
+    partial_results_->DumpResults();
+    if (!case_path.empty()) {
+        std::string snapshot_dir = GetParentDirectoryPath(case_path) + "/FO_MONITOR";
+        if (!DirectoryExists(snapshot_dir)) CreateDirectory(snapshot_dir);
+        snapshot_ = new ERTWrapper::ECLSummary::ECLSummarySnapshot(case_path, snapshot_dir);
+        std::string base = case_path;
+        if (base.size() > 5 && base.substr(base.size() - 5) == ".DATA")
+            base = base.substr(0, base.size() - 5);
+        prt_path_ = base + ".PRT";
+    }
+    prt_offset_ = 0;
+    conv_failures_ = 0;
+    end_time_ = end_time;
+    times_.clear();
+    values_.clear();
+    best_rate_ = 0.0;
+    bound_ = std::numeric_limits<double>::quiet_NaN();
+    verdict_ = CONTINUE;
+}
+
+bool SimulationMonitor::Check()
+{
+    if (verdict_ != CONTINUE) return true;
+    if (snapshot_ == nullptr) return false;
+
+    if (max_conv_failures_ > 0) {
+        conv_failures_ += countNewConvergenceFailures();
+        if (conv_failures_ >= max_conv_failures_) {
+            verdict_ = CONVERGENCE_FAILURE;
+            if (VERB_SIM >= 1) Printer::ext_info("Simulator reported " + Printer::num2str(conv_failures_)
+                                                     + " convergence failures. Terminating simulation.",
+                                                 "Simulation", "SimulationMonitor");
+            return true;
+        }
+    }
+
+    if (objective_ && checkBound()) {
+        verdict_ = BOUND_EXCEEDED;
+        if (VERB_SIM >= 1) Printer::ext_info("Objective bound " + Printer::num2str(bound_) + " at t="
+                                                 + Printer::num2str(times_.back()) + " of " + Printer::num2str(end_time_)
+                                                 + " days can not beat reference. Terminating simulation.",
+                                             "Simulation", "SimulationMonitor");
+        return true;
+    }
+    return false;
+}
+
+bool SimulationMonitor::checkBound()
+{
+    if (!snapshot_->Update() || !snapshot_->IsReadable())
+        return false;
+
+    double t, v;
+    try {
+        partial_results_->ReadResults(QString::fromStdString(snapshot_->snapshot_path()));
+        t = partial_results_->GetValueVector(Results::Results::Time).back();
+        v = objective_();
+    }
+    catch (std::exception &e) {
+        if (VERB_SIM >= 2) Printer::ext_warn("Unable to read partial results: " + std::string(e.what()),
+                                             "Simulation", "SimulationMonitor");
+        return false;
+    }
+    if (!times_.empty() && t <= times_.back()) return false;
+    if (!times_.empty()) {
+        double rate = (v - values_.back()) / (t - times_.back());
+        best_rate_ = maximize_ ? std::max(best_rate_, rate) : std::min(best_rate_, rate);
+    }
+    times_.push_back(t);
+    values_.push_back(v);
+    if (times_.size() < 2 || t < min_fraction_ * end_time_)
+        return false;
+
+    bound_ = v + best_rate_ * std::max(0.0, end_time_ - t);
+    double reference = reference_ ? reference_() : std::numeric_limits<double>::quiet_NaN();
+    if (std::isnan(reference))
+        return false;
+    if (maximize_)
+        return bound_ < reference - margin_ * std::fabs(reference);
+    else
+        return bound_ > reference + margin_ * std::fabs(reference);
+}
+
+int SimulationMonitor::countNewConvergenceFailures()
+{
+    std::ifstream prt(prt_path_, std::ios::binary);
+    if (!prt.good()) return 0;
+    prt.seekg(0, std::ios::end);
+    long size = prt.tellg();
+    if (size < prt_offset_) prt_offset_ = 0; // The simulator has started over
+    if (size == prt_offset_) return 0;
+
+    std::string text(size - prt_offset_, '\0');
+    prt.seekg(prt_offset_);
+    prt.read(&text[0], text.size());
+
+    // Only scan complete lines; the rest is scanned in the next check
+    size_t end = text.rfind('\n');
+    if (end == std::string::npos) return 0;
+    text.resize(end + 1);
+    prt_offset_ += text.size();
+
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    int count = 0;
+    const std::string pattern = "convergence failure";
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size())) {
+        count++;
+    }
+    return count;
+}
+
+}
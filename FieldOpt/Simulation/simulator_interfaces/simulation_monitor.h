@@ -0,0 +1,139 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#ifndef SIMULATION_MONITOR_H
+#define SIMULATION_MONITOR_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "Settings/simulator.h"
+#include "Simulation/results/eclresults.h"
+#include "ERTWrapper/eclsummarysnapshot.h"
+
+namespace Simulation {
+
+/*!
+ * \brief The SimulationMonitor class watches the output of a running ECLIPSE/Flow
+ * simulation, and decides whether it should be terminated early.
+ *
+ * A simulation is terminated when either
+ *  - the simulator has reported EarlyTerminationMaxConvergenceFailures convergence
+ *    failures in its PRT file; or
+ *  - an optimistic bound on the final objective value is worse than the reference
+ *    (the best objective found so far) by more than EarlyTerminationMargin (relative).
+ *
+ * The bound is computed from the objective evaluated on the partial summary (read
+ * through an ERTWrapper::ECLSummary::ECLSummarySnapshot): the objective at the
+ * current simulated time t, plus the highest rate of increase seen between two
+ * checks, continued until the end of the schedule T:
+ *
+ *   bound = v(t) + max(0, max_k dv_k/dt_k) * (T - t)     (mirrored when minimizing)
+ *
+ * This is an extrapolation, not a proof: a schedule that opens wells or raises
+ * rates late may do better than the bound. EarlyTerminationMinFraction and the
+ * margin control how aggressive the monitor is. The bound is not checked until
+ * at least EarlyTerminationMinFraction of [0, T] has been simulated. Because it is
+ * not a proof, the bound is only used to decide when to terminate; the runners
+ * give terminated cases the sentinel value, not the bound.
+ *
+ * Check is called from the thread running the simulation; the reference function
+ * must be safe to call from that thread.
+ */
+class SimulationMonitor {
+ public:
+  enum Verdict { CONTINUE, BOUND_EXCEEDED, CONVERGENCE_FAILURE };
+
+  /*!
+   * \param settings Simulator settings holding the early termination parameters.
+   * \param maximize Whether the objective is maximized.
+   */
+  SimulationMonitor(Settings::Simulator *settings, bool maximize);
+  ~SimulationMonitor();
+
+  /*!
+   * \brief partial_results Results object holding the partial summary of the running
+   * simulation. The objective set with SetObjective should read from this.
+   */
+  Results::Results *partial_results() { return partial_results_; }
+
+  /*!
+   * \brief SetObjective Set the function computing the objective from partial_results().
+   * The bound is not checked if no objective is set.
+   */
+  void SetObjective(std::function<double()> objective) { objective_ = objective; }
+
+  /*!
+   * \brief SetReference Set the function returning the objective value to beat. It
+   * should return NaN while there is no reference.
+   */
+  void SetReference(std::function<double()> reference) { reference_ = reference; }
+
+  /*!
+   * \brief Start Prepare for monitoring a new simulation.
+   * \param case_path Path to the simulation deck (the .DATA file).
+   * \param end_time Simulated time (days) at the end of the schedule.
+   */
+  void Start(const std::string &case_path, double end_time);
+
+  /*!
+   * \brief Check Read any new output from the simulation and update the verdict.
+   * \return True if the simulation should be terminated.
+   */
+  bool Check();
+
+  Verdict verdict() const { return verdict_; }
+
+  /*!
+   * \brief bound The last computed bound on the final objective value. NaN if
+   * no bound has been computed for the current simulation.
+   */
+  double bound() const { return bound_; }
+
+  /*!
+   * \brief interval Seconds between each call to Check.
+   */
+  double interval() const { return interval_; }
+
+ private:
+  bool maximize_;
+  double margin_;
+  double min_fraction_;
+  int max_conv_failures_;
+  double interval_;
+
+  std::function<double()> objective_;
+  std::function<double()> reference_;
+  Results::ECLResults *partial_results_;
+  ERTWrapper::ECLSummary::ECLSummarySnapshot *snapshot_;
+
+  std::string prt_path_;
+  long prt_offset_; //!< Position in the PRT file up to which it has been scanned.
+  int conv_failures_;
+  double end_time_;
+  std::vector<double> times_; //!< Simulated times at which the objective has been evaluated.
+  std::vector<double> values_; //!< Objective values at times_.
+  double best_rate_; //!< Most optimistic rate of change of the objective seen so far.
+  double bound_;
+  Verdict verdict_;
+
+  int countNewConvergenceFailures(); //!< Scan the new part of the PRT file.
+  bool checkBound(); //!< Evaluate the partial objective and check its bound against the reference.
+};
+
+}
+
+#endif // SIMULATION_MONITOR_H
@@ -77,6 +77,27 @@ void Simulator::PostSimWork() {
     }
 }
 
+void Simulator::runExecutionScript(int timeout, const QString &case_path) {
+    QString script = QString::fromStdString(paths_.GetPath(Paths::SIM_EXEC_SCRIPT_FILE));
+    if (monitor_ == nullptr) {
+        last_run_ = Utilities::Unix::RunShellScript(script, script_args_, timeout);
+        return;
+    }
+    monitor_->Start(case_path.toStdString(), control_times_.isEmpty() ? 0 : control_times_.last());
+    last_run_ = Utilities::Unix::RunShellScript(script, script_args_, timeout, "",
+                                                [this] { return monitor_->Check(); },
+                                                monitor_->interval());
+}
+
+void Simulator::provisionDirectory(const std::string &origin, const std::string &destination, bool verbose) {
+    if (!settings_->simulator()->link_driver_files()) {
+        CopyDirectory(origin, destination, verbose);
+        return;
+    }
+    std::string deck_prefix = driver_file_name_.split(".").first().toStdString();
+    ProvisionDirectory(origin, destination, {deck_prefix}, verbose);
+}
+
 void Simulator::SetVerbosityLevel(int level) {
     verbosity_level_ = level;
 }
@@ -26,6 +26,8 @@
 #include "Settings/simulator.h"
 #include "Simulation/execution_scripts/execution_scripts.h"
 #include "Settings/ensemble.h"
+#include "Utilities/process_supervisor.hpp"
+#include "simulation_monitor.h"
 
 namespace Simulation {
 
@@ -57,7 +59,7 @@ class Simulator {
   /*!
    * \brief Evaluate Writes the driver file and executes a simulation of the model. The simulation
    * is terminated after the amount of seconds provided in the timeout argument.
-   * @param timeout Number of seconds before the simulation should be terminated.
+   * @param timeout Number of seconds before the simulation should be terminated. No timeout if <= 0.
    * @param threads Number of threads to be used by the simulator. Only works for AD-GPRS.
    * @return True if the simuation completes before the set timeout, otherwise false.
    */
@@ -92,6 +94,25 @@ class Simulator {
 
   void SetVerbosityLevel(int level);
 
+  /*!
+   * @brief Get the exit status and wall/CPU time of the last simulation run by
+   * Evaluate. Runners should use this for simulation timing.
+   */
+  const Utilities::Unix::ProcessResult &last_run() const { return last_run_; }
+
+  /*!
+   * @brief Set the monitor used to terminate simulations early. The simulator does
+   * not take ownership. Only used by simulators that support it (ECLIPSE and Flow),
+   * in Evaluate(timeout, threads).
+   */
+  void SetMonitor(SimulationMonitor *monitor) { monitor_ = monitor; }
+  SimulationMonitor *monitor() const { return monitor_; }
+
+  /*!
+   * @brief Whether the last simulation was terminated by the monitor.
+   */
+  bool WasTerminatedEarly() const { return last_run_.killed && monitor_ != nullptr; }
+
  protected:
   /*!
    * Set various path variables. Should only be called by child classes.
@@ -111,6 +132,25 @@ class Simulator {
    */
   void PostSimWork();
 
+  /*!
+   * @brief Run the execution script with the current script arguments, and store the
+   * outcome in last_run_. If a monitor is set, it is started for the given deck and
+   * the simulation is killed when the monitor says so.
+   * @param timeout Seconds before the simulation is killed. No timeout if <= 0.
+   * @param case_path Path to the deck being simulated.
+   */
+  void runExecutionScript(int timeout, const QString &case_path);
+
+  /*!
+   * @brief Populate a work directory with the contents of an input directory. Unless the
+   * LinkDriverFiles setting is disabled, files are linked instead of copied (see
+   * Utilities::FileHandling::ProvisionDirectory); files named after the driver file are
+   * always copied.
+   * @param origin Path to the input directory.
+   * @param destination Path to the (existing) work directory.
+   */
+  void provisionDirectory(const std::string &origin, const std::string &destination, bool verbose=false);
+
   Paths paths_;
 
   QString driver_file_name_; //!< The name of the driver main file.
@@ -123,6 +163,8 @@ class Simulator {
   QList<int> control_times_;
   virtual void UpdateFilePaths() = 0;
   int verbosity_level_; //!< Verbosity level for runtime console logging.
+  Utilities::Unix::ProcessResult last_run_; //!< Result of the last simulation process.
+  SimulationMonitor *monitor_ = nullptr;
 };
 
 }
@@ -0,0 +1,50 @@
+#include <Model/tests/test_resource_model.h>
+#include <gtest/gtest.h>
+#include "Simulation/simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/schedule_cache.h"
+#include "Simulation/simulator_interfaces/driver_file_writers/driver_parts/ecl_driver_parts/schedule_section.h"
+
+using namespace ::Simulation::ECLDriverParts;
+
+namespace {
+
+class DriverPartScheduleCacheTest : public ::testing::Test, public TestResources::TestResourceModel {
+protected:
+    DriverPartScheduleCacheTest(){}
+    virtual ~DriverPartScheduleCacheTest(){}
+
+    QString expectedSchedule() {
+        return Schedule(model_->wells(), settings_model_->control_times(), insets_).GetPartString();
+    }
+
+    ScheduleCache cache_;
+    ScheduleInsets insets_;
+};
+
+TEST_F(DriverPartScheduleCacheTest, EqualToSchedule) {
+    auto control_times = settings_model_->control_times();
+    EXPECT_EQ(expectedSchedule(), cache_.GetSchedule(model_->wells(), control_times, insets_));
+    EXPECT_EQ(Schedule(model_->wells(), control_times, insets_).GetTimeEntryStrings(), cache_.GetTimeEntryStrings());
+    EXPECT_EQ(Welspecs(model_->wells()).GetPartString(), cache_.GetWelspecs(model_->wells()));
+    EXPECT_EQ(Compdat(model_->wells()).GetPartString(), cache_.GetCompdat(model_->wells()));
+}
+
+TEST_F(DriverPartScheduleCacheTest, OnlyChangedEntriesAreGenerated) {
+    auto control_times = settings_model_->control_times();
+    cache_.GetSchedule(model_->wells(), control_times, insets_);
+    EXPECT_LT(0, cache_.generated_entries());
+
+    cache_.GetSchedule(model_->wells(), control_times, insets_);
+    EXPECT_EQ(0, cache_.generated_entries());
+    cache_.GetCompdat(model_->wells());
+    EXPECT_EQ(0, cache_.generated_entries());
+
+    // Changing one control only regenerates the control entries of that well at that time
+    auto control = model_->wells()->first()->controls()->last();
+    control->setBhp(control->bhp() + 10.0);
+    control->setRate(control->rate() + 100.0);
+    QString schedule = cache_.GetSchedule(model_->wells(), control_times, insets_);
+    EXPECT_EQ(1, cache_.generated_entries());
+    EXPECT_EQ(expectedSchedule(), schedule);
+}
+
+}
@@ -22,4 +22,14 @@ TEST_F(DriverPartScheduleTest, Constructor) {
 //    std::cout << schedule_->GetPartString().toStdString() << std::endl;
 }
 
+TEST_F(DriverPartScheduleTest, TimeEntryStrings) {
+    QStringList entries = schedule_->GetTimeEntryStrings();
+    EXPECT_EQ(settings_model_->control_times().size(), entries.size());
+    EXPECT_EQ(schedule_->GetPartString(), entries.join("") + "\n\n");
+    for (int i = 0; i < entries.size() - 1; ++i) {
+        EXPECT_EQ(1, entries[i].count("TSTEP"));
+    }
+    EXPECT_EQ(0, entries.last().count("TSTEP"));
+}
+
 }
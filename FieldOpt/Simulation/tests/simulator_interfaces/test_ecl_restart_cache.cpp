@@ -0,0 +1,157 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include "Simulation/simulator_interfaces/ecl_restart_cache.h"
+#include "Settings/tests/test_resource_example_file_paths.hpp"
+
+using namespace Simulation;
+using namespace TestResources::ExampleFilePaths;
+namespace fs = boost::filesystem;
+
+namespace {
+
+class EclRestartCacheTest : public ::testing::Test {
+ protected:
+  EclRestartCacheTest() {
+      output_dir_ = (fs::temp_directory_path() / "fieldopt_restart_cache").string();
+      fs::remove_all(output_dir_);
+      fs::create_directories(output_dir_ + "/5spot");
+      case_root_ = output_dir_ + "/5spot/ECL_5SPOT";
+      for (std::string suffix : {".UNRST", ".SMSPEC", ".UNSMRY"}) {
+          std::ofstream out(case_root_ + suffix);
+          out << suffix;
+      }
+  }
+
+  virtual ~EclRestartCacheTest() {
+      fs::remove_all(output_dir_);
+  }
+
+  std::string readFile(const std::string &path) {
+      std::ifstream in(path, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  /*!
+   * Time entries for a schedule with control times 0, 100, ..., with the given rates.
+   */
+  std::vector<std::string> schedule(std::vector<int> rates) {
+      std::vector<std::string> entries;
+      for (int i = 0; i < (int)rates.size(); ++i) {
+          std::string entry = "WCONPROD\n PROD 'OPEN' 'ORAT' " + std::to_string(rates[i]) + " /\n/\n\n";
+          if (i + 1 < (int)rates.size()) entry += "TSTEP\n 100 /\n\n";
+          entries.push_back(entry);
+      }
+      return entries;
+  }
+
+  std::string output_dir_;
+  std::string case_root_;
+};
+
+TEST_F(EclRestartCacheTest, ReportSteps) {
+    EXPECT_TRUE(EclRestartCache::HasOneReportStepPerEntry(schedule({1, 2, 3})));
+    EXPECT_FALSE(EclRestartCache::HasOneReportStepPerEntry({"TSTEP\n 10 20 /\n", "\n"}));
+    EXPECT_FALSE(EclRestartCache::HasOneReportStepPerEntry({"TSTEP\n 2*10 /\n", "\n"}));
+    EXPECT_FALSE(EclRestartCache::HasOneReportStepPerEntry({"DATES\n 1 JAN 2020 /\n/\n", "\n"}));
+    EXPECT_FALSE(EclRestartCache::HasOneReportStepPerEntry({"\n", "\n"}));
+}
+
+TEST_F(EclRestartCacheTest, FindRestart) {
+    EclRestartCache cache(output_dir_, "ECL_5SPOT", 10);
+    EclRestartCache::Restart restart;
+    EXPECT_FALSE(cache.FindRestart(schedule({1, 2, 3, 4}), restart));
+    EXPECT_TRUE(cache.Add(case_root_, schedule({1, 2, 3, 4}), nullptr));
+    EXPECT_TRUE(fs::exists(output_dir_ + "/RST_C0001/ECL_5SPOT.UNRST"));
+
+    // Differs from the first control time: no restart
+    EXPECT_FALSE(cache.FindRestart(schedule({9, 2, 3, 4}), restart));
+
+    // Differs from the third control time: restart from report step 2
+    EXPECT_TRUE(cache.FindRestart(schedule({1, 2, 9, 4}), restart));
+    EXPECT_EQ(1, restart.entry);
+    EXPECT_EQ(2, restart.step);
+    EXPECT_EQ("../RST_C0001/ECL_5SPOT", restart.root);
+
+    // Identical schedule: at least the last report step is simulated again
+    EXPECT_TRUE(cache.FindRestart(schedule({1, 2, 3, 4}), restart));
+    EXPECT_EQ(2, restart.step);
+
+    // A case restarted from step 2 does not hold restarts for steps 1 and 2
+    EXPECT_TRUE(cache.Add(case_root_, schedule({1, 2, 9, 9}), &restart));
+    EXPECT_TRUE(cache.FindRestart(schedule({1, 2, 9, 9, 9}), restart));
+    EXPECT_EQ(2, restart.entry);
+    EXPECT_EQ(3, restart.step);
+    EXPECT_TRUE(cache.FindRestart(schedule({1, 7, 9, 9}), restart));
+    EXPECT_EQ(1, restart.entry);
+    EXPECT_EQ(1, restart.step);
+}
+
+TEST_F(EclRestartCacheTest, Eviction) {
+    EclRestartCache cache(output_dir_, "ECL_5SPOT", 2);
+    EclRestartCache::Restart restart;
+    EXPECT_TRUE(cache.Add(case_root_, schedule({1, 1, 1}), nullptr));
+    EXPECT_TRUE(cache.Add(case_root_, schedule({2, 2, 2}), nullptr));
+    EXPECT_TRUE(cache.FindRestart(schedule({1, 1, 5}), restart)); // Entry 1 is now the most recently used
+    EXPECT_TRUE(cache.Add(case_root_, schedule({1, 1, 5}), &restart));
+    EXPECT_EQ(2, cache.size());
+    EXPECT_FALSE(fs::exists(output_dir_ + "/RST_C0002"));
+    EXPECT_FALSE(cache.FindRestart(schedule({2, 2, 5}), restart));
+
+    // Entry 1 is the parent of entry 3 and can not be evicted; neither can entry 3 be
+    // while restarting from it
+    EXPECT_TRUE(cache.FindRestart(schedule({1, 1, 5, 5}), restart));
+    EXPECT_EQ(3, restart.entry);
+    EXPECT_FALSE(cache.Add(case_root_, schedule({1, 1, 5, 5}), &restart));
+    EXPECT_TRUE(fs::exists(output_dir_ + "/RST_C0001"));
+    EXPECT_TRUE(fs::exists(output_dir_ + "/RST_C0003"));
+}
+
+TEST_F(EclRestartCacheTest, SupportsRestarts) {
+    std::string reason;
+    EXPECT_TRUE(EclRestartCache::SupportsRestarts(readFile(deck_ecl_5spot_), "ECL_5SPOT_SCH.INC", reason));
+    EXPECT_FALSE(EclRestartCache::SupportsRestarts(readFile(deck_horzwel_), "HORZWELL_SCH.INC", reason));
+    EXPECT_FALSE(reason.empty());
+
+    std::string deck = "RUNSPEC\nUNIFOUT\nSOLUTION\nEQUIL\n/\nSCHEDULE\nTSTEP\n 1 /\nINCLUDE\n 'SCH.INC' /\nEND\n";
+    EXPECT_FALSE(EclRestartCache::SupportsRestarts(deck, "SCH.INC", reason));
+    deck = "RUNSPEC\nSOLUTION\nEQUIL\n/\nSCHEDULE\nINCLUDE\n 'SCH.INC' /\nEND\n";
+    EXPECT_FALSE(EclRestartCache::SupportsRestarts(deck, "SCH.INC", reason));
+}
+
+TEST_F(EclRestartCacheTest, RestartDeck) {
+    EclRestartCache::Restart restart;
+    restart.entry = 1;
+    restart.step = 3;
+    restart.root = "../RST_C0001/ECL_5SPOT";
+    std::string deck = "RUNSPEC\nUNIFOUT\nGRID\nINIT\nSOLUTION\n-- Initial state\nEQUIL\n 2000 200 /\n"
+                       "SUMMARY\nFOPT\nSCHEDULE\nINCLUDE\n 'SCH.INC' /\nEND\n";
+    std::string expected = "RUNSPEC\nUNIFIN\n\nUNIFOUT\nGRID\nINIT\nSOLUTION\n"
+                           "RESTART\n '../RST_C0001/ECL_5SPOT' 3 /\n\nRPTRST\n 'BASIC=2' /\n\n"
+                           "SUMMARY\nFOPT\nSCHEDULE\nSKIPREST\n\nINCLUDE\n 'SCH.INC' /\nEND\n";
+    EXPECT_EQ(expected, EclRestartCache::RestartDeck(deck, restart));
+
+    // UNIFIN is not added twice
+    std::string restart_deck = EclRestartCache::RestartDeck(readFile(deck_ecl_5spot_), restart);
+    EXPECT_EQ(restart_deck.find("UNIFIN"), restart_deck.rfind("UNIFIN"));
+    EXPECT_EQ(std::string::npos, restart_deck.find("EQUIL"));
+}
+
+}
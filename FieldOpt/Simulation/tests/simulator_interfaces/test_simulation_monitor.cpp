@@ -0,0 +1,152 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <QJsonObject>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <cmath>
+#include "Simulation/simulator_interfaces/simulation_monitor.h"
+#include "Settings/tests/test_resource_example_file_paths.hpp"
+
+using namespace Simulation;
+using namespace TestResources::ExampleFilePaths;
+namespace fs = boost::filesystem;
+
+namespace {
+
+/*!
+ * Plays back the HORZWELL example summary as if the simulation was running,
+ * and checks the monitor's verdict. The objective is the field oil production.
+ */
+class SimulationMonitorTest : public ::testing::Test {
+ protected:
+  SimulationMonitorTest() {
+      running_dir_ = (fs::temp_directory_path() / "fieldopt_monitor_running").string();
+      fs::remove_all(running_dir_);
+      fs::create_directories(running_dir_);
+      case_path_ = running_dir_ + "/HORZWELL.DATA";
+      spec_ = readFile(ecl_base_horzwell + ".SMSPEC");
+      data_ = readFile(ecl_base_horzwell + ".UNSMRY");
+      writeRunning(".SMSPEC", spec_);
+
+      Paths paths;
+      paths.SetPath(Paths::SIM_DRIVER_FILE, ecl_base_horzwell + ".DATA");
+      QJsonObject json;
+      json["Type"] = "ECLIPSE";
+      json["EarlyTermination"] = true;
+      json["EarlyTerminationMargin"] = 0.1;
+      json["EarlyTerminationMinFraction"] = 0.2;
+      json["EarlyTerminationMaxConvergenceFailures"] = 2;
+      settings_ = new Settings::Simulator(json, paths);
+  }
+
+  virtual ~SimulationMonitorTest() {
+      fs::remove_all(running_dir_);
+      delete settings_;
+  }
+
+  std::string readFile(const std::string &path) {
+      std::ifstream in(path, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  void writeRunning(const std::string &suffix, const std::string &content) {
+      std::ofstream out(running_dir_ + "/HORZWELL" + suffix, std::ios::binary | std::ios::trunc);
+      out.write(content.data(), content.size());
+  }
+
+  SimulationMonitor *createMonitor(double reference) {
+      auto monitor = new SimulationMonitor(settings_, true);
+      monitor->SetObjective([monitor] {
+        return monitor->partial_results()->GetValue(Results::Results::CumulativeOilProduction);
+      });
+      monitor->SetReference([reference] { return reference; });
+      monitor->Start(case_path_, 200);
+      return monitor;
+  }
+
+  /*!
+   * Write the summary in increments and check the monitor after each one.
+   * @return The fraction of the summary written when the monitor asked for termination; 1 if it never did.
+   */
+  double playBack(SimulationMonitor *monitor) {
+      for (size_t length = 0; length <= data_.size(); length += data_.size() / 20) {
+          writeRunning(".UNSMRY", data_.substr(0, length));
+          if (monitor->Check()) return (double)length / data_.size();
+      }
+      return 1.0;
+  }
+
+  Settings::Simulator *settings_;
+  std::string running_dir_;
+  std::string case_path_;
+  std::string spec_;
+  std::string data_;
+};
+
+TEST_F(SimulationMonitorTest, Settings) {
+    EXPECT_TRUE(settings_->early_termination());
+    EXPECT_DOUBLE_EQ(0.1, settings_->early_termination_margin());
+    EXPECT_DOUBLE_EQ(0.2, settings_->early_termination_min_fraction());
+    EXPECT_EQ(2, settings_->early_termination_max_conv_failures());
+    EXPECT_EQ(10, settings_->monitor_interval());
+}
+
+TEST_F(SimulationMonitorTest, HopelessCaseIsTerminated) {
+    // Final FOPT is 187866; a reference ten times higher can not be reached
+    auto monitor = createMonitor(1.9e6);
+    double fraction = playBack(monitor);
+    EXPECT_LT(fraction, 1.0);
+    EXPECT_EQ(SimulationMonitor::BOUND_EXCEEDED, monitor->verdict());
+    EXPECT_LT(monitor->bound(), 1.9e6 * 0.9);
+    EXPECT_GE(monitor->bound(), 187866); // The bound should be optimistic for this case
+    delete monitor;
+}
+
+TEST_F(SimulationMonitorTest, PromisingCaseIsNotTerminated) {
+    auto monitor = createMonitor(1.5e5);
+    EXPECT_DOUBLE_EQ(1.0, playBack(monitor));
+    EXPECT_EQ(SimulationMonitor::CONTINUE, monitor->verdict());
+    delete monitor;
+}
+
+TEST_F(SimulationMonitorTest, NoReference) {
+    auto monitor = createMonitor(std::nan(""));
+    EXPECT_DOUBLE_EQ(1.0, playBack(monitor));
+    EXPECT_EQ(SimulationMonitor::CONTINUE, monitor->verdict());
+    delete monitor;
+}
+
+TEST_F(SimulationMonitorTest, ConvergenceFailures) {
+    auto monitor = createMonitor(std::nan(""));
+    writeRunning(".PRT", "@--PROBLEM  AT TIME 10.0 DAYS\n@  Convergence failure in step 4\n@  retrying");
+    EXPECT_FALSE(monitor->Check());
+    writeRunning(".PRT", "@--PROBLEM  AT TIME 10.0 DAYS\n@  Convergence failure in step 4\n@  retrying\n"
+                         "@  CONVERGENCE FAILURE in step 5\n");
+    EXPECT_TRUE(monitor->Check());
+    EXPECT_EQ(SimulationMonitor::CONVERGENCE_FAILURE, monitor->verdict());
+
+    // Starting a new simulation resets the monitor
+    fs::remove(running_dir_ + "/HORZWELL.PRT");
+    monitor->Start(case_path_, 200);
+    EXPECT_FALSE(monitor->Check());
+    EXPECT_EQ(SimulationMonitor::CONTINUE, monitor->verdict());
+    delete monitor;
+}
+
+}
@@ -5,11 +5,13 @@ SET(UTILITIES_HEADERS
 	filehandling.hpp
 	math.hpp
 	printer.hpp
+	process_supervisor.hpp
 	stringhelpers.hpp
 	time.hpp
 	random.hpp
 	system.hpp
 	verbosity.h
+	workdir.hpp
 )
 
 SET(UTILITIES_SOURCES
@@ -20,6 +22,8 @@ SET(UTILITIES_TESTS
 	tests/test_filehandling.cpp
 	tests/test_math.cpp
 	tests/test_printer.cpp
+	tests/test_process_supervisor.cpp
 	tests/test_time.cpp
 	tests/test_random.cpp
+	tests/test_workdir.cpp
 )
@@ -24,10 +24,10 @@
 #include "Utilities/filehandling.hpp"
 #include "Utilities/verbosity.h"
 #include "Utilities/printer.hpp"
+#include "Utilities/process_supervisor.hpp"
+#include <functional>
 #include <iostream>
-#include <unistd.h>
-#include <sys/wait.h>
-#include <assert.h>
+#include <sstream>
 
 namespace Utilities {
 namespace Unix {
@@ -62,87 +62,88 @@ inline QString Exec(QString directory, QStringList commands, bool verbose=false)
 }
 
 /*!
- * \brief ExecShellScript Executes a shell script with the given set of parameters.
+ * \brief RunShellScript Executes a shell script with the given set of parameters
+ * through the process-wide ProcessSupervisor, and waits for it to finish.
+ *
+ * The script is run in its own process group; if the timeout is reached, the
+ * whole group is killed. Several scripts may be run at the same time from
+ * different threads.
+ *
+ * The script is executed directly, not through sh, so it must be executable and
+ * start with a #! line. Each entry in args is passed as a single argument: it is
+ * not split on whitespace, and no quoting or glob expansion is applied.
  * \param script_path Absolute path to the shell script.
  * \param args Arguments to be passed to the script.
+ * \param timeout Seconds before the execution is terminated. No timeout if <= 0.
+ * \param output_path File to write the stdout and stderr of the script to. The
+ * output is not redirected if the path is empty.
+ * \param abort_check Called every check_interval seconds while the script is
+ * running. If it returns true, the process group is killed (the result then
+ * has killed set). Not used if empty.
+ * \param check_interval Seconds between calls to abort_check.
+ * \return The exit status and wall/CPU time of the script.
  */
-inline void ExecShellScript(QString script_path, QStringList args)
+inline ProcessResult RunShellScript(QString script_path, QStringList args, int timeout=0, QString output_path="",
+                                    std::function<bool()> abort_check=nullptr, double check_interval=10.0)
 {
     if (!Utilities::FileHandling::FileExists(script_path))
         throw std::runtime_error("File not found: " + script_path.toStdString());
-    QString command = script_path + " " + args.join(" ");
-    system(command.toLatin1().constData());
-}
 
-namespace helpers {
-/*!
- * Create a child-process and execute the given script with the given arguments in it.
- * @param script_path Path to the script to be executed (must take 2 args).
- * @param arglist List of arguments to be passed to the script (must be length 2).
- * @return The PID of the child process.
- */
-inline pid_t fork_child(QString script_path, QStringList arglist)
-{
-    QStringList cmdl = script_path.split("/");
-    QString cmd = cmdl.last();
-    QString arg1 = arglist[0];
-    QString arg2 = arglist[1];
-    QString arg3 = arglist[2];
-    auto barg1 = arg1.toLatin1();
-    auto barg2 = arg2.toLatin1();
-    auto barg3 = arg3.toLatin1();
-    int p = fork();
-    if (p == -1) {
-        perror("fork");
-        exit(1);
+    std::vector<std::string> argv;
+    for (auto &arg : args) argv.push_back(arg.toStdString());
+    if (VERB_RUN >= 2) {
+        std::stringstream ss;
+        ss << "Executing shell script " << script_path.toStdString() << std::endl
+           << "   with arguments " << args.join(" ; ").toStdString() << std::endl
+           << "   and timeout " << timeout << std::endl;
+        Printer::ext_info(ss.str(), "Utilities", "Execution");
     }
-    if (p == 0) {
-        char *carg1 = barg1.data();
-        char *carg2 = barg2.data();
-        char *carg3 = barg3.data();
-        char *ccmnd = cmd.toLatin1().data();
-        char *cscrp = script_path.toLatin1().data();
-        char *cargs[] = {ccmnd, carg1, carg2, carg3, (char *)0};
-        execvp(cscrp, cargs);
-        delete carg1, carg2, carg3, ccmnd, cscrp;
-        exit(0);
+
+    auto &supervisor = ProcessSupervisor::Instance();
+    auto handle = supervisor.Launch(script_path.toStdString(), argv, timeout,
+                                    output_path.toStdString(), output_path.toStdString());
+    ProcessResult result;
+    if (abort_check) {
+        while (!supervisor.WaitFor(handle, check_interval, result)) {
+            if (abort_check()) {
+                supervisor.Kill(handle);
+                result = supervisor.Wait(handle);
+                break;
+            }
+        }
+    }
+    else {
+        result = supervisor.Wait(handle);
     }
-    return p;
-}
 
-/*!
- * Check if a process with the given PID is running (after waiting for defunct processes to terminate properly).
- * @param pid The PID of the process to check.
- * @return True if the process is running; otherwise false.
- */
-inline bool is_pid_running(int pid)
-{
-    while(waitpid(-1, 0, WNOHANG) > 0) {
-        // Wait for defunct....
+    if (result.killed) {
+        if (VERB_SIM >= 1) Printer::ext_info("Aborted process group " + Printer::num2str(result.pid) + " after "
+                                                 + Printer::num2str(result.wall_time) + " s.", "Utilities", "Execution");
+    }
+    else if (result.timed_out) {
+        Printer::ext_warn("Timeout, killed process group " + Printer::num2str(result.pid), "Utilities", "Execution");
+    }
+    else if (VERB_SIM >= 2) {
+        Printer::ext_info("Process " + Printer::num2str(result.pid) + " finished with exit code "
+                              + Printer::num2str(result.exit_code) + " after " + Printer::num2str(result.wall_time)
+                              + " s (" + Printer::num2str(result.cpu_time) + " s CPU).", "Utilities", "Execution");
     }
-    if (0 == kill(pid, 0))
-        return 1; // Process exists
-    return 0;
+    return result;
 }
 
 /*!
- * After checking if the process is running using the is_pid_running function, terminate it.
- * @param pid The PID of the process to terminate.
+ * \brief ExecShellScript Executes a shell script with the given set of parameters.
+ * \param script_path Absolute path to the shell script.
+ * \param args Arguments to be passed to the script.
  */
-inline void terminate_process(int pid)
+inline void ExecShellScript(QString script_path, QStringList args)
 {
-    if (is_pid_running(pid)) {
-        kill(pid, SIGKILL);
-    }
-}
+    RunShellScript(script_path, args);
 }
 
 /*!
  * @brief ExecShellScriptTimeout execututes a shell script with the given set of parameters, and
- * terminates the process after a set time has passed if it has not returned by then.
- *
- * \todo In this function, in the else block, we can also, at a later stage, monitor the output files
- * of a simulation and use them to decide whether we should abort.
+ * terminates the process (group) after a set time has passed if it has not returned by then.
  *
  * @param script_path Absolute path to the shell script.
  * @param args Arguments to be passed to the script.
@@ -151,95 +152,8 @@ inline void terminate_process(int pid)
  */
 inline bool ExecShellScriptTimeout(QString script_path, QStringList args, int timeout)
 {
-    if (!Utilities::FileHandling::FileExists(script_path))
-        throw std::runtime_error("File not found: " + script_path.toStdString());
-    assert(args.length() == 3);
-
-    if (VERB_RUN >= 2) {
-        std::stringstream ss;
-        ss << "Executing shell script " << script_path.toStdString() << std::endl
-           << "   with arguments " << args.join(" ; ").toStdString() << std::endl
-           << "   and timeout " << timeout << std::endl;
-        Printer::ext_info(ss.str(), "Utilities", "Execution");
-    }
-
-
-    pid_t pid;
-    sigset_t mask;
-    sigset_t orig_mask;
-    struct timespec to;
-    sigemptyset (&mask);
-    sigaddset (&mask, SIGCHLD);
-
-    if (sigprocmask(SIG_BLOCK, &mask, &orig_mask) < 0) {
-        perror ("sigprocmask");
-        return false;
-    }
-
-    pid  = helpers::fork_child(script_path, args);
-    to.tv_sec = timeout;
-    to.tv_nsec = 0;
-
-
-    if (VERB_SIM >= 2) {
-        std::stringstream ss;
-        ss << "Monitoring child process with pid " << pid << ". Timeout set to " << to.tv_sec << std::endl;
-        Printer::info(ss.str());
-    }
-    do {
-        if (!helpers::is_pid_running(pid)) // If the child no longer exists, return true
-            return true;
-        int ret = sigtimedwait(&mask, NULL, &to);
-        if (VERB_SIM >= 2) {
-            std::stringstream ss;
-            ss << "SIGTIMEDWAIT returned " << ret << " with errno " << errno << std::endl;
-            Printer::info(ss.str());
-        }
-        if (ret < 0) {
-            if (errno == EINTR) {
-                Printer::ext_warn("Interrupted by a signal other than sigchild.", "Utilities", "Execution");
-                helpers::terminate_process(pid);
-                return false;
-            }
-            else if (errno == EAGAIN) {
-                Printer::ext_warn("Timeout, killing child " + Printer::num2str(pid), "Utilities", "Execution");
-                if (helpers::is_pid_running(pid)) { // Ensure that child still exists
-                    kill(pid, SIGKILL);
-                    return false;
-                }
-                else {
-                    if (VERB_SIM >= 2) {
-                        Printer::info("The process terminated successfully before the set timeout.");
-                    }
-                    return true;
-                }
-            }
-            else if (errno == EINVAL) {
-                Printer::ext_warn("Got error EINVAL from process, terminating it.", "Utilities", "Execution");
-                helpers::terminate_process(pid);
-                return false;
-            }
-            else {
-                Printer::ext_warn("Got error sigtimedwait from process, terminating it.", "Utilities", "Execution");
-                helpers::terminate_process(pid);
-                return false;
-            }
-        }
-        else { // sigtimedwait returned something >= 0
-            if (helpers::is_pid_running(pid)) {
-                Printer::ext_warn("Process returned a non-error value, but it is still running - waiting ....", "Utilities", "Execution");
-                continue;
-            }
-            else {
-                if (VERB_SIM >= 2) {
-                    Printer::info("The process terminated successfully before the set timeout.");
-                }
-                return true;
-            }
-        }
-    } while (1);
+    return !RunShellScript(script_path, args, timeout).timed_out;
 }
 }
 }
 #endif // EXECUTION_H
-
@@ -15,6 +15,7 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include <vector>
+#include "workdir.hpp"
 
 namespace Utilities {
 namespace FileHandling {
@@ -157,6 +158,7 @@ inline void WriteStringToFile(QString string, QString file_path)
     if (!string.endsWith("\n"))
         string.append("\n");
 
+    BreakHardLink(file_path.toStdString()); // Don't write through to a linked input file
     QFile file(file_path);
     file.open(QIODevice::WriteOnly | QIODevice::Truncate);
     QTextStream out(&file);
@@ -179,6 +181,7 @@ inline void WriteLineToFile(QString string, QString file_path)
     if (!string.endsWith("\n"))
         string.append("\n");
 
+    BreakHardLink(file_path.toStdString());
     QFile file(file_path);
     file.open(QIODevice::Append);
     QTextStream out(&file);
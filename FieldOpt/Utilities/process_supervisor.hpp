@@ -0,0 +1,481 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#ifndef PROCESS_SUPERVISOR_H
+#define PROCESS_SUPERVISOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+
+namespace Utilities {
+namespace Unix {
+
+/*!
+ * @brief The outcome of a process run by the ProcessSupervisor.
+ */
+struct ProcessResult {
+  pid_t pid = -1;
+  bool exited = false; //!< Whether the process terminated normally (i.e. called exit).
+  int exit_code = -1; //!< Exit code of the process. Only valid if exited is true.
+  int signal = 0; //!< Signal that terminated the process. Zero if it exited normally.
+  bool timed_out = false; //!< Whether the process was killed by the supervisor because its timeout was reached.
+  bool killed = false; //!< Whether the process was killed through ProcessSupervisor::Kill.
+  double wall_time = 0.0; //!< Seconds from the process was started until it was reaped.
+  double cpu_time = 0.0; //!< User + system CPU seconds of the process and the descendants it waited for.
+
+  bool Succeeded() const { return exited && exit_code == 0 && !timed_out; }
+};
+
+/*!
+ * @brief The ProcessSupervisor class launches and monitors child processes
+ * (simulations) without polling.
+ *
+ * Any number of processes may run at the same time. Each is identified by the
+ * handle returned by Launch. A monitor thread waits on a pidfd for each child
+ * using epoll, and reaps exactly the children it launched (never waitpid(-1)).
+ * If the kernel does not support pidfds (Linux < 5.3), the monitor falls back
+ * to checking its children every 100 ms.
+ *
+ * Each child is placed in its own process group. When a job's timeout is
+ * reached, or it is killed, the whole group is sent SIGKILL, so that processes
+ * started by a simulator wrapper script are terminated along with it.
+ *
+ * Because the children are not in FieldOpt's process group, a Ctrl-C or a
+ * SIGTERM sent to FieldOpt's group does not reach them. The first supervisor
+ * therefore installs SIGINT and SIGTERM handlers that kill the groups of all
+ * running jobs, and then pass the signal on to the previous disposition
+ * (normally terminating FieldOpt). Signals that were ignored are left alone.
+ *
+ * The supervisor is thread safe. Instance() returns the process-wide supervisor
+ * that should normally be used.
+ */
+class ProcessSupervisor {
+ public:
+  typedef long Handle;
+
+  ProcessSupervisor() {
+      stop_ = false;
+      next_handle_ = 1;
+      epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+      wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      if (epoll_fd_ < 0 || wake_fd_ < 0)
+          throw std::runtime_error("Unable to create process supervisor: " + std::string(strerror(errno)));
+      struct epoll_event ev;
+      ev.events = EPOLLIN;
+      ev.data.u64 = 0;
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+      installSignalHandlers();
+      monitor_ = std::thread(&ProcessSupervisor::monitor, this);
+  }
+
+  /*!
+   * @brief Kill all processes that are still running and stop the monitor thread.
+   */
+  ~ProcessSupervisor() {
+      {
+          std::lock_guard<std::mutex> lock(mutex_);
+          for (auto &job : jobs_) {
+              if (!job.second.done) killGroup(job.second.pid);
+          }
+          stop_ = true;
+      }
+      wake();
+      monitor_.join();
+      for (auto &job : jobs_) {
+          if (!job.second.done) {
+              waitpid(job.second.pid, nullptr, 0);
+              untrackGroup(job.second.group_slot);
+          }
+          if (job.second.pidfd >= 0) close(job.second.pidfd);
+      }
+      close(wake_fd_);
+      close(epoll_fd_);
+  }
+
+  static ProcessSupervisor &Instance() {
+      static ProcessSupervisor supervisor;
+      return supervisor;
+  }
+
+  /*!
+   * @brief Launch a process.
+   * @param program Path to the executable (or name of an executable on PATH).
+   * @param args Arguments to pass to the program (not including the program name).
+   * @param timeout Seconds before the process group is killed. No timeout if <= 0.
+   * @param stdout_path File to redirect stdout to (truncated). Inherited if empty.
+   * @param stderr_path File to redirect stderr to (truncated). Inherited if empty.
+   * @param working_dir Directory to start the process in. Inherited if empty.
+   * @return Handle for the job.
+   */
+  Handle Launch(const std::string &program,
+                const std::vector<std::string> &args,
+                double timeout = 0,
+                const std::string &stdout_path = "",
+                const std::string &stderr_path = "",
+                const std::string &working_dir = "") {
+      // Everything the child needs is prepared before forking; between fork
+      // and exec the child only makes async-signal-safe calls.
+      std::vector<char *> argv;
+      argv.push_back(const_cast<char *>(program.c_str()));
+      for (auto &arg : args) argv.push_back(const_cast<char *>(arg.c_str()));
+      argv.push_back(nullptr);
+      int out_fd = openOutput(stdout_path);
+      int err_fd = stderr_path == stdout_path ? out_fd : openOutput(stderr_path);
+      bool search_path = program.find('/') == std::string::npos;
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto start = std::chrono::steady_clock::now();
+      pid_t pid = fork();
+      if (pid < 0) {
+          int err = errno;
+          closeOutputs(out_fd, err_fd);
+          throw std::runtime_error("Unable to fork process for " + program + ": " + strerror(err));
+      }
+      if (pid == 0) {
+          setpgid(0, 0);
+          sigset_t empty;
+          sigemptyset(&empty);
+          sigprocmask(SIG_SETMASK, &empty, nullptr);
+          if (out_fd >= 0) dup2(out_fd, STDOUT_FILENO);
+          if (err_fd >= 0) dup2(err_fd, STDERR_FILENO);
+          if (!working_dir.empty() && chdir(working_dir.c_str()) != 0) _exit(127);
+          if (search_path) execvp(argv[0], argv.data());
+          else execv(argv[0], argv.data());
+          _exit(127);
+      }
+      setpgid(pid, pid); // Also set from the parent, so the group exists before we may need to kill it
+      closeOutputs(out_fd, err_fd);
+
+      Job job;
+      job.pid = pid;
+      job.pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+      job.start = start;
+      job.has_deadline = timeout > 0;
+      job.deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(timeout > 0 ? timeout : 0));
+      job.done = false;
+      job.result.pid = pid;
+      job.group_slot = trackGroup(pid);
+
+      Handle handle = next_handle_++;
+      if (job.pidfd >= 0) {
+          struct epoll_event ev;
+          ev.events = EPOLLIN;
+          ev.data.u64 = (uint64_t)handle;
+          epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, job.pidfd, &ev);
+      }
+      jobs_[handle] = job;
+      wake();
+      return handle;
+  }
+
+  /*!
+   * @brief Check whether the job has terminated and been reaped.
+   */
+  bool IsDone(Handle handle) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return findJob(handle).done;
+  }
+
+  /*!
+   * @brief Block until the job has terminated, and get its result. The handle
+   * is invalid after this call.
+   */
+  ProcessResult Wait(Handle handle) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      Job &job = findJob(handle);
+      done_cv_.wait(lock, [&job] { return job.done; });
+      ProcessResult result = job.result;
+      jobs_.erase(handle);
+      return result;
+  }
+
+  /*!
+   * @brief Block until the job has terminated or the given time has passed.
+   * If the job terminated, its result is returned and the handle is invalid
+   * after the call, as for Wait.
+   * @param handle Job to wait for.
+   * @param seconds Maximum time to wait.
+   * @param result Set to the result of the job if it terminated.
+   * @return True if the job terminated.
+   */
+  bool WaitFor(Handle handle, double seconds, ProcessResult &result) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      Job &job = findJob(handle);
+      if (!done_cv_.wait_for(lock, std::chrono::duration<double>(seconds), [&job] { return job.done; }))
+          return false;
+      result = job.result;
+      jobs_.erase(handle);
+      return true;
+  }
+
+  /*!
+   * @brief Block until one of the given jobs has terminated, and get its result.
+   * The handle of the terminated job is invalid after this call.
+   * @param handles Jobs to wait for. Must not be empty.
+   * @param result Set to the result of the terminated job.
+   * @return The handle of the terminated job.
+   */
+  Handle WaitAny(const std::vector<Handle> &handles, ProcessResult &result) {
+      if (handles.empty())
+          throw std::runtime_error("No processes to wait for.");
+      std::unique_lock<std::mutex> lock(mutex_);
+      Handle finished = 0;
+      done_cv_.wait(lock, [&] {
+        for (Handle handle : handles) {
+            if (findJob(handle).done) { finished = handle; return true; }
+        }
+        return false;
+      });
+      result = jobs_[finished].result;
+      jobs_.erase(finished);
+      return finished;
+  }
+
+  /*!
+   * @brief Kill the process group of the job. The job must still be waited for.
+   */
+  void Kill(Handle handle) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Job &job = findJob(handle);
+      if (!job.done) {
+          job.result.killed = true;
+          killGroup(job.pid);
+      }
+  }
+
+  /*!
+   * @brief Number of launched jobs that have not yet terminated.
+   */
+  int NumberOfRunning() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      int running = 0;
+      for (auto &job : jobs_) {
+          if (!job.second.done) running++;
+      }
+      return running;
+  }
+
+ private:
+  struct Job {
+    pid_t pid;
+    int pidfd; //!< -1 if pidfds are not supported.
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point deadline;
+    bool has_deadline;
+    bool done;
+    int group_slot; //!< Index in groupTable(); -1 if the table was full.
+    ProcessResult result;
+  };
+
+  static const int kMaxTrackedGroups = 256;
+
+  std::map<Handle, Job> jobs_;
+  std::mutex mutex_;
+  std::condition_variable done_cv_;
+  std::thread monitor_;
+  int epoll_fd_;
+  int wake_fd_; //!< eventfd used to wake the monitor when jobs are added or the supervisor is stopped.
+  bool stop_;
+  Handle next_handle_;
+
+  Job &findJob(Handle handle) {
+      auto it = jobs_.find(handle);
+      if (it == jobs_.end())
+          throw std::runtime_error("Unknown process handle " + std::to_string(handle));
+      return it->second;
+  }
+
+  void wake() {
+      uint64_t one = 1;
+      ssize_t ret = write(wake_fd_, &one, sizeof(one));
+      (void)ret;
+  }
+
+  static void killGroup(pid_t pid) {
+      if (kill(-pid, SIGKILL) != 0) kill(pid, SIGKILL);
+  }
+
+  /*!
+   * @brief Process groups of running jobs, from all supervisors, for the signal
+   * handler. Zero marks a free entry. Lock-free, so the handler may read it.
+   */
+  static std::atomic<pid_t> *groupTable() {
+      static std::atomic<pid_t> table[kMaxTrackedGroups] = {};
+      return table;
+  }
+
+  static struct sigaction *previousActions() { //!< Dispositions of SIGINT and SIGTERM before ours.
+      static struct sigaction actions[2];
+      return actions;
+  }
+
+  static int trackGroup(pid_t pid) {
+      auto table = groupTable();
+      for (int i = 0; i < kMaxTrackedGroups; ++i) {
+          pid_t free_entry = 0;
+          if (table[i].compare_exchange_strong(free_entry, pid)) return i;
+      }
+      return -1; // Not killed on signals, but still on timeouts and destruction
+  }
+
+  static void untrackGroup(int slot) {
+      if (slot >= 0) groupTable()[slot].store(0);
+  }
+
+  static void onTerminationSignal(int sig) {
+      // Only async-signal-safe calls from here on
+      auto table = groupTable();
+      for (int i = 0; i < kMaxTrackedGroups; ++i) {
+          pid_t pid = table[i].load();
+          if (pid > 0) kill(-pid, SIGKILL);
+      }
+      sigaction(sig, &previousActions()[sig == SIGINT ? 0 : 1], nullptr);
+      raise(sig); // Delivered with the previous disposition when this handler returns
+  }
+
+  static void installSignalHandlers() {
+      static std::once_flag installed;
+      std::call_once(installed, [] {
+        groupTable(); // Initialize the statics before the handler can run
+        const int signals[2] = {SIGINT, SIGTERM};
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = &ProcessSupervisor::onTerminationSignal;
+        sigemptyset(&action.sa_mask);
+        for (int i = 0; i < 2; ++i) {
+            sigaction(signals[i], nullptr, &previousActions()[i]);
+            if (previousActions()[i].sa_handler == SIG_IGN) continue;
+            sigaction(signals[i], &action, nullptr);
+        }
+      });
+  }
+
+  static int openOutput(const std::string &path) {
+      if (path.empty()) return -1;
+      int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+      if (fd < 0)
+          throw std::runtime_error("Unable to open " + path + " for process output: " + strerror(errno));
+      return fd;
+  }
+
+  static void closeOutputs(int out_fd, int err_fd) {
+      if (out_fd >= 0) close(out_fd);
+      if (err_fd >= 0 && err_fd != out_fd) close(err_fd);
+  }
+
+  /*!
+   * @brief Reap terminated jobs and kill jobs past their deadline. Must be
+   * called with the mutex held.
+   * @return Milliseconds until the next deadline (or poll, if a job has no
+   * pidfd); -1 if there is nothing to wait for but events.
+   */
+  int updateJobs() {
+      auto now = std::chrono::steady_clock::now();
+      bool any_done = false;
+      long wait_ms = -1;
+      for (auto &entry : jobs_) {
+          Job &job = entry.second;
+          if (job.done) continue;
+
+          int status;
+          struct rusage usage;
+          pid_t ret = wait4(job.pid, &status, WNOHANG, &usage);
+          if (ret == job.pid || (ret < 0 && errno == ECHILD)) {
+              job.done = true;
+              any_done = true;
+              untrackGroup(job.group_slot);
+              job.result.wall_time = std::chrono::duration<double>(now - job.start).count();
+              if (ret == job.pid) {
+                  job.result.exited = WIFEXITED(status);
+                  job.result.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+                  job.result.signal = WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+                  job.result.cpu_time = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6
+                      + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+              }
+              if (job.pidfd >= 0) {
+                  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, job.pidfd, nullptr);
+                  close(job.pidfd);
+                  job.pidfd = -1;
+              }
+              continue;
+          }
+
+          if (job.has_deadline && !job.result.timed_out) {
+              if (now >= job.deadline) {
+                  job.result.timed_out = true;
+                  killGroup(job.pid);
+              }
+              else {
+                  long ms = std::chrono::duration_cast<std::chrono::milliseconds>(job.deadline - now).count() + 1;
+                  wait_ms = wait_ms < 0 ? ms : std::min(wait_ms, ms);
+              }
+          }
+          if (job.pidfd < 0 || job.result.timed_out) {
+              wait_ms = wait_ms < 0 ? 100 : std::min(wait_ms, 100L);
+          }
+      }
+      if (any_done) done_cv_.notify_all();
+      return (int)wait_ms;
+  }
+
+  void monitor() {
+      struct epoll_event events[16];
+      while (true) {
+          int wait_ms;
+          {
+              std::lock_guard<std::mutex> lock(mutex_);
+              if (stop_) return;
+              wait_ms = updateJobs();
+          }
+          int n = epoll_wait(epoll_fd_, events, 16, wait_ms);
+          for (int i = 0; i < n; ++i) {
+              if (events[i].data.u64 == 0) {
+                  uint64_t count;
+                  ssize_t ret = read(wake_fd_, &count, sizeof(count));
+                  (void)ret;
+              }
+          }
+      }
+  }
+};
+
+}
+}
+
+#endif // PROCESS_SUPERVISOR_H
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+#include "process_supervisor.hpp"
+
+using Utilities::Unix::ProcessSupervisor;
+using Utilities::Unix::ProcessResult;
+
+namespace {
+
+class ProcessSupervisorTest : public ::testing::Test {
+ protected:
+  ProcessSupervisorTest() {
+      out_path_ = "/tmp/fieldopt_test_process_supervisor.out";
+      err_path_ = "/tmp/fieldopt_test_process_supervisor.err";
+  }
+  virtual ~ProcessSupervisorTest() {
+      std::remove(out_path_.c_str());
+      std::remove(err_path_.c_str());
+  }
+
+  std::string readFile(const std::string &path) {
+      std::ifstream file(path);
+      std::stringstream ss;
+      ss << file.rdbuf();
+      return ss.str();
+  }
+
+  ProcessSupervisor supervisor_;
+  std::string out_path_;
+  std::string err_path_;
+};
+
+TEST_F(ProcessSupervisorTest, ExitStatus) {
+    auto ok = supervisor_.Launch("/bin/sh", {"-c", "exit 0"});
+    auto failed = supervisor_.Launch("sh", {"-c", "exit 3"});
+    ProcessResult result = supervisor_.Wait(failed);
+    EXPECT_TRUE(result.exited);
+    EXPECT_EQ(3, result.exit_code);
+    EXPECT_FALSE(result.Succeeded());
+
+    result = supervisor_.Wait(ok);
+    EXPECT_TRUE(result.Succeeded());
+    EXPECT_FALSE(result.timed_out);
+    EXPECT_EQ(0, supervisor_.NumberOfRunning());
+    EXPECT_THROW(supervisor_.Wait(ok), std::runtime_error);
+}
+
+TEST_F(ProcessSupervisorTest, CapturesOutput) {
+    auto handle = supervisor_.Launch("/bin/sh", {"-c", "echo out; echo err >&2; pwd"},
+                                     0, out_path_, err_path_, "/tmp");
+    EXPECT_TRUE(supervisor_.Wait(handle).Succeeded());
+    EXPECT_EQ("out\n/tmp\n", readFile(out_path_));
+    EXPECT_EQ("err\n", readFile(err_path_));
+}
+
+TEST_F(ProcessSupervisorTest, TimeoutKillsProcessGroup) {
+    // The background job must be killed along with the shell, before it writes the file
+    auto handle = supervisor_.Launch("/bin/sh", {"-c", "(sleep 1; echo late > " + out_path_ + ") & sleep 30"}, 0.3);
+    ProcessResult result = supervisor_.Wait(handle);
+    EXPECT_TRUE(result.timed_out);
+    EXPECT_FALSE(result.exited);
+    EXPECT_EQ(SIGKILL, result.signal);
+    EXPECT_LT(result.wall_time, 5.0);
+    usleep(1500000);
+    EXPECT_FALSE(std::ifstream(out_path_).good());
+}
+
+TEST_F(ProcessSupervisorTest, RunsConcurrently) {
+    std::vector<ProcessSupervisor::Handle> handles;
+    for (int i = 0; i < 4; ++i) {
+        handles.push_back(supervisor_.Launch("sleep", {"1"}));
+    }
+    EXPECT_EQ(4, supervisor_.NumberOfRunning());
+    auto start = std::chrono::steady_clock::now();
+    while (!handles.empty()) {
+        ProcessResult result;
+        auto done = supervisor_.WaitAny(handles, result);
+        EXPECT_TRUE(result.Succeeded());
+        EXPECT_GE(result.wall_time, 0.9);
+        handles.erase(std::find(handles.begin(), handles.end(), done));
+    }
+    EXPECT_LT(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 2.5);
+}
+
+TEST_F(ProcessSupervisorTest, Kill) {
+    auto handle = supervisor_.Launch("sleep", {"30"});
+    EXPECT_FALSE(supervisor_.IsDone(handle));
+    supervisor_.Kill(handle);
+    ProcessResult result = supervisor_.Wait(handle);
+    EXPECT_EQ(SIGKILL, result.signal);
+    EXPECT_FALSE(result.timed_out);
+    EXPECT_TRUE(result.killed);
+}
+
+TEST_F(ProcessSupervisorTest, WaitFor) {
+    auto handle = supervisor_.Launch("sleep", {"1"});
+    ProcessResult result;
+    EXPECT_FALSE(supervisor_.WaitFor(handle, 0.1, result));
+    EXPECT_FALSE(supervisor_.IsDone(handle));
+    EXPECT_TRUE(supervisor_.WaitFor(handle, 5.0, result));
+    EXPECT_TRUE(result.Succeeded());
+    EXPECT_FALSE(result.killed);
+    EXPECT_THROW(supervisor_.IsDone(handle), std::runtime_error);
+}
+
+TEST_F(ProcessSupervisorTest, MissingExecutable) {
+    auto handle = supervisor_.Launch("/nonexistent/simulator", {});
+    ProcessResult result = supervisor_.Wait(handle);
+    EXPECT_TRUE(result.exited);
+    EXPECT_EQ(127, result.exit_code);
+}
+
+TEST_F(ProcessSupervisorTest, TerminationSignalKillsProcessGroups) {
+    // A child process stands in for FieldOpt: it launches a simulation and is then sent SIGTERM
+    pid_t fieldopt = fork();
+    ASSERT_GE(fieldopt, 0);
+    if (fieldopt == 0) {
+        ProcessSupervisor supervisor;
+        supervisor.Launch("/bin/sh", {"-c", "echo $$ > " + out_path_ + ".tmp; mv " + out_path_ + ".tmp " + out_path_ + "; exec sleep 30"});
+        sleep(30);
+        _exit(0);
+    }
+    for (int i = 0; i < 100 && !std::ifstream(out_path_).good(); ++i) usleep(50000);
+    pid_t simulation = std::stoi(readFile(out_path_));
+    kill(fieldopt, SIGTERM);
+    int status;
+    waitpid(fieldopt, &status, 0);
+    EXPECT_TRUE(WIFSIGNALED(status));
+    EXPECT_EQ(SIGTERM, WTERMSIG(status));
+
+    // The orphaned simulation is reaped by init once it has been killed
+    bool gone = false;
+    for (int i = 0; i < 100 && !gone; ++i) {
+        gone = kill(simulation, 0) != 0 && errno == ESRCH;
+        if (!gone) usleep(50000);
+    }
+    EXPECT_TRUE(gone);
+}
+
+}
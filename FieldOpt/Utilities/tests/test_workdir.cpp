@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+
+#include "workdir.hpp"
+
+using namespace Utilities::FileHandling;
+namespace fs = boost::filesystem;
+
+namespace {
+
+class WorkDirTest : public ::testing::Test {
+ protected:
+  WorkDirTest() {
+      origin_ = (fs::temp_directory_path() / "fieldopt_test_workdir_origin").string();
+      destination_ = (fs::temp_directory_path() / "fieldopt_test_workdir").string();
+      fs::remove_all(origin_);
+      fs::remove_all(destination_);
+      fs::create_directories(origin_ + "/include");
+      fs::create_directories(destination_);
+      writeFile(origin_ + "/DECK.DATA", "deck");
+      writeFile(origin_ + "/DECK.UNSMRY", "old summary");
+      writeFile(origin_ + "/include/PERMX.INC", "permx");
+      writeFile(origin_ + "/include/SCH.INC", "schedule");
+  }
+  virtual ~WorkDirTest() {
+      fs::remove_all(origin_);
+      fs::remove_all(destination_);
+  }
+
+  void writeFile(const std::string &path, const std::string &content) {
+      std::ofstream file(path, std::ios::trunc);
+      file << content;
+  }
+
+  std::string readFile(const std::string &path) {
+      std::ifstream file(path);
+      std::stringstream ss;
+      ss << file.rdbuf();
+      return ss.str();
+  }
+
+  std::string origin_;
+  std::string destination_;
+};
+
+TEST_F(WorkDirTest, ProvisionDirectory) {
+    ProvisionDirectory(origin_, destination_, {"DECK"});
+    EXPECT_EQ("deck", readFile(destination_ + "/DECK.DATA"));
+    EXPECT_EQ("old summary", readFile(destination_ + "/DECK.UNSMRY"));
+    EXPECT_EQ("permx", readFile(destination_ + "/include/PERMX.INC"));
+
+    // Files named after the deck are never shared with the original
+    EXPECT_EQ(1, fs::hard_link_count(destination_ + "/DECK.UNSMRY"));
+    writeFile(destination_ + "/DECK.UNSMRY", "new summary");
+    EXPECT_EQ("old summary", readFile(origin_ + "/DECK.UNSMRY"));
+
+    // Provisioning again replaces the files
+    writeFile(destination_ + "/include/PERMX.INC.extra", "extra");
+    ProvisionDirectory(origin_, destination_, {"DECK"});
+    EXPECT_EQ("old summary", readFile(destination_ + "/DECK.UNSMRY"));
+    EXPECT_EQ("permx", readFile(destination_ + "/include/PERMX.INC"));
+}
+
+TEST_F(WorkDirTest, BreakHardLink) {
+    ProvisionDirectory(origin_, destination_, {});
+    std::string schedule = destination_ + "/include/SCH.INC";
+    BreakHardLink(schedule);
+    EXPECT_EQ(1, fs::hard_link_count(schedule));
+    EXPECT_EQ("schedule", readFile(schedule));
+    writeFile(schedule, "new schedule");
+    EXPECT_EQ("schedule", readFile(origin_ + "/include/SCH.INC"));
+
+    // Does nothing for missing files
+    BreakHardLink(destination_ + "/MISSING");
+    EXPECT_FALSE(fs::exists(destination_ + "/MISSING"));
+}
+
+}
@@ -46,6 +46,16 @@ inline double time_since_seconds(const std::chrono::system_clock::time_point t)
     return time.count();
 }
 
+/*!
+ * @brief Get the time since t in milliseconds using std lib methods.
+ * @param t Time to get the number of milliseconds since.
+ * @return Milliseconds since t.
+ */
+inline long time_since_milliseconds(const std::chrono::system_clock::time_point t) {
+    std::chrono::milliseconds time = std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - t);
+    return time.count();
+}
+
 /*!
  * @brief Get a time stamp string formatted as YYYY-MM-ddTHH:mm:ss
  * @return
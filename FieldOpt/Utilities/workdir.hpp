@@ -0,0 +1,137 @@
+/******************************************************************************
+   This file is part of the FieldOpt project.
+
+   FieldOpt is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   FieldOpt is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with FieldOpt.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+#ifndef WORKDIR_H
+#define WORKDIR_H
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+
+namespace Utilities {
+namespace FileHandling {
+
+/*!
+ * \brief CloneFile Create destination as a reflink (copy-on-write clone) of origin. This
+ * takes constant time, and the clone can be written without affecting the original.
+ * \return True if the clone was created; false if the file system does not support it.
+ */
+inline bool CloneFile(const std::string &origin, const std::string &destination) {
+#ifdef FICLONE
+    int src = open(origin.c_str(), O_RDONLY);
+    if (src < 0) return false;
+    struct stat st;
+    fstat(src, &st);
+    int dst = open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC, st.st_mode & 0777);
+    if (dst < 0) {
+        close(src);
+        return false;
+    }
+    bool cloned = ioctl(dst, FICLONE, src) == 0;
+    close(dst);
+    close(src);
+    if (!cloned) unlink(destination.c_str());
+    return cloned;
+#else
+    return false;
+#endif
+}
+
+/*!
+ * \brief LinkOrCopyFile Provide a file at destination with the contents of origin as
+ * cheaply as possible: as a reflink where the file system supports it, otherwise as a
+ * hard link, otherwise as a copy. An existing destination is replaced.
+ *
+ * A hard link shares its data with the original, so writing to it in place modifies the
+ * original too. Pass allow_hard_link=false for files that may be written in place.
+ */
+inline void LinkOrCopyFile(const std::string &origin, const std::string &destination, bool allow_hard_link) {
+    boost::filesystem::remove(destination);
+    if (CloneFile(origin, destination)) return;
+    if (allow_hard_link) {
+        boost::system::error_code ec;
+        boost::filesystem::create_hard_link(origin, destination, ec);
+        if (!ec) return;
+    }
+    boost::filesystem::copy_file(origin, destination);
+}
+
+/*!
+ * \brief BreakHardLink Make the file at the given path an independent copy if it is a hard
+ * link shared with another path, so that it can be written without modifying the other.
+ * Does nothing for files that do not exist or are not shared.
+ */
+inline void BreakHardLink(const std::string &path) {
+    boost::system::error_code ec;
+    if (boost::filesystem::hard_link_count(path, ec) <= 1 || ec) return;
+    std::string tmp = path + ".fo_unlink";
+    boost::filesystem::copy_file(path, tmp, boost::filesystem::copy_option::overwrite_if_exists);
+    boost::filesystem::rename(tmp, path);
+}
+
+/*!
+ * \brief ProvisionDirectory Populate destination with the contents of origin (recursively),
+ * linking files instead of copying them where possible (see LinkOrCopyFile).
+ *
+ * Files whose names start with one of the given prefixes are expected to be written in
+ * place (e.g. simulator output files named after the deck), and are never hard linked.
+ * Files that FieldOpt regenerates are protected by the writing functions in filehandling.hpp,
+ * which break hard links before writing.
+ * \param origin Path to the original directory.
+ * \param destination Path to the (existing) directory to populate.
+ * \param written_prefixes Prefixes of the names of files that may be written in place.
+ */
+inline void ProvisionDirectory(const std::string &origin,
+                               const std::string &destination,
+                               const std::vector<std::string> &written_prefixes,
+                               bool verbose=false) {
+    namespace fs = boost::filesystem;
+    if (!fs::is_directory(origin))
+        throw std::runtime_error("Can't find directory to provision from: " + origin);
+    if (!fs::is_directory(destination))
+        throw std::runtime_error("Can't find directory to provision: " + destination);
+
+    for (fs::directory_iterator it(origin); it != fs::directory_iterator(); ++it) {
+        std::string name = it->path().filename().string();
+        std::string target = destination + "/" + name;
+        if (fs::is_directory(it->status())) {
+            fs::create_directory(target);
+            ProvisionDirectory(it->path().string(), target, written_prefixes, verbose);
+        }
+        else if (fs::is_regular_file(it->status())) {
+            bool written = false;
+            for (auto &prefix : written_prefixes) {
+                if (!prefix.empty() && name.compare(0, prefix.size(), prefix) == 0) written = true;
+            }
+            LinkOrCopyFile(it->path().string(), target, !written);
+            if (verbose) std::cout << "Provisioning FILE: " << name << std::endl;
+        }
+    }
+}
+
+}
+}
+
+#endif // WORKDIR_H
@@ -356,7 +356,17 @@ RIECLExtractor::RIECLExtractor(const RICaseData* aCase,
 }
 
 // -----------------------------------------------------------------
-void RIECLExtractor::calculateIntersection() {
+RIECLExtractor::RIECLExtractor(const RICaseData* aCase,
+                               const Reservoir::WellIndexCalculation::WellPath& wellpath,
+                               const RISegmentIntersectionCache* previousSegments,
+                               RISegmentIntersectionCache* computedSegments)
+    : m_caseData(aCase), RIExtractor(aCase, wellpath) {
+  calculateIntersection(previousSegments, computedSegments);
+}
+
+// -----------------------------------------------------------------
+void RIECLExtractor::calculateIntersection(const RISegmentIntersectionCache* previousSegments,
+                                           RISegmentIntersectionCache* computedSegments) {
 
   map<RIMDCellIdxEnterLeaveKey, cvf::HexIntersectionInfo > uniqueIntersections;
 
@@ -371,48 +381,62 @@ void RIECLExtractor::calculateIntersection() {
     cvf::Vec3d p1 = m_wellPath->m_wellPathPoints[wpp];
     cvf::Vec3d p2 = m_wellPath->m_wellPathPoints[wpp+1];
 
-    // Add coords to bbox
-    cvf::BoundingBox bb;
-    bb.add(p1);
-    bb.add(p2);
+    // Reuse the intersections of segments that have not moved
+    std::array<double, 6> segmentKey = {{ p1.x(), p1.y(), p1.z(),
+                                          p2.x(), p2.y(), p2.z() }};
+    RISegmentIntersectionCache::const_iterator cached;
+    if (previousSegments != nullptr &&
+        (cached = previousSegments->find(segmentKey)) != previousSegments->end()) {
+      intersections = cached->second;
+    }
+    else {
+      // Add coords to bbox
+      cvf::BoundingBox bb;
+      bb.add(p1);
+      bb.add(p2);
 
-    // Find cells close to bbox
-    vector<size_t> closeCells = findCloseCells(bb);
+      // Find cells close to bbox
+      vector<size_t> closeCells = findCloseCells(bb);
 
-    // Loop through cell neighborhood
-    cvf::Vec3d hexCorners[8];
-    for (size_t cIdx = 0; cIdx < closeCells.size(); ++cIdx) {
+      // Loop through cell neighborhood
+      cvf::Vec3d hexCorners[8];
+      for (size_t cIdx = 0; cIdx < closeCells.size(); ++cIdx) {
 
-      // Get current cell
-      const RICell& cell =
-          m_caseData->mainGrid()->globalCellArray()[closeCells[cIdx]];
+        // Get current cell
+        const RICell& cell =
+            m_caseData->mainGrid()->globalCellArray()[closeCells[cIdx]];
 
-      if (cell.isInvalid()) continue;
+        if (cell.isInvalid()) continue;
 
-      // Get corner vertices of current cell
-      const caf::SizeTArray8& cornerIndices = cell.cornerIndices();
+        // Get corner vertices of current cell
+        const caf::SizeTArray8& cornerIndices = cell.cornerIndices();
 
-      hexCorners[0] = nodeCoords[cornerIndices[0]];
-      hexCorners[1] = nodeCoords[cornerIndices[1]];
-      hexCorners[2] = nodeCoords[cornerIndices[2]];
-      hexCorners[3] = nodeCoords[cornerIndices[3]];
-      hexCorners[4] = nodeCoords[cornerIndices[4]];
-      hexCorners[5] = nodeCoords[cornerIndices[5]];
-      hexCorners[6] = nodeCoords[cornerIndices[6]];
-      hexCorners[7] = nodeCoords[cornerIndices[7]];
+        hexCorners[0] = nodeCoords[cornerIndices[0]];
+        hexCorners[1] = nodeCoords[cornerIndices[1]];
+        hexCorners[2] = nodeCoords[cornerIndices[2]];
+        hexCorners[3] = nodeCoords[cornerIndices[3]];
+        hexCorners[4] = nodeCoords[cornerIndices[4]];
+        hexCorners[5] = nodeCoords[cornerIndices[5]];
+        hexCorners[6] = nodeCoords[cornerIndices[6]];
+        hexCorners[7] = nodeCoords[cornerIndices[7]];
 
-      cvf::RigHexIntersectionTools::lineHexCellIntersection(
-          p1, p2, hexCorners, closeCells[cIdx], &intersections);
+        cvf::RigHexIntersectionTools::lineHexCellIntersection(
+            p1, p2, hexCorners, closeCells[cIdx], &intersections);
 
-    } // End: for (size_t cIdx = 0; cIdx < closeCells.size(); ++cIdx)
+      } // End: for (size_t cIdx = 0; cIdx < closeCells.size(); ++cIdx)
 
-    if (!isCellFaceNormalsOut) {
-      for (size_t intIdx = 0; intIdx < intersections.size(); ++intIdx) {
-        intersections[intIdx].m_isIntersectionEntering =
-            !intersections[intIdx].m_isIntersectionEntering ;
+      if (!isCellFaceNormalsOut) {
+        for (size_t intIdx = 0; intIdx < intersections.size(); ++intIdx) {
+          intersections[intIdx].m_isIntersectionEntering =
+              !intersections[intIdx].m_isIntersectionEntering ;
+        }
       }
     }
 
+    if (computedSegments != nullptr) {
+      (*computedSegments)[segmentKey] = intersections;
+    }
+
     // Now, with all the intersections of this piece of line, we need to sort
     // them in order, and set the measured depth and corresponding cell index
 
@@ -277,12 +277,29 @@ class RIExtractor : public cvf::Object
 // ╠╦╝  ║  ║╣   ║    ║    ║╣   ╔╩╦╝   ║   ╠╦╝  ╠═╣  ║     ║   ║ ║  ╠╦╝
 // ╩╚═  ╩  ╚═╝  ╚═╝  ╩═╝  ╚═╝  ╩ ╚═   ╩   ╩╚═  ╩ ╩  ╚═╝   ╩   ╚═╝  ╩╚═
 //==================================================================
+// -----------------------------------------------------------------
+// Raw hex intersections of well path line segments, keyed on the
+// end points of the segment (x1, y1, z1, x2, y2, z2). Lets the
+// extractor skip re-intersecting segments that have not moved
+// since the last extraction for a well path.
+typedef map<std::array<double, 6>, vector<cvf::HexIntersectionInfo>>
+    RISegmentIntersectionCache;
+
 class RIECLExtractor : public RIExtractor
 {
  public:
   RIECLExtractor(const RICaseData* aCase,
                  const Reservoir::WellIndexCalculation::WellPath& wellpath);
 
+  // ---------------------------------------------------------------
+  // Segments found in previousSegments are not re-intersected; the
+  // intersections of all segments in wellpath are put in
+  // computedSegments, for use in the next extraction.
+  RIECLExtractor(const RICaseData* aCase,
+                 const Reservoir::WellIndexCalculation::WellPath& wellpath,
+                 const RISegmentIntersectionCache* previousSegments,
+                 RISegmentIntersectionCache* computedSegments);
+
 //  void curveData(
 //      const RIResultAccessor* resultAccessor,
 //      std::vector<double>* values );
@@ -291,7 +308,8 @@ class RIECLExtractor : public RIExtractor
 
 
  protected:
-  void calculateIntersection();
+  void calculateIntersection(const RISegmentIntersectionCache* previousSegments = nullptr,
+                             RISegmentIntersectionCache* computedSegments = nullptr);
   std::vector<size_t> findCloseCells(const cvf::BoundingBox& bb);
 
   virtual cvf::Vec3d calculateLengthInCell(
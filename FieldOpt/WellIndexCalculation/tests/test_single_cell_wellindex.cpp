@@ -157,4 +157,95 @@ TEST_F(SingleCellWellIndexTest, Well_index_grid_test) {
 
     EXPECT_EQ(117, wblocks.size());
 }
+
+TEST_F(SingleCellWellIndexTest, BatchedWellBlocksMatchSerial) {
+    file_path_ = TestResources::ExampleFilePaths::grid_5spot_;
+    auto uncached_grid = new ECLGrid(file_path_);
+    auto cached_grid = new ECLGrid(file_path_, true);
+
+    vector<WellDefinition> wells;
+    wells.push_back(init_well(Eigen::Vector3d(0.05, 0.00, 1712), Eigen::Vector3d(1440.0, 1400.0, 1712)));
+    wells.push_back(init_well(Eigen::Vector3d(10.0, 1400.0, 1705), Eigen::Vector3d(1400.0, 10.0, 1710)));
+    wells.push_back(init_well(Eigen::Vector3d(700.0, 20.0, 1702), Eigen::Vector3d(710.0, 1380.0, 1718)));
+    wells.push_back(init_well(Eigen::Vector3d(100.0, 700.0, 1712), Eigen::Vector3d(1300.0, 720.0, 1712)));
+    wells.push_back(init_well(Eigen::Vector3d(360.0, 360.0, 1701), Eigen::Vector3d(370.0, 370.0, 1719)));
+
+    for (auto grid : {uncached_grid, cached_grid}) {
+        auto wic = wicalc_rixx(grid);
+        vector<vector<IntersectedCell>> serial;
+        for (auto &well : wells) {
+            vector<IntersectedCell> well_indices;
+            wic.ComputeWellBlocks(well_indices, well);
+            serial.push_back(well_indices);
+        }
+
+        for (int n_threads : {1, 2, 4, 8}) {
+            vector<vector<IntersectedCell>> batched;
+            wic.ComputeWellBlocks(batched, wells, n_threads);
+            ASSERT_EQ(serial.size(), batched.size());
+            for (int w = 0; w < wells.size(); ++w) {
+                ASSERT_EQ(serial[w].size(), batched[w].size());
+                for (int c = 0; c < serial[w].size(); ++c) {
+                    EXPECT_EQ(serial[w][c].global_index(), batched[w][c].global_index());
+                    EXPECT_DOUBLE_EQ(serial[w][c].cell_well_index_matrix(), batched[w][c].cell_well_index_matrix());
+                    EXPECT_DOUBLE_EQ(serial[w][c].get_segment_entry_md(0), batched[w][c].get_segment_entry_md(0));
+                    EXPECT_DOUBLE_EQ(serial[w][c].get_segment_exit_md(0), batched[w][c].get_segment_exit_md(0));
+                }
+            }
+        }
+    }
+}
+
+TEST_F(SingleCellWellIndexTest, IncrementalWellBlocksMatchFresh) {
+    file_path_ = TestResources::ExampleFilePaths::grid_5spot_;
+    grid_ = new ECLGrid(file_path_);
+
+    std::vector<Eigen::Vector3d> points = {
+        Eigen::Vector3d(20.0, 20.0, 1702),
+        Eigen::Vector3d(400.0, 380.0, 1706),
+        Eigen::Vector3d(800.0, 760.0, 1710),
+        Eigen::Vector3d(1100.0, 1000.0, 1714),
+        Eigen::Vector3d(1400.0, 1380.0, 1716)
+    };
+    auto spline_well = [](const std::vector<Eigen::Vector3d> &pts) {
+        WellDefinition well;
+        well.wellname = "testwell";
+        for (int i = 0; i < pts.size() - 1; ++i) {
+            well.heels.push_back(pts[i]);
+            well.toes.push_back(pts[i+1]);
+            well.radii.push_back(0.1905/2.0);
+            well.skins.push_back(0.0);
+            well.heel_md.push_back(i == 0 ? 0.0 : well.toe_md.back());
+            well.toe_md.push_back(well.heel_md.back() + (pts[i+1] - pts[i]).norm());
+        }
+        return well;
+    };
+
+    auto incremental_wic = wicalc_rixx(grid_);
+    auto well = spline_well(points);
+    vector<IntersectedCell> well_indices;
+    incremental_wic.ComputeWellBlocks(well_indices, well);
+
+    // Move one interior point at a time, as a pattern search would
+    for (int p = 1; p < points.size() - 1; ++p) {
+        auto moved_points = points;
+        moved_points[p] += Eigen::Vector3d(35.0, -25.0, 1.5);
+        auto moved_well = spline_well(moved_points);
+
+        vector<IntersectedCell> incremental;
+        incremental_wic.ComputeWellBlocks(incremental, moved_well);
+
+        auto fresh_wic = wicalc_rixx(grid_);
+        vector<IntersectedCell> fresh;
+        fresh_wic.ComputeWellBlocks(fresh, moved_well);
+
+        ASSERT_EQ(fresh.size(), incremental.size());
+        for (int c = 0; c < fresh.size(); ++c) {
+            EXPECT_EQ(fresh[c].global_index(), incremental[c].global_index());
+            EXPECT_DOUBLE_EQ(fresh[c].cell_well_index_matrix(), incremental[c].cell_well_index_matrix());
+            EXPECT_DOUBLE_EQ(fresh[c].get_segment_entry_md(0), incremental[c].get_segment_entry_md(0));
+            EXPECT_DOUBLE_EQ(fresh[c].get_segment_exit_md(0), incremental[c].get_segment_exit_md(0));
+        }
+    }
+}
 }
@@ -38,6 +38,11 @@ using std::stringstream;
 
 // ---------------------------------------------------------
 #include <memory>
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <exception>
 #include <Utilities/verbosity.h>
 #include <Utilities/printer.hpp>
 #include <Utilities/stringhelpers.hpp>
@@ -151,7 +156,10 @@ void
 wicalc_rixx::collectIntersectedCells(vector<IntersectedCell> &isc_cells,
                                      vector<WellPathCellIntersectionInfo> isc_info,
                                      WellDefinition well,
-                                     WellPath& wellPath) {
+                                     WellPath& wellPath,
+                                     std::mutex *grid_mutex,
+                                     const IntersectedCellCache *previous_cells,
+                                     IntersectedCellCache *computed_cells) {
 
   vector<RICompData> completionData;
 
@@ -170,14 +178,40 @@ wicalc_rixx::collectIntersectedCells(vector<IntersectedCell> &isc_cells,
       continue;
     }
 
+    // -------------------------------------------------------------
+    // Reuse the cell if the well entered and exited it at the same
+    // points in the previous computation
+    std::array<double, 11> cell_key = {{
+        (double)cell.globCellIndex,
+        cell.startPoint.x(), cell.startPoint.y(), cell.startPoint.z(),
+        cell.endPoint.x(), cell.endPoint.y(), cell.endPoint.z(),
+        cell.startMD, cell.endMD, well.radii[0], well.skins[0] }};
+    if (previous_cells != nullptr) {
+      auto cached = previous_cells->find(cell_key);
+      if (cached != previous_cells->end()) {
+        isc_cells.push_back(cached->second);
+        if (computed_cells != nullptr) {
+          computed_cells->insert(*cached);
+        }
+        continue;
+      }
+    }
+
     // -------------------------------------------------------------
     // Make RI Completion object
     RICompData completion(QString::fromStdString(well.wellname),
                           IJKCellIndex(i, j, k));
 
     // -------------------------------------------------------------
-    // Make FO Cell object + fill values for trans.computation
-    IntersectedCell icell = grid_->GetCell(cell.globCellIndex);
+    // Make FO Cell object + fill values for trans.computation;
+    // the grid is not thread safe unless it has been cached
+    IntersectedCell icell;
+    if (grid_mutex != nullptr) {
+      std::lock_guard<std::mutex> lock(*grid_mutex);
+      icell = grid_->GetCell(cell.globCellIndex);
+    } else {
+      icell = grid_->GetCell(cell.globCellIndex);
+    }
 
     // -------------------------------------------------------------
     // Calculate direction
@@ -231,23 +265,15 @@ wicalc_rixx::collectIntersectedCells(vector<IntersectedCell> &isc_cells,
 
     // Add to vector of intersected cells
     isc_cells.push_back(icell);
+    if (computed_cells != nullptr) {
+      computed_cells->insert(std::make_pair(cell_key, icell));
+    }
   }
 }
 
 // =========================================================
-void
-wicalc_rixx::ComputeWellBlocks(
-    vector<IntersectedCell> &well_indices,
-    WellDefinition &well) {
-
-  // -------------------------------------------------------
-  stringstream str;
-  cvf::ref<WellPath> wellPath = nullptr;
-  cvf::ref<RIExtractor> extractor = nullptr;
-
-  // -------------------------------------------------------------
-  // Intersected cells for well
-  vector<IntersectedCell> intersected_cells;
+cvf::ref<WellPath>
+wicalc_rixx::createWellPath(const WellDefinition &well) const {
 
   // -------------------------------------------------------------
   // Loop through well segments
@@ -255,7 +281,7 @@ wicalc_rixx::ComputeWellBlocks(
     Printer::ext_info("Looping through " + Printer::num2str(well.radii.size()) + " segments.",
                       "wicalc_rixx", "WellIndexCalculation");
   }
-  wellPath = new WellPath();
+  cvf::ref<WellPath> wellPath = new WellPath();
   for (int seg = 0; seg < well.radii.size(); ++seg) {
     if (VERB_WIC >= 3) {
       Printer::ext_info("Computing segment " + Printer::num2str(seg)
@@ -263,9 +289,6 @@ wicalc_rixx::ComputeWellBlocks(
                     + "; StartPt: " + eigenvec_to_str(well.heels[seg]) + "; EndPt: " + eigenvec_to_str(well.toes[seg]),
                         "wicalc_rixx", "WellIndexCalculation" );
     }
-    // -----------------------------------------------------------
-    // cvf::ref<WellPath> wellPath = new WellPath();
-    vector<WellPathCellIntersectionInfo> intersectionInfos;
 
     // -----------------------------------------------------------
     // Load measuredepths onto wellPath (= current segment)
@@ -287,27 +310,38 @@ wicalc_rixx::ComputeWellBlocks(
     wellPath->m_wellPathPoints.push_back(cvf_xyzToe);
 
   }
+  return wellPath;
+}
 
-  // -----------------------------------------------------------
-  // Calculate cells intersected by well path
-  calculateWellPathIntersections(*wellPath, intersections_);
-  // cout << "[mod]wicalc_rixx-05.--------- calculateWellPathIntersections" << endl;
+// -----------------------------------------------------------------
+wicalc_rixx::WellCache *
+wicalc_rixx::wellCache(const string &well_name) {
+  return &dict_well_caches_[grid_->GetGridFilePath()][well_name];
+}
 
-  // -----------------------------------------------------------
-  // Use intersection data to find intersected cell data
-  // cvf::ref<RIExtractor> extractor = new RIECLExtractor(ricasedata, *wellPath);
-  extractor = new RIECLExtractor(ricasedata_.p(), *wellPath);
-  // cout << "[mod]wicalc_rixx-06.--------- cvf::ref<RIExtractor> extractor" << endl;
+// -----------------------------------------------------------------
+void
+wicalc_rixx::computeIntersectedCells(vector<IntersectedCell> &intersected_cells,
+                                     WellDefinition &well,
+                                     WellPath &wellPath,
+                                     std::mutex *grid_mutex,
+                                     WellCache *cache) {
 
   // -----------------------------------------------------------
-  activeCellInfo_ = ricasedata_->activeCellInfo(MATRIX_MODEL);
-  //fractureActiveCellInfo_ = ricasedata_->activeCellInfo(FRACTURE_MODEL);
-  // cout << "[mod]wicalc_rixx-07.--------- activeCellInfo_" << endl;
+  // Use intersection data to find intersected cell data; only
+  // the results of this computation are kept for the next one
+  WellCache computed;
+  cvf::ref<RIExtractor> extractor;
+  if (cache != nullptr) {
+    extractor = new RIECLExtractor(ricasedata_.p(), wellPath,
+                                   &cache->segments, &computed.segments);
+  } else {
+    extractor = new RIECLExtractor(ricasedata_.p(), wellPath);
+  }
 
   // -----------------------------------------------------------
   vector<WellPathCellIntersectionInfo>
       intersectedCellInfo = extractor->cellIntersectionInfosAlongWellPath();
-  // cout << "[mod]wicalc_rixx-08.--------- intersectedCellInfo" << endl;
   if (VERB_WIC >= 3) {
     for (auto celli : intersectedCellInfo) {
       auto gci = celli.globCellIndex;
@@ -327,18 +361,125 @@ wicalc_rixx::ComputeWellBlocks(
   collectIntersectedCells(intersected_cells,
                           intersectedCellInfo,
                           well,
-                          *wellPath);
+                          wellPath,
+                          grid_mutex,
+                          cache != nullptr ? &cache->cells : nullptr,
+                          cache != nullptr ? &computed.cells : nullptr);
+  if (cache != nullptr) {
+    std::swap(*cache, computed);
+  }
 
   if (VERB_WIC >= 2) {
     Printer::ext_info("Found " + Printer::num2str(intersected_cells.size())
-                          + " intersected cells.", "WellIndexCalculation", "wicalc_rixx");
+                          + " intersected cells in well " + well.wellname + ".",
+                      "WellIndexCalculation", "wicalc_rixx");
   }
+}
 
+// =========================================================
+void
+wicalc_rixx::ComputeWellBlocks(
+    vector<IntersectedCell> &well_indices,
+    WellDefinition &well) {
+
+  // -------------------------------------------------------------
+  // Intersected cells for well
+  vector<IntersectedCell> intersected_cells;
+  cvf::ref<WellPath> wellPath = createWellPath(well);
+
+  // -----------------------------------------------------------
+  activeCellInfo_ = ricasedata_->activeCellInfo(MATRIX_MODEL);
+  //fractureActiveCellInfo_ = ricasedata_->activeCellInfo(FRACTURE_MODEL);
+
+  // -----------------------------------------------------------
+  computeIntersectedCells(intersected_cells, well, *wellPath,
+                          nullptr, wellCache(well.wellname));
 
   // Assign intersected cells to well
   well_indices = intersected_cells;
 
 }
+
+// =========================================================
+void
+wicalc_rixx::ComputeWellBlocks(
+    vector<vector<IntersectedCell>> &well_indices,
+    vector<WellDefinition> &wells,
+    int n_threads) {
+
+  // -------------------------------------------------------------
+  // Each well writes only to its own slot, so the order of the
+  // output does not depend on the order the wells are finished in
+  well_indices.assign(wells.size(), vector<IntersectedCell>());
+  if (wells.empty()) {
+    return;
+  }
+  activeCellInfo_ = ricasedata_->activeCellInfo(MATRIX_MODEL);
+
+  // -------------------------------------------------------------
+  // The ERT backed grid computes cell data lazily on lookup;
+  // only a grid that has been read into memory may be shared.
+  auto *ecl_grid = dynamic_cast<Grid::ECLGrid *>(grid_);
+  bool grid_is_shareable = ecl_grid != nullptr && ecl_grid->IsCached();
+  std::mutex grid_mutex;
+  std::mutex *grid_lock = grid_is_shareable ? nullptr : &grid_mutex;
+
+  // -------------------------------------------------------------
+  // Look up the caches before starting the workers; a cache can
+  // only be used by one of the wells sharing a name
+  vector<WellCache *> caches;
+  std::set<string> well_names;
+  for (auto &well : wells) {
+    if (well_names.insert(well.wellname).second) {
+      caches.push_back(wellCache(well.wellname));
+    } else {
+      caches.push_back(nullptr);
+    }
+  }
+
+  n_threads = std::max(1, std::min(n_threads, (int)wells.size()));
+  if (VERB_WIC >= 2) {
+    Printer::ext_info("Computing well blocks for " + Printer::num2str((int)wells.size())
+                          + " wells using " + Printer::num2str(n_threads) + " threads.",
+                      "WellIndexCalculation", "wicalc_rixx");
+  }
+
+  // -------------------------------------------------------------
+  // Workers pull the index of the next well to compute from a
+  // shared counter; the first exception thrown is rethrown here
+  std::atomic<int> next_well(0);
+  std::exception_ptr error = nullptr;
+  std::mutex error_mutex;
+  auto worker = [&]() {
+    for (int w = next_well++; w < (int)wells.size(); w = next_well++) {
+      try {
+        cvf::ref<WellPath> wellPath = createWellPath(wells[w]);
+        computeIntersectedCells(well_indices[w], wells[w], *wellPath, grid_lock, caches[w]);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (error == nullptr) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  if (n_threads == 1) {
+    worker();
+  } else {
+    vector<std::thread> pool;
+    for (int t = 0; t < n_threads; ++t) {
+      pool.push_back(std::thread(worker));
+    }
+    for (auto &thread : pool) {
+      thread.join();
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
 // -----------------------------------------------------------------
 
 }
@@ -32,6 +32,9 @@
 #include "resinxx/well_path.h"
 #include "WellDefinition.h"
 
+// ---------------------------------------------------------
+#include <mutex>
+
 // ---------------------------------------------------------
 namespace Reservoir {
 namespace WellIndexCalculation {
@@ -42,6 +45,12 @@ using std::endl;
 using std::string;
 using std::vector;
 
+// ---------------------------------------------------------
+// Intersected cells with computed well indices, keyed on the
+// global cell index, the entry and exit points and MDs of the
+// well in the cell, and the well radius and skin.
+typedef map<std::array<double, 11>, IntersectedCell> IntersectedCellCache;
+
 //==========================================================
 class wicalc_rixx
 {
@@ -80,16 +89,51 @@ class wicalc_rixx
   void collectIntersectedCells(vector<IntersectedCell> &isc_cells,
                                vector<WellPathCellIntersectionInfo> isc_info,
                                WellDefinition well,
-                               WellPath& wellPath);
+                               WellPath& wellPath,
+                               std::mutex *grid_mutex = nullptr,
+                               const IntersectedCellCache *previous_cells = nullptr,
+                               IntersectedCellCache *computed_cells = nullptr);
 
   // ---------------------------------------------------------------
   void calculateWellPathIntersections(const WellPath& wellPath,
                                       vector<double> &isc_values);
 
   // ---------------------------------------------------------------
+  /*!
+   * @brief Compute the intersected cells and well indices for a well.
+   *
+   * The segment intersections and intersected cells computed for a
+   * well are kept (per grid and well name) until the next call for
+   * the same well. Segments whose end points have not moved since
+   * then are not re-intersected, and the well indices of cells
+   * entered and exited at the same points are reused, so that only
+   * the cells along moved segments are recomputed.
+   */
   void ComputeWellBlocks(vector<IntersectedCell> &well_indices,
                          WellDefinition &well);
 
+  /*!
+   * @brief Compute the intersected cells and well indices for
+   * all wells in a case, distributing the wells over a pool of
+   * n_threads worker threads.
+   *
+   * well_indices[w] is set to the cells computed for wells[w],
+   * so the output is independent of the number of threads and
+   * identical to calling ComputeWellBlocks for each well in turn.
+   * The case data for the active grid is only read by the
+   * workers; access to an uncached grid is serialized. Results
+   * for unchanged segments are reused as in the single-well
+   * version, except for wells sharing a name with an earlier
+   * well in the list.
+   *
+   * @param well_indices Output; resized to wells.size().
+   * @param wells Definitions of the wells to compute.
+   * @param n_threads Number of threads to use (<= 1 runs serially).
+   */
+  void ComputeWellBlocks(vector<vector<IntersectedCell>> &well_indices,
+                         vector<WellDefinition> &wells,
+                         int n_threads);
+
   /*!
    * @brief Check if a grid has been read into an RICaseData object.
    * @param path Grid path to check.
@@ -121,9 +165,31 @@ class wicalc_rixx
   // size_t gcellarray_sz_;
 
  private:
+  // ---------------------------------------------------------------
+  cvf::ref<WellPath> createWellPath(const WellDefinition &well) const;
+
+  /*!
+   * @brief Results kept from the last computation for a well.
+   */
+  struct WellCache {
+    RISegmentIntersectionCache segments;
+    IntersectedCellCache cells;
+  };
+
+  // ---------------------------------------------------------------
+  WellCache *wellCache(const string &well_name);
+
+  // ---------------------------------------------------------------
+  void computeIntersectedCells(vector<IntersectedCell> &intersected_cells,
+                               WellDefinition &well,
+                               WellPath &wellPath,
+                               std::mutex *grid_mutex,
+                               WellCache *cache);
+
   map<string, cvf::ref<RICaseData>> dict_casedata_;
   map<string, Grid::Grid*> dict_grids_;
   map<string, vector<double>> dict_intersections_;
+  map<string, map<string, WellCache>> dict_well_caches_; //!< Last results pr. well name, pr. grid path.
 
 };
 